@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+enum class CommandType : uint32_t {
+    // Does nothing, for checking that the plugin is draining commands
+    Ping,
+    SetFieldOfView,
+    SetSmoothing,
+    SetEnable,
+    SelectPreset,
+    Dump
+};
+
+// Command sent by an external client through shared memory. Fields have
+// fixed sizes, so the layout is the same for every compiler.
+struct Command {
+    // Steady clock time the client sent it, in nanoseconds
+    int64_t sendTime;
+    CommandType type;
+    // Field of view in degrees, index of a preset, or zero to disable and
+    // anything else to enable
+    int32_t value;
+    // Smoothing time constant in seconds
+    float smoothing;
+    uint32_t reserved;
+};
+
+static_assert(std::is_trivially_copyable_v<Command>);
+static_assert(sizeof(Command) == 24);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "plugin/Command.hpp"
+#include "utils/SharedMemory.hpp"
+#include "utils/SpscRing.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+// Shared memory rings the plugin drains the commands of external clients
+// from, one per client. Each client claims a channel by writing its process
+// id, so that it is the only producer of the channel's ring, and channels of
+// clients that died without releasing them are taken over. The plugin is the
+// only consumer and never blocks on a client.
+class CommandRing {
+public:
+    static constexpr auto NAME = "genshin_fov_unlock_commands";
+    // Bumped whenever the layout of the page or the commands changes
+    static constexpr uint32_t VERSION = 2;
+    static constexpr size_t CAPACITY = 256;
+    static constexpr size_t MAX_CLIENTS = 8;
+
+    CommandRing();
+    ~CommandRing() noexcept = default;
+
+    // Takes from each channel in turn, so a client flooding its ring cannot
+    // hold back the others
+    bool TryPop(Command& command) noexcept;
+
+private:
+    friend class CommandClient;
+
+    struct Channel {
+        // Process id of the client using the channel, or zero when free
+        std::atomic<uint32_t> owner;
+        SpscRing<Command, CAPACITY> ring;
+    };
+
+    struct Layout {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t size;
+        std::array<Channel, MAX_CLIENTS> channels;
+    };
+
+    static constexpr uint32_t MAGIC = 0x43564F46;
+
+    SharedMemory memory;
+    Layout* layout;
+    size_t nextChannel;
+};
+
+// Sends commands to a running plugin. Sending is a few stores to shared
+// memory, and the plugin picks them up on its next tick.
+class CommandClient {
+public:
+    // Throws std::system_error if no plugin is running, and
+    // std::runtime_error if its ring has another version or every channel
+    // is in use
+    CommandClient();
+    ~CommandClient() noexcept;
+
+    CommandClient(const CommandClient&) = delete;
+    CommandClient& operator=(const CommandClient&) = delete;
+
+    // Each returns the sequence number of the command, or nothing when the
+    // client's ring is full. Only one thread at a time may send.
+    std::optional<uint64_t> Ping() noexcept;
+    std::optional<uint64_t> SetFieldOfView(int value) noexcept;
+    std::optional<uint64_t> SetSmoothing(float value) noexcept;
+    std::optional<uint64_t> SetEnable(bool value) noexcept;
+    std::optional<uint64_t> SelectPreset(int index) noexcept;
+    std::optional<uint64_t> Dump() noexcept;
+    // Stamps the send time of the command
+    std::optional<uint64_t> Send(Command command) noexcept;
+
+    // Whether the plugin has taken the command off the ring
+    [[nodiscard]] bool IsReceived(uint64_t sequence) const noexcept;
+
+private:
+    // Claims a free channel, or failing that the channel of a client that
+    // died without releasing it
+    [[nodiscard]] static CommandRing::Channel* ClaimChannel(
+        std::span<CommandRing::Channel> channels) noexcept;
+
+    SharedMemory memory;
+    CommandRing::Layout* layout;
+    CommandRing::Channel* channel;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "utils/KeyBinding.hpp"
+#include "utils/SmoothingFilter.hpp"
+
+#include <optional>
+#include <vector>
+
+#include <Windows.h>
+
+struct Config {
+    bool enabled = true;
+    int fov = 75;
+    std::vector<int> fovPresets {
+        30, 45, 60, 75, 90, 110
+    };
+    float smoothing = 0.125;
+    FilterType filter = FilterType::Exponential;
+    float oneEuroBeta = 0.002f;
+
+    KeyBinding enableKey = MakeKeyBinding(VK_DOWN);
+    KeyBinding nextKey = MakeKeyBinding(VK_RIGHT);
+    KeyBinding prevKey = MakeKeyBinding(VK_LEFT);
+    KeyBinding dumpKey = MakeKeyBinding(VK_F12);
+};
+
+// Fields of a config that changed, in the same order as Config
+struct ConfigChange {
+    std::optional<bool> enabled;
+    std::optional<int> fov;
+    std::optional<std::vector<int>> fovPresets;
+    std::optional<float> smoothing;
+    std::optional<FilterType> filter;
+    std::optional<float> oneEuroBeta;
+
+    std::optional<KeyBinding> enableKey;
+    std::optional<KeyBinding> nextKey;
+    std::optional<KeyBinding> prevKey;
+    std::optional<KeyBinding> dumpKey;
+
+    [[nodiscard]] bool IsEmpty() const noexcept;
+};
+
+[[nodiscard]] ConfigChange Diff(const Config& previous, const Config& current);
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "plugin/Command.hpp"
+#include "plugin/Config.hpp"
+
+#include <chrono>
 #include <cstdint>
 #include <variant>
 
@@ -9,16 +13,21 @@ struct OnPluginStart {};
 
 struct OnPluginEnd {};
 
+// Key and config events carry the time the input was first seen, from which
+// the latency of applying it is measured
 struct OnKeyDown {
     const uint8_t vKey;
+    const std::chrono::steady_clock::time_point time;
 };
 
 struct OnKeyHold {
     const uint8_t vKey;
+    const std::chrono::steady_clock::time_point time;
 };
 
 struct OnKeyUp {
     const uint8_t vKey;
+    const std::chrono::steady_clock::time_point time;
 };
 
 struct OnCursorVisibilityChange {
@@ -29,6 +38,17 @@ struct OnForegroundWindowChange {
     const HWND foregroundWindow;
 };
 
+struct OnConfigChange {
+    const ConfigChange change;
+    const std::chrono::steady_clock::time_point time;
+};
+
+// Command of an external client, timed from when the client sent it
+struct OnCommand {
+    const Command command;
+    const std::chrono::steady_clock::time_point time;
+};
+
 using Event = std::variant<
     OnPluginStart,
     OnPluginEnd,
@@ -36,5 +56,7 @@ using Event = std::variant<
     OnKeyHold,
     OnKeyUp,
     OnCursorVisibilityChange,
-    OnForegroundWindowChange
+    OnForegroundWindowChange,
+    OnConfigChange,
+    OnCommand
 >;
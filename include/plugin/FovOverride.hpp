@@ -0,0 +1,60 @@
+#pragma once
+
+#include "utils/SmoothingFilter.hpp"
+
+#include <chrono>
+
+// Decides the field of view passed on for every call of the game's setter.
+// The setter is called for several cameras per frame, and only the one that
+// repeats its previous value or the default of 45 is overridden. Kept free
+// of platform code so recorded calls can be replayed offline.
+class FovOverride {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    struct Result {
+        float value;
+
+        // The output is back at the game's value and the hook is no longer
+        // wanted, so it can be disabled
+        bool isHookDone;
+
+        // The call is of the camera that is overridden, so the current
+        // target has been applied to it
+        bool isTargetApplied;
+    };
+
+    FovOverride() noexcept;
+    ~FovOverride() noexcept = default;
+
+    [[nodiscard]] SmoothingFilter<float>& Filter() noexcept;
+    [[nodiscard]] bool IsHooked() const noexcept;
+
+    void SetHook(bool value) noexcept;
+    void SetEnable(bool value) noexcept;
+    void SetFieldOfView(int value) noexcept;
+
+    // Calls of other cameras after which the filter restarts from the
+    // game's value, and distance below which the output counts as back at
+    // the game's value
+    void SetResetCallCount(int value) noexcept;
+    void SetSettleThreshold(float value) noexcept;
+
+    [[nodiscard]] Result Process(
+        void* instance, float value, TimePoint timePoint) noexcept;
+
+private:
+    SmoothingFilter<float> filter;
+
+    bool isHooked;
+    bool isEnabled;
+    bool isEnabledOnce;
+    int overrideFov;
+    int resetCallCount;
+    float settleThreshold;
+
+    int setFovCount;
+    void* previousInstance;
+    float previousFov;
+    bool isPreviousFov;
+};
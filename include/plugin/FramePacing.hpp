@@ -0,0 +1,80 @@
+#pragma once
+
+#include "utils/Histogram.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Frame times measured from the calls of the game's field of view setter,
+// which every camera makes once per rendered frame, with one histogram of
+// intervals per camera instance. Calls are recorded on the render thread,
+// one at a time, and the histograms are sampled and reported from a single
+// other thread without blocking it.
+class FramePacing {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    static constexpr size_t MAX_INSTANCES = 8;
+    // Longer gaps between calls are pauses, such as loading screens or the
+    // hook being disabled, rather than frames
+    static constexpr auto MAX_INTERVAL = std::chrono::seconds(1);
+    // Reports cover the last samples, taken once per period
+    static constexpr auto SAMPLE_PERIOD = std::chrono::seconds(1);
+    static constexpr size_t WINDOW_SAMPLES = 10;
+
+    FramePacing() noexcept;
+    ~FramePacing() noexcept = default;
+
+    FramePacing(const FramePacing&) = delete;
+    FramePacing& operator=(const FramePacing&) = delete;
+
+    void Record(void* instance, TimePoint time) noexcept;
+
+    // Does nothing until the sample period has passed since the last call
+    void Sample(TimePoint time);
+
+    // Intervals of each instance over the sampled window, in nanoseconds
+    [[nodiscard]] std::vector<std::pair<void*, HistogramSnapshot>>
+    Snapshot() const;
+
+    // One line per instance with its frame count, frame rates and frame
+    // time percentiles
+    [[nodiscard]] std::string Report() const;
+
+private:
+    // Each instance taking a slot, or calling again after a pause, starts a
+    // new generation. Intervals keep adding up across generations, so the
+    // sampling thread only ever subtracts earlier snapshots, and the render
+    // thread records nothing for a generation until the sampling thread has
+    // taken its starting snapshot.
+    struct Instance {
+        std::atomic<void*> instance;
+        // Published by the render thread once the slot's state is set
+        std::atomic<uint64_t> generation;
+        // Published by the sampling thread once it has the starting snapshot
+        std::atomic<uint64_t> sampledGeneration;
+        TimePoint previousTime;
+        Histogram intervals;
+    };
+
+    struct Window {
+        uint64_t generation;
+        std::deque<HistogramSnapshot> samples;
+    };
+
+    void Begin(Instance& slot, void* instance, TimePoint time) noexcept;
+
+    std::array<Instance, MAX_INSTANCES> instances;
+
+    // Only used by the sampling thread
+    std::array<Window, MAX_INSTANCES> windows;
+    TimePoint nextSample;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "utils/Histogram.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+// Latency of the stages between an input and the frame that first applies
+// it, recorded from the threads each stage ends on
+class InputLatency {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    enum class Stage : size_t {
+        // From the keyboard hook to the observer draining the input
+        KeyToObserver,
+        // From the keyboard hook to the plugin handling the event
+        KeyToHandler,
+        // From a config file change being seen to the plugin handling it
+        ConfigToHandler,
+        // From an external client sending a command to the plugin handling
+        // it
+        CommandToHandler,
+        // From the unlocker being given a target to the first call of the
+        // game's setter that applies it
+        TargetToFrame,
+        // From the key, config change or command to that same call
+        InputToFrame
+    };
+
+    [[nodiscard]] static InputLatency& GetInstance();
+
+    InputLatency() noexcept = default;
+    ~InputLatency() noexcept = default;
+
+    void Record(Stage stage, TimePoint start, TimePoint end) noexcept;
+    void Reset() noexcept;
+
+    // One line per stage with its count, mean and percentiles
+    [[nodiscard]] std::string Report() const;
+
+private:
+    static constexpr size_t STAGE_COUNT = 6;
+
+    std::array<Histogram, STAGE_COUNT> histograms;
+};
@@ -2,8 +2,15 @@
 
 #include "components/ConfigManager.hpp"
 #include "plugin/Events.hpp"
+#include "plugin/StatsPage.hpp"
 #include "plugin/interfaces/IMediator.hpp"
+#include "utils/CycleCounter.hpp"
+#include "utils/KeyBindingEngine.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 #include <Windows.h>
@@ -17,16 +24,35 @@ private:
     struct Visitor;
 
     void Start() noexcept override;
+    void Update() noexcept override;
     void Notify(const Event& event) noexcept override;
 
     template <typename Event>
     void Handle(const Event& event) noexcept;
     void ConsumeState() noexcept;
+    void SaveConfig() noexcept;
+    void Dump() noexcept;
+    void PublishStats(std::chrono::steady_clock::time_point now) noexcept;
+    void CompileKeyBindings() noexcept;
+    void Trigger(
+        size_t keyBinding,
+        std::chrono::steady_clock::time_point inputTime) noexcept;
 
     // State
     bool isUnlockerHooked;
     bool isWindowFocused;
     bool isCursorVisible;
+    // Changed since it was last saved, which happens on the next tick
+    bool isConfigDirty;
     std::vector<HWND> targetWindows;
     Config config;
+    KeyBindingEngine keyBindings;
+
+    // Stats page, and the totals at its last update from which rates are
+    // taken
+    std::optional<StatsPage> statsPage;
+    std::chrono::steady_clock::time_point statsTime;
+    uint64_t statsHookCalls;
+    CycleCounter::Totals statsTicks;
+    CycleCalibration cycleCalibration;
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "utils/CycleCounter.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+// Time the plugin spends on the game's threads and its own, counted in
+// cycles so that it can stay on in release builds
+class SelfOverhead {
+public:
+    enum class Site : size_t {
+        // Calls of the field of view hook for the overridden camera, once
+        // per frame, and for the others, without the original function
+        FrameCall,
+        OtherCall,
+        // Keyboard hook, without the next hooks in the chain
+        KeyboardHook
+    };
+
+    [[nodiscard]] static SelfOverhead& GetInstance();
+
+    SelfOverhead() noexcept = default;
+    ~SelfOverhead() noexcept = default;
+
+    [[nodiscard]] CycleCounter& Counter(Site site) noexcept;
+
+    // Time per frame on the render thread, per input on the keyboard hook
+    // thread and per tick on the mediator thread, whose cycles are counted
+    // by the mediator itself
+    [[nodiscard]] std::string Report(const CycleCounter& mediatorTicks) const;
+
+private:
+    static constexpr size_t SITE_COUNT = 3;
+
+    CycleCalibration calibration;
+    std::array<CycleCounter, SITE_COUNT> counters;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "utils/SeqLock.hpp"
+#include "utils/SharedMemory.hpp"
+#include "utils/SmoothingFilter.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+// State of the plugin as seen by external monitors. Fields have fixed sizes
+// and are ordered by size, so the layout is the same for every compiler.
+struct PluginStats {
+    // Steady clock time of the update, in nanoseconds, which the monitor
+    // compares to its own clock to tell a stalled plugin
+    int64_t updateTime;
+
+    // Rates over the last publish period
+    double hookCallRate;
+    double tickRate;
+    double tickMicroseconds;
+
+    uint64_t hookCalls;
+    uint64_t ticks;
+    int64_t pendingEvents;
+
+    // Errors since the plugin started
+    uint64_t hookErrors;
+    uint64_t configParseErrors;
+    uint64_t droppedInputs;
+
+    int32_t fov;
+    // Last value the filter gave the overridden camera
+    float appliedFov;
+    float smoothing;
+    float oneEuroBeta;
+    FilterType filter;
+    bool isEnabled;
+    bool isHooked;
+    bool isWindowFocused;
+    bool isCursorVisible;
+};
+
+static_assert(std::is_trivially_copyable_v<PluginStats>);
+static_assert(sizeof(PluginStats) == 104);
+
+// Shared memory page the plugin publishes its stats to. Publishing is a few
+// stores under a sequence lock, with no system call, and monitors poll it
+// without any coordination with the plugin.
+class StatsPage {
+public:
+    static constexpr auto NAME = "genshin_fov_unlock_stats";
+    // Bumped whenever the layout of the page or the stats changes
+    static constexpr uint32_t VERSION = 1;
+
+    StatsPage();
+    ~StatsPage() noexcept = default;
+
+    void Publish(const PluginStats& stats) noexcept;
+
+private:
+    friend class StatsPageReader;
+
+    struct Layout {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t size;
+        uint32_t reserved;
+        SeqLock<PluginStats> stats;
+    };
+
+    static constexpr uint32_t MAGIC = 0x53564F46;
+
+    SharedMemory memory;
+    Layout* layout;
+};
+
+// Read-only view of the page of a running plugin
+class StatsPageReader {
+public:
+    // Throws std::system_error if no plugin is running, and
+    // std::runtime_error if its page has another version
+    StatsPageReader();
+    ~StatsPageReader() noexcept = default;
+
+    // Retries while the plugin is publishing, and gives up if it stopped
+    // halfway through
+    [[nodiscard]] std::optional<PluginStats> Read() const noexcept;
+    // Number of times the plugin has published
+    [[nodiscard]] uint64_t Version() const noexcept;
+
+private:
+    SharedMemory memory;
+    const StatsPage::Layout* layout;
+};
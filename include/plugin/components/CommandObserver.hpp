@@ -0,0 +1,18 @@
+#pragma once
+
+#include "plugin/CommandRing.hpp"
+#include "plugin/Events.hpp"
+#include "plugin/interfaces/IComponent.hpp"
+
+// Drains the commands external clients send through shared memory into
+// events, once per update
+class CommandObserver final : public IComponent<Event> {
+public:
+    CommandObserver();
+    ~CommandObserver() noexcept override;
+
+private:
+    void Update() noexcept override;
+
+    CommandRing ring;
+};
@@ -1,38 +1,53 @@
 #pragma once
 
+#include "plugin/Config.hpp"
 #include "plugin/Events.hpp"
 #include "plugin/interfaces/IComponent.hpp"
+#include "utils/AsyncFileWriter.hpp"
+#include "utils/FileWatcher.hpp"
+#include "utils/WriteEchoFilter.hpp"
 
-#include <cstdint>
+#include <chrono>
 #include <filesystem>
-#include <vector>
-
-#include <Windows.h>
-
-struct Config {
-    bool enabled = true;
-    int fov = 75;
-    std::vector<int> fovPresets {
-        30, 45, 60, 75, 90, 110
-    };
-    float smoothing = 0.125;
-
-    uint8_t enableKey = VK_DOWN;
-    uint8_t nextKey = VK_RIGHT;
-    uint8_t prevKey = VK_LEFT;
-    uint8_t dumpKey = VK_F12;
-};
-
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Reads and writes the config file, and reports edits made to it while the
+// game runs as OnConfigChange events carrying only the edited fields. Writes
+// are atomic, coalesced and done in the background.
 class ConfigManager final : public IComponent<Event> {
 public:
     explicit ConfigManager(
         std::filesystem::path filePath = "fov_config.json") noexcept;
     ~ConfigManager() noexcept override;
 
-    // TODO: Add file watcher
-    [[nodiscard]] Config Read() const;
-    void Write(const Config& config) const;
+    [[nodiscard]] Config Read();
+    void Write(const Config& config);
 
 private:
+    void Update() noexcept override;
+
+    [[nodiscard]] std::string ReadText() const;
+    [[nodiscard]] Config Parse(std::string_view text) const;
+    void Reload() noexcept;
+
     std::filesystem::path filePath;
+
+    // The last config read or written, and the last one reported. Reloads
+    // happen on the watcher thread and are reported on the mediator's.
+    // Reloads of writes still landing are ignored, since they would undo
+    // the newer config of later writes.
+    std::mutex mutex;
+    Config currentConfig;
+    Config reportedConfig;
+    bool isReloaded;
+    std::chrono::steady_clock::time_point reloadTime;
+    WriteEchoFilter echoFilter;
+
+    std::unique_ptr<AsyncFileWriter> writer;
+
+    // Declared last so it stops before the state it reloads into is gone
+    std::unique_ptr<FileWatcher> watcher;
 };
@@ -2,9 +2,9 @@
 
 #include "plugin/Events.hpp"
 #include "plugin/interfaces/IComponent.hpp"
+#include "utils/MulticastRing.hpp"
 
-#include <mutex>
-#include <vector>
+#include <cstdint>
 
 class KeyboardObserver final : public IComponent<Event> {
 public:
@@ -14,8 +14,26 @@ public:
 private:
     struct Hook;
 
+    enum class KeyAction : uint8_t {
+        Down,
+        Hold,
+        Up
+    };
+
+    // Packed into one word so the ring stays lock-free, with the time as
+    // the low bits of the steady clock's nanoseconds, which wrap every few
+    // days but are drained within milliseconds
+    struct KeyInput {
+        uint64_t time : 48;
+        uint64_t vKey : 8;
+        uint64_t action : 8;
+    };
+
+    // Enough for every key of a keyboard held down with room to spare, as
+    // inputs are drained every update
+    using KeyInputRing = MulticastRing<KeyInput, 1024>;
+
     void Update() noexcept override;
 
-    std::mutex mutex;
-    std::vector<Event> keyboardEvents;
+    KeyInputRing::Reader reader;
 };
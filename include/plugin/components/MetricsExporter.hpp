@@ -0,0 +1,23 @@
+#pragma once
+
+#include "plugin/Events.hpp"
+#include "plugin/interfaces/IComponent.hpp"
+#include "utils/AsyncFileWriter.hpp"
+
+#include <chrono>
+#include <filesystem>
+
+// Writes the registered metrics as JSON once per period, in the background
+class MetricsExporter final : public IComponent<Event> {
+public:
+    MetricsExporter(
+        const std::filesystem::path& filePath, std::chrono::seconds period);
+    ~MetricsExporter() noexcept override;
+
+private:
+    void Update() noexcept override;
+
+    std::chrono::seconds period;
+    std::chrono::steady_clock::time_point nextExport;
+    AsyncFileWriter writer;
+};
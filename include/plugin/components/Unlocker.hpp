@@ -2,14 +2,37 @@
 
 #include "plugin/Events.hpp"
 #include "plugin/interfaces/IComponent.hpp"
+#include "utils/SmoothingFilter.hpp"
+
+#include <chrono>
+#include <filesystem>
 
 class Unlocker final : public IComponent<Event> {
 public:
-    Unlocker();
+    explicit Unlocker(const std::filesystem::path& cacheFilePath);
     ~Unlocker() noexcept override;
 
+    using TimePoint = std::chrono::steady_clock::time_point;
+
     void SetHook(bool value) const;
-    void SetEnable(bool value) const noexcept;
-    void SetFieldOfView(int value) noexcept;
+    // The input time is when the change was asked for, from which the
+    // latency until a frame applies it is measured while hooked
+    void SetEnable(bool value, TimePoint inputTime) const noexcept;
+    void SetFieldOfView(int value, TimePoint inputTime) noexcept;
     void SetSmoothing(float value) noexcept;
+    void SetFilter(FilterType type, float oneEuroBeta);
+
+    // Last value given to the overridden camera, or zero before any
+    [[nodiscard]] float AppliedFieldOfView() const noexcept;
+
+    // Writes the calls of the last seconds as a CSV trace. Calls are only
+    // recorded when logging is enabled.
+    void DumpTrace(const std::filesystem::path& filePath) const;
+
+    // Writes the frame times of each camera over the last seconds. Frame
+    // times are only recorded when frame pacing is enabled.
+    void DumpFramePacing(const std::filesystem::path& filePath) const;
+
+private:
+    void Update() noexcept override;
 };
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "utils/CycleCounter.hpp"
+#include "utils/Metrics.hpp"
+
 #include <atomic>
 #include <memory>
 #include <thread>
@@ -40,6 +43,9 @@ protected:
     requires IsComponent<Component, Event>
     void ClearComponent();
 
+    // Cycles spent in each tick, from the first update to the last event
+    [[nodiscard]] const CycleCounter& TickCycles() const noexcept;
+
 private:
     void StartThread();
     void StopThread() noexcept;
@@ -48,6 +54,11 @@ private:
     std::thread thread;
     std::vector<std::unique_ptr<IComponent<Event>>> components;
     std::vector<Event> events;
+    CycleCounter tickCycles;
+
+    MetricCounter& tickCount;
+    MetricCounter& eventCount;
+    MetricGauge& pendingEventCount;
 
     using ComponentIterator =
         typename decltype(components)::iterator;
@@ -1,16 +1,26 @@
 #pragma once
 
 #include "plugin/interfaces/IMediator.hpp"
+#include "utils/CycleCounter.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/Tracer.hpp"
 
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <thread>
 #include <utility>
 
 template <typename Event>
-IMediator<Event>::IMediator() {
+IMediator<Event>::IMediator()
+    : tickCount { MetricsRegistry::GetInstance().RegisterCounter(
+        "mediator.ticks") }
+    , eventCount { MetricsRegistry::GetInstance().RegisterCounter(
+        "mediator.events") }
+    , pendingEventCount { MetricsRegistry::GetInstance().RegisterGauge(
+        "mediator.pending_events") } {
     StartThread();
 }
 
@@ -67,6 +77,11 @@ void IMediator<Event>::ClearComponent() {
     throw std::runtime_error { "Component not set" };
 }
 
+template <typename Event>
+const CycleCounter& IMediator<Event>::TickCycles() const noexcept {
+    return tickCycles;
+}
+
 template <typename Event>
 template <typename Component>
 requires IsComponent<Component, Event>
@@ -89,19 +104,28 @@ template <typename Event>
 void IMediator<Event>::StartThread() {
     stopFlag.store(false);
     thread = std::thread([this]() {
+        TRACE_THREAD_NAME("mediator");
         Start();
         while (!stopFlag.load()) {
-            // Update components
-            for (auto& component : components) {
-                component->Update();
-            }
-            Update();
-
-            // Process events
-            for (const auto& event : events) {
-                Notify(event);
+            {
+                TRACE_SCOPE("Tick");
+                CycleScope tick { tickCycles };
+
+                // Update components
+                for (auto& component : components) {
+                    component->Update();
+                }
+                Update();
+
+                // Process events
+                pendingEventCount.Set(static_cast<int64_t>(events.size()));
+                for (const auto& event : events) {
+                    Notify(event);
+                }
+                eventCount.Add(events.size());
+                events.clear();
+                tickCount.Add();
             }
-            events.clear();
 
             // Wait until the next scheduler tick
             std::this_thread::sleep_for(
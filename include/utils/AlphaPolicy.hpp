@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+// Smoothing factors alpha = exp(-deltaTime / timeConstant) for
+// ExponentialFilter. SetTimeConstant is only called with positive values,
+// and deltaTime is never negative.
+
+// std::exp, exact up to the accuracy of the standard library
+template <typename T>
+class ExactAlpha {
+public:
+    void SetTimeConstant(T timeConstant) noexcept;
+    [[nodiscard]] T operator()(T deltaTime) const noexcept;
+
+private:
+    T timeConstant {};
+};
+
+// 2^-t split into an exact power of two and a degree 5 minimax polynomial
+// for the fraction. Absolute error is below 7.5e-8 for double and 1.6e-7
+// for float after rounding, and values under 2^-32 return zero.
+template <typename T>
+class PolynomialAlpha {
+public:
+    void SetTimeConstant(T timeConstant) noexcept;
+    [[nodiscard]] T operator()(T deltaTime) const noexcept;
+
+private:
+    static constexpr size_t MAX_EXPONENT = 32;
+
+    T scale {};
+};
+
+// Linear interpolation in a table of exp(-x) for x = deltaTime / tau in
+// [0, 16] with 1/64 steps. Absolute error is below 3.1e-5, and beyond the
+// table below exp(-16) = 1.2e-7. The table does not depend on the time
+// constant, so it is built once and shared.
+template <typename T>
+class TableAlpha {
+public:
+    void SetTimeConstant(T timeConstant) noexcept;
+    [[nodiscard]] T operator()(T deltaTime) const noexcept;
+
+private:
+    static constexpr size_t STEPS_PER_UNIT = 64;
+    static constexpr size_t TABLE_SIZE = 16 * STEPS_PER_UNIT;
+
+    [[nodiscard]] static const std::array<T, TABLE_SIZE + 1>& Table() noexcept;
+
+    T scale {};
+};
+
+#include "utils/AlphaPolicyInl.hpp"
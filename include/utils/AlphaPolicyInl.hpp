@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+
+template <typename T>
+void ExactAlpha<T>::SetTimeConstant(const T timeConstant) noexcept {
+    this->timeConstant = timeConstant;
+}
+
+template <typename T>
+T ExactAlpha<T>::operator()(const T deltaTime) const noexcept {
+    return std::exp(-deltaTime / timeConstant);
+}
+
+template <typename T>
+void PolynomialAlpha<T>::SetTimeConstant(const T timeConstant) noexcept {
+    scale = std::numbers::log2e_v<T> / timeConstant;
+}
+
+template <typename T>
+T PolynomialAlpha<T>::operator()(const T deltaTime) const noexcept {
+    // exp(-dt / tau) = 2^-t = 2^-k * 2^-f with t = k + f and f in [0, 1)
+    static constexpr auto POWERS = [] {
+        std::array<T, MAX_EXPONENT> powers {};
+        T power = static_cast<T>(1);
+        for (auto& value : powers) {
+            value = power;
+            power *= static_cast<T>(0.5);
+        }
+        return powers;
+    }();
+
+    const T t = deltaTime * scale;
+    if (!(t < static_cast<T>(MAX_EXPONENT))) {
+        return static_cast<T>(0);
+    }
+    const auto k = static_cast<size_t>(t);
+    const T f = t - static_cast<T>(k);
+
+    // Remez fit of 2^-f on [0, 1]
+    const T fraction = static_cast<T>(0.9999999250635262) + f *
+        (static_cast<T>(-0.6931422525933718) + f *
+        (static_cast<T>(0.2401721892495758) + f *
+        (static_cast<T>(-0.0552797225836039) + f *
+        (static_cast<T>(0.009188611733236497) + f *
+        static_cast<T>(-0.0009387883375996818)))));
+    return fraction * POWERS[k];
+}
+
+template <typename T>
+void TableAlpha<T>::SetTimeConstant(const T timeConstant) noexcept {
+    scale = static_cast<T>(STEPS_PER_UNIT) / timeConstant;
+}
+
+template <typename T>
+T TableAlpha<T>::operator()(const T deltaTime) const noexcept {
+    const T position = deltaTime * scale;
+    if (!(position < static_cast<T>(TABLE_SIZE))) {
+        return static_cast<T>(0);
+    }
+    const auto index = static_cast<size_t>(position);
+    const T fraction = position - static_cast<T>(index);
+    const auto& table = Table();
+    return table[index] + fraction * (table[index + 1] - table[index]);
+}
+
+template <typename T>
+const std::array<T, TableAlpha<T>::TABLE_SIZE + 1>&
+TableAlpha<T>::Table() noexcept {
+    static const auto table = [] {
+        std::array<T, TABLE_SIZE + 1> values {};
+        for (size_t i = 0; i <= TABLE_SIZE; ++i) {
+            values[i] = std::exp(
+                -static_cast<T>(i) / static_cast<T>(STEPS_PER_UNIT));
+        }
+        return values;
+    }();
+    return table;
+}
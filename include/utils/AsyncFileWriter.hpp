@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Replaces a file's contents atomically on its own thread. Contents given
+// in quick succession are coalesced into one write of the latest, once none
+// has been given for the debounce delay. On destruction, pending contents
+// are written right away, giving up on them if a write already in progress
+// does not finish within the shutdown timeout.
+class AsyncFileWriter {
+public:
+    // Called on the writer's thread when a write fails
+    using ErrorCallback = std::function<void(const std::exception&)>;
+
+    AsyncFileWriter(
+        std::filesystem::path filePath,
+        std::chrono::milliseconds debounceDelay,
+        std::chrono::milliseconds shutdownTimeout,
+        ErrorCallback onError = {}
+    );
+    ~AsyncFileWriter() noexcept;
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    void Write(std::string contents);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Shared with the thread, which may outlive the writer if it is stuck
+    // in a write at shutdown
+    struct State {
+        std::filesystem::path filePath;
+        ErrorCallback onError;
+
+        std::mutex mutex {};
+        std::condition_variable condition {};
+        std::string pending {};
+        // Set while contents are pending, pushed back by every write
+        Clock::time_point deadline { Clock::time_point::max() };
+        bool isWriting { false };
+        bool isStopping { false };
+    };
+
+    static void Run(State& state) noexcept;
+    static void WriteNow(State& state, std::string contents) noexcept;
+
+    std::chrono::milliseconds debounceDelay;
+    std::chrono::milliseconds shutdownTimeout;
+    std::shared_ptr<State> state;
+    std::thread thread;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-size set of flags that can be read and changed from any thread
+// without locking. Every operation is a single atomic instruction on one
+// word, so it is wait-free.
+template <size_t N>
+class AtomicBitset {
+    static_assert(N > 0, "N must be positive");
+
+public:
+    AtomicBitset() noexcept;
+    ~AtomicBitset() noexcept = default;
+
+    AtomicBitset(const AtomicBitset&) = delete;
+    AtomicBitset& operator=(const AtomicBitset&) = delete;
+
+    [[nodiscard]] static constexpr size_t Size() noexcept;
+
+    [[nodiscard]] bool Test(size_t index) const noexcept;
+    // Return the previous value
+    bool Set(size_t index, bool value = true) noexcept;
+    bool Reset(size_t index) noexcept;
+    void ResetAll() noexcept;
+
+private:
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t WORD_COUNT = (N + WORD_BITS - 1) / WORD_BITS;
+
+    [[nodiscard]] static constexpr uint64_t Mask(size_t index) noexcept;
+
+    std::array<std::atomic<uint64_t>, WORD_COUNT> words;
+};
+
+#include "utils/AtomicBitsetInl.hpp"
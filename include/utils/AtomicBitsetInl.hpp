@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Flags are independent of each other and of other memory, so relaxed
+// ordering is enough
+
+template <size_t N>
+AtomicBitset<N>::AtomicBitset() noexcept {
+    ResetAll();
+}
+
+template <size_t N>
+constexpr size_t AtomicBitset<N>::Size() noexcept {
+    return N;
+}
+
+template <size_t N>
+bool AtomicBitset<N>::Test(const size_t index) const noexcept {
+    const auto word = words[index / WORD_BITS].load(std::memory_order_relaxed);
+    return (word & Mask(index)) != 0;
+}
+
+template <size_t N>
+bool AtomicBitset<N>::Set(const size_t index, const bool value) noexcept {
+    auto& word = words[index / WORD_BITS];
+    const auto previous = value ?
+        word.fetch_or(Mask(index), std::memory_order_relaxed) :
+        word.fetch_and(~Mask(index), std::memory_order_relaxed);
+    return (previous & Mask(index)) != 0;
+}
+
+template <size_t N>
+bool AtomicBitset<N>::Reset(const size_t index) noexcept {
+    return Set(index, false);
+}
+
+template <size_t N>
+void AtomicBitset<N>::ResetAll() noexcept {
+    for (auto& word : words) {
+        word.store(0, std::memory_order_relaxed);
+    }
+}
+
+template <size_t N>
+constexpr uint64_t AtomicBitset<N>::Mask(const size_t index) noexcept {
+    return uint64_t { 1 } << (index % WORD_BITS);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+// Replaces a file's contents so that readers, and the file after a crash,
+// see either the old or the new contents in full. The contents go to a
+// temporary file next to it, flushed to disk, then renamed over it.
+void WriteFileAtomic(
+    const std::filesystem::path& filePath,
+    std::string_view contents);
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+// One recorded call of a hooked function
+struct CallSample {
+    double time;
+    uint64_t instance;
+    float value;
+};
+
+enum class CallTraceFormat : uint8_t {
+    Csv,
+    Binary
+};
+
+// The format is detected from the file contents
+[[nodiscard]] std::vector<CallSample> ReadCallTrace(
+    const std::filesystem::path& filePath);
+void WriteCallTrace(
+    const std::filesystem::path& filePath,
+    std::span<const CallSample> samples,
+    CallTraceFormat format = CallTraceFormat::Csv);
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Reads the processor's time stamp counter, or the steady clock's
+// nanoseconds where there is none. Only differences are meaningful.
+[[nodiscard]] inline uint64_t ReadCycles() noexcept;
+
+// Converts cycles to time from the rates of the cycle counter and the
+// steady clock since construction, which gets more precise as it ages
+class CycleCalibration {
+public:
+    CycleCalibration() noexcept;
+    ~CycleCalibration() noexcept = default;
+
+    [[nodiscard]] double NanosecondsPerCycle() const noexcept;
+    [[nodiscard]] std::chrono::steady_clock::duration Elapsed() const noexcept;
+
+private:
+    uint64_t startCycles;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+// Number of calls and cycles spent in them. Each thread adds to its own
+// cache line with plain loads and stores, so adding costs no atomic
+// read-modify-write and no cache line moves between threads. Slots are
+// given back when their thread exits, and threads beyond the slot count
+// share the last one, which they add to atomically.
+class CycleCounter {
+public:
+    static constexpr size_t MAX_THREADS = 16;
+
+    struct Totals {
+        uint64_t calls;
+        uint64_t cycles;
+    };
+
+    CycleCounter() noexcept = default;
+    ~CycleCounter() noexcept = default;
+
+    CycleCounter(const CycleCounter&) = delete;
+    CycleCounter& operator=(const CycleCounter&) = delete;
+
+    void Add(uint64_t cycles) noexcept;
+    // Sum of every thread's slot, each read at a slightly different time
+    [[nodiscard]] Totals Read() const noexcept;
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct alignas(CACHE_LINE) Slot {
+        std::atomic<uint64_t> calls;
+        std::atomic<uint64_t> cycles;
+    };
+
+    std::array<Slot, MAX_THREADS> slots;
+};
+
+// Adds the cycles from construction to the first of Stop and destruction
+class CycleScope {
+public:
+    explicit CycleScope(CycleCounter& counter) noexcept;
+    ~CycleScope() noexcept;
+
+    CycleScope(const CycleScope&) = delete;
+    CycleScope& operator=(const CycleScope&) = delete;
+
+    void Stop() noexcept;
+
+private:
+    CycleCounter* counter;
+    uint64_t start;
+};
+
+#include "utils/CycleCounterInl.hpp"
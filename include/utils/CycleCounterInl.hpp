@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+// Inline, as it is read twice around every measured call
+
+inline uint64_t ReadCycles() noexcept {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<
+        std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+inline CycleScope::CycleScope(CycleCounter& counter) noexcept
+    : counter { &counter }
+    , start { ReadCycles() } {}
+
+inline CycleScope::~CycleScope() noexcept {
+    Stop();
+}
+
+inline void CycleScope::Stop() noexcept {
+    if (counter) {
+        counter->Add(ReadCycles() - start);
+        counter = nullptr;
+    }
+}
@@ -1,9 +1,15 @@
 #pragma once
 
+#include "utils/AlphaPolicy.hpp"
+
 #include <chrono>
 #include <type_traits>
 
-template <typename T>
+template <
+    typename T,
+    typename AlphaPolicy = ExactAlpha<T>,
+    typename Clock = std::chrono::steady_clock
+>
 class ExponentialFilter {
     static_assert(
         std::is_floating_point_v<T>,
@@ -11,6 +17,8 @@ class ExponentialFilter {
     );
 
 public:
+    using TimePoint = typename Clock::time_point;
+
     explicit ExponentialFilter(
         T timeConstant = static_cast<T>(0),
         T initialValue = static_cast<T>(0)
@@ -19,12 +27,17 @@ public:
 
     void SetTimeConstant(T value) noexcept;
     void SetInitialValue(T value) noexcept;
+    void SetInitialValue(T value, TimePoint timePoint) noexcept;
+
+    // Timestamps earlier than the previous one count as no time elapsed
     T Update(T value) noexcept;
+    T Update(T value, TimePoint timePoint) noexcept;
 
 private:
     T timeConstant;
+    AlphaPolicy alphaPolicy;
     T lastFilteredValue;
-    std::chrono::time_point<std::chrono::steady_clock> lastTime;
+    TimePoint lastTime;
 };
 
 #include "utils/ExponentialFilterInl.hpp"
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+// N exponential filters updated together. Channels are stored as separate
+// contiguous arrays so the blend vectorizes, and one clock read and one
+// alpha are shared by every channel while they use the same time constant.
+template <typename T, size_t N, typename Clock = std::chrono::steady_clock>
+class ExponentialFilterBank {
+    static_assert(
+        std::is_floating_point_v<T>,
+        "T must be a floating-point type"
+    );
+    static_assert(N > 0, "N must be positive");
+
+public:
+    using TimePoint = typename Clock::time_point;
+
+    explicit ExponentialFilterBank(
+        T timeConstant = static_cast<T>(0),
+        T initialValue = static_cast<T>(0)
+    ) noexcept;
+    ~ExponentialFilterBank() noexcept = default;
+
+    [[nodiscard]] static constexpr size_t Size() noexcept;
+
+    void SetTimeConstant(T value) noexcept;
+    void SetTimeConstant(size_t channel, T value) noexcept;
+
+    // Also restarts the shared time base
+    void SetInitialValue(T value) noexcept;
+    void SetInitialValue(T value, TimePoint timePoint) noexcept;
+    void SetInitialValue(size_t channel, T value) noexcept;
+
+    [[nodiscard]] T Value(size_t channel) const noexcept;
+    [[nodiscard]] std::span<const T, N> Values() const noexcept;
+
+    std::span<const T, N> Update(std::span<const T, N> values) noexcept;
+    std::span<const T, N> Update(
+        std::span<const T, N> values,
+        TimePoint timePoint) noexcept;
+
+private:
+    [[nodiscard]] static T Alpha(T deltaTime, T timeConstant) noexcept;
+
+    alignas(64) std::array<T, N> lastFilteredValues;
+    alignas(64) std::array<T, N> timeConstants;
+    bool isUniform;
+    TimePoint lastTime;
+};
+
+#include "utils/ExponentialFilterBankInl.hpp"
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+template <typename T, size_t N, typename Clock>
+ExponentialFilterBank<T, N, Clock>::ExponentialFilterBank(
+    const T timeConstant,
+    const T initialValue) noexcept
+    : lastFilteredValues {}
+    , timeConstants {}
+    , isUniform { true } {
+    SetTimeConstant(timeConstant);
+    SetInitialValue(initialValue);
+}
+
+template <typename T, size_t N, typename Clock>
+constexpr size_t ExponentialFilterBank<T, N, Clock>::Size() noexcept {
+    return N;
+}
+
+template <typename T, size_t N, typename Clock>
+void ExponentialFilterBank<T, N, Clock>::SetTimeConstant(const T value) noexcept {
+    timeConstants.fill(value);
+    isUniform = true;
+}
+
+template <typename T, size_t N, typename Clock>
+void ExponentialFilterBank<T, N, Clock>::SetTimeConstant(
+    const size_t channel,
+    const T value) noexcept {
+    timeConstants[channel] = value;
+    isUniform = std::ranges::all_of(timeConstants, [value](const T other) {
+        return other == value;
+    });
+}
+
+template <typename T, size_t N, typename Clock>
+void ExponentialFilterBank<T, N, Clock>::SetInitialValue(const T value) noexcept {
+    SetInitialValue(value, Clock::now());
+}
+
+template <typename T, size_t N, typename Clock>
+void ExponentialFilterBank<T, N, Clock>::SetInitialValue(
+    const T value,
+    const TimePoint timePoint) noexcept {
+    lastFilteredValues.fill(value);
+    lastTime = timePoint;
+}
+
+template <typename T, size_t N, typename Clock>
+void ExponentialFilterBank<T, N, Clock>::SetInitialValue(
+    const size_t channel,
+    const T value) noexcept {
+    lastFilteredValues[channel] = value;
+}
+
+template <typename T, size_t N, typename Clock>
+T ExponentialFilterBank<T, N, Clock>::Value(const size_t channel) const noexcept {
+    return lastFilteredValues[channel];
+}
+
+template <typename T, size_t N, typename Clock>
+std::span<const T, N> ExponentialFilterBank<T, N, Clock>::Values() const noexcept {
+    return lastFilteredValues;
+}
+
+template <typename T, size_t N, typename Clock>
+std::span<const T, N> ExponentialFilterBank<T, N, Clock>::Update(
+    const std::span<const T, N> values) noexcept {
+    return Update(values, Clock::now());
+}
+
+template <typename T, size_t N, typename Clock>
+std::span<const T, N> ExponentialFilterBank<T, N, Clock>::Update(
+    const std::span<const T, N> values,
+    const TimePoint timePoint) noexcept {
+    // y(k) = x(k) + alpha * (y(k - 1) - x(k)), see ExponentialFilter
+
+    const T deltaTime = std::max(static_cast<T>(0),
+        std::chrono::duration_cast<std::chrono::duration<T>>(
+            timePoint - lastTime).count());
+    lastTime = std::max(lastTime, timePoint);
+
+    // Plain indexed loops over the arrays are left for the compiler to
+    // vectorize
+    T* filtered = lastFilteredValues.data();
+    const T* input = values.data();
+    if (isUniform) {
+        const T alpha = Alpha(deltaTime, timeConstants[0]);
+        for (size_t i = 0; i < N; ++i) {
+            filtered[i] = input[i] + alpha * (filtered[i] - input[i]);
+        }
+    } else {
+        for (size_t i = 0; i < N; ++i) {
+            const T alpha = Alpha(deltaTime, timeConstants[i]);
+            filtered[i] = input[i] + alpha * (filtered[i] - input[i]);
+        }
+    }
+    return lastFilteredValues;
+}
+
+template <typename T, size_t N, typename Clock>
+T ExponentialFilterBank<T, N, Clock>::Alpha(
+    const T deltaTime,
+    const T timeConstant) noexcept {
+    if (timeConstant <= static_cast<T>(0)) {
+        return static_cast<T>(0);
+    }
+    return std::exp(-deltaTime / timeConstant);
+}
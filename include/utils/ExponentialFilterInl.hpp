@@ -1,31 +1,52 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
-#include <cmath>
 
-template <typename T>
-ExponentialFilter<T>::ExponentialFilter(
+template <typename T, typename AlphaPolicy, typename Clock>
+ExponentialFilter<T, AlphaPolicy, Clock>::ExponentialFilter(
     const T timeConstant,
     const T initialValue) noexcept
     : timeConstant(static_cast<T>(0))
+    , alphaPolicy()
     , lastFilteredValue(static_cast<T>(0)) {
     SetTimeConstant(timeConstant);
     SetInitialValue(initialValue);
 }
 
-template <typename T>
-void ExponentialFilter<T>::SetTimeConstant(const T value) noexcept {
+template <typename T, typename AlphaPolicy, typename Clock>
+void ExponentialFilter<T, AlphaPolicy, Clock>::SetTimeConstant(const T value) noexcept {
     timeConstant = value;
+    if (value > static_cast<T>(0)) {
+        alphaPolicy.SetTimeConstant(value);
+    }
+}
+
+template <typename T, typename AlphaPolicy, typename Clock>
+void ExponentialFilter<T, AlphaPolicy, Clock>::SetInitialValue(const T value) noexcept {
+    SetInitialValue(value, Clock::now());
 }
 
-template <typename T>
-void ExponentialFilter<T>::SetInitialValue(const T value) noexcept {
+template <typename T, typename AlphaPolicy, typename Clock>
+void ExponentialFilter<T, AlphaPolicy, Clock>::SetInitialValue(
+    const T value,
+    const TimePoint timePoint) noexcept {
     lastFilteredValue = value;
-    lastTime = std::chrono::steady_clock::now();
+    lastTime = timePoint;
+}
+
+template <typename T, typename AlphaPolicy, typename Clock>
+T ExponentialFilter<T, AlphaPolicy, Clock>::Update(const T value) noexcept {
+    if (timeConstant <= static_cast<T>(0)) {
+        return value;
+    }
+    return Update(value, Clock::now());
 }
 
-template <typename T>
-T ExponentialFilter<T>::Update(const T value) noexcept {
+template <typename T, typename AlphaPolicy, typename Clock>
+T ExponentialFilter<T, AlphaPolicy, Clock>::Update(
+    const T value,
+    const TimePoint timePoint) noexcept {
     // y(k) = alpha * y(k - 1) + (1 - alpha) * x(k)
     // alpha = exp(-T / tau)
 
@@ -39,12 +60,12 @@ T ExponentialFilter<T>::Update(const T value) noexcept {
         return value;
     }
 
-    const auto currentTime = std::chrono::steady_clock::now();
-    const T deltaTime = std::chrono::duration_cast<std::chrono::duration<T>>(
-        currentTime - lastTime).count();
-    lastTime = currentTime;
+    const T deltaTime = std::max(static_cast<T>(0),
+        std::chrono::duration_cast<std::chrono::duration<T>>(
+            timePoint - lastTime).count());
+    lastTime = std::max(lastTime, timePoint);
 
-    const T alpha = std::exp(-deltaTime / timeConstant);
+    const T alpha = alphaPolicy(deltaTime);
     lastFilteredValue = alpha * lastFilteredValue +
         (static_cast<T>(1) - alpha) * value;
     return lastFilteredValue;
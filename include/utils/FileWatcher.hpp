@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <thread>
+
+namespace details {
+    // Native change notifications for one file, implemented per platform
+    // (inotify or ReadDirectoryChangesW)
+    class FileWatcherBackend {
+    public:
+        enum class WaitResult {
+            Changed,
+            Timeout,
+            Stopped
+        };
+
+        explicit FileWatcherBackend(const std::filesystem::path& filePath);
+        ~FileWatcherBackend() noexcept;
+
+        // Blocks until the file changes, the timeout expires or Stop is
+        // called. Without a timeout it waits indefinitely.
+        [[nodiscard]] WaitResult Wait(
+            std::optional<std::chrono::milliseconds> timeout) noexcept;
+        void Stop() noexcept;
+
+    private:
+        struct State;
+        std::unique_ptr<State> state;
+    };
+}
+
+// Calls back on its own thread after a file has been created, modified or
+// replaced. Bursts of changes, such as an editor truncating and rewriting
+// the file, are coalesced into one call once the file has been quiet for
+// the debounce delay. The parent directory is watched, so the file may be
+// missing or replaced by a rename.
+class FileWatcher {
+public:
+    using Callback = std::function<void()>;
+
+    FileWatcher(
+        const std::filesystem::path& filePath,
+        std::chrono::milliseconds debounceDelay,
+        Callback callback
+    );
+    ~FileWatcher() noexcept;
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+private:
+    void Run() noexcept;
+
+    std::chrono::milliseconds debounceDelay;
+    Callback callback;
+    details::FileWatcherBackend backend;
+    std::thread thread;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class HistogramSnapshot;
+
+// Counts of values in log-linear buckets, as in HDR histograms: each power
+// of two is split into the same number of linear buckets, so every value is
+// kept within about 3% whatever its magnitude. Values can be recorded from
+// any thread and read while being recorded.
+class Histogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t { 1 } << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT =
+        (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    Histogram() noexcept;
+    ~Histogram() noexcept = default;
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void Record(uint64_t value) noexcept;
+    // Cheaper, as counts are not read-modify-written atomically, but only
+    // correct while a single thread at a time records
+    void RecordExclusive(uint64_t value) noexcept;
+    void Reset() noexcept;
+
+    [[nodiscard]] HistogramSnapshot Snapshot() const;
+
+    [[nodiscard]] static size_t BucketIndex(uint64_t value) noexcept;
+    // Smallest and largest values that fall in a bucket
+    [[nodiscard]] static uint64_t BucketLowerBound(size_t index) noexcept;
+    [[nodiscard]] static uint64_t BucketUpperBound(size_t index) noexcept;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts;
+    std::atomic<uint64_t> sum;
+};
+
+// Copy of a histogram's counts at one point, which can be queried, merged
+// with others and subtracted from a later one to get the values recorded
+// in between
+class HistogramSnapshot {
+public:
+    HistogramSnapshot();
+    ~HistogramSnapshot() noexcept = default;
+
+    [[nodiscard]] uint64_t Count() const noexcept;
+    [[nodiscard]] uint64_t Sum() const noexcept;
+    [[nodiscard]] double Mean() const noexcept;
+    // Zero when empty. Values are those of the bucket's upper bound, so
+    // percentiles are never underestimated.
+    [[nodiscard]] uint64_t Min() const noexcept;
+    [[nodiscard]] uint64_t Max() const noexcept;
+    [[nodiscard]] uint64_t Percentile(double percentile) const noexcept;
+
+    HistogramSnapshot& operator+=(const HistogramSnapshot& other) noexcept;
+    // The other must be an earlier snapshot of the same histogram
+    HistogramSnapshot& operator-=(const HistogramSnapshot& other) noexcept;
+
+private:
+    friend class Histogram;
+
+    std::vector<uint64_t> counts;
+    uint64_t count;
+    uint64_t sum;
+};
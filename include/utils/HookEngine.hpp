@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include <span>
+
+struct HookChange {
+    void* target;
+    bool enable;
+};
+
+// Patches targets on behalf of MinHook instances, which keep the state
+// bookkeeping themselves
+class IHookEngine {
+public:
+    virtual ~IHookEngine() noexcept = default;
+
+    virtual void Create(void* target, void* detour, void** original) = 0;
+
+    // Disables the hook first if needed
+    virtual void Remove(void* target) = 0;
+
+    // Applies every change within a single freeze of the other threads
+    virtual void Apply(std::span<const HookChange> changes) = 0;
+};
+
+// Engine selected at build time, MinHook or the in-tree one
+[[nodiscard]] std::unique_ptr<IHookEngine> CreateHookEngine();
+
+// Replaces the engine used by MinHook instances. Only allowed while no hook
+// is created.
+void SetHookEngine(std::unique_ptr<IHookEngine> engine);
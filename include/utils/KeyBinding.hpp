@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Modifiers held while a key is pressed, as a bit mask. Left and right keys
+// of the same modifier are not told apart.
+enum class KeyModifiers : uint8_t {
+    None = 0,
+    Ctrl = 1 << 0,
+    Shift = 1 << 1,
+    Alt = 1 << 2,
+    Win = 1 << 3
+};
+
+[[nodiscard]] constexpr KeyModifiers operator|(
+    KeyModifiers lhs, KeyModifiers rhs) noexcept;
+[[nodiscard]] constexpr KeyModifiers operator&(
+    KeyModifiers lhs, KeyModifiers rhs) noexcept;
+[[nodiscard]] constexpr KeyModifiers operator~(KeyModifiers value) noexcept;
+
+// Modifier of a virtual-key code, or none for other keys
+[[nodiscard]] KeyModifiers GetKeyModifier(uint8_t vKey) noexcept;
+
+// A key pressed while exactly the given modifiers are held
+struct KeyChord {
+    uint8_t vKey;
+    KeyModifiers modifiers;
+
+    bool operator==(const KeyChord&) const noexcept = default;
+};
+
+// When a binding triggers, relative to its last chord's key
+enum class KeyPress : uint8_t {
+    // As soon as it is pressed
+    Down,
+    // Once it is released without having been held
+    Tap,
+    // Once it has been held for a while
+    Hold
+};
+
+// Chords pressed one after the other, such as Ctrl+K then F
+struct KeyBinding {
+    std::vector<KeyChord> sequence;
+    KeyPress press;
+
+    bool operator==(const KeyBinding&) const noexcept = default;
+};
+
+// A single key pressed down, as bindings used to be
+[[nodiscard]] KeyBinding MakeKeyBinding(uint8_t vKey);
+
+// Text form: an optional "tap:" or "hold:" prefix, then chords separated by
+// spaces, each made of modifiers and a key joined by '+', such as
+// "hold:Ctrl+Right" or "Ctrl+K F". Keys are named or given as virtual-key
+// codes such as 0x28. Names are case-insensitive.
+[[nodiscard]] KeyBinding ParseKeyBinding(std::string_view text);
+[[nodiscard]] std::string FormatKeyBinding(const KeyBinding& binding);
+
+#include "utils/KeyBindingInl.hpp"
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "utils/KeyBinding.hpp"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+// Matches key events against bindings compiled into a transition table. The
+// chords of every binding form paths from a root state, and each key event
+// follows at most one edge, found by indexing the current state's row with
+// the key. Events cost the same however many bindings there are, and never
+// allocate.
+class KeyBindingEngine {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    // Without any bindings
+    KeyBindingEngine();
+    // Events return the index of the binding they trigger. Throws if a
+    // binding is a prefix of another or two trigger on the same event.
+    explicit KeyBindingEngine(
+        std::span<const KeyBinding> bindings,
+        std::chrono::milliseconds holdDelay = std::chrono::milliseconds { 500 },
+        std::chrono::milliseconds sequenceTimeout =
+            std::chrono::milliseconds { 1000 }
+    );
+    ~KeyBindingEngine() noexcept = default;
+
+    std::optional<size_t> OnKeyDown(uint8_t vKey, TimePoint time) noexcept;
+    // Auto-repeated key down, which lets holds trigger while still held
+    std::optional<size_t> OnKeyHold(uint8_t vKey, TimePoint time) noexcept;
+    std::optional<size_t> OnKeyUp(uint8_t vKey, TimePoint time) noexcept;
+
+    // Forgets sequences in progress, but not which keys are held
+    void Reset() noexcept;
+
+private:
+    static constexpr uint16_t ROOT = 0;
+    static constexpr uint16_t NONE = UINT16_MAX;
+    static constexpr size_t KEY_COUNT = 256;
+
+    struct Edge {
+        KeyModifiers modifiers;
+        uint16_t next;
+    };
+
+    // Bindings that end in a state, by KeyPress
+    using Actions = std::array<uint16_t, 3>;
+
+    [[nodiscard]] uint16_t Find(
+        uint16_t state, uint8_t vKey, KeyModifiers modifiers) const noexcept;
+    void SetKeyDown(uint8_t vKey, bool isDown) noexcept;
+
+    std::chrono::milliseconds holdDelay;
+    std::chrono::milliseconds sequenceTimeout;
+
+    // Row of each state, indexed by key, holding the end of that key's
+    // edges in edges. They start where the previous key's end.
+    std::vector<uint32_t> edgeEnds;
+    std::vector<Edge> edges;
+    std::vector<Actions> actions;
+
+    uint16_t state;
+    TimePoint stepTime;
+    std::bitset<KEY_COUNT> keysDown;
+    std::array<uint8_t, 4> modifierKeyCounts;
+    KeyModifiers modifiers;
+
+    // The last key of a tap or hold binding, until it is released
+    uint16_t pendingState;
+    uint8_t pendingKey;
+    TimePoint pendingTime;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <type_traits>
+
+constexpr KeyModifiers operator|(
+    const KeyModifiers lhs,
+    const KeyModifiers rhs) noexcept {
+    using Underlying = std::underlying_type_t<KeyModifiers>;
+    return static_cast<KeyModifiers>(
+        static_cast<Underlying>(lhs) | static_cast<Underlying>(rhs));
+}
+
+constexpr KeyModifiers operator&(
+    const KeyModifiers lhs,
+    const KeyModifiers rhs) noexcept {
+    using Underlying = std::underlying_type_t<KeyModifiers>;
+    return static_cast<KeyModifiers>(
+        static_cast<Underlying>(lhs) & static_cast<Underlying>(rhs));
+}
+
+constexpr KeyModifiers operator~(const KeyModifiers value) noexcept {
+    using Underlying = std::underlying_type_t<KeyModifiers>;
+    return static_cast<KeyModifiers>(~static_cast<Underlying>(value));
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Clock that only moves when told to. Can be plugged into the filters to
+// replay recorded input faster than real time or to check them
+// deterministically.
+class ManualClock {
+public:
+    using rep = int64_t;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<ManualClock>;
+
+    static constexpr bool is_steady = true;
+
+    [[nodiscard]] static time_point now() noexcept;
+
+    static void Set(time_point value) noexcept;
+    static void Advance(duration value) noexcept;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "utils/Histogram.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Count of events that only goes up
+class MetricCounter {
+public:
+    MetricCounter() noexcept = default;
+    ~MetricCounter() noexcept = default;
+
+    MetricCounter(const MetricCounter&) = delete;
+    MetricCounter& operator=(const MetricCounter&) = delete;
+
+    void Add(uint64_t value = 1) noexcept;
+    [[nodiscard]] uint64_t Value() const noexcept;
+
+private:
+    std::atomic<uint64_t> value;
+};
+
+// Current level of something, such as a queue's length
+class MetricGauge {
+public:
+    MetricGauge() noexcept = default;
+    ~MetricGauge() noexcept = default;
+
+    MetricGauge(const MetricGauge&) = delete;
+    MetricGauge& operator=(const MetricGauge&) = delete;
+
+    void Set(int64_t value) noexcept;
+    void Add(int64_t value) noexcept;
+    [[nodiscard]] int64_t Value() const noexcept;
+
+private:
+    std::atomic<int64_t> value;
+};
+
+// Named metrics, registered once and then updated from any thread with
+// relaxed atomics, without going through the registry. Registering a name
+// again returns the same metric. Metrics live as long as the registry.
+class MetricsRegistry {
+public:
+    [[nodiscard]] static MetricsRegistry& GetInstance();
+
+    MetricsRegistry() = default;
+    ~MetricsRegistry() noexcept = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // Throw std::invalid_argument if the name is taken by another kind
+    [[nodiscard]] MetricCounter& RegisterCounter(std::string_view name);
+    [[nodiscard]] MetricGauge& RegisterGauge(std::string_view name);
+    [[nodiscard]] Histogram& RegisterHistogram(std::string_view name);
+
+    // One metric per line, sorted by name, with histograms summarized by
+    // their count, mean and percentiles
+    [[nodiscard]] std::string ToText() const;
+    [[nodiscard]] std::string ToJson(int indent = 4) const;
+
+private:
+    template <typename Metric>
+    using Metrics = std::map<
+        std::string, std::unique_ptr<Metric>, std::less<>>;
+
+    template <typename Metric>
+    Metric& Register(Metrics<Metric>& metrics, std::string_view name);
+    [[nodiscard]] bool IsRegistered(std::string_view name) const noexcept;
+
+    mutable std::mutex mutex;
+    Metrics<MetricCounter> counters;
+    Metrics<MetricGauge> gauges;
+    Metrics<Histogram> histograms;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 namespace details {
@@ -18,9 +19,30 @@ namespace details {
         [[nodiscard]] static bool IsEnabled(void* target) noexcept;
         static void Enable(void* target);
         static void Disable(void* target);
+
+        static void BeginTransaction();
+        static void CommitTransaction();
+        static void AbortTransaction() noexcept;
     };
 }
 
+// Queues Enable and Disable calls of every MinHook until Commit, which
+// applies them within a single freeze of the other threads. Changes that
+// were not committed are discarded on destruction.
+class HookTransaction : details::MinHookBackend {
+public:
+    HookTransaction();
+    ~HookTransaction() noexcept;
+
+    HookTransaction(const HookTransaction&) = delete;
+    HookTransaction& operator=(const HookTransaction&) = delete;
+
+    void Commit();
+
+private:
+    bool isOpen;
+};
+
 template <typename Ret, typename... Args>
 class MinHook : public details::MinHookBackend {
 public:
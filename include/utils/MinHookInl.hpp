@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <utility>
 
 template <typename Ret, typename... Args>
 MinHook<Ret, Args...>::MinHook()
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// Fixed-capacity ring written by one producer and read by any number of
+// readers, each of which sees every value through its own cursor. The
+// producer never waits for readers: a reader that falls more than the
+// capacity behind skips the values that were overwritten and counts them
+// as lost. Pushing and reading are wait-free and never allocate.
+template <typename T, size_t Capacity>
+class MulticastRing {
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "T must be trivially copyable"
+    );
+    static_assert(
+        std::atomic<T>::is_always_lock_free,
+        "T must fit in a lock-free atomic"
+    );
+    static_assert(
+        Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+        "Capacity must be a power of two"
+    );
+
+public:
+    class Reader {
+    public:
+        // Starts after the values already pushed
+        explicit Reader(const MulticastRing& ring) noexcept;
+        ~Reader() noexcept = default;
+
+        // Returns false when there is no new value
+        bool Next(T& value) noexcept;
+
+        [[nodiscard]] uint64_t Lost() const noexcept;
+
+    private:
+        const MulticastRing* ring;
+        uint64_t cursor;
+        uint64_t lost;
+    };
+
+    MulticastRing() noexcept;
+    ~MulticastRing() noexcept = default;
+
+    MulticastRing(const MulticastRing&) = delete;
+    MulticastRing& operator=(const MulticastRing&) = delete;
+
+    [[nodiscard]] static constexpr size_t Size() noexcept;
+
+    // Must only be called from one thread at a time
+    void Push(const T& value) noexcept;
+
+private:
+    // The sequence is the position of the value plus one, or zero while
+    // it is being replaced
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        std::atomic<T> value;
+    };
+
+    static constexpr size_t CACHE_LINE = 64;
+
+    alignas(CACHE_LINE) std::atomic<uint64_t> head;
+    alignas(CACHE_LINE) std::array<Slot, Capacity> slots;
+};
+
+#include "utils/MulticastRingInl.hpp"
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, size_t Capacity>
+MulticastRing<T, Capacity>::Reader::Reader(const MulticastRing& ring) noexcept
+    : ring { &ring }
+    , cursor { ring.head.load(std::memory_order_acquire) }
+    , lost { 0 } {}
+
+template <typename T, size_t Capacity>
+bool MulticastRing<T, Capacity>::Reader::Next(T& value) noexcept {
+    while (true) {
+        const auto head = ring->head.load(std::memory_order_acquire);
+        if (cursor == head) {
+            return false;
+        }
+        if (head - cursor > Capacity) {
+            lost += head - Capacity - cursor;
+            cursor = head - Capacity;
+        }
+
+        // Read like a seqlock: the value is only valid if the slot held the
+        // same position before and after it was copied
+        const auto& slot = ring->slots[cursor % Capacity];
+        const auto before = slot.sequence.load(std::memory_order_acquire);
+        const auto result = slot.value.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto after = slot.sequence.load(std::memory_order_relaxed);
+        ++cursor;
+        if (before == cursor && after == cursor) {
+            value = result;
+            return true;
+        }
+        // Overwritten while being read, which means this reader is being
+        // lapped and the values after it are about to be overwritten too
+        ++lost;
+    }
+}
+
+template <typename T, size_t Capacity>
+uint64_t MulticastRing<T, Capacity>::Reader::Lost() const noexcept {
+    return lost;
+}
+
+template <typename T, size_t Capacity>
+MulticastRing<T, Capacity>::MulticastRing() noexcept
+    : head { 0 } {
+    for (auto& slot : slots) {
+        slot.sequence.store(0, std::memory_order_relaxed);
+    }
+}
+
+template <typename T, size_t Capacity>
+constexpr size_t MulticastRing<T, Capacity>::Size() noexcept {
+    return Capacity;
+}
+
+template <typename T, size_t Capacity>
+void MulticastRing<T, Capacity>::Push(const T& value) noexcept {
+    const auto position = head.load(std::memory_order_relaxed);
+    auto& slot = slots[position % Capacity];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.sequence.store(position + 1, std::memory_order_release);
+    head.store(position + 1, std::memory_order_release);
+}
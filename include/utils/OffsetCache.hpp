@@ -0,0 +1,51 @@
+#pragma once
+
+#include "utils/PeImage.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct ModuleFingerprint {
+    uint32_t timeDateStamp;
+    uint32_t sizeOfImage;
+    uint64_t sectionHash;
+
+    bool operator==(const ModuleFingerprint&) const noexcept = default;
+};
+
+// Only uses fields that are identical on disk and once loaded, so files and
+// running images of the same build share fingerprints
+[[nodiscard]] ModuleFingerprint GetModuleFingerprint(
+    const PeImage& image) noexcept;
+
+// Resolved RVAs persisted across launches, keyed by name and module build
+class OffsetCache {
+public:
+    explicit OffsetCache(std::filesystem::path filePath) noexcept;
+    ~OffsetCache() noexcept;
+
+    void Read();
+    void Write() const;
+
+    [[nodiscard]] std::optional<uint32_t> Get(
+        std::string_view name,
+        const ModuleFingerprint& fingerprint) const noexcept;
+    void Set(
+        std::string_view name,
+        const ModuleFingerprint& fingerprint,
+        uint32_t rva);
+
+private:
+    struct Entry {
+        std::string name;
+        ModuleFingerprint fingerprint;
+        uint32_t rva;
+    };
+
+    std::filesystem::path filePath;
+    std::vector<Entry> entries;
+};
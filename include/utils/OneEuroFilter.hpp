@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <type_traits>
+
+// One Euro filter (Casiez et al., CHI 2012). A low-pass filter whose cutoff
+// frequency rises with the filtered rate of change, so slow changes are
+// smoothed heavily while fast ones follow with little lag.
+template <typename T, typename Clock = std::chrono::steady_clock>
+class OneEuroFilter {
+    static_assert(
+        std::is_floating_point_v<T>,
+        "T must be a floating-point type"
+    );
+
+public:
+    using TimePoint = typename Clock::time_point;
+
+    // Cutoffs are in hertz and beta in hertz per unit per second
+    explicit OneEuroFilter(
+        T minCutoff = static_cast<T>(1),
+        T beta = static_cast<T>(0),
+        T derivativeCutoff = static_cast<T>(1),
+        T initialValue = static_cast<T>(0)
+    ) noexcept;
+    ~OneEuroFilter() noexcept = default;
+
+    void SetMinCutoff(T value) noexcept;
+    void SetBeta(T value) noexcept;
+    void SetDerivativeCutoff(T value) noexcept;
+
+    // Minimum cutoff equivalent to an exponential filter's time constant
+    void SetTimeConstant(T value) noexcept;
+
+    void SetInitialValue(T value) noexcept;
+    void SetInitialValue(T value, TimePoint timePoint) noexcept;
+    T Update(T value) noexcept;
+    T Update(T value, TimePoint timePoint) noexcept;
+
+private:
+    // Exact for a constant input over deltaTime, so frame rate independent
+    [[nodiscard]] static T Smoothing(T cutoff, T deltaTime) noexcept;
+
+    T minCutoff;
+    T beta;
+    T derivativeCutoff;
+    T lastFilteredValue;
+    T lastDerivative;
+    TimePoint lastTime;
+};
+
+#include "utils/OneEuroFilterInl.hpp"
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+template <typename T, typename Clock>
+OneEuroFilter<T, Clock>::OneEuroFilter(
+    const T minCutoff,
+    const T beta,
+    const T derivativeCutoff,
+    const T initialValue) noexcept
+    : minCutoff(minCutoff)
+    , beta(beta)
+    , derivativeCutoff(derivativeCutoff)
+    , lastFilteredValue(static_cast<T>(0))
+    , lastDerivative(static_cast<T>(0)) {
+    SetInitialValue(initialValue);
+}
+
+template <typename T, typename Clock>
+void OneEuroFilter<T, Clock>::SetMinCutoff(const T value) noexcept {
+    minCutoff = value;
+}
+
+template <typename T, typename Clock>
+void OneEuroFilter<T, Clock>::SetBeta(const T value) noexcept {
+    beta = value;
+}
+
+template <typename T, typename Clock>
+void OneEuroFilter<T, Clock>::SetDerivativeCutoff(const T value) noexcept {
+    derivativeCutoff = value;
+}
+
+template <typename T, typename Clock>
+void OneEuroFilter<T, Clock>::SetTimeConstant(const T value) noexcept {
+    // fc = 1 / (2 * pi * tau), with no smoothing for non-positive tau
+    minCutoff = value > static_cast<T>(0) ?
+        static_cast<T>(1) / (static_cast<T>(2) * std::numbers::pi_v<T> * value) :
+        static_cast<T>(0);
+}
+
+template <typename T, typename Clock>
+void OneEuroFilter<T, Clock>::SetInitialValue(const T value) noexcept {
+    SetInitialValue(value, Clock::now());
+}
+
+template <typename T, typename Clock>
+void OneEuroFilter<T, Clock>::SetInitialValue(
+    const T value,
+    const TimePoint timePoint) noexcept {
+    lastFilteredValue = value;
+    lastDerivative = static_cast<T>(0);
+    lastTime = timePoint;
+}
+
+template <typename T, typename Clock>
+T OneEuroFilter<T, Clock>::Update(const T value) noexcept {
+    return Update(value, Clock::now());
+}
+
+template <typename T, typename Clock>
+T OneEuroFilter<T, Clock>::Update(
+    const T value,
+    const TimePoint timePoint) noexcept {
+    // dx(k) = (x(k) - y(k - 1)) / T, smoothed with the derivative cutoff
+    // fc(k) = fcmin + beta * |dx(k)|
+    // y(k) = y(k - 1) + a(fc(k)) * (x(k) - y(k - 1))
+
+    if (minCutoff <= static_cast<T>(0)) {
+        return value;
+    }
+
+    const T deltaTime = std::chrono::duration_cast<std::chrono::duration<T>>(
+        timePoint - lastTime).count();
+    if (deltaTime <= static_cast<T>(0)) {
+        return lastFilteredValue;
+    }
+    lastTime = timePoint;
+
+    const T derivative = (value - lastFilteredValue) / deltaTime;
+    lastDerivative += Smoothing(derivativeCutoff, deltaTime) *
+        (derivative - lastDerivative);
+
+    const T cutoff = minCutoff + beta * std::abs(lastDerivative);
+    lastFilteredValue += Smoothing(cutoff, deltaTime) *
+        (value - lastFilteredValue);
+    return lastFilteredValue;
+}
+
+template <typename T, typename Clock>
+T OneEuroFilter<T, Clock>::Smoothing(
+    const T cutoff,
+    const T deltaTime) noexcept {
+    // a = 1 - exp(-2 * pi * fc * T)
+    return -std::expm1(
+        static_cast<T>(-2) * std::numbers::pi_v<T> *
+        std::max(cutoff, static_cast<T>(0)) * deltaTime);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+// Guard-page hook targets grouped by the page that holds them. Pages are
+// kept in a sorted flat array so a fault needs one binary search.
+//
+// Every change publishes a new immutable snapshot through an atomic
+// pointer, so lookups never block and are safe from exception and signal
+// handlers racing with Insert and Erase. Changes must be serialized by the
+// caller. Superseded snapshots are kept until Clear, since a handler may
+// still be reading one; hooks only change a handful of times per run.
+class PageHookIndex {
+public:
+    explicit PageHookIndex(size_t pageSize = 0x1000) noexcept;
+    ~PageHookIndex() noexcept;
+
+    PageHookIndex(const PageHookIndex&) = delete;
+    PageHookIndex& operator=(const PageHookIndex&) = delete;
+
+    [[nodiscard]] size_t PageSize() const noexcept;
+    [[nodiscard]] uintptr_t PageOf(const void* address) const noexcept;
+
+    // Number of hooks, not pages
+    [[nodiscard]] size_t Size() const noexcept;
+    [[nodiscard]] std::vector<uintptr_t> Pages() const;
+
+    [[nodiscard]] bool Contains(const void* target) const noexcept;
+    [[nodiscard]] bool IsHookedPage(const void* address) const noexcept;
+    [[nodiscard]] void* FindDetour(const void* address) const noexcept;
+
+    void Insert(void* target, void* detour);
+
+    // Returns whether the page that held target has no hooks left, in
+    // which case its guard should be cleared
+    bool Erase(const void* target);
+
+    // Frees every snapshot, so no lookup may be running
+    void Clear() noexcept;
+
+    // A fault on a hooked page marks it for the faulting thread, and the
+    // following single step re-arms exactly that page
+    static void SetPendingPage(uintptr_t page) noexcept;
+    [[nodiscard]] static std::optional<uintptr_t> TakePendingPage() noexcept;
+
+private:
+    struct Hook {
+        const void* target;
+        void* detour;
+    };
+
+    struct Page {
+        uintptr_t address;
+        std::vector<Hook> hooks;
+    };
+
+    struct Snapshot {
+        size_t size;
+        std::vector<Page> pages;
+    };
+
+    [[nodiscard]] const Page* FindPage(
+        const Snapshot& snapshot, uintptr_t address) const noexcept;
+    void Publish(std::unique_ptr<Snapshot> snapshot);
+
+    size_t pageSize;
+    std::atomic<const Snapshot*> current;
+    std::vector<std::unique_ptr<const Snapshot>> snapshots;
+};
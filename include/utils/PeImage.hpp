@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Read-only view over a PE/COFF image. Works on a file mapped as-is from disk
+// or on an image laid out by the loader, and never copies section contents.
+class PeImage {
+public:
+    enum class Layout {
+        File,
+        Image
+    };
+
+    struct Section {
+        std::string_view name;
+        uint32_t virtualAddress;
+        uint32_t virtualSize;
+        uint32_t rawDataOffset;
+        uint32_t rawDataSize;
+        uint32_t characteristics;
+
+        [[nodiscard]] bool IsExecutable() const noexcept;
+    };
+
+    struct Export {
+        std::string_view name;
+        uint32_t rva;
+    };
+
+    explicit PeImage(
+        std::span<const uint8_t> data, Layout layout = Layout::Image);
+    ~PeImage() noexcept;
+
+    [[nodiscard]] std::span<const uint8_t> Data() const noexcept;
+    [[nodiscard]] std::span<const uint8_t> Headers() const noexcept;
+    [[nodiscard]] uint32_t TimeDateStamp() const noexcept;
+    [[nodiscard]] uint32_t SizeOfImage() const noexcept;
+
+    [[nodiscard]] std::span<const Section> Sections() const noexcept;
+    [[nodiscard]] std::span<const uint8_t> SectionData(
+        const Section& section) const noexcept;
+    [[nodiscard]] std::optional<size_t> RvaToOffset(
+        uint32_t rva) const noexcept;
+
+    [[nodiscard]] std::vector<Export> Exports() const;
+    [[nodiscard]] std::optional<uint32_t> FindExport(
+        std::string_view name) const;
+
+    // Decorated names look like ".?AVClassName@@". Returns the RVA of the
+    // MSVC type descriptor that holds the name.
+    [[nodiscard]] std::optional<uint32_t> FindTypeDescriptor(
+        std::string_view decoratedName) const noexcept;
+
+private:
+    std::span<const uint8_t> data;
+    Layout layout;
+
+    uint32_t timeDateStamp;
+    uint32_t sizeOfImage;
+    uint32_t sizeOfHeaders;
+    uint32_t exportDirectoryRva;
+    uint32_t exportDirectorySize;
+    std::vector<Section> sections;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+// Value written by one thread and copied by any number of readers without
+// blocking the writer. A reader that overlaps a write gets nothing and
+// retries. The value is held in words of lock-free atomics, so it may live
+// in memory shared with other processes, and a torn copy is detected rather
+// than undefined. Zeroed memory is a valid, never written lock.
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+class SeqLock {
+public:
+    SeqLock() noexcept;
+    ~SeqLock() noexcept = default;
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Only one thread may store at a time
+    void Store(const T& value) noexcept;
+    [[nodiscard]] std::optional<T> TryLoad() const noexcept;
+
+    // Number of completed stores
+    [[nodiscard]] uint64_t Version() const noexcept;
+
+private:
+    static constexpr size_t WORD_COUNT =
+        (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+    // Odd while a store is in progress
+    std::atomic<uint64_t> sequence;
+    std::array<std::atomic<uint64_t>, WORD_COUNT> words;
+};
+
+#include "utils/SeqLockInl.hpp"
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+SeqLock<T>::SeqLock() noexcept
+    : sequence { 0 }
+    , words {} {}
+
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+void SeqLock<T>::Store(const T& value) noexcept {
+    std::array<uint64_t, WORD_COUNT> buffer {};
+    std::memcpy(buffer.data(), &value, sizeof(T));
+
+    // The fence keeps the words from being written before the sequence is
+    // seen to be odd
+    const auto start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+        words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+std::optional<T> SeqLock<T>::TryLoad() const noexcept {
+    const auto start = sequence.load(std::memory_order_acquire);
+    if (start & 1) {
+        return std::nullopt;
+    }
+    std::array<uint64_t, WORD_COUNT> buffer {};
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+        buffer[i] = words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) != start) {
+        return std::nullopt;
+    }
+
+    T value {};
+    std::memcpy(&value, buffer.data(), sizeof(T));
+    return value;
+}
+
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+uint64_t SeqLock<T>::Version() const noexcept {
+    return sequence.load(std::memory_order_acquire) / 2;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Named region of memory mapped into every process that opens it. The
+// creator sizes it, zero-filled, and removes the name when it closes it;
+// the region itself lives until the last process unmaps it. There is one
+// creator at a time: creating fails while another creator has the region,
+// but takes over one left by a creator that died. Names are
+// plain words, prefixed as each platform requires (a slash for shm_open,
+// Local\ for file mappings).
+class SharedMemory {
+public:
+    enum class Access {
+        Create,
+        ReadWrite,
+        ReadOnly
+    };
+
+    // Creating throws std::system_error if another creator has the region,
+    // and opening if the region does not exist or is smaller than the size
+    SharedMemory(std::string_view name, size_t size, Access access);
+    ~SharedMemory() noexcept;
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    // Writing through a read-only mapping faults
+    [[nodiscard]] std::span<std::byte> Data() const noexcept;
+
+private:
+    void* data;
+    size_t size;
+    std::string unlinkName;
+    // Descriptor the creator holds its lock through on POSIX, or -1
+    int lockFile;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Byte pattern with wildcards, parsed from IDA-style strings such as
+// "48 8B ?? ?? 89". Wildcards are written as "?" or "??".
+class Signature {
+public:
+    explicit Signature(std::string_view pattern);
+    ~Signature() noexcept;
+
+    [[nodiscard]] size_t Size() const noexcept;
+    [[nodiscard]] bool Matches(
+        std::span<const uint8_t> data, size_t offset = 0) const noexcept;
+    [[nodiscard]] std::optional<size_t> Find(
+        std::span<const uint8_t> data) const noexcept;
+
+    // Splits data into overlapping chunks scanned in ascending order by up
+    // to threadCount threads, or one per hardware thread if zero. Returns
+    // the same match as Find.
+    [[nodiscard]] std::optional<size_t> FindParallel(
+        std::span<const uint8_t> data, size_t threadCount = 0) const;
+
+private:
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask;
+
+    // Offsets of the first and last non-wildcard bytes, compared in bulk
+    // before a candidate position is fully verified
+    size_t firstAnchor;
+    size_t lastAnchor;
+};
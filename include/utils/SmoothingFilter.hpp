@@ -0,0 +1,55 @@
+#pragma once
+
+#include "utils/AlphaPolicy.hpp"
+#include "utils/ExponentialFilter.hpp"
+#include "utils/OneEuroFilter.hpp"
+#include "utils/SpringFilter.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <variant>
+
+enum class FilterType : uint8_t {
+    Exponential,
+    OneEuro,
+    Spring
+};
+
+// One of the smoothing filters, chosen at runtime. Every filter is driven
+// by the same time constant, and beta only affects the One Euro filter.
+template <typename T, typename Clock = std::chrono::steady_clock>
+class SmoothingFilter {
+public:
+    using TimePoint = typename Clock::time_point;
+
+    explicit SmoothingFilter(
+        FilterType type = FilterType::Exponential,
+        T timeConstant = static_cast<T>(0),
+        T initialValue = static_cast<T>(0)
+    ) noexcept;
+    ~SmoothingFilter() noexcept = default;
+
+    [[nodiscard]] FilterType Type() const noexcept;
+
+    // Continues from the last output so switching does not cause a jump
+    void SetType(FilterType value) noexcept;
+    void SetTimeConstant(T value) noexcept;
+    void SetBeta(T value) noexcept;
+
+    void SetInitialValue(T value) noexcept;
+    void SetInitialValue(T value, TimePoint timePoint) noexcept;
+    T Update(T value) noexcept;
+    T Update(T value, TimePoint timePoint) noexcept;
+
+private:
+    std::variant<
+        ExponentialFilter<T, PolynomialAlpha<T>, Clock>,
+        OneEuroFilter<T, Clock>,
+        SpringFilter<T, Clock>
+    > filter;
+    T timeConstant;
+    T beta;
+    T lastFilteredValue;
+};
+
+#include "utils/SmoothingFilterInl.hpp"
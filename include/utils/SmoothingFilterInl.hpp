@@ -0,0 +1,88 @@
+#pragma once
+
+#include <variant>
+
+template <typename T, typename Clock>
+SmoothingFilter<T, Clock>::SmoothingFilter(
+    const FilterType type,
+    const T timeConstant,
+    const T initialValue) noexcept
+    : filter()
+    , timeConstant(timeConstant)
+    , beta(static_cast<T>(0))
+    , lastFilteredValue(initialValue) {
+    SetType(type);
+}
+
+template <typename T, typename Clock>
+FilterType SmoothingFilter<T, Clock>::Type() const noexcept {
+    return static_cast<FilterType>(filter.index());
+}
+
+template <typename T, typename Clock>
+void SmoothingFilter<T, Clock>::SetType(const FilterType value) noexcept {
+    switch (value) {
+        case FilterType::OneEuro: {
+            filter.template emplace<OneEuroFilter<T, Clock>>();
+            break;
+        }
+        case FilterType::Spring: {
+            filter.template emplace<SpringFilter<T, Clock>>();
+            break;
+        }
+        default: {
+            filter.template emplace<
+                ExponentialFilter<T, PolynomialAlpha<T>, Clock>>();
+            break;
+        }
+    }
+    SetTimeConstant(timeConstant);
+    SetBeta(beta);
+    SetInitialValue(lastFilteredValue);
+}
+
+template <typename T, typename Clock>
+void SmoothingFilter<T, Clock>::SetTimeConstant(const T value) noexcept {
+    timeConstant = value;
+    std::visit([value](auto& filter) {
+        filter.SetTimeConstant(value);
+    }, filter);
+}
+
+template <typename T, typename Clock>
+void SmoothingFilter<T, Clock>::SetBeta(const T value) noexcept {
+    beta = value;
+    if (auto* oneEuro = std::get_if<OneEuroFilter<T, Clock>>(&filter)) {
+        oneEuro->SetBeta(value);
+    }
+}
+
+template <typename T, typename Clock>
+void SmoothingFilter<T, Clock>::SetInitialValue(const T value) noexcept {
+    SetInitialValue(value, Clock::now());
+}
+
+template <typename T, typename Clock>
+void SmoothingFilter<T, Clock>::SetInitialValue(
+    const T value,
+    const TimePoint timePoint) noexcept {
+    lastFilteredValue = value;
+    std::visit([value, timePoint](auto& filter) {
+        filter.SetInitialValue(value, timePoint);
+    }, filter);
+}
+
+template <typename T, typename Clock>
+T SmoothingFilter<T, Clock>::Update(const T value) noexcept {
+    return Update(value, Clock::now());
+}
+
+template <typename T, typename Clock>
+T SmoothingFilter<T, Clock>::Update(
+    const T value,
+    const TimePoint timePoint) noexcept {
+    lastFilteredValue = std::visit([value, timePoint](auto& filter) {
+        return filter.Update(value, timePoint);
+    }, filter);
+    return lastFilteredValue;
+}
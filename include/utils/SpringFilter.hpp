@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <type_traits>
+
+// Critically damped spring pulling the output toward the input. Unlike an
+// exponential filter it carries velocity, so it starts moving smoothly and
+// settles without overshoot after a step.
+template <typename T, typename Clock = std::chrono::steady_clock>
+class SpringFilter {
+    static_assert(
+        std::is_floating_point_v<T>,
+        "T must be a floating-point type"
+    );
+
+public:
+    using TimePoint = typename Clock::time_point;
+
+    // The angular frequency is 2 / timeConstant, so a step reaches 63% after
+    // 1.07 time constants, close to the exponential filter's one, and 90%
+    // after 1.94 instead of 2.30
+    explicit SpringFilter(
+        T timeConstant = static_cast<T>(0),
+        T initialValue = static_cast<T>(0)
+    ) noexcept;
+    ~SpringFilter() noexcept = default;
+
+    void SetTimeConstant(T value) noexcept;
+    void SetInitialValue(T value) noexcept;
+    void SetInitialValue(T value, TimePoint timePoint) noexcept;
+    T Update(T value) noexcept;
+    T Update(T value, TimePoint timePoint) noexcept;
+
+private:
+    T omega;
+    T lastFilteredValue;
+    T velocity;
+    TimePoint lastTime;
+};
+
+#include "utils/SpringFilterInl.hpp"
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cmath>
+
+template <typename T, typename Clock>
+SpringFilter<T, Clock>::SpringFilter(
+    const T timeConstant,
+    const T initialValue) noexcept
+    : omega(static_cast<T>(0))
+    , lastFilteredValue(static_cast<T>(0))
+    , velocity(static_cast<T>(0)) {
+    SetTimeConstant(timeConstant);
+    SetInitialValue(initialValue);
+}
+
+template <typename T, typename Clock>
+void SpringFilter<T, Clock>::SetTimeConstant(const T value) noexcept {
+    omega = value > static_cast<T>(0) ?
+        static_cast<T>(2) / value : static_cast<T>(0);
+}
+
+template <typename T, typename Clock>
+void SpringFilter<T, Clock>::SetInitialValue(const T value) noexcept {
+    SetInitialValue(value, Clock::now());
+}
+
+template <typename T, typename Clock>
+void SpringFilter<T, Clock>::SetInitialValue(
+    const T value,
+    const TimePoint timePoint) noexcept {
+    lastFilteredValue = value;
+    velocity = static_cast<T>(0);
+    lastTime = timePoint;
+}
+
+template <typename T, typename Clock>
+T SpringFilter<T, Clock>::Update(const T value) noexcept {
+    return Update(value, Clock::now());
+}
+
+template <typename T, typename Clock>
+T SpringFilter<T, Clock>::Update(
+    const T value,
+    const TimePoint timePoint) noexcept {
+    // Exact solution of y'' = w^2 * (x - y) - 2 * w * y' for an input held
+    // constant over the step, so the result does not depend on frame rate:
+    // e(t) = (e(0) + (v(0) + w * e(0)) * t) * exp(-w * t)
+    // v(t) = (v(0) - w * (v(0) + w * e(0)) * t) * exp(-w * t)
+
+    // Where:
+    // e is the displacement y - x
+    // v is the velocity y'
+    // w is the angular frequency
+
+    if (omega <= static_cast<T>(0)) {
+        return value;
+    }
+
+    const T deltaTime = std::chrono::duration_cast<std::chrono::duration<T>>(
+        timePoint - lastTime).count();
+    if (deltaTime <= static_cast<T>(0)) {
+        return lastFilteredValue;
+    }
+    lastTime = timePoint;
+
+    const T displacement = lastFilteredValue - value;
+    const T impulse = (velocity + omega * displacement) * deltaTime;
+    const T decay = std::exp(-omega * deltaTime);
+    lastFilteredValue = value + (displacement + impulse) * decay;
+    velocity = (velocity - omega * impulse) * decay;
+    return lastFilteredValue;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Fixed-capacity queue with one producer and one consumer, which may be in
+// different processes when the ring lives in shared memory. Pushing fails
+// when the ring is full instead of overwriting, and neither side ever waits
+// or allocates. Each side keeps its index and a copy of the other's on its
+// own cache line, so the lines only move when the copy runs out. Zeroed
+// memory is a valid, empty ring.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "T must be trivially copyable"
+    );
+    static_assert(
+        Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+        "Capacity must be a power of two"
+    );
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+public:
+    SpscRing() noexcept;
+    ~SpscRing() noexcept = default;
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    [[nodiscard]] static constexpr size_t Size() noexcept;
+
+    // Must only be called by the producer. Returns false when full.
+    bool TryPush(const T& value) noexcept;
+    // Must only be called by the consumer. Returns false when empty.
+    bool TryPop(T& value) noexcept;
+
+    // Number of values pushed and popped so far, which either side may read
+    [[nodiscard]] uint64_t Pushed() const noexcept;
+    [[nodiscard]] uint64_t Popped() const noexcept;
+
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    alignas(CACHE_LINE) std::atomic<uint64_t> head;
+    uint64_t cachedTail;
+    alignas(CACHE_LINE) std::atomic<uint64_t> tail;
+    uint64_t cachedHead;
+    alignas(CACHE_LINE) std::array<T, Capacity> slots;
+};
+
+#include "utils/SpscRingInl.hpp"
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, size_t Capacity>
+SpscRing<T, Capacity>::SpscRing() noexcept
+    : head { 0 }
+    , cachedTail { 0 }
+    , tail { 0 }
+    , cachedHead { 0 }
+    , slots {} {}
+
+template <typename T, size_t Capacity>
+constexpr size_t SpscRing<T, Capacity>::Size() noexcept {
+    return Capacity;
+}
+
+template <typename T, size_t Capacity>
+bool SpscRing<T, Capacity>::TryPush(const T& value) noexcept {
+    const auto position = head.load(std::memory_order_relaxed);
+    if (position - cachedTail >= Capacity) {
+        cachedTail = tail.load(std::memory_order_acquire);
+        if (position - cachedTail >= Capacity) {
+            return false;
+        }
+    }
+    slots[position % Capacity] = value;
+    head.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, size_t Capacity>
+bool SpscRing<T, Capacity>::TryPop(T& value) noexcept {
+    const auto position = tail.load(std::memory_order_relaxed);
+    if (position == cachedHead) {
+        cachedHead = head.load(std::memory_order_acquire);
+        if (position == cachedHead) {
+            return false;
+        }
+        // A producer in another process may be faulty, so an impossible
+        // head drops what is queued rather than reading past it
+        if (cachedHead - position > Capacity) {
+            tail.store(cachedHead, std::memory_order_release);
+            return false;
+        }
+    }
+    value = slots[position % Capacity];
+    tail.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, size_t Capacity>
+uint64_t SpscRing<T, Capacity>::Pushed() const noexcept {
+    return head.load(std::memory_order_acquire);
+}
+
+template <typename T, size_t Capacity>
+uint64_t SpscRing<T, Capacity>::Popped() const noexcept {
+    return tail.load(std::memory_order_acquire);
+}
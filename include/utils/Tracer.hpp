@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Timeline of named spans and instants on every thread, written as Chrome
+// trace event JSON for Perfetto or chrome://tracing. Compiled out unless
+// TRACING is defined. Names must be string literals or otherwise outlive
+// the tracer, as only their address is recorded.
+#ifdef TRACING
+    #define TRACE_CONCAT_INNER(a, b) a##b
+    #define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+    #define TRACE_SCOPE(name)                                                   \
+        const TraceScope TRACE_CONCAT(traceScope, __LINE__) { name }
+    #define TRACE_INSTANT(name) Tracer::GetInstance().Instant(name)
+    #define TRACE_THREAD_NAME(name) Tracer::GetInstance().SetThreadName(name)
+    #define TRACE_WRITE(filePath) Tracer::GetInstance().Write(filePath)
+#else
+    #define TRACE_SCOPE(name)
+    #define TRACE_INSTANT(name)
+    #define TRACE_THREAD_NAME(name)
+    #define TRACE_WRITE(filePath)
+#endif
+
+// Each thread records into its own ring of the last events, without locking
+// or allocating after its first event. The rings can be read while being
+// recorded into, with events being overwritten skipped.
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    // Events kept per thread
+    static constexpr size_t CAPACITY = size_t { 1 } << 15;
+
+    [[nodiscard]] static Tracer& GetInstance();
+
+    Tracer();
+    ~Tracer() noexcept;
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    void Span(const char* name, TimePoint start, TimePoint end) noexcept;
+    void Instant(const char* name) noexcept;
+    void SetThreadName(const char* name) noexcept;
+
+    [[nodiscard]] std::string ToJson() const;
+    void Write(const std::filesystem::path& filePath) const;
+
+private:
+    struct Buffer;
+
+    [[nodiscard]] Buffer* ThreadBuffer() noexcept;
+    void Record(const char* name, TimePoint start, int64_t duration) noexcept;
+
+    uint64_t id;
+    TimePoint origin;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+};
+
+// Records a span from construction to destruction
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) noexcept;
+    ~TraceScope() noexcept;
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    // Taken before the start, which is then never before the tracer's origin
+    Tracer& tracer;
+    const char* name;
+    Tracer::TimePoint start;
+};
@@ -1,9 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
-#include <Windows.h>
-
 namespace details {
     class VehHookBackend {
     protected:
@@ -18,9 +17,10 @@ namespace details {
         static void Remove(void* target) noexcept;
     };
 
-    DWORD SetProtection(void* target, DWORD protection) noexcept;
-    DWORD SetPageGuard(void* target) noexcept;
-    DWORD ClearPageGuard(void* target) noexcept;
+    // Protection values are native to the backend (PAGE_* or PROT_*)
+    uint32_t SetProtection(void* target, uint32_t protection) noexcept;
+    uint32_t SetPageGuard(void* target) noexcept;
+    uint32_t ClearPageGuard(void* target) noexcept;
 }
 
 // TODO: ADD HOOK ENABLE/DISABLE
@@ -14,7 +14,7 @@ VehHook<Ret, Args...>::VehHook()
 template <typename Ret, typename... Args>
 VehHook<Ret, Args...>::VehHook(void* target, void* detour)
     : VehHook { } {
-    VehHookBackend::Create(target, detour);
+    Create(target, detour);
 }
 
 template <typename Ret, typename... Args>
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <span>
 #include <system_error>
 #include <vector>
 
@@ -19,4 +21,5 @@ void ThrowOnSystemError(T&& condition) {
 
 void AllocateConsole();
 std::filesystem::path GetModulePath(const void* address = nullptr);
+std::span<const uint8_t> GetModuleImage(HMODULE module);
 std::vector<HWND> GetProcessWindows(DWORD processId = 0);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+
+// Tells reloads of a file that only see the owner's own writes landing
+// from edits made by others. Writes may be coalesced and land well after
+// they were given, so the contents of every write since the last one seen
+// are kept, up to a few.
+class WriteEchoFilter {
+public:
+    static constexpr size_t MAX_WRITES = 8;
+
+    WriteEchoFilter() noexcept;
+    ~WriteEchoFilter() noexcept = default;
+
+    // Records contents handed to the writer, before they can land
+    void OnWrite(std::string contents);
+
+    // Whether reloaded contents are those of a write. Writes given before
+    // it can no longer land and are forgotten. Contents of no write are
+    // someone else's edit, after which every write is forgotten, since the
+    // ones still pending land over the edit as changes of their own.
+    [[nodiscard]] bool IsEcho(std::string_view contents) noexcept;
+
+private:
+    std::deque<std::string> writes;
+};
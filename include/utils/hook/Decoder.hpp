@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace hook {
+enum class Branch : uint8_t {
+    None,
+    Jump,
+    Conditional,
+    Call,
+    Loop,
+    Return
+};
+
+// Length and relocation-relevant layout of one x86-64 instruction
+struct Instruction {
+    uint8_t length;
+    uint8_t opcode;
+
+    // Offset of the disp32 of a RIP-relative memory operand, or zero
+    uint8_t ripDisplacementOffset;
+
+    // Relative branch target operand, if any. Indirect branches only set
+    // the branch kind.
+    Branch branch;
+    uint8_t relativeOffset;
+    uint8_t relativeSize;
+
+    [[nodiscard]] bool IsRipRelative() const noexcept;
+    [[nodiscard]] bool IsRelativeBranch() const noexcept;
+};
+
+// Returns nullopt for invalid or unsupported encodings
+[[nodiscard]] std::optional<Instruction> Decode(const uint8_t* code) noexcept;
+} // namespace hook
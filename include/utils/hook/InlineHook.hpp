@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace hook {
+// Redirects a function to a detour by patching its first instructions with
+// a jump. The displaced instructions are relocated into a trampoline that
+// calls the original function.
+class InlineHook {
+public:
+    InlineHook(void* target, void* detour);
+    ~InlineHook() noexcept;
+
+    InlineHook(const InlineHook&) = delete;
+    InlineHook& operator=(const InlineHook&) = delete;
+
+    [[nodiscard]] void* Target() const noexcept;
+    [[nodiscard]] void* Trampoline() const noexcept;
+    [[nodiscard]] size_t PatchSize() const noexcept;
+
+    // Callers are responsible for freezing other threads when needed
+    [[nodiscard]] bool IsEnabled() const noexcept;
+    void Enable();
+    void Disable();
+
+    // Maps an instruction pointer within the displaced instructions to the
+    // equivalent location in the trampoline, and back
+    [[nodiscard]] uintptr_t ToTrampoline(uintptr_t ip) const noexcept;
+    [[nodiscard]] uintptr_t FromTrampoline(uintptr_t ip) const noexcept;
+
+private:
+    static constexpr size_t MAX_PATCH_SIZE = 14;
+    static constexpr size_t MAX_INSTRUCTIONS = MAX_PATCH_SIZE;
+
+    struct Mapping {
+        uint8_t targetOffset;
+        uint8_t trampolineOffset;
+    };
+
+    void Build();
+
+    uint8_t* target;
+    uint8_t* detour;
+    uint8_t* slot;
+    bool isEnabled;
+
+    size_t patchSize;
+    std::array<uint8_t, MAX_PATCH_SIZE> patch;
+    std::array<uint8_t, MAX_PATCH_SIZE> original;
+
+    size_t mappingCount;
+    std::array<Mapping, MAX_INSTRUCTIONS> mappings;
+};
+} // namespace hook
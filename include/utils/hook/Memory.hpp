@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace hook {
+constexpr size_t SLOT_SIZE = 128;
+
+// Whether a rel32 operand at from can reach to
+[[nodiscard]] bool IsNear(const void* from, const void* to) noexcept;
+
+// Returns an executable slot of SLOT_SIZE bytes, preferably within reach of
+// a rel32 jump from origin
+[[nodiscard]] uint8_t* AllocateSlot(const void* origin);
+void FreeSlot(uint8_t* slot) noexcept;
+
+// Replaces code, atomically when the bytes fit in an aligned 8 or 16-byte
+// block so running threads never observe a torn instruction
+void WriteCode(uint8_t* address, const uint8_t* bytes, size_t size);
+
+// Suspends every other thread of the process for its lifetime. Does nothing
+// on platforms where threads cannot be suspended, where WriteCode atomicity
+// is relied on instead.
+class ThreadFreezer {
+public:
+    ThreadFreezer();
+    ~ThreadFreezer() noexcept;
+
+    ThreadFreezer(const ThreadFreezer&) = delete;
+    ThreadFreezer& operator=(const ThreadFreezer&) = delete;
+
+    // Moves suspended threads whose instruction pointer was relocated
+    void RedirectInstructionPointers(
+        const std::function<uintptr_t(uintptr_t)>& relocate) noexcept;
+
+private:
+    std::vector<void*> threads;
+};
+} // namespace hook
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+enum class JsonToken : uint8_t {
+    BeginObject,
+    EndObject,
+    BeginArray,
+    EndArray,
+    Key,
+    String,
+    Number,
+    True,
+    False,
+    Null,
+    End,
+    Error
+};
+
+// Pull parser over JSON text. Tokens are produced one at a time and checked
+// against the grammar as they are read, without building a document or
+// throwing. Once an error is found every further token is Error.
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) noexcept;
+    ~JsonReader() noexcept = default;
+
+    JsonToken Next() noexcept;
+
+    // Consumes the rest of the value whose first token was just read, and
+    // returns its last token
+    JsonToken SkipValue(JsonToken first) noexcept;
+
+    // Unescaped contents of the last key or string, or the text of the last
+    // number. Only valid until the next token is read.
+    [[nodiscard]] std::string_view Value() const noexcept;
+
+    [[nodiscard]] bool HasError() const noexcept;
+    // Describes the first error and where it was found
+    [[nodiscard]] std::string Error() const;
+
+private:
+    static constexpr size_t MAX_DEPTH = 64;
+
+    enum class Expect : uint8_t {
+        Value,
+        FirstKeyOrEnd,
+        Key,
+        FirstValueOrEnd,
+        CommaOrEnd,
+        Done
+    };
+
+    JsonToken Fail(std::string_view message) noexcept;
+    JsonToken BeginContainer(bool isObject) noexcept;
+    JsonToken EndContainer(bool isObject) noexcept;
+    JsonToken ReadScalar() noexcept;
+    JsonToken EndValue(JsonToken token) noexcept;
+    bool ReadString() noexcept;
+    bool ReadNumber() noexcept;
+    bool ReadLiteral(std::string_view literal) noexcept;
+    void SkipWhitespace() noexcept;
+
+    std::string_view text;
+    size_t position;
+    Expect expect;
+
+    size_t depth;
+    std::array<bool, MAX_DEPTH> isObjects;
+
+    std::string_view value;
+    std::string buffer;
+
+    std::string_view error;
+    size_t errorPosition;
+};
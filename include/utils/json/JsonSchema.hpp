@@ -0,0 +1,142 @@
+#pragma once
+
+#include "utils/json/JsonReader.hpp"
+#include "utils/json/JsonWriter.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Reads and writes one type of JSON value. A read consumes the whole value
+// starting at the given token, even one of the wrong type, and reports
+// whether it could be stored. The type name describes what is accepted.
+template <typename T>
+struct JsonCodec;
+
+template <>
+struct JsonCodec<bool> {
+    [[nodiscard]] static std::string TypeName();
+    static bool Read(JsonReader& reader, JsonToken token, bool& value) noexcept;
+    static void Write(JsonWriter& writer, bool value);
+};
+
+template <typename T>
+requires std::integral<T> && (!std::same_as<T, bool>)
+struct JsonCodec<T> {
+    [[nodiscard]] static std::string TypeName();
+    static bool Read(JsonReader& reader, JsonToken token, T& value) noexcept;
+    static void Write(JsonWriter& writer, T value);
+};
+
+template <std::floating_point T>
+struct JsonCodec<T> {
+    [[nodiscard]] static std::string TypeName();
+    static bool Read(JsonReader& reader, JsonToken token, T& value) noexcept;
+    static void Write(JsonWriter& writer, T value);
+};
+
+template <typename T>
+struct JsonCodec<std::vector<T>> {
+    [[nodiscard]] static std::string TypeName();
+    static bool Read(
+        JsonReader& reader, JsonToken token, std::vector<T>& value) noexcept;
+    static void Write(JsonWriter& writer, const std::vector<T>& value);
+};
+
+// Names of an enum's values, specialized with a static constexpr array of
+// value and name pairs called NAMES
+template <typename T>
+requires std::is_enum_v<T>
+struct JsonEnum;
+
+template <typename T>
+requires std::is_enum_v<T>
+struct JsonCodec<T> {
+    [[nodiscard]] static std::string TypeName();
+    static bool Read(JsonReader& reader, JsonToken token, T& value) noexcept;
+    static void Write(JsonWriter& writer, T value);
+};
+
+// One member of an object and the condition its value must satisfy
+template <typename Object, typename T, typename Validator>
+struct JsonField {
+    using Type = T;
+
+    std::string_view key;
+    T Object::* member;
+    Validator validator;
+    std::string_view condition;
+};
+
+struct JsonAlwaysValid {
+    template <typename T>
+    constexpr bool operator()(const T&) const noexcept {
+        return true;
+    }
+};
+
+template <typename Object, typename T>
+constexpr JsonField<Object, T, JsonAlwaysValid> MakeJsonField(
+    std::string_view key, T Object::* member) noexcept;
+
+template <typename Object, typename T, typename Validator>
+constexpr JsonField<Object, T, Validator> MakeJsonField(
+    std::string_view key,
+    T Object::* member,
+    Validator validator,
+    std::string_view condition) noexcept;
+
+// Field whose value must satisfy a condition written in terms of the member
+// name, such as JSON_FIELD_IF("fov", Config, fov, fov > 0)
+#define JSON_FIELD_IF(key, Object, member, condition)                           \
+    MakeJsonField(                                                              \
+        key, &Object::member,                                                   \
+        [](const auto& member) noexcept { return condition; },                  \
+        #condition                                                              \
+    )
+
+struct JsonReadResult {
+    // Set when the text is not valid JSON. The object may then have been
+    // partially read.
+    std::optional<std::string> syntaxError;
+
+    // Missing keys and values of the wrong type or failing their condition,
+    // which are left unchanged
+    std::vector<std::string> errors;
+};
+
+// Maps an object to a JSON object with one key per field, in order. Reading
+// streams through the text once and collects every error instead of
+// stopping at the first. Unknown keys are ignored.
+template <typename Object, typename... Fields>
+class JsonSchema {
+public:
+    constexpr explicit JsonSchema(Fields... fields) noexcept;
+
+    [[nodiscard]] JsonReadResult Read(
+        std::string_view text, Object& object) const;
+    [[nodiscard]] std::string Write(
+        const Object& object, int indent = 4) const;
+
+private:
+    template <size_t Index>
+    void ReadField(
+        JsonReader& reader,
+        Object& object,
+        std::vector<std::string>& errors) const;
+
+    std::tuple<Fields...> fields;
+};
+
+template <typename Object, typename... Fields>
+constexpr JsonSchema<Object, Fields...> MakeJsonSchema(
+    Fields... fields) noexcept;
+
+#include "utils/json/JsonSchemaInl.hpp"
@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+template <typename T>
+requires std::integral<T> && (!std::same_as<T, bool>)
+std::string JsonCodec<T>::TypeName() {
+    return "an integer from " + std::to_string(std::numeric_limits<T>::min()) +
+        " to " + std::to_string(std::numeric_limits<T>::max());
+}
+
+template <typename T>
+requires std::integral<T> && (!std::same_as<T, bool>)
+bool JsonCodec<T>::Read(
+    JsonReader& reader,
+    const JsonToken token,
+    T& value) noexcept {
+    if (token != JsonToken::Number) {
+        reader.SkipValue(token);
+        return false;
+    }
+    const auto text = reader.Value();
+    T result {};
+    const auto [end, error] = std::from_chars(
+        text.data(), text.data() + text.size(), result);
+    if (error != std::errc {} || end != text.data() + text.size()) {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+template <typename T>
+requires std::integral<T> && (!std::same_as<T, bool>)
+void JsonCodec<T>::Write(JsonWriter& writer, const T value) {
+    if constexpr (std::is_signed_v<T>) {
+        writer.Integer(value);
+    } else {
+        writer.Unsigned(value);
+    }
+}
+
+template <std::floating_point T>
+std::string JsonCodec<T>::TypeName() {
+    return "a number";
+}
+
+template <std::floating_point T>
+bool JsonCodec<T>::Read(
+    JsonReader& reader,
+    const JsonToken token,
+    T& value) noexcept {
+    if (token != JsonToken::Number) {
+        reader.SkipValue(token);
+        return false;
+    }
+    const auto text = reader.Value();
+    T result {};
+    const auto [end, error] = std::from_chars(
+        text.data(), text.data() + text.size(), result);
+    if (error != std::errc {} || end != text.data() + text.size()) {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+template <std::floating_point T>
+void JsonCodec<T>::Write(JsonWriter& writer, const T value) {
+    writer.Number(value);
+}
+
+template <typename T>
+std::string JsonCodec<std::vector<T>>::TypeName() {
+    return "an array with each element " + JsonCodec<T>::TypeName();
+}
+
+template <typename T>
+bool JsonCodec<std::vector<T>>::Read(
+    JsonReader& reader,
+    const JsonToken token,
+    std::vector<T>& value) noexcept try {
+    if (token != JsonToken::BeginArray) {
+        reader.SkipValue(token);
+        return false;
+    }
+
+    // Later elements are still consumed after an invalid one
+    std::vector<T> result {};
+    bool isValid = true;
+    for (auto next = reader.Next();
+         next != JsonToken::EndArray;
+         next = reader.Next()) {
+        if (next == JsonToken::Error) {
+            return false;
+        }
+        T element {};
+        isValid &= JsonCodec<T>::Read(reader, next, element);
+        if (isValid) {
+            result.push_back(std::move(element));
+        }
+    }
+    if (isValid) {
+        value = std::move(result);
+    }
+    return isValid;
+} catch (...) {
+    return false;
+}
+
+template <typename T>
+void JsonCodec<std::vector<T>>::Write(
+    JsonWriter& writer,
+    const std::vector<T>& value) {
+    writer.BeginArray();
+    for (const auto& element : value) {
+        JsonCodec<T>::Write(writer, element);
+    }
+    writer.EndArray();
+}
+
+template <typename T>
+requires std::is_enum_v<T>
+std::string JsonCodec<T>::TypeName() {
+    std::string name {};
+    for (const auto& [enumValue, enumName] : JsonEnum<T>::NAMES) {
+        name += name.empty() ? "one of '" : ", '";
+        name += enumName;
+        name += '\'';
+    }
+    return name;
+}
+
+template <typename T>
+requires std::is_enum_v<T>
+bool JsonCodec<T>::Read(
+    JsonReader& reader,
+    const JsonToken token,
+    T& value) noexcept {
+    if (token != JsonToken::String) {
+        reader.SkipValue(token);
+        return false;
+    }
+    const auto name = reader.Value();
+    for (const auto& [enumValue, enumName] : JsonEnum<T>::NAMES) {
+        if (name == enumName) {
+            value = enumValue;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+requires std::is_enum_v<T>
+void JsonCodec<T>::Write(JsonWriter& writer, const T value) {
+    for (const auto& [enumValue, enumName] : JsonEnum<T>::NAMES) {
+        if (value == enumValue) {
+            writer.String(enumName);
+            return;
+        }
+    }
+    writer.Null();
+}
+
+template <typename Object, typename T>
+constexpr JsonField<Object, T, JsonAlwaysValid> MakeJsonField(
+    const std::string_view key,
+    T Object::* member) noexcept {
+    return { key, member, JsonAlwaysValid {}, {} };
+}
+
+template <typename Object, typename T, typename Validator>
+constexpr JsonField<Object, T, Validator> MakeJsonField(
+    const std::string_view key,
+    T Object::* member,
+    Validator validator,
+    const std::string_view condition) noexcept {
+    return { key, member, std::move(validator), condition };
+}
+
+template <typename Object, typename... Fields>
+constexpr JsonSchema<Object, Fields...>::JsonSchema(Fields... fields) noexcept
+    : fields { std::move(fields)... } {}
+
+template <typename Object, typename... Fields>
+JsonReadResult JsonSchema<Object, Fields...>::Read(
+    const std::string_view text,
+    Object& object) const {
+    // Keys are matched at runtime, then dispatched to the reader of the
+    // field's type
+    const auto keys = std::apply([](const auto&... field) {
+        return std::array<std::string_view, sizeof...(Fields)> { field.key... };
+    }, fields);
+    constexpr auto readers = []<size_t... Indices>(
+        std::index_sequence<Indices...>) {
+        return std::array { &JsonSchema::ReadField<Indices>... };
+    }(std::index_sequence_for<Fields...> {});
+
+    JsonReader reader { text };
+    JsonReadResult result {};
+    std::array<bool, sizeof...(Fields)> isFound {};
+
+    const auto fail = [&reader, &result](const std::string_view message) {
+        result.syntaxError = reader.HasError() ?
+            reader.Error() : std::string { message };
+        return result;
+    };
+
+    if (reader.Next() != JsonToken::BeginObject) {
+        return fail("Expected an object");
+    }
+    for (auto token = reader.Next();
+         token != JsonToken::EndObject;
+         token = reader.Next()) {
+        if (token != JsonToken::Key) {
+            return fail("Expected a key");
+        }
+        if (const auto it = std::ranges::find(keys, reader.Value());
+            it != keys.end()) {
+            const auto index = static_cast<size_t>(it - keys.begin());
+            isFound[index] = true;
+            (this->*readers[index])(reader, object, result.errors);
+        } else {
+            reader.SkipValue(reader.Next());
+        }
+        if (reader.HasError()) {
+            return fail({});
+        }
+    }
+    if (reader.Next() != JsonToken::End) {
+        return fail({});
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (!isFound[i]) {
+            result.errors.push_back(
+                "Missing key '" + std::string { keys[i] } + "'");
+        }
+    }
+    return result;
+}
+
+template <typename Object, typename... Fields>
+std::string JsonSchema<Object, Fields...>::Write(
+    const Object& object,
+    const int indent) const {
+    JsonWriter writer { indent };
+    writer.BeginObject();
+    std::apply([&writer, &object](const auto&... field) {
+        ((writer.Key(field.key),
+          JsonCodec<typename std::remove_cvref_t<decltype(field)>::Type>::Write(
+              writer, object.*(field.member))), ...);
+    }, fields);
+    writer.EndObject();
+    return writer.Output();
+}
+
+template <typename Object, typename... Fields>
+template <size_t Index>
+void JsonSchema<Object, Fields...>::ReadField(
+    JsonReader& reader,
+    Object& object,
+    std::vector<std::string>& errors) const {
+    const auto& [key, member, validator, condition] = std::get<Index>(fields);
+    using Type = typename std::tuple_element_t<Index, std::tuple<Fields...>>::Type;
+
+    // Read into a copy so invalid values leave the member unchanged
+    Type value = object.*member;
+    if (!JsonCodec<Type>::Read(reader, reader.Next(), value)) {
+        if (!reader.HasError()) {
+            errors.push_back(
+                "Failed to parse key '" + std::string { key } + "': expected " +
+                JsonCodec<Type>::TypeName());
+        }
+        return;
+    }
+    if (!validator(value)) {
+        errors.push_back(
+            "Invalid value for key '" + std::string { key } + "': " +
+            std::string { condition } + " is not satisfied");
+        return;
+    }
+    object.*member = std::move(value);
+}
+
+template <typename Object, typename... Fields>
+constexpr JsonSchema<Object, Fields...> MakeJsonSchema(
+    Fields... fields) noexcept {
+    return JsonSchema<Object, Fields...> { std::move(fields)... };
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Appends JSON text as values are given, pretty-printed with the given
+// indent or compact when it is negative. The caller is responsible for
+// producing a well-formed sequence of calls.
+class JsonWriter {
+public:
+    explicit JsonWriter(int indent = 4);
+    ~JsonWriter() noexcept = default;
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+
+    void Key(std::string_view key);
+    void String(std::string_view value);
+    void Bool(bool value);
+    void Null();
+    void Integer(int64_t value);
+    void Unsigned(uint64_t value);
+    // Written with the fewest digits that read back to the same value
+    void Number(float value);
+    void Number(double value);
+
+    [[nodiscard]] const std::string& Output() const noexcept;
+
+private:
+    void BeginValue();
+    void Begin(char bracket);
+    void End(char bracket);
+    void NewLine();
+    void AppendString(std::string_view value);
+
+    template <typename T>
+    void AppendNumber(T value);
+
+    int indent;
+    std::string output;
+
+    // Whether each open container has no element yet
+    std::vector<bool> isEmpty;
+    bool isAfterKey;
+};
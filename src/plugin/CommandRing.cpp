@@ -0,0 +1,165 @@
+#include "plugin/CommandRing.hpp"
+#include "plugin/Command.hpp"
+#include "utils/SharedMemory.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <cerrno>
+    #include <csignal>
+    #include <unistd.h>
+#endif
+
+namespace {
+Command MakeCommand(
+    const CommandType type,
+    const int32_t value = 0,
+    const float smoothing = 0.0f) noexcept {
+    return { 0, type, value, smoothing, 0 };
+}
+
+#ifdef _WIN32
+uint32_t CurrentProcessId() noexcept {
+    return static_cast<uint32_t>(GetCurrentProcessId());
+}
+
+bool IsProcessAlive(const uint32_t processId) noexcept {
+    const HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, processId);
+    if (!process) {
+        // Processes of other users may not be opened, but are alive
+        return GetLastError() != ERROR_INVALID_PARAMETER;
+    }
+    const bool isAlive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return isAlive;
+}
+#else
+uint32_t CurrentProcessId() noexcept {
+    return static_cast<uint32_t>(getpid());
+}
+
+bool IsProcessAlive(const uint32_t processId) noexcept {
+    return kill(static_cast<pid_t>(processId), 0) == 0 || errno != ESRCH;
+}
+#endif
+} // namespace
+
+CommandRing::CommandRing()
+    : memory { NAME, sizeof(Layout), SharedMemory::Access::Create }
+    , layout { new (memory.Data().data()) Layout {} }
+    , nextChannel { 0 } {
+    layout->version = VERSION;
+    layout->size = sizeof(Layout);
+    // Written last, since clients only trust a page with the magic
+    std::atomic_ref { layout->magic }.store(MAGIC, std::memory_order_release);
+}
+
+bool CommandRing::TryPop(Command& command) noexcept {
+    // Released channels are drained too, as their last commands may still
+    // be there
+    for (size_t i = 0; i < MAX_CLIENTS; ++i) {
+        auto& channel = layout->channels[nextChannel];
+        nextChannel = (nextChannel + 1) % MAX_CLIENTS;
+        if (channel.ring.TryPop(command)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+CommandClient::CommandClient()
+    : memory {
+        CommandRing::NAME, sizeof(CommandRing::Layout),
+        SharedMemory::Access::ReadWrite
+    }
+    , layout { reinterpret_cast<CommandRing::Layout*>(memory.Data().data()) }
+    , channel { nullptr } {
+    const auto magic = std::atomic_ref { layout->magic }.load(
+        std::memory_order_acquire);
+    if (magic != CommandRing::MAGIC) {
+        throw std::runtime_error { "Command ring is not initialized" };
+    }
+    if (layout->version != CommandRing::VERSION ||
+        layout->size != sizeof(CommandRing::Layout)) {
+        throw std::runtime_error {
+            "Command ring has version " + std::to_string(layout->version) +
+            ", expected " + std::to_string(CommandRing::VERSION)
+        };
+    }
+    channel = ClaimChannel(layout->channels);
+    if (!channel) {
+        throw std::runtime_error { "Every command channel is in use" };
+    }
+}
+
+CommandClient::~CommandClient() noexcept {
+    channel->owner.store(0, std::memory_order_release);
+}
+
+// A process that reused the id of a dead client keeps its channel until it
+// exits too
+CommandRing::Channel* CommandClient::ClaimChannel(
+    const std::span<CommandRing::Channel> channels) noexcept {
+    const auto processId = CurrentProcessId();
+    for (const bool isTakingOver : { false, true }) {
+        for (auto& channel : channels) {
+            uint32_t owner = channel.owner.load(std::memory_order_relaxed);
+            if (owner != 0 && (!isTakingOver || IsProcessAlive(owner))) {
+                continue;
+            }
+            if (channel.owner.compare_exchange_strong(
+                    owner, processId, std::memory_order_acquire,
+                    std::memory_order_relaxed)) {
+                return &channel;
+            }
+        }
+    }
+    return nullptr;
+}
+
+std::optional<uint64_t> CommandClient::Ping() noexcept {
+    return Send(MakeCommand(CommandType::Ping));
+}
+
+std::optional<uint64_t> CommandClient::SetFieldOfView(const int value) noexcept {
+    return Send(MakeCommand(CommandType::SetFieldOfView, value));
+}
+
+std::optional<uint64_t> CommandClient::SetSmoothing(const float value) noexcept {
+    return Send(MakeCommand(CommandType::SetSmoothing, 0, value));
+}
+
+std::optional<uint64_t> CommandClient::SetEnable(const bool value) noexcept {
+    return Send(MakeCommand(CommandType::SetEnable, value ? 1 : 0));
+}
+
+std::optional<uint64_t> CommandClient::SelectPreset(const int index) noexcept {
+    return Send(MakeCommand(CommandType::SelectPreset, index));
+}
+
+std::optional<uint64_t> CommandClient::Dump() noexcept {
+    return Send(MakeCommand(CommandType::Dump));
+}
+
+std::optional<uint64_t> CommandClient::Send(Command command) noexcept {
+    command.sendTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (!channel->ring.TryPush(command)) {
+        return std::nullopt;
+    }
+    return channel->ring.Pushed();
+}
+
+bool CommandClient::IsReceived(const uint64_t sequence) const noexcept {
+    return channel->ring.Popped() >= sequence;
+}
@@ -0,0 +1,38 @@
+#include "plugin/Config.hpp"
+
+#include <optional>
+
+namespace {
+template <typename T>
+std::optional<T> DiffField(const T& previous, const T& current) {
+    if (previous == current) {
+        return std::nullopt;
+    }
+    return current;
+}
+} // namespace
+
+bool ConfigChange::IsEmpty() const noexcept {
+    const auto& [enabled, fov, fovPresets, smoothing, filter, oneEuroBeta,
+        enableKey, nextKey, prevKey, dumpKey] = *this;
+    return !enabled && !fov && !fovPresets && !smoothing && !filter &&
+        !oneEuroBeta && !enableKey && !nextKey && !prevKey && !dumpKey;
+}
+
+ConfigChange Diff(const Config& previous, const Config& current) {
+    const auto& [enabled, fov, fovPresets, smoothing, filter, oneEuroBeta,
+        enableKey, nextKey, prevKey, dumpKey] = current;
+
+    return {
+        DiffField(previous.enabled, enabled),
+        DiffField(previous.fov, fov),
+        DiffField(previous.fovPresets, fovPresets),
+        DiffField(previous.smoothing, smoothing),
+        DiffField(previous.filter, filter),
+        DiffField(previous.oneEuroBeta, oneEuroBeta),
+        DiffField(previous.enableKey, enableKey),
+        DiffField(previous.nextKey, nextKey),
+        DiffField(previous.prevKey, prevKey),
+        DiffField(previous.dumpKey, dumpKey)
+    };
+}
@@ -1,4 +1,5 @@
 #include "plugin/Plugin.hpp"
+#include "utils/Tracer.hpp"
 #include "utils/Windows.hpp"
 #include "utils/log/Logger.hpp"
 #include "utils/log/sinks/FileSink.hpp"
@@ -14,6 +15,8 @@ std::unique_ptr<Plugin> plugin {};
 
 void Initialize() noexcept {
     const auto init = []() {
+        TRACE_THREAD_NAME("init");
+        TRACE_SCOPE("Initialize");
         try {
             const auto workingDirectory = GetModulePath().parent_path();
             LOG_SET_LEVEL(Level::Trace);
@@ -0,0 +1,94 @@
+#include "plugin/FovOverride.hpp"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+FovOverride::FovOverride() noexcept
+    : filter {}
+    , isHooked { false }
+    , isEnabled { false }
+    , isEnabledOnce { false }
+    , overrideFov { 45 }
+    , resetCallCount { 8 }
+    , settleThreshold { 0.1f }
+    , setFovCount { 0 }
+    , previousInstance { nullptr }
+    , previousFov { 45.0f }
+    , isPreviousFov { false } {}
+
+SmoothingFilter<float>& FovOverride::Filter() noexcept {
+    return filter;
+}
+
+bool FovOverride::IsHooked() const noexcept {
+    return isHooked;
+}
+
+void FovOverride::SetHook(const bool value) noexcept {
+    isHooked = value;
+    if (value) {
+        isEnabledOnce = true;
+    }
+}
+
+void FovOverride::SetEnable(const bool value) noexcept {
+    isEnabled = value;
+}
+
+void FovOverride::SetFieldOfView(const int value) noexcept {
+    overrideFov = value;
+}
+
+void FovOverride::SetResetCallCount(const int value) noexcept {
+    resetCallCount = value;
+}
+
+void FovOverride::SetSettleThreshold(const float value) noexcept {
+    settleThreshold = value;
+}
+
+FovOverride::Result FovOverride::Process(
+    void* instance, float value, const TimePoint timePoint) noexcept {
+    bool isHookDone = false;
+    bool isTargetApplied = false;
+
+    ++setFovCount;
+    if (const bool isDefaultFov = value == 45.0f;
+        instance == previousInstance &&
+        (value == previousFov || isDefaultFov)) {
+        if (isDefaultFov) {
+            previousInstance = instance;
+            previousFov = value;
+        }
+
+        if (setFovCount > resetCallCount) {
+            filter.SetInitialValue(value, timePoint);
+        }
+        setFovCount = 0;
+        isTargetApplied = true;
+
+        if (isEnabledOnce) {
+            isEnabledOnce = false;
+            filter.Update(value, timePoint);
+        }
+        const float target = (isHooked && isEnabled) ?
+            static_cast<float>(overrideFov) : previousFov;
+        const float filtered = filter.Update(target, timePoint);
+
+        if ((isHooked && isEnabled) || !isPreviousFov) {
+            isPreviousFov = std::abs(previousFov - filtered) < settleThreshold;
+            value = filtered;
+        } else if (!isHooked) {
+            isPreviousFov = false;
+            isHookDone = true;
+        }
+    } else {
+        const auto rep = std::bit_cast<std::uint32_t>(value);
+        value = std::bit_cast<float>(rep + 1); // marker value
+        previousInstance = instance;
+        previousFov = value;
+    }
+
+    return { value, isHookDone, isTargetApplied };
+}
@@ -0,0 +1,149 @@
+#include "plugin/FramePacing.hpp"
+#include "utils/Histogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+double ToMilliseconds(const uint64_t nanoseconds) noexcept {
+    return static_cast<double>(nanoseconds) / 1'000'000.0;
+}
+
+double ToFrameRate(const double nanoseconds) noexcept {
+    return nanoseconds > 0.0 ? 1'000'000'000.0 / nanoseconds : 0.0;
+}
+} // namespace
+
+FramePacing::FramePacing() noexcept
+    : instances {}
+    , windows {}
+    , nextSample {} {}
+
+void FramePacing::Record(void* instance, const TimePoint time) noexcept {
+    Instance* stalest = nullptr;
+    for (auto& slot : instances) {
+        void* const current = slot.instance.load(std::memory_order_relaxed);
+        if (current == instance) {
+            const auto interval = time - slot.previousTime;
+            // A camera recreated at the same address also calls again after
+            // a pause, so its intervals are kept apart from the old one's
+            if (interval > MAX_INTERVAL) {
+                Begin(slot, instance, time);
+                return;
+            }
+            slot.previousTime = time;
+            const auto generation =
+                slot.generation.load(std::memory_order_relaxed);
+            if (slot.sampledGeneration.load(std::memory_order_acquire) ==
+                generation) {
+                slot.intervals.RecordExclusive(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        interval).count()));
+            }
+            return;
+        }
+        if (!current || !stalest || slot.previousTime < stalest->previousTime) {
+            stalest = &slot;
+        }
+        if (!current) {
+            break;
+        }
+    }
+
+    // Cameras are recreated on scene changes, so instances that stopped
+    // calling give their place to new ones
+    void* const previous = stalest->instance.load(std::memory_order_relaxed);
+    if (previous && time - stalest->previousTime <= MAX_INTERVAL) {
+        return;
+    }
+    Begin(*stalest, instance, time);
+}
+
+void FramePacing::Sample(const TimePoint time) {
+    if (time < nextSample) {
+        return;
+    }
+    nextSample = time + SAMPLE_PERIOD;
+
+    for (size_t i = 0; i < MAX_INSTANCES; ++i) {
+        auto& slot = instances[i];
+        const auto generation = slot.generation.load(std::memory_order_acquire);
+        if (generation == 0) {
+            continue;
+        }
+        auto& window = windows[i];
+        auto snapshot = slot.intervals.Snapshot();
+        // New generations start from what the slot had counted so far
+        if (window.generation != generation) {
+            window.generation = generation;
+            window.samples.clear();
+            window.samples.push_back(std::move(snapshot));
+            slot.sampledGeneration.store(generation, std::memory_order_release);
+            continue;
+        }
+        window.samples.push_back(std::move(snapshot));
+        if (window.samples.size() > WINDOW_SAMPLES) {
+            window.samples.pop_front();
+        }
+    }
+}
+
+std::vector<std::pair<void*, HistogramSnapshot>> FramePacing::Snapshot() const {
+    std::vector<std::pair<void*, HistogramSnapshot>> snapshots {};
+    for (size_t i = 0; i < MAX_INSTANCES; ++i) {
+        const auto& slot = instances[i];
+        const auto generation = slot.generation.load(std::memory_order_acquire);
+        void* const instance = slot.instance.load(std::memory_order_relaxed);
+        if (generation == 0) {
+            continue;
+        }
+        // Generations not sampled yet have recorded nothing
+        const auto& window = windows[i];
+        if (window.generation != generation || window.samples.empty()) {
+            snapshots.emplace_back(instance, HistogramSnapshot {});
+            continue;
+        }
+        auto snapshot = slot.intervals.Snapshot();
+        snapshot -= window.samples.front();
+        snapshots.emplace_back(instance, std::move(snapshot));
+    }
+    return snapshots;
+}
+
+void FramePacing::Begin(
+    Instance& slot,
+    void* instance,
+    const TimePoint time) noexcept {
+    slot.previousTime = time;
+    slot.instance.store(instance, std::memory_order_relaxed);
+    slot.generation.store(
+        slot.generation.load(std::memory_order_relaxed) + 1,
+        std::memory_order_release);
+}
+
+std::string FramePacing::Report() const {
+    std::string report = std::format(
+        "{:<18} {:>7} {:>9} {:>9} {:>9} {:>9} {:>9}\n",
+        "instance", "frames", "mean fps", "1% low", "p50 ms", "p99 ms",
+        "max ms");
+    for (const auto& [instance, snapshot] : Snapshot()) {
+        if (snapshot.Count() == 0) {
+            continue;
+        }
+        // The 1% low is the frame rate of the 99th percentile frame time
+        const auto p99 = snapshot.Percentile(99.0);
+        report += std::format(
+            "{:<18} {:>7} {:>9.1f} {:>9.1f} {:>9.3f} {:>9.3f} {:>9.3f}\n",
+            instance, snapshot.Count(), ToFrameRate(snapshot.Mean()),
+            ToFrameRate(static_cast<double>(p99)),
+            ToMilliseconds(snapshot.Percentile(50.0)), ToMilliseconds(p99),
+            ToMilliseconds(snapshot.Max()));
+    }
+    return report;
+}
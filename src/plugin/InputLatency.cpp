@@ -0,0 +1,65 @@
+#include "plugin/InputLatency.hpp"
+#include "utils/Histogram.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+
+namespace {
+constexpr std::array STAGE_NAMES {
+    "key to observer",
+    "key to handler",
+    "config to handler",
+    "command to handler",
+    "target to frame",
+    "input to frame"
+};
+static_assert(STAGE_NAMES.size() == static_cast<size_t>(
+    InputLatency::Stage::InputToFrame) + 1);
+
+double ToMilliseconds(const double nanoseconds) noexcept {
+    return nanoseconds / 1'000'000.0;
+}
+} // namespace
+
+InputLatency& InputLatency::GetInstance() {
+    static InputLatency instance {};
+    return instance;
+}
+
+void InputLatency::Record(
+    const Stage stage, const TimePoint start, const TimePoint end) noexcept {
+    const auto nanoseconds = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(end - start).count();
+    histograms[static_cast<size_t>(stage)].Record(
+        static_cast<uint64_t>(std::max<decltype(nanoseconds)>(nanoseconds, 0)));
+}
+
+void InputLatency::Reset() noexcept {
+    for (auto& histogram : histograms) {
+        histogram.Reset();
+    }
+}
+
+std::string InputLatency::Report() const {
+    std::string report = std::format(
+        "{:<18} {:>7} {:>9} {:>9} {:>9} {:>9} {:>9}\n",
+        "stage (ms)", "count", "mean", "p50", "p90", "p99", "max");
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const auto snapshot = histograms[i].Snapshot();
+        const auto percentile = [&snapshot](const double value) {
+            return ToMilliseconds(
+                static_cast<double>(snapshot.Percentile(value)));
+        };
+        report += std::format(
+            "{:<18} {:>7} {:>9.3f} {:>9.3f} {:>9.3f} {:>9.3f} {:>9.3f}\n",
+            STAGE_NAMES[i], snapshot.Count(), ToMilliseconds(snapshot.Mean()),
+            percentile(50.0), percentile(90.0), percentile(99.0),
+            ToMilliseconds(static_cast<double>(snapshot.Max())));
+    }
+    return report;
+}
@@ -1,33 +1,97 @@
 #include "plugin/Plugin.hpp"
 #include "plugin/Events.hpp"
+#include "plugin/InputLatency.hpp"
+#include "plugin/SelfOverhead.hpp"
+#include "plugin/StatsPage.hpp"
+#include "plugin/Command.hpp"
+#include "plugin/components/CommandObserver.hpp"
 #include "plugin/components/ConfigManager.hpp"
 #include "plugin/components/CursorObserver.hpp"
 #include "plugin/components/KeyboardObserver.hpp"
+#include "plugin/components/MetricsExporter.hpp"
 #include "plugin/components/Unlocker.hpp"
 #include "plugin/components/WindowObserver.hpp"
+#include "utils/AtomicFile.hpp"
+#include "utils/CycleCounter.hpp"
+#include "utils/KeyBindingEngine.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/Tracer.hpp"
 #include "utils/Windows.hpp"
 #include "utils/log/Logger.hpp"
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <ranges>
+#include <typeinfo>
 #include <variant>
 
+namespace {
+// Order of the bindings given to the engine
+enum class KeyAction : size_t {
+    Enable,
+    Next,
+    Prev,
+    Dump
+};
+
+constexpr auto STATS_PERIOD = std::chrono::milliseconds(100);
+
+// Counted by the components, and published to the stats page
+MetricCounter& hookCallCount =
+    MetricsRegistry::GetInstance().RegisterCounter("hook.calls");
+MetricCounter& hookErrorCount =
+    MetricsRegistry::GetInstance().RegisterCounter("hook.errors");
+MetricCounter& parseErrorCount =
+    MetricsRegistry::GetInstance().RegisterCounter("config.parse_errors");
+MetricCounter& droppedInputCount =
+    MetricsRegistry::GetInstance().RegisterCounter("keyboard.dropped");
+MetricGauge& queuedEventCount =
+    MetricsRegistry::GetInstance().RegisterGauge("mediator.pending_events");
+
+MetricCounter& rejectedCommandCount =
+    MetricsRegistry::GetInstance().RegisterCounter("commands.rejected");
+} // namespace
+
 Plugin::Plugin()
     : isUnlockerHooked { false }
     , isWindowFocused { true }
-    , isCursorVisible { true } {};
+    , isCursorVisible { true }
+    , isConfigDirty { false }
+    , statsTime {}
+    , statsHookCalls { 0 }
+    , statsTicks {} {};
 
 Plugin::~Plugin() {
     Notify(OnPluginEnd {});
 }
 
 void Plugin::Start() noexcept try {
-    SetComponent<Unlocker>();
-    SetComponent<ConfigManager>(
-        GetModulePath().parent_path() / "fov_config.json");
+    TRACE_SCOPE("Plugin::Start");
+    const auto directory = GetModulePath().parent_path();
+    SetComponent<Unlocker>(directory / "fov_offsets.cache");
+    SetComponent<ConfigManager>(directory / "fov_config.json");
     SetComponent<WindowObserver>();
     SetComponent<CursorObserver>();
     SetComponent<KeyboardObserver>();
+#if ACTIVE_LEVEL < LEVEL_OFF
+    SetComponent<MetricsExporter>(
+        directory / "fov_metrics.json", std::chrono::seconds(10));
+#endif
+
+    try {
+        SetComponent<CommandObserver>();
+    } catch (const std::exception& e) {
+        LOG_W("Failed to create command ring: {}", e.what());
+    }
+    try {
+        statsPage.emplace();
+        statsTime = std::chrono::steady_clock::now();
+    } catch (const std::exception& e) {
+        LOG_W("Failed to create stats page: {}", e.what());
+    }
 
     targetWindows = GetProcessWindows();
     Notify(OnPluginStart {});
@@ -35,6 +99,16 @@ void Plugin::Start() noexcept try {
     LOG_E("Failed to start plugin: {}", e.what());
 }
 
+void Plugin::Update() noexcept {
+    if (isConfigDirty) {
+        SaveConfig();
+    }
+    if (const auto now = std::chrono::steady_clock::now();
+        statsPage && now - statsTime >= STATS_PERIOD) {
+        PublishStats(now);
+    }
+}
+
 template <>
 void Plugin::Handle(const OnPluginStart& event) noexcept {
     try {
@@ -43,52 +117,134 @@ void Plugin::Handle(const OnPluginStart& event) noexcept {
         LOG_W("Failed to read config: {}", e.what());
     }
 
+    const auto now = std::chrono::steady_clock::now();
     auto& unlocker = GetComponent<Unlocker>();
-    unlocker.SetEnable(config.enabled);
-    unlocker.SetFieldOfView(config.fov);
+    unlocker.SetEnable(config.enabled, now);
+    unlocker.SetFieldOfView(config.fov, now);
     unlocker.SetSmoothing(config.smoothing);
+    unlocker.SetFilter(config.filter, config.oneEuroBeta);
+    CompileKeyBindings();
 }
 
 template <>
 void Plugin::Handle(const OnPluginEnd& event) noexcept {
-    try {
-        GetComponent<ConfigManager>().Write(config);
-    } catch (const std::exception& e) {
-        LOG_W("Failed to write config: {}", e.what());
-    }
+    SaveConfig();
 }
 
+// Key state is followed even while unhooked, so that modifiers held then
+// are still known once the game has focus again. Keys are timed from the
+// hook, so that the binding engine sees when they were really pressed.
 template <>
 void Plugin::Handle(const OnKeyDown& event) noexcept {
-    const auto key = event.vKey;
-    auto& [enabled, fov, fovPresets, smoothing,
-        enableKey, nextKey, prevKey, dumpKey] = config;
+    InputLatency::GetInstance().Record(
+        InputLatency::Stage::KeyToHandler, event.time,
+        std::chrono::steady_clock::now());
+    if (const auto keyBinding = keyBindings.OnKeyDown(event.vKey, event.time)) {
+        Trigger(*keyBinding, event.time);
+    }
+}
 
-    if (!isUnlockerHooked) {
-        return;
+template <>
+void Plugin::Handle(const OnKeyHold& event) noexcept {
+    InputLatency::GetInstance().Record(
+        InputLatency::Stage::KeyToHandler, event.time,
+        std::chrono::steady_clock::now());
+    if (const auto keyBinding = keyBindings.OnKeyHold(event.vKey, event.time)) {
+        Trigger(*keyBinding, event.time);
+    }
+}
+
+template <>
+void Plugin::Handle(const OnKeyUp& event) noexcept {
+    InputLatency::GetInstance().Record(
+        InputLatency::Stage::KeyToHandler, event.time,
+        std::chrono::steady_clock::now());
+    if (const auto keyBinding = keyBindings.OnKeyUp(event.vKey, event.time)) {
+        Trigger(*keyBinding, event.time);
     }
+}
 
+template <>
+void Plugin::Handle(const OnConfigChange& event) noexcept try {
+    const auto& [enabled, fov, fovPresets, smoothing, filter, oneEuroBeta,
+        enableKey, nextKey, prevKey, dumpKey] = event.change;
+    InputLatency::GetInstance().Record(
+        InputLatency::Stage::ConfigToHandler, event.time,
+        std::chrono::steady_clock::now());
+
+    // Only the edited fields are applied, so the filter keeps its state and
+    // the preset the user cycled to stays unless the file changes it
     auto& unlocker = GetComponent<Unlocker>();
-    if (key == enableKey) {
-        enabled = !enabled;
-        unlocker.SetEnable(enabled);
-    } else if (!enabled || isCursorVisible) {
+    if (enabled) {
+        config.enabled = *enabled;
+        unlocker.SetEnable(config.enabled, event.time);
+    }
+    if (fov) {
+        config.fov = *fov;
+        unlocker.SetFieldOfView(config.fov, event.time);
+    }
+    if (fovPresets) {
+        config.fovPresets = *fovPresets;
+    }
+    if (smoothing) {
+        config.smoothing = *smoothing;
+        unlocker.SetSmoothing(config.smoothing);
+    }
+    if (filter || oneEuroBeta) {
+        config.filter = filter.value_or(config.filter);
+        config.oneEuroBeta = oneEuroBeta.value_or(config.oneEuroBeta);
+        unlocker.SetFilter(config.filter, config.oneEuroBeta);
+    }
+    if (enableKey || nextKey || prevKey || dumpKey) {
+        config.enableKey = enableKey.value_or(config.enableKey);
+        config.nextKey = nextKey.value_or(config.nextKey);
+        config.prevKey = prevKey.value_or(config.prevKey);
+        config.dumpKey = dumpKey.value_or(config.dumpKey);
+        CompileKeyBindings();
+    }
+    LOG_I("Reloaded config");
+} catch (const std::exception& e) {
+    LOG_E("Failed to apply config change: {}", e.what());
+}
+
+// Commands apply whether or not the game has focus, since a client sends
+// them on purpose, and are saved like key bindings
+template <>
+void Plugin::Handle(const OnCommand& event) noexcept try {
+    const auto& [sendTime, type, value, smoothing, reserved] = event.command;
+    InputLatency::GetInstance().Record(
+        InputLatency::Stage::CommandToHandler, event.time,
+        std::chrono::steady_clock::now());
+
+    auto& unlocker = GetComponent<Unlocker>();
+    if (type == CommandType::Ping) {
+        return;
+    } else if (type == CommandType::SetFieldOfView && value > 0 && value < 180) {
+        config.fov = value;
+        unlocker.SetFieldOfView(config.fov, event.time);
+    } else if (type == CommandType::SetSmoothing &&
+               smoothing >= 0.0f && smoothing <= 1.0f) {
+        config.smoothing = smoothing;
+        unlocker.SetSmoothing(config.smoothing);
+    } else if (type == CommandType::SetEnable) {
+        config.enabled = value != 0;
+        unlocker.SetEnable(config.enabled, event.time);
+    } else if (type == CommandType::SelectPreset && value >= 0 &&
+               static_cast<size_t>(value) < config.fovPresets.size()) {
+        config.fov = config.fovPresets[static_cast<size_t>(value)];
+        unlocker.SetFieldOfView(config.fov, event.time);
+    } else if (type == CommandType::Dump) {
+        Dump();
+        return;
+    } else {
+        rejectedCommandCount.Add();
+        LOG_W("Rejected command of type {} with value {} and smoothing {}",
+            static_cast<uint32_t>(type), value, smoothing);
         return;
-    } else if (key == nextKey) {
-        const auto it = std::ranges::find_if(
-            fovPresets,
-            [fov](const int fovPreset) { return fov < fovPreset; });
-        fov = it != fovPresets.end() ? *it : fovPresets.front();
-        unlocker.SetFieldOfView(fov);
-    } else if (key == prevKey) {
-        const auto it = std::ranges::find_if(
-            fovPresets | std::views::reverse,
-            [fov](const int fovPreset) { return fov > fovPreset; });
-        fov = it != fovPresets.rend() ? *it : fovPresets.back();
-        unlocker.SetFieldOfView(fov);
-    } else if (key == dumpKey) {
-        // TODO: plugin.unlocker.DumpBuffer();
     }
+    isConfigDirty = true;
+} catch (const std::exception& e) {
+    LOG_E("Failed to apply command: {}", e.what());
 }
 
 template <>
@@ -117,6 +273,127 @@ void Plugin::ConsumeState() noexcept try {
     LOG_E("Failed to set hook: {}", e.what());
 }
 
+void Plugin::CompileKeyBindings() noexcept try {
+    const std::array bindings {
+        config.enableKey, config.nextKey, config.prevKey, config.dumpKey
+    };
+    keyBindings = KeyBindingEngine { bindings };
+} catch (const std::exception& e) {
+    // The previous bindings stay in effect
+    LOG_E("Failed to compile key bindings: {}", e.what());
+}
+
+void Plugin::Trigger(
+    const size_t keyBinding,
+    const std::chrono::steady_clock::time_point inputTime) noexcept {
+    auto& [enabled, fov, fovPresets, smoothing, filter, oneEuroBeta,
+        enableKey, nextKey, prevKey, dumpKey] = config;
+
+    if (!isUnlockerHooked) {
+        return;
+    }
+
+    auto& unlocker = GetComponent<Unlocker>();
+    const auto action = static_cast<KeyAction>(keyBinding);
+    if (action == KeyAction::Enable) {
+        enabled = !enabled;
+        unlocker.SetEnable(enabled, inputTime);
+        isConfigDirty = true;
+    } else if (!enabled || isCursorVisible) {
+        return;
+    } else if (action == KeyAction::Next) {
+        const auto it = std::ranges::find_if(
+            fovPresets,
+            [fov](const int fovPreset) { return fov < fovPreset; });
+        fov = it != fovPresets.end() ? *it : fovPresets.front();
+        unlocker.SetFieldOfView(fov, inputTime);
+        isConfigDirty = true;
+    } else if (action == KeyAction::Prev) {
+        const auto it = std::ranges::find_if(
+            fovPresets | std::views::reverse,
+            [fov](const int fovPreset) { return fov > fovPreset; });
+        fov = it != fovPresets.rend() ? *it : fovPresets.back();
+        unlocker.SetFieldOfView(fov, inputTime);
+        isConfigDirty = true;
+    } else if (action == KeyAction::Dump) {
+        Dump();
+    }
+}
+
+void Plugin::Dump() noexcept try {
+    const auto directory = GetModulePath().parent_path();
+    auto& unlocker = GetComponent<Unlocker>();
+    unlocker.DumpTrace(directory / "fov_trace.csv");
+    unlocker.DumpFramePacing(directory / "fov_frames.txt");
+
+    const auto latency = InputLatency::GetInstance().Report();
+    WriteFileAtomic(directory / "fov_latency.txt", latency);
+    LOG_I("Input latency:\n{}", latency);
+
+    const auto overhead = SelfOverhead::GetInstance().Report(TickCycles());
+    WriteFileAtomic(directory / "fov_overhead.txt", overhead);
+    LOG_I("Overhead:\n{}", overhead);
+
+    const auto& metrics = MetricsRegistry::GetInstance();
+    WriteFileAtomic(directory / "fov_metrics.json", metrics.ToJson());
+    LOG_I("Metrics:\n{}", metrics.ToText());
+
+    TRACE_WRITE(directory / "fov_timeline.json");
+} catch (const std::exception& e) {
+    LOG_W("Failed to dump diagnostics: {}", e.what());
+}
+
+void Plugin::PublishStats(
+    const std::chrono::steady_clock::time_point now) noexcept {
+    const double seconds =
+        std::chrono::duration<double>(now - statsTime).count();
+    const auto hookCalls = hookCallCount.Value();
+    const auto ticks = TickCycles().Read();
+    const auto tickCalls = ticks.calls - statsTicks.calls;
+    const auto tickCycles = ticks.cycles - statsTicks.cycles;
+    const auto unlocker = TryGetComponent<Unlocker>();
+
+    PluginStats stats {};
+    stats.updateTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now.time_since_epoch()).count();
+    stats.hookCallRate =
+        static_cast<double>(hookCalls - statsHookCalls) / seconds;
+    stats.tickRate = static_cast<double>(tickCalls) / seconds;
+    stats.tickMicroseconds = tickCalls == 0 ? 0.0 :
+        static_cast<double>(tickCycles) *
+        cycleCalibration.NanosecondsPerCycle() / 1000.0 /
+        static_cast<double>(tickCalls);
+    stats.hookCalls = hookCalls;
+    stats.ticks = ticks.calls;
+    stats.pendingEvents = queuedEventCount.Value();
+    stats.hookErrors = hookErrorCount.Value();
+    stats.configParseErrors = parseErrorCount.Value();
+    stats.droppedInputs = droppedInputCount.Value();
+    stats.fov = config.fov;
+    stats.appliedFov = unlocker ? unlocker->AppliedFieldOfView() : 0.0f;
+    stats.smoothing = config.smoothing;
+    stats.oneEuroBeta = config.oneEuroBeta;
+    stats.filter = config.filter;
+    stats.isEnabled = config.enabled;
+    stats.isHooked = isUnlockerHooked;
+    stats.isWindowFocused = isWindowFocused;
+    stats.isCursorVisible = isCursorVisible;
+    statsPage->Publish(stats);
+
+    statsTime = now;
+    statsHookCalls = hookCalls;
+    statsTicks = ticks;
+}
+
+// Called on the tick after changes, so that a burst of them, such as a
+// client's commands, is serialized once
+void Plugin::SaveConfig() noexcept try {
+    isConfigDirty = false;
+    GetComponent<ConfigManager>().Write(config);
+} catch (const std::exception& e) {
+    LOG_W("Failed to write config: {}", e.what());
+}
+
 struct Plugin::Visitor {
     Plugin& plugin;
 
@@ -126,6 +403,7 @@ struct Plugin::Visitor {
 
 template <typename Event>
 void Plugin::Visitor::operator()(const Event& event) const noexcept {
+    TRACE_SCOPE(typeid(Event).name());
     plugin.Handle(event);
 }
 
@@ -0,0 +1,61 @@
+#include "plugin/SelfOverhead.hpp"
+#include "utils/CycleCounter.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string>
+
+namespace {
+double PerCall(
+    const CycleCounter::Totals& totals,
+    const uint64_t calls,
+    const double nanosecondsPerCycle) noexcept {
+    return calls == 0 ? 0.0 : static_cast<double>(totals.cycles) *
+        nanosecondsPerCycle / 1000.0 / static_cast<double>(calls);
+}
+} // namespace
+
+SelfOverhead& SelfOverhead::GetInstance() {
+    static SelfOverhead instance {};
+    return instance;
+}
+
+CycleCounter& SelfOverhead::Counter(const Site site) noexcept {
+    return counters[static_cast<size_t>(site)];
+}
+
+std::string SelfOverhead::Report(const CycleCounter& mediatorTicks) const {
+    const double scale = calibration.NanosecondsPerCycle();
+    const double seconds = std::chrono::duration<double>(
+        calibration.Elapsed()).count();
+
+    const auto frames =
+        counters[static_cast<size_t>(Site::FrameCall)].Read();
+    const auto others =
+        counters[static_cast<size_t>(Site::OtherCall)].Read();
+    const CycleCounter::Totals render {
+        frames.calls + others.calls, frames.cycles + others.cycles
+    };
+    const auto keyboard =
+        counters[static_cast<size_t>(Site::KeyboardHook)].Read();
+    const auto ticks = mediatorTicks.Read();
+
+    // Share of one core over the whole run
+    const auto share = [scale, seconds](const CycleCounter::Totals& totals) {
+        return seconds == 0.0 ? 0.0 : static_cast<double>(totals.cycles) *
+            scale / 1e9 / seconds * 100.0;
+    };
+    return std::format(
+        "render thread: {:.3f} us per frame over {} frames, "
+        "{:.3f} us per call over {} calls, {:.4f}% of a core\n"
+        "keyboard hook: {:.3f} us per input over {} inputs, "
+        "{:.4f}% of a core\n"
+        "mediator: {:.3f} us per tick over {} ticks, {:.4f}% of a core\n",
+        PerCall(render, frames.calls, scale), frames.calls,
+        PerCall(render, render.calls, scale), render.calls, share(render),
+        PerCall(keyboard, keyboard.calls, scale), keyboard.calls,
+        share(keyboard),
+        PerCall(ticks, ticks.calls, scale), ticks.calls, share(ticks));
+}
@@ -0,0 +1,64 @@
+#include "plugin/StatsPage.hpp"
+#include "utils/SharedMemory.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+constexpr int READ_ATTEMPTS = 1000;
+} // namespace
+
+StatsPage::StatsPage()
+    : memory { NAME, sizeof(Layout), SharedMemory::Access::Create }
+    , layout { new (memory.Data().data()) Layout {} } {
+    layout->version = VERSION;
+    layout->size = sizeof(Layout);
+    // Written last, since readers only trust a page with the magic
+    std::atomic_ref { layout->magic }.store(MAGIC, std::memory_order_release);
+}
+
+void StatsPage::Publish(const PluginStats& stats) noexcept {
+    layout->stats.Store(stats);
+}
+
+StatsPageReader::StatsPageReader()
+    : memory {
+        StatsPage::NAME, sizeof(StatsPage::Layout),
+        SharedMemory::Access::ReadOnly
+    }
+    , layout { reinterpret_cast<const StatsPage::Layout*>(
+        memory.Data().data()) } {
+    const auto magic = std::atomic_ref {
+        const_cast<uint32_t&>(layout->magic)
+    }.load(std::memory_order_acquire);
+    if (magic != StatsPage::MAGIC) {
+        throw std::runtime_error { "Stats page is not initialized" };
+    }
+    if (layout->version != StatsPage::VERSION ||
+        layout->size != sizeof(StatsPage::Layout)) {
+        throw std::runtime_error {
+            "Stats page has version " + std::to_string(layout->version) +
+            ", expected " + std::to_string(StatsPage::VERSION)
+        };
+    }
+}
+
+std::optional<PluginStats> StatsPageReader::Read() const noexcept {
+    for (int i = 0; i < READ_ATTEMPTS; ++i) {
+        if (const auto stats = layout->stats.TryLoad()) {
+            return stats;
+        }
+        std::this_thread::yield();
+    }
+    return std::nullopt;
+}
+
+uint64_t StatsPageReader::Version() const noexcept {
+    return layout->stats.Version();
+}
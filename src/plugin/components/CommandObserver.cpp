@@ -0,0 +1,47 @@
+#include "plugin/components/CommandObserver.hpp"
+#include "plugin/Command.hpp"
+#include "plugin/CommandRing.hpp"
+#include "plugin/Events.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/log/Logger.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Clients share the steady clock, but send times older than this or in the
+// future are not trusted, and the command is timed from its receipt
+constexpr auto MAX_SEND_AGE = std::chrono::seconds(1);
+
+MetricCounter& commandCount =
+    MetricsRegistry::GetInstance().RegisterCounter("commands.received");
+} // namespace
+
+CommandObserver::CommandObserver() try
+    : ring {} {
+} catch (const std::exception& e) {
+    LOG_E("Failed to create CommandObserver: {}", e.what());
+    throw;
+}
+
+CommandObserver::~CommandObserver() noexcept = default;
+
+void CommandObserver::Update() noexcept {
+    // Bounded, so that a client flooding the ring cannot stall the tick
+    Command command {};
+    for (size_t i = 0; i < CommandRing::CAPACITY && ring.TryPop(command); ++i) {
+        const auto now = Clock::now();
+        auto time = Clock::time_point {
+            std::chrono::duration_cast<Clock::duration>(
+                std::chrono::nanoseconds { command.sendTime })
+        };
+        if (time > now || now - time > MAX_SEND_AGE) {
+            time = now;
+        }
+        Notify(OnCommand { command, time });
+        commandCount.Add();
+    }
+}
@@ -1,13 +1,30 @@
 #include "plugin/components/ConfigManager.hpp"
+#include "plugin/Config.hpp"
+#include "plugin/Events.hpp"
+#include "utils/AsyncFileWriter.hpp"
+#include "utils/AtomicFile.hpp"
+#include "utils/FileWatcher.hpp"
+#include "utils/KeyBinding.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/Tracer.hpp"
+#include "utils/WriteEchoFilter.hpp"
+#include "utils/json/JsonSchema.hpp"
 #include "utils/log/Logger.hpp"
 
-#include <nlohmann/json.hpp>
-
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <fstream>
+#include <ios>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <utility>
 
 namespace {
@@ -15,95 +32,240 @@ constexpr auto ENABLED = "enabled";
 constexpr auto FOV = "fov";
 constexpr auto FOV_PRESETS = "fov_presets";
 constexpr auto SMOOTHING = "smoothing";
+constexpr auto FILTER = "filter";
+constexpr auto ONE_EURO_BETA = "one_euro_beta";
 constexpr auto ENABLE_KEY = "enable_key";
 constexpr auto NEXT_KEY = "next_key";
 constexpr auto PREV_KEY = "prev_key";
 constexpr auto DUMP_KEY = "dump_key";
-} // namespace
 
-ConfigManager::ConfigManager(std::filesystem::path filePath) noexcept
-    : filePath { std::move(filePath) } {}
+// Editors often save in several writes, such as a truncate then a write
+constexpr auto RELOAD_DELAY = std::chrono::milliseconds { 200 };
 
-ConfigManager::~ConfigManager() noexcept = default;
+// Long enough to coalesce cycling through presets, short enough to be
+// written before the game is closed
+constexpr auto WRITE_DELAY = std::chrono::milliseconds { 500 };
+// How long unloading waits for a write in progress
+constexpr auto WRITE_TIMEOUT = std::chrono::milliseconds { 500 };
+} // namespace
 
-#define TRY_GET_TO(json, key, value)                                            \
-    try {                                                                       \
-        (json).at(key).get_to(value);                                           \
-    } catch (const std::exception& e) {                                         \
-        LOG_W("Failed to parse key '{}': {}", key, e.what());                   \
-    }
+template <>
+struct JsonEnum<FilterType> {
+    static constexpr std::array NAMES {
+        std::pair { FilterType::Exponential, std::string_view { "exponential" } },
+        std::pair { FilterType::OneEuro, std::string_view { "one_euro" } },
+        std::pair { FilterType::Spring, std::string_view { "spring" } }
+    };
+};
 
-#define TRY_GET_TO_IF(json, key, value, condition)                              \
-    try {                                                                       \
-        auto previousValue = value;                                             \
-        (json).at(key).get_to(value);                                           \
-        if (!(condition)) {                                                     \
-            (value) = previousValue;                                            \
-            LOG_W(                                                              \
-                "Invalid value for key '{}': {} is not satisfied",              \
-                key, #condition                                                 \
-            );                                                                  \
-        }                                                                       \
-    } catch (const std::exception& e) {                                         \
-        LOG_W("Failed to parse key '{}': {}", key, e.what());                   \
+// Single keys pressed down are written as plain key codes, as they were
+// before bindings could be anything else
+template <>
+struct JsonCodec<KeyBinding> {
+    [[nodiscard]] static std::string TypeName() {
+        return "a key code or a key binding such as 'Ctrl+Right'";
     }
 
-Config ConfigManager::Read() const {
-    std::ifstream file { filePath };
-    if (!file.is_open()) {
-        throw std::runtime_error { "Failed to open file" };
+    static bool Read(
+        JsonReader& reader,
+        const JsonToken token,
+        KeyBinding& value) noexcept try {
+        if (token == JsonToken::Number) {
+            uint8_t vKey {};
+            if (!JsonCodec<uint8_t>::Read(reader, token, vKey) ||
+                vKey == 0 || vKey == 255) {
+                return false;
+            }
+            value = MakeKeyBinding(vKey);
+            return true;
+        }
+        if (token != JsonToken::String) {
+            reader.SkipValue(token);
+            return false;
+        }
+        value = ParseKeyBinding(reader.Value());
+        return true;
+    } catch (const std::exception&) {
+        return false;
     }
 
-    nlohmann::ordered_json j {};
-    file >> j;
-
-    Config config {};
-    auto& [enabled, fov, fovPresets, smoothing,
-        enableKey, nextKey, prevKey, dumpKey] = config;
+    static void Write(JsonWriter& writer, const KeyBinding& value) {
+        const auto& [sequence, press] = value;
+        if (sequence.size() == 1 &&
+            sequence.front().modifiers == KeyModifiers::None &&
+            press == KeyPress::Down) {
+            writer.Unsigned(sequence.front().vKey);
+        } else {
+            writer.String(FormatKeyBinding(value));
+        }
+    }
+};
 
-    TRY_GET_TO(j, ENABLED, enabled);
-    TRY_GET_TO_IF(j, FOV, fov,
-        fov > 0 && fov < 180);
-    TRY_GET_TO_IF(j, FOV_PRESETS, fovPresets,
+namespace {
+constexpr auto SCHEMA = MakeJsonSchema<Config>(
+    MakeJsonField(ENABLED, &Config::enabled),
+    JSON_FIELD_IF(FOV, Config, fov,
+        fov > 0 && fov < 180),
+    JSON_FIELD_IF(FOV_PRESETS, Config, fovPresets,
+        !fovPresets.empty() &&
         std::ranges::all_of(fovPresets, [](const int fovPreset) {
             return fovPreset > 0 && fovPreset < 180;
-        }));
-    TRY_GET_TO_IF(j, SMOOTHING, smoothing,
-        smoothing >= 0.0 && smoothing <= 1.0);
-    TRY_GET_TO_IF(j, ENABLE_KEY, enableKey,
-        enableKey > 0 && enableKey < 255);
-    TRY_GET_TO_IF(j, NEXT_KEY, nextKey,
-        nextKey > 0 && nextKey < 255);
-    TRY_GET_TO_IF(j, PREV_KEY, prevKey,
-        prevKey > 0 && prevKey < 255);
-    TRY_GET_TO_IF(j, DUMP_KEY, dumpKey,
-        dumpKey > 0 && dumpKey < 255);
+        })),
+    JSON_FIELD_IF(SMOOTHING, Config, smoothing,
+        smoothing >= 0.0 && smoothing <= 1.0),
+    MakeJsonField(FILTER, &Config::filter),
+    JSON_FIELD_IF(ONE_EURO_BETA, Config, oneEuroBeta,
+        oneEuroBeta >= 0.0),
+    MakeJsonField(ENABLE_KEY, &Config::enableKey),
+    MakeJsonField(NEXT_KEY, &Config::nextKey),
+    MakeJsonField(PREV_KEY, &Config::prevKey),
+    MakeJsonField(DUMP_KEY, &Config::dumpKey)
+);
 
-    std::ranges::sort(fovPresets);
-    const auto last = std::ranges::unique(fovPresets).begin();
-    fovPresets.erase(last, fovPresets.end());
+MetricCounter& reloadCount =
+    MetricsRegistry::GetInstance().RegisterCounter("config.reloads");
+MetricCounter& parseErrorCount =
+    MetricsRegistry::GetInstance().RegisterCounter("config.parse_errors");
+MetricCounter& writeCount =
+    MetricsRegistry::GetInstance().RegisterCounter("config.writes");
+Histogram& parseTime =
+    MetricsRegistry::GetInstance().RegisterHistogram("config.parse_ns");
+} // namespace
+
+ConfigManager::ConfigManager(std::filesystem::path filePath) noexcept
+    : filePath { std::move(filePath) }
+    , isReloaded { false }
+    , reloadTime {}
+    , echoFilter {} {
+    try {
+        writer = std::make_unique<AsyncFileWriter>(
+            this->filePath, WRITE_DELAY, WRITE_TIMEOUT,
+            [](const std::exception& e) {
+                LOG_W("Failed to write config: {}", e.what());
+            });
+    } catch (const std::exception& e) {
+        LOG_W("Failed to start config writer: {}", e.what());
+    }
+    try {
+        watcher = std::make_unique<FileWatcher>(
+            this->filePath, RELOAD_DELAY, [this] { Reload(); });
+    } catch (const std::exception& e) {
+        LOG_W("Failed to watch config file: {}", e.what());
+    }
+}
 
+ConfigManager::~ConfigManager() noexcept {
+    watcher.reset();
+    writer.reset();
+}
+
+Config ConfigManager::Read() {
+    TRACE_SCOPE("ConfigManager::Read");
+    const auto config = Parse(ReadText());
+    std::lock_guard lock { mutex };
+    currentConfig = config;
+    reportedConfig = config;
+    isReloaded = false;
     return config;
 }
 
-void ConfigManager::Write(const Config& config) const {
-    auto& [enabled, fov, fovPresets, smoothing,
-        enableKey, nextKey, prevKey, dumpKey] = config;
-
-    const nlohmann::ordered_json j {
-        { ENABLED, enabled },
-        { FOV, fov },
-        { FOV_PRESETS, fovPresets },
-        { SMOOTHING, smoothing },
-        { ENABLE_KEY, enableKey },
-        { NEXT_KEY, nextKey },
-        { PREV_KEY, prevKey },
-        { DUMP_KEY, dumpKey }
-    };
+void ConfigManager::Write(const Config& config) {
+    TRACE_SCOPE("ConfigManager::Write");
+    auto text = SCHEMA.Write(config);
+    // Recorded first so that the watcher sees its own write as unchanged
+    {
+        std::lock_guard lock { mutex };
+        currentConfig = config;
+        reportedConfig = config;
+        isReloaded = false;
+        echoFilter.OnWrite(text);
+    }
+
+    writeCount.Add();
+    if (writer) {
+        writer->Write(std::move(text));
+    } else {
+        WriteFileAtomic(filePath, text);
+    }
+}
+
+void ConfigManager::Update() noexcept {
+    ConfigChange change {};
+    std::chrono::steady_clock::time_point time {};
+    {
+        std::lock_guard lock { mutex };
+        if (!isReloaded) {
+            return;
+        }
+        isReloaded = false;
+        change = Diff(reportedConfig, currentConfig);
+        reportedConfig = currentConfig;
+        time = reloadTime;
+    }
+    if (!change.IsEmpty()) {
+        Notify(OnConfigChange { std::move(change), time });
+    }
+}
+
+void ConfigManager::Reload() noexcept try {
+    TRACE_SCOPE("ConfigManager::Reload");
+    const auto time = std::chrono::steady_clock::now();
+    const auto text = ReadText();
+    const auto config = Parse(text);
+    std::lock_guard lock { mutex };
+    // A write that lands while a later one is pending would otherwise be
+    // reported as a change back to it
+    if (echoFilter.IsEcho(text)) {
+        return;
+    }
+    currentConfig = config;
+    // Reloads not yet reported are reported together from the first
+    if (!isReloaded) {
+        reloadTime = time;
+    }
+    isReloaded = true;
+    reloadCount.Add();
+} catch (const std::exception& e) {
+    LOG_W("Failed to reload config: {}", e.what());
+}
 
-    std::ofstream file { filePath };
+// Read in one call rather than a character at a time, since the file is
+// small enough for opening and reading it to be most of the cost
+std::string ConfigManager::ReadText() const {
+    std::ifstream file { filePath, std::ios::binary | std::ios::ate };
     if (!file.is_open()) {
         throw std::runtime_error { "Failed to open file" };
     }
-    file << j.dump(4);
+    std::string text(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(text.data(), static_cast<std::streamsize>(text.size()))) {
+        throw std::runtime_error { "Failed to read file" };
+    }
+    return text;
+}
+
+Config ConfigManager::Parse(const std::string_view text) const {
+    const auto start = std::chrono::steady_clock::now();
+    // Invalid values keep their defaults, but a file that is not JSON at
+    // all is rejected as a whole
+    Config config {};
+    const auto [syntaxError, errors] = SCHEMA.Read(text, config);
+    if (syntaxError) {
+        parseErrorCount.Add();
+        throw std::runtime_error { *syntaxError };
+    }
+    parseErrorCount.Add(errors.size());
+    for ([[maybe_unused]] const auto& error : errors) {
+        LOG_W("{}", error);
+    }
+
+    auto& fovPresets = config.fovPresets;
+    std::ranges::sort(fovPresets);
+    const auto last = std::ranges::unique(fovPresets).begin();
+    fovPresets.erase(last, fovPresets.end());
+
+    parseTime.Record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+    return config;
 }
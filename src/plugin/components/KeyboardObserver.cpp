@@ -1,25 +1,58 @@
 #include "plugin/components/KeyboardObserver.hpp"
 #include "plugin/Events.hpp"
+#include "plugin/InputLatency.hpp"
+#include "plugin/SelfOverhead.hpp"
+#include "utils/AtomicBitset.hpp"
+#include "utils/CycleCounter.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/MulticastRing.hpp"
 #include "utils/ThreadWrapper.hpp"
+#include "utils/Tracer.hpp"
 #include "utils/Windows.hpp"
 #include "utils/log/Logger.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <exception>
 #include <mutex>
 #include <optional>
 #include <thread>
-#include <unordered_map>
-#include <utility>
 #include <vector>
 
 #include <Windows.h>
 
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int TIME_BITS = 48;
+constexpr uint64_t TIME_MASK = (uint64_t { 1 } << TIME_BITS) - 1;
+
+MetricCounter& inputCount =
+    MetricsRegistry::GetInstance().RegisterCounter("keyboard.inputs");
+MetricCounter& droppedInputCount =
+    MetricsRegistry::GetInstance().RegisterCounter("keyboard.dropped");
+
+uint64_t PackTime(const Clock::time_point time) noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<
+        std::chrono::nanoseconds>(time.time_since_epoch()).count()) & TIME_MASK;
+}
+
+// The time must not be after now
+Clock::time_point UnpackTime(
+    const uint64_t packed, const Clock::time_point now) noexcept {
+    const auto elapsed = (PackTime(now) - packed) & TIME_MASK;
+    return now - std::chrono::duration_cast<Clock::duration>(
+        std::chrono::nanoseconds { elapsed });
+}
+} // namespace
+
 struct KeyboardObserver::Hook {
     static void Register(KeyboardObserver* instance);
     static void Unregister(KeyboardObserver* instance) noexcept;
 
+    static inline KeyInputRing keyInputs {};
+
 private:
     static LRESULT CALLBACK KeyboardProc(
         int nCode, WPARAM wParam, LPARAM lParam) noexcept;
@@ -37,7 +70,9 @@ private:
     static inline std::vector<KeyboardObserver*> instances {};
     static inline std::optional<ThreadWrapper<
         Prologue, Body, Epilogue>> thread {};
-    static inline std::unordered_map<uint8_t, bool> keyDownStates {};
+
+    // Only the hook thread changes these
+    static inline AtomicBitset<256> keyDownStates {};
 };
 
 void KeyboardObserver::Hook::Register(KeyboardObserver* instance) try {
@@ -76,48 +111,37 @@ LRESULT CALLBACK KeyboardObserver::Hook::KeyboardProc(
         return next();
     }
 
-    Event event {};
+    // Runs under the system's hook timeout, so it neither locks nor
+    // allocates. Observers drain their inputs on their own thread.
+    TRACE_SCOPE("KeyboardProc");
+    CycleScope scope { SelfOverhead::GetInstance().Counter(
+        SelfOverhead::Site::KeyboardHook) };
     const auto keyboard = reinterpret_cast<KBDLLHOOKSTRUCT*>(lParam);
     const auto key = static_cast<uint8_t>(keyboard->vkCode);
-    bool* isKeyDownPtr {};
-    try {
-        isKeyDownPtr = &keyDownStates[key];
-    } catch (const std::exception& e) {
-        LOG_E("Failed to get key state: {}", e.what());
-        return next();
-    }
-    auto& isKeyDown = *isKeyDownPtr;
-
+    const auto push = [key](const KeyAction action) noexcept {
+        keyInputs.Push({
+            PackTime(Clock::now()), key, static_cast<uint64_t>(action) });
+    };
     switch (wParam) {
         case WM_KEYDOWN: case WM_SYSKEYDOWN: {
-            if (isKeyDown) {
-                event.emplace<OnKeyHold>(key);
-            } else {
-                event.emplace<OnKeyDown>(key);
-            }
-            isKeyDown = true;
+            const bool wasKeyDown = keyDownStates.Set(key);
+            push(wasKeyDown ? KeyAction::Hold : KeyAction::Down);
             break;
         }
         case WM_KEYUP: case WM_SYSKEYUP: {
-            event.emplace<OnKeyUp>(key);
-            isKeyDown = false;
+            keyDownStates.Reset(key);
+            push(KeyAction::Up);
             break;
         }
         default: break;
     }
-
-    {
-        std::lock_guard lock { mutex };
-        for (const auto instance : instances) {
-            std::lock_guard instanceLock { instance->mutex };
-            instance->keyboardEvents.emplace_back(event);
-        }
-    }
+    scope.Stop();
 
     return next();
 }
 
 void KeyboardObserver::Hook::SetHook() {
+    TRACE_THREAD_NAME("keyboard hook");
     ThrowOnSystemError(hHook = SetWindowsHookEx(
         WH_KEYBOARD_LL, KeyboardProc, nullptr, 0
     ));
@@ -138,7 +162,8 @@ void KeyboardObserver::Hook::ClearHook(std::thread& thread) noexcept {
     hHook = nullptr;
 }
 
-KeyboardObserver::KeyboardObserver() try {
+KeyboardObserver::KeyboardObserver() try
+    : reader { Hook::keyInputs } {
     Hook::Register(this);
 } catch (const std::exception& e) {
     LOG_E("Failed to create KeyboardObserver: {}", e.what());
@@ -150,9 +175,25 @@ KeyboardObserver::~KeyboardObserver() noexcept {
 }
 
 void KeyboardObserver::Update() noexcept {
-    std::lock_guard lock { mutex };
-    for (const auto& event : keyboardEvents) {
-        Notify(event);
+    const auto lost = reader.Lost();
+    auto& latency = InputLatency::GetInstance();
+    KeyInput input {};
+    while (reader.Next(input)) {
+        // Read after the input so that it is never in the future
+        const auto now = Clock::now();
+        const auto time = UnpackTime(input.time, now);
+        latency.Record(InputLatency::Stage::KeyToObserver, time, now);
+
+        const auto vKey = static_cast<uint8_t>(input.vKey);
+        switch (static_cast<KeyAction>(input.action)) {
+            case KeyAction::Down: Notify(OnKeyDown { vKey, time }); break;
+            case KeyAction::Hold: Notify(OnKeyHold { vKey, time }); break;
+            case KeyAction::Up: Notify(OnKeyUp { vKey, time }); break;
+        }
+        inputCount.Add();
+    }
+    if (reader.Lost() != lost) {
+        droppedInputCount.Add(reader.Lost() - lost);
+        LOG_W("Dropped {} key inputs", reader.Lost() - lost);
     }
-    keyboardEvents.clear();
 }
@@ -0,0 +1,36 @@
+#include "plugin/components/MetricsExporter.hpp"
+#include "utils/AsyncFileWriter.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/log/Logger.hpp"
+
+#include <chrono>
+#include <exception>
+#include <filesystem>
+
+namespace {
+// Each export replaces the last, so there is nothing to coalesce
+constexpr auto WRITE_DELAY = std::chrono::milliseconds(0);
+constexpr auto WRITE_TIMEOUT = std::chrono::milliseconds(500);
+} // namespace
+
+MetricsExporter::MetricsExporter(
+    const std::filesystem::path& filePath, const std::chrono::seconds period)
+    : period { period }
+    , nextExport { std::chrono::steady_clock::now() + period }
+    , writer { filePath, WRITE_DELAY, WRITE_TIMEOUT,
+        [](const std::exception& e) {
+            LOG_W("Failed to write metrics: {}", e.what());
+        } } {}
+
+MetricsExporter::~MetricsExporter() noexcept = default;
+
+void MetricsExporter::Update() noexcept try {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < nextExport) {
+        return;
+    }
+    nextExport = now + period;
+    writer.Write(MetricsRegistry::GetInstance().ToJson());
+} catch (const std::exception& e) {
+    LOG_W("Failed to export metrics: {}", e.what());
+}
@@ -1,61 +1,111 @@
 #include "plugin/components/Unlocker.hpp"
-#include "utils/ExponentialFilter.hpp"
+#include "plugin/FovOverride.hpp"
+#include "plugin/FramePacing.hpp"
+#include "plugin/InputLatency.hpp"
+#include "plugin/SelfOverhead.hpp"
+#include "utils/AtomicFile.hpp"
+#include "utils/CallTrace.hpp"
+#include "utils/CycleCounter.hpp"
+#include "utils/Metrics.hpp"
 #include "utils/MinHook.hpp"
+#include "utils/OffsetCache.hpp"
+#include "utils/PeImage.hpp"
+#include "utils/Signature.hpp"
+#include "utils/Tracer.hpp"
+#include "utils/Windows.hpp"
 #include "utils/log/Logger.hpp"
 
-#include <nlohmann/json.hpp>
-
-#include <bit>
+#include <atomic>
 #include <chrono>
-#include <cmath>
 #include <cstdint>
-#include <memory>
+#include <deque>
+#include <filesystem>
 #include <mutex>
-#include <queue>
-#include <string>
-#include <tuple>
+#include <optional>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include <Windows.h>
 
 namespace {
-constexpr auto OFFSET_GL = 0xFD8BE0;
-constexpr auto OFFSET_CN = 0xFD8BE0;
+// Prologue of the field of view setter, shared by the global and CN builds
+constexpr auto SIGNATURE =
+    "40 53 48 83 EC 30 0F 29 74 24 ?? 0F 28 F1 48 8B D9";
+constexpr auto SIGNATURE_NAME = "SetFieldOfView";
 
+std::optional<uint32_t> FindTarget(
+    const PeImage& image, const std::filesystem::path& cacheFilePath);
+std::optional<uint32_t> FindUniqueMatch(
+    const PeImage& image, const Signature& signature);
 void HkSetFieldOfView(void* instance, float value) noexcept;
-void AddToBuffer(void* instance, float value);
-std::string DumpBuffer();
+void SetTarget(Unlocker::TimePoint inputTime) noexcept;
+void AddToTrace(
+    std::chrono::steady_clock::time_point timePoint,
+    void* instance,
+    float value);
+void AddToFramePacing(
+    std::chrono::steady_clock::time_point timePoint, void* instance) noexcept;
 
 std::mutex mutex {};
 std::optional<MinHook<void, void*, float>> hook {};
-ExponentialFilter<float> filter {};
+FovOverride fovOverride {};
+
+// Calls of the game's setter, those whose value was changed, and those
+// recognized as the overridden camera's by the marker or default value
+MetricCounter& callCount =
+    MetricsRegistry::GetInstance().RegisterCounter("hook.calls");
+MetricCounter& overrideCount =
+    MetricsRegistry::GetInstance().RegisterCounter("hook.overrides");
+MetricCounter& markerHitCount =
+    MetricsRegistry::GetInstance().RegisterCounter("hook.marker_hits");
+MetricCounter& errorCount =
+    MetricsRegistry::GetInstance().RegisterCounter("hook.errors");
+
+// Last value given to the overridden camera, read without the mutex
+std::atomic<float> appliedFov { 0.0f };
+
+// Target given while hooked that no frame has applied yet
+struct PendingTarget {
+    Unlocker::TimePoint targetTime;
+    Unlocker::TimePoint inputTime;
+};
+std::optional<PendingTarget> pendingTarget {};
 
-bool isHooked = false;
-bool isEnabled = false;
-bool isEnabledOnce = false;
-int overrideFov = 45;
+#if ACTIVE_LEVEL < LEVEL_OFF
+// Calls of the last seconds, for replaying with the sweep tool
+constexpr auto TRACE_WINDOW = std::chrono::seconds(10);
+std::deque<std::pair<std::chrono::steady_clock::time_point, CallSample>>
+    trace {};
+#endif
 
-int setFovCount = 0;
-void* previousInstance = nullptr;
-float previousFov = 45.0f;
-bool isPreviousFov = false;
+#ifdef FRAME_PACING
+// Recorded under the mutex, and sampled without it on the mediator thread
+FramePacing framePacing {};
+#endif
 } // namespace
 
-Unlocker::Unlocker() try {
+Unlocker::Unlocker(const std::filesystem::path& cacheFilePath) try {
+    TRACE_SCOPE("Unlocker::Unlocker");
     std::lock_guard lock { mutex };
 
-    auto module = reinterpret_cast<uintptr_t>(
-        GetModuleHandle("GenshinImpact.exe"));
-    const auto global = module ? true : (
-        module = reinterpret_cast<uintptr_t>(
-        GetModuleHandle("YuanShen.exe")), false);
+    auto module = GetModuleHandle("GenshinImpact.exe");
+    if (!module) {
+        module = GetModuleHandle("YuanShen.exe");
+    }
     if (!module) {
         throw std::runtime_error {
             "Failed to get module handle due to unknown game"
         };
     }
-    const auto offset = global ? OFFSET_GL : OFFSET_CN;
-    const auto target = reinterpret_cast<void*>(module + offset);
+
+    const PeImage image { GetModuleImage(module) };
+    const auto rva = FindTarget(image, cacheFilePath);
+    if (!rva) {
+        throw std::runtime_error { "Failed to find target function" };
+    }
+    LOG_D("Found target function at RVA {:#x}", *rva);
+    const auto target = const_cast<uint8_t*>(image.Data().data() + *rva);
     const auto detour = reinterpret_cast<void*>(HkSetFieldOfView);
 
     if (!hook) {
@@ -74,116 +124,222 @@ Unlocker::~Unlocker() noexcept {
 
 void Unlocker::SetHook(const bool value) const {
     std::lock_guard lock { mutex };
-    isHooked = value;
+    fovOverride.SetHook(value);
+    TRACE_INSTANT(value ? "SetHook(true)" : "SetHook(false)");
     if (value) {
         hook->Enable();
-        isEnabledOnce = true;
     } else {
-        // hook->Disable();
+        pendingTarget.reset();
     }
 }
 
-void Unlocker::SetEnable(const bool value) const noexcept {
-    isEnabled = value;
+void Unlocker::SetEnable(
+    const bool value, const TimePoint inputTime) const noexcept {
+    std::lock_guard lock { mutex };
+    fovOverride.SetEnable(value);
+    SetTarget(inputTime);
 }
 
-void Unlocker::SetFieldOfView(const int value) noexcept {
-    overrideFov = value;
+void Unlocker::SetFieldOfView(
+    const int value, const TimePoint inputTime) noexcept {
+    std::lock_guard lock { mutex };
+    fovOverride.SetFieldOfView(value);
+    SetTarget(inputTime);
 }
 
 void Unlocker::SetSmoothing(const float value) noexcept {
-    filter.SetTimeConstant(value);
+    std::lock_guard lock { mutex };
+    fovOverride.Filter().SetTimeConstant(value);
 }
 
-namespace {
-void HkSetFieldOfView(void* instance, float value) noexcept try {
+void Unlocker::SetFilter(const FilterType type, const float oneEuroBeta) {
     std::lock_guard lock { mutex };
+    auto& filter = fovOverride.Filter();
+    filter.SetBeta(oneEuroBeta);
+    if (filter.Type() != type) {
+        filter.SetType(type);
+    }
+}
 
-    ++setFovCount;
-    if (const bool isDefaultFov = value == 45.0f;
-        instance == previousInstance &&
-        (value == previousFov || isDefaultFov)) {
-        if (isDefaultFov) {
-            previousInstance = instance;
-            previousFov = value;
-        }
-
-        if (setFovCount > 8) {
-            filter.SetInitialValue(value);
-        }
-        setFovCount = 0;
+float Unlocker::AppliedFieldOfView() const noexcept {
+    return appliedFov.load(std::memory_order_relaxed);
+}
 
-        if (isEnabledOnce) {
-            isEnabledOnce = false;
-            filter.Update(value);
+void Unlocker::DumpTrace(const std::filesystem::path& filePath) const {
+#if ACTIVE_LEVEL < LEVEL_OFF
+    std::vector<CallSample> samples {};
+    {
+        std::lock_guard lock { mutex };
+        if (trace.empty()) {
+            return;
         }
-        const float target = (isHooked && isEnabled) ?
-            static_cast<float>(overrideFov) : previousFov;
-        const float filtered = filter.Update(target);
-
-        if ((isHooked && isEnabled) || !isPreviousFov) {
-            isPreviousFov = std::abs(previousFov - filtered) < 0.1f;
-            value = filtered;
-        } else if (!isHooked) {
-            isPreviousFov = false;
-            hook->Disable();
+        const auto firstTime = trace.front().first;
+        samples.reserve(trace.size());
+        for (auto [timePoint, sample] : trace) {
+            sample.time = std::chrono::duration<double>(
+                timePoint - firstTime).count();
+            samples.push_back(sample);
         }
-    } else {
-        const auto rep = std::bit_cast<std::uint32_t>(value);
-        value = std::bit_cast<float>(rep + 1); // marker value
-        previousInstance = instance;
-        previousFov = value;
     }
+    WriteCallTrace(filePath, samples);
+    LOG_I("Dumped {} calls to {}", samples.size(), filePath.string());
+#endif
+}
 
-    // AddToBuffer(instance, value);
-    hook->CallOriginal(instance, value);
-} catch (const std::exception& e) {
-    LOG_E("Failed to hook set field of view: {}", e.what());
+void Unlocker::DumpFramePacing(
+    [[maybe_unused]] const std::filesystem::path& filePath) const {
+#ifdef FRAME_PACING
+    const auto report = framePacing.Report();
+    WriteFileAtomic(filePath, report);
+    LOG_I("Frame pacing:\n{}", report);
+#endif
+}
+
+void Unlocker::Update() noexcept {
+#ifdef FRAME_PACING
+    try {
+        framePacing.Sample(std::chrono::steady_clock::now());
+    } catch (const std::exception& e) {
+        LOG_W("Failed to sample frame pacing: {}", e.what());
+    }
+#endif
 }
-} // namespace
 
-#if false // TODO: Reimplement
 namespace {
-namespace sc = std::chrono;
-
-std::queue<std::tuple<
-    sc::steady_clock::time_point, uintptr_t, float>
-> buffer {};
-
-void AddToBuffer(void* instance, const float value) {
-    const auto now = sc::steady_clock::now();
-    while (!buffer.empty()) {
-        const auto [time, instance, value] = buffer.front();
-        if (const auto elapsed = now - time;
-            elapsed < sc::seconds(10)) {
-            break;
+std::optional<uint32_t> FindTarget(
+    const PeImage& image, const std::filesystem::path& cacheFilePath) {
+    TRACE_SCOPE("FindTarget");
+    const Signature signature { SIGNATURE };
+    const auto fingerprint = GetModuleFingerprint(image);
+
+    OffsetCache cache { cacheFilePath };
+    try {
+        cache.Read();
+    } catch (const std::exception& e) {
+        LOG_W("Failed to read offset cache: {}", e.what());
+    }
+    if (const auto rva = cache.Get(SIGNATURE_NAME, fingerprint)) {
+        if (const auto offset = image.RvaToOffset(*rva);
+            offset && signature.Matches(image.Data(), *offset)) {
+            return rva;
         }
-        buffer.pop();
+        LOG_W("Cached RVA {:#x} does not match signature", *rva);
+    }
+
+    // The prologue is generic, so a match is only trusted if it is the
+    // only one. Any of several could be the wrong function, including one
+    // at the setter's address in an older build.
+    const auto rva = FindUniqueMatch(image, signature);
+    if (!rva) {
+        return std::nullopt;
+    }
+
+    try {
+        cache.Set(SIGNATURE_NAME, fingerprint, *rva);
+        cache.Write();
+    } catch (const std::exception& e) {
+        LOG_W("Failed to write offset cache: {}", e.what());
     }
-    buffer.emplace(now, reinterpret_cast<uintptr_t>(instance), value);
+    return rva;
 }
 
-std::string DumpBuffer() {
-    using namespace nlohmann;
+std::optional<uint32_t> FindUniqueMatch(
+    const PeImage& image, const Signature& signature) {
+    std::optional<uint32_t> rva {};
+    size_t matchCount = 0;
+    for (const auto& section : image.Sections()) {
+        if (!section.IsExecutable()) {
+            continue;
+        }
+        const auto data = image.SectionData(section);
+        for (size_t start = 0; start < data.size() && matchCount < 2;) {
+            const auto offset = signature.FindParallel(data.subspan(start));
+            if (!offset) {
+                break;
+            }
+            rva = section.virtualAddress +
+                static_cast<uint32_t>(start + *offset);
+            ++matchCount;
+            start += *offset + 1;
+        }
+    }
+    if (matchCount > 1) {
+        LOG_E("Signature matches more than once, refusing to hook");
+        return std::nullopt;
+    }
+    return rva;
+}
 
+void HkSetFieldOfView(void* instance, float value) noexcept try {
+    const auto startCycles = ReadCycles();
+    TRACE_THREAD_NAME("render");
+    TRACE_SCOPE("HkSetFieldOfView");
     std::lock_guard lock { mutex };
-    if (buffer.empty()) {
-        return "[]";
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto [result, isHookDone, isTargetApplied] =
+        fovOverride.Process(instance, value, now);
+    callCount.Add();
+    if (isTargetApplied) {
+        markerHitCount.Add();
+        appliedFov.store(result, std::memory_order_relaxed);
+        if (result != value) {
+            overrideCount.Add();
+        }
     }
+    if (isHookDone) {
+        TRACE_INSTANT("DisableHook");
+        hook->Disable();
+    }
+    if (isTargetApplied && pendingTarget) {
+        TRACE_INSTANT("TargetApplied");
+        auto& latency = InputLatency::GetInstance();
+        latency.Record(
+            InputLatency::Stage::TargetToFrame, pendingTarget->targetTime, now);
+        latency.Record(
+            InputLatency::Stage::InputToFrame, pendingTarget->inputTime, now);
+        pendingTarget.reset();
+    }
+
+    AddToTrace(now, instance, value);
+    AddToFramePacing(now, instance);
+
+    SelfOverhead::GetInstance().Counter(isTargetApplied ?
+        SelfOverhead::Site::FrameCall : SelfOverhead::Site::OtherCall
+    ).Add(ReadCycles() - startCycles);
+    hook->CallOriginal(instance, result);
+} catch (const std::exception& e) {
+    errorCount.Add();
+    LOG_E("Failed to hook set field of view: {}", e.what());
+}
 
-    ordered_json j = ordered_json::array();
-    const auto firstTime = std::get<0>(buffer.front());
-    while (!buffer.empty()) {
-        const auto [time, instance, value] = buffer.front();
-        const auto elapsed = sc::duration<double>(time - firstTime).count();
-        j.push_back({
-            { "time", elapsed },
-            { "instance", instance },
-            { "value", value }
-        });
-        buffer.pop();
+void SetTarget(const Unlocker::TimePoint inputTime) noexcept {
+    // Targets given while unhooked wait for the game to have focus, which
+    // is not latency
+    if (fovOverride.IsHooked()) {
+        pendingTarget = { std::chrono::steady_clock::now(), inputTime };
     }
-    return j.dump();
 }
-} // namespace
+
+void AddToTrace(
+    const std::chrono::steady_clock::time_point timePoint,
+    void* instance,
+    const float value) {
+#if ACTIVE_LEVEL < LEVEL_OFF
+    while (!trace.empty() && timePoint - trace.front().first >= TRACE_WINDOW) {
+        trace.pop_front();
+    }
+    trace.emplace_back(timePoint, CallSample {
+        0.0, reinterpret_cast<uintptr_t>(instance), value
+    });
 #endif
+}
+
+void AddToFramePacing(
+    [[maybe_unused]] const std::chrono::steady_clock::time_point timePoint,
+    [[maybe_unused]] void* instance) noexcept {
+#ifdef FRAME_PACING
+    framePacing.Record(instance, timePoint);
+#endif
+}
+} // namespace
@@ -0,0 +1,105 @@
+#include "utils/AsyncFileWriter.hpp"
+#include "utils/AtomicFile.hpp"
+#include "utils/Tracer.hpp"
+
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+constexpr auto NONE = std::chrono::steady_clock::time_point::max();
+} // namespace
+
+AsyncFileWriter::AsyncFileWriter(
+    std::filesystem::path filePath,
+    const std::chrono::milliseconds debounceDelay,
+    const std::chrono::milliseconds shutdownTimeout,
+    ErrorCallback onError)
+    : debounceDelay { debounceDelay }
+    , shutdownTimeout { shutdownTimeout }
+    , state { std::make_shared<State>() } {
+    state->filePath = std::move(filePath);
+    state->onError = std::move(onError);
+    thread = std::thread { [state = state] { Run(*state); } };
+}
+
+AsyncFileWriter::~AsyncFileWriter() noexcept {
+    std::unique_lock lock { state->mutex };
+    state->isStopping = true;
+    state->condition.notify_all();
+
+    // The thread is gone without a trace at process exit, so the pending
+    // contents are written here rather than handed to it
+    const bool isIdle = state->condition.wait_for(
+        lock, shutdownTimeout, [this] { return !state->isWriting; });
+    if (!isIdle) {
+        // Its callback may refer to the owner, which is going away
+        state->onError = {};
+        lock.unlock();
+        thread.detach();
+        return;
+    }
+
+    const bool isPending = state->deadline != NONE;
+    auto contents = std::move(state->pending);
+    state->deadline = NONE;
+    lock.unlock();
+
+    if (isPending) {
+        WriteNow(*state, std::move(contents));
+    }
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void AsyncFileWriter::Write(std::string contents) {
+    std::lock_guard lock { state->mutex };
+    state->pending = std::move(contents);
+    state->deadline = Clock::now() + debounceDelay;
+    state->condition.notify_all();
+}
+
+void AsyncFileWriter::Run(State& state) noexcept {
+    TRACE_THREAD_NAME("file writer");
+    std::unique_lock lock { state.mutex };
+    while (!state.isStopping) {
+        if (state.deadline == NONE) {
+            state.condition.wait(lock);
+            continue;
+        }
+        if (Clock::now() < state.deadline) {
+            state.condition.wait_until(lock, state.deadline);
+            continue;
+        }
+
+        auto contents = std::move(state.pending);
+        state.deadline = NONE;
+        state.isWriting = true;
+        lock.unlock();
+        WriteNow(state, std::move(contents));
+        lock.lock();
+        state.isWriting = false;
+        state.condition.notify_all();
+    }
+}
+
+void AsyncFileWriter::WriteNow(State& state, std::string contents) noexcept {
+    try {
+        WriteFileAtomic(state.filePath, contents);
+    } catch (const std::exception& e) {
+        std::lock_guard lock { state.mutex };
+        if (state.onError) {
+            try {
+                state.onError(e);
+            } catch (...) {
+                // Nothing left to report it to
+            }
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#include "utils/AtomicFile.hpp"
+#include "utils/Tracer.hpp"
+
+#include <cerrno>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+[[noreturn]] void ThrowLastError() {
+#ifdef _WIN32
+    const auto error = static_cast<int>(GetLastError());
+#else
+    const auto error = errno;
+#endif
+    throw std::system_error { error, std::system_category() };
+}
+
+std::filesystem::path GetTemporaryPath(const std::filesystem::path& filePath) {
+    auto temporaryPath = filePath;
+    temporaryPath += ".tmp";
+    return temporaryPath;
+}
+} // namespace
+
+#ifdef _WIN32
+void WriteFileAtomic(
+    const std::filesystem::path& filePath,
+    const std::string_view contents) {
+    TRACE_SCOPE("WriteFileAtomic");
+    const auto temporaryPath = GetTemporaryPath(filePath);
+    const HANDLE file = CreateFileW(
+        temporaryPath.c_str(), GENERIC_WRITE, 0, nullptr,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        ThrowLastError();
+    }
+
+    DWORD written {};
+    const bool isWritten =
+        WriteFile(file, contents.data(), static_cast<DWORD>(contents.size()),
+            &written, nullptr) &&
+        written == contents.size() &&
+        FlushFileBuffers(file);
+    const auto error = GetLastError();
+    CloseHandle(file);
+    if (!isWritten) {
+        DeleteFileW(temporaryPath.c_str());
+        SetLastError(error);
+        ThrowLastError();
+    }
+
+    if (!MoveFileExW(
+            temporaryPath.c_str(), filePath.c_str(),
+            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        const auto moveError = GetLastError();
+        DeleteFileW(temporaryPath.c_str());
+        SetLastError(moveError);
+        ThrowLastError();
+    }
+}
+#else
+void WriteFileAtomic(
+    const std::filesystem::path& filePath,
+    const std::string_view contents) {
+    TRACE_SCOPE("WriteFileAtomic");
+    const auto temporaryPath = GetTemporaryPath(filePath);
+    const int file = open(
+        temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (file < 0) {
+        ThrowLastError();
+    }
+
+    bool isWritten = true;
+    for (size_t offset = 0; isWritten && offset < contents.size();) {
+        const auto size = write(
+            file, contents.data() + offset, contents.size() - offset);
+        if (size < 0 && errno == EINTR) {
+            continue;
+        }
+        isWritten = size > 0;
+        offset += isWritten ? static_cast<size_t>(size) : 0;
+    }
+    isWritten = isWritten && fsync(file) == 0;
+    const auto error = errno;
+    close(file);
+    if (!isWritten) {
+        unlink(temporaryPath.c_str());
+        errno = error;
+        ThrowLastError();
+    }
+
+    if (rename(temporaryPath.c_str(), filePath.c_str()) != 0) {
+        const auto renameError = errno;
+        unlink(temporaryPath.c_str());
+        errno = renameError;
+        ThrowLastError();
+    }
+
+    // Makes the rename itself durable
+    auto directoryPath = filePath.parent_path();
+    if (directoryPath.empty()) {
+        directoryPath = ".";
+    }
+    if (const int directory = open(
+            directoryPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        directory >= 0) {
+        fsync(directory);
+        close(directory);
+    }
+}
+#endif
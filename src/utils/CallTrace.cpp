@@ -0,0 +1,109 @@
+#include "utils/CallTrace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// CSV: a "time,instance,value" header, then one call per line with the
+// time in seconds and the instance in hexadecimal
+// Binary: the magic, then packed little-endian records of a double time,
+// a uint64_t instance and a float value
+
+namespace {
+constexpr auto CSV_HEADER = "time,instance,value";
+constexpr std::array<char, 8> MAGIC { 'C', 'A', 'L', 'L', 'T', 'R', 'C', '1' };
+constexpr size_t RECORD_SIZE = sizeof(double) + sizeof(uint64_t) + sizeof(float);
+
+std::vector<CallSample> ReadCsv(std::istream& stream) {
+    std::vector<CallSample> samples {};
+    std::string line {};
+    while (std::getline(stream, line)) {
+        if (line.empty() || line.starts_with(CSV_HEADER)) {
+            continue;
+        }
+        std::ranges::replace(line, ',', ' ');
+        std::istringstream lineStream { line };
+        CallSample sample {};
+        lineStream >> sample.time >> std::hex >> sample.instance
+            >> std::dec >> sample.value;
+        if (!lineStream) {
+            throw std::runtime_error { "Malformed line: " + line };
+        }
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+std::vector<CallSample> ReadBinary(std::istream& stream) {
+    std::vector<CallSample> samples {};
+    std::array<char, RECORD_SIZE> record {};
+    while (stream.read(record.data(), record.size())) {
+        CallSample sample {};
+        auto data = record.data();
+        std::memcpy(&sample.time, data, sizeof(sample.time));
+        data += sizeof(sample.time);
+        std::memcpy(&sample.instance, data, sizeof(sample.instance));
+        data += sizeof(sample.instance);
+        std::memcpy(&sample.value, data, sizeof(sample.value));
+        samples.push_back(sample);
+    }
+    if (stream.gcount() != 0) {
+        throw std::runtime_error { "Truncated record" };
+    }
+    return samples;
+}
+} // namespace
+
+std::vector<CallSample> ReadCallTrace(const std::filesystem::path& filePath) {
+    std::ifstream file { filePath, std::ios::binary };
+    if (!file.is_open()) {
+        throw std::runtime_error { "Failed to open file" };
+    }
+
+    std::array<char, MAGIC.size()> magic {};
+    file.read(magic.data(), magic.size());
+    if (file && magic == MAGIC) {
+        return ReadBinary(file);
+    }
+    file.clear();
+    file.seekg(0);
+    return ReadCsv(file);
+}
+
+void WriteCallTrace(
+    const std::filesystem::path& filePath,
+    const std::span<const CallSample> samples,
+    const CallTraceFormat format) {
+    std::ofstream file { filePath, std::ios::binary };
+    if (!file.is_open()) {
+        throw std::runtime_error { "Failed to open file" };
+    }
+
+    if (format == CallTraceFormat::Binary) {
+        file.write(MAGIC.data(), MAGIC.size());
+        for (const auto& [time, instance, value] : samples) {
+            file.write(reinterpret_cast<const char*>(&time), sizeof(time));
+            file.write(reinterpret_cast<const char*>(&instance), sizeof(instance));
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    } else {
+        file << CSV_HEADER << '\n';
+        file.precision(9);
+        for (const auto& [time, instance, value] : samples) {
+            file << time << ',' << std::hex << instance << std::dec
+                << ',' << value << '\n';
+        }
+    }
+    if (!file) {
+        throw std::runtime_error { "Failed to write file" };
+    }
+}
@@ -0,0 +1,96 @@
+#include "utils/CycleCounter.hpp"
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+constexpr size_t SHARED_INDEX = CycleCounter::MAX_THREADS - 1;
+static_assert(CycleCounter::MAX_THREADS <= 64);
+
+// Bit of each index held by a live thread, for every counter. Threads give
+// theirs back on exit, so threads coming and going do not use up the slots.
+constinit std::atomic<uint64_t> usedIndices { 0 };
+
+// Threads taking a freed index see the last counts of the thread that gave
+// it back, and carry on from them
+size_t AcquireIndex() noexcept {
+    auto used = usedIndices.load(std::memory_order_relaxed);
+    while (true) {
+        const auto index = static_cast<size_t>(std::countr_one(used));
+        if (index >= SHARED_INDEX) {
+            return SHARED_INDEX;
+        }
+        if (usedIndices.compare_exchange_weak(
+                used, used | uint64_t { 1 } << index,
+                std::memory_order_acquire, std::memory_order_relaxed)) {
+            return index;
+        }
+    }
+}
+
+void ReleaseIndex(const size_t index) noexcept {
+    if (index < SHARED_INDEX) {
+        usedIndices.fetch_and(
+            ~(uint64_t { 1 } << index), std::memory_order_release);
+    }
+}
+
+struct ThreadIndex {
+    const size_t index { AcquireIndex() };
+
+    ~ThreadIndex() noexcept {
+        ReleaseIndex(index);
+    }
+};
+
+// Assigned on the first count of each thread
+size_t CurrentThreadIndex() noexcept {
+    thread_local const ThreadIndex threadIndex {};
+    return threadIndex.index;
+}
+} // namespace
+
+CycleCalibration::CycleCalibration() noexcept
+    : startCycles { ReadCycles() }
+    , startTime { std::chrono::steady_clock::now() } {}
+
+double CycleCalibration::NanosecondsPerCycle() const noexcept {
+    const auto cycles = ReadCycles() - startCycles;
+    const auto nanoseconds = std::chrono::duration<double, std::nano>(
+        Elapsed()).count();
+    return cycles == 0 ? 1.0 : nanoseconds / static_cast<double>(cycles);
+}
+
+std::chrono::steady_clock::duration CycleCalibration::Elapsed() const noexcept {
+    return std::chrono::steady_clock::now() - startTime;
+}
+
+void CycleCounter::Add(const uint64_t cycles) noexcept {
+    const size_t index = CurrentThreadIndex();
+    if (index == SHARED_INDEX) {
+        auto& [calls, total] = slots.back();
+        calls.fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(cycles, std::memory_order_relaxed);
+        return;
+    }
+
+    // Atomic only so that reads from other threads are not races
+    auto& [calls, total] = slots[index];
+    calls.store(
+        calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    total.store(
+        total.load(std::memory_order_relaxed) + cycles,
+        std::memory_order_relaxed);
+}
+
+CycleCounter::Totals CycleCounter::Read() const noexcept {
+    Totals totals { 0, 0 };
+    for (const auto& [calls, cycles] : slots) {
+        totals.calls += calls.load(std::memory_order_relaxed);
+        totals.cycles += cycles.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
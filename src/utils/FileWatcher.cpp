@@ -0,0 +1,65 @@
+#include "utils/FileWatcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <thread>
+#include <utility>
+
+using WaitResult = details::FileWatcherBackend::WaitResult;
+
+FileWatcher::FileWatcher(
+    const std::filesystem::path& filePath,
+    const std::chrono::milliseconds debounceDelay,
+    Callback callback)
+    : debounceDelay { debounceDelay }
+    , callback { std::move(callback) }
+    , backend { filePath }
+    , thread { [this] { Run(); } } {}
+
+FileWatcher::~FileWatcher() noexcept {
+    backend.Stop();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void FileWatcher::Run() noexcept {
+    using Clock = std::chrono::steady_clock;
+
+    // Every change pushes the deadline back, so the callback only runs once
+    // the file has been quiet for the whole delay
+    constexpr auto NONE = Clock::time_point::max();
+    auto deadline = NONE;
+    while (true) {
+        std::optional<std::chrono::milliseconds> timeout {};
+        if (deadline != NONE) {
+            timeout = std::max(
+                std::chrono::ceil<std::chrono::milliseconds>(
+                    deadline - Clock::now()),
+                std::chrono::milliseconds::zero());
+        }
+
+        switch (backend.Wait(timeout)) {
+            case WaitResult::Changed: {
+                deadline = Clock::now() + debounceDelay;
+                break;
+            }
+            case WaitResult::Timeout: {
+                if (deadline != NONE && Clock::now() >= deadline) {
+                    deadline = NONE;
+                    try {
+                        callback();
+                    } catch (...) {
+                        // Keep watching, the next change may succeed
+                    }
+                }
+                break;
+            }
+            case WaitResult::Stopped: {
+                return;
+            }
+        }
+    }
+}
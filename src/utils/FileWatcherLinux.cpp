@@ -0,0 +1,126 @@
+#include "utils/FileWatcher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace details {
+namespace {
+constexpr uint32_t WATCH_MASK =
+    IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_DELETE;
+
+[[noreturn]] void ThrowErrno() {
+    throw std::system_error { errno, std::generic_category() };
+}
+} // namespace
+
+struct FileWatcherBackend::State {
+    int inotifyFd;
+    int stopFd;
+    std::string fileName;
+
+    ~State() noexcept {
+        if (inotifyFd >= 0) {
+            close(inotifyFd);
+        }
+        if (stopFd >= 0) {
+            close(stopFd);
+        }
+    }
+
+    // Drains pending notifications and reports whether any was for the file
+    [[nodiscard]] bool ReadEvents() const noexcept {
+        alignas(inotify_event) std::array<char, 4096> buffer {};
+        bool isChanged = false;
+        while (true) {
+            const auto size = read(inotifyFd, buffer.data(), buffer.size());
+            if (size <= 0) {
+                return isChanged;
+            }
+            for (ssize_t offset = 0; offset < size;) {
+                const auto event = reinterpret_cast<const inotify_event*>(
+                    buffer.data() + offset);
+                if (event->len > 0 && fileName == event->name) {
+                    isChanged = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+    }
+};
+
+FileWatcherBackend::FileWatcherBackend(const std::filesystem::path& filePath)
+    : state { std::make_unique<State>(-1, -1, filePath.filename().string()) } {
+    auto directory = filePath.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    state->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (state->inotifyFd < 0) {
+        ThrowErrno();
+    }
+    if (inotify_add_watch(
+            state->inotifyFd, directory.c_str(), WATCH_MASK) < 0) {
+        ThrowErrno();
+    }
+    state->stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (state->stopFd < 0) {
+        ThrowErrno();
+    }
+}
+
+FileWatcherBackend::~FileWatcherBackend() noexcept = default;
+
+FileWatcherBackend::WaitResult FileWatcherBackend::Wait(
+    const std::optional<std::chrono::milliseconds> timeout) noexcept {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = timeout ?
+        Clock::now() + *timeout : Clock::time_point::max();
+
+    std::array<pollfd, 2> fds {{
+        { state->stopFd, POLLIN, 0 },
+        { state->inotifyFd, POLLIN, 0 }
+    }};
+    while (true) {
+        int pollTimeout = -1;
+        if (timeout) {
+            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - Clock::now());
+            pollTimeout = static_cast<int>(std::max(remaining.count(), 0L));
+        }
+
+        const int count = poll(fds.data(), fds.size(), pollTimeout);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0 || fds[0].revents != 0) {
+            return WaitResult::Stopped;
+        }
+        if (count == 0) {
+            return WaitResult::Timeout;
+        }
+        // Notifications for other files in the directory keep waiting
+        if (state->ReadEvents()) {
+            return WaitResult::Changed;
+        }
+    }
+}
+
+void FileWatcherBackend::Stop() noexcept {
+    const uint64_t value = 1;
+    [[maybe_unused]] const auto size = write(state->stopFd, &value, sizeof(value));
+}
+} // namespace details
@@ -0,0 +1,159 @@
+#include "utils/FileWatcher.hpp"
+#include "utils/Windows.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <Windows.h>
+
+namespace details {
+namespace {
+constexpr DWORD NOTIFY_FILTER =
+    FILE_NOTIFY_CHANGE_FILE_NAME |
+    FILE_NOTIFY_CHANGE_LAST_WRITE |
+    FILE_NOTIFY_CHANGE_SIZE;
+} // namespace
+
+struct FileWatcherBackend::State {
+    HANDLE directory;
+    HANDLE changeEvent;
+    HANDLE stopEvent;
+    std::wstring fileName;
+    OVERLAPPED overlapped;
+    bool isPending;
+    alignas(DWORD) std::array<std::byte, 4096> buffer;
+
+    ~State() noexcept {
+        // The pending read writes into the buffer until it is cancelled
+        if (isPending) {
+            CancelIoEx(directory, &overlapped);
+            DWORD size {};
+            GetOverlappedResult(directory, &overlapped, &size, TRUE);
+        }
+        if (directory != INVALID_HANDLE_VALUE) {
+            CloseHandle(directory);
+        }
+        if (changeEvent) {
+            CloseHandle(changeEvent);
+        }
+        if (stopEvent) {
+            CloseHandle(stopEvent);
+        }
+    }
+
+    void Queue() {
+        overlapped = {};
+        overlapped.hEvent = changeEvent;
+        ThrowOnSystemError(ReadDirectoryChangesW(
+            directory, buffer.data(), static_cast<DWORD>(buffer.size()),
+            FALSE, NOTIFY_FILTER, nullptr, &overlapped, nullptr
+        ));
+        isPending = true;
+    }
+
+    // Reports whether any completed notification was for the file. An
+    // overflowed buffer loses the names, so it counts as a change.
+    [[nodiscard]] bool ReadEvents() noexcept {
+        isPending = false;
+        DWORD size {};
+        if (!GetOverlappedResult(directory, &overlapped, &size, FALSE)) {
+            return false;
+        }
+        if (size == 0) {
+            return true;
+        }
+
+        for (size_t offset = 0;;) {
+            const auto info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(
+                buffer.data() + offset);
+            const std::wstring_view name {
+                info->FileName, info->FileNameLength / sizeof(WCHAR)
+            };
+            if (CompareStringOrdinal(
+                    name.data(), static_cast<int>(name.size()),
+                    fileName.data(), static_cast<int>(fileName.size()),
+                    TRUE) == CSTR_EQUAL) {
+                return true;
+            }
+            if (info->NextEntryOffset == 0) {
+                return false;
+            }
+            offset += info->NextEntryOffset;
+        }
+    }
+};
+
+FileWatcherBackend::FileWatcherBackend(const std::filesystem::path& filePath)
+    : state { std::make_unique<State>(
+        INVALID_HANDLE_VALUE, nullptr, nullptr,
+        filePath.filename().wstring()) } {
+    auto directory = filePath.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    state->directory = CreateFileW(
+        directory.c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+        OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+        nullptr);
+    ThrowOnSystemError(state->directory != INVALID_HANDLE_VALUE);
+    ThrowOnSystemError(
+        state->changeEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr));
+    ThrowOnSystemError(
+        state->stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr));
+    state->Queue();
+}
+
+FileWatcherBackend::~FileWatcherBackend() noexcept = default;
+
+FileWatcherBackend::WaitResult FileWatcherBackend::Wait(
+    const std::optional<std::chrono::milliseconds> timeout) noexcept {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = timeout ?
+        Clock::now() + *timeout : Clock::time_point::max();
+
+    const std::array handles { state->stopEvent, state->changeEvent };
+    while (true) {
+        DWORD waitTimeout = INFINITE;
+        if (timeout) {
+            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - Clock::now());
+            waitTimeout = static_cast<DWORD>(
+                std::max(remaining.count(), decltype(remaining.count()) { 0 }));
+        }
+
+        const auto result = WaitForMultipleObjects(
+            static_cast<DWORD>(handles.size()), handles.data(),
+            FALSE, waitTimeout);
+        if (result == WAIT_TIMEOUT) {
+            return WaitResult::Timeout;
+        }
+        if (result != WAIT_OBJECT_0 + 1) {
+            return WaitResult::Stopped;
+        }
+
+        const bool isChanged = state->ReadEvents();
+        try {
+            state->Queue();
+        } catch (...) {
+            return WaitResult::Stopped;
+        }
+        // Notifications for other files in the directory keep waiting
+        if (isChanged) {
+            return WaitResult::Changed;
+        }
+    }
+}
+
+void FileWatcherBackend::Stop() noexcept {
+    SetEvent(state->stopEvent);
+}
+} // namespace details
@@ -0,0 +1,147 @@
+#include "utils/Histogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+Histogram::Histogram() noexcept {
+    Reset();
+}
+
+void Histogram::Record(const uint64_t value) noexcept {
+    counts[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+void Histogram::RecordExclusive(const uint64_t value) noexcept {
+    auto& count = counts[BucketIndex(value)];
+    count.store(
+        count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum.store(
+        sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void Histogram::Reset() noexcept {
+    for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    sum.store(0, std::memory_order_relaxed);
+}
+
+HistogramSnapshot Histogram::Snapshot() const {
+    HistogramSnapshot snapshot {};
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        const auto count = counts[i].load(std::memory_order_relaxed);
+        snapshot.counts[i] = count;
+        snapshot.count += count;
+    }
+    snapshot.sum = sum.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+// Values below the sub-bucket count have a bucket each. Above, a value with
+// its highest bit at position e lands in row e - SUB_BUCKET_BITS + 1, at the
+// column given by the SUB_BUCKET_BITS bits below the highest one.
+size_t Histogram::BucketIndex(const uint64_t value) noexcept {
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    const int exponent = std::bit_width(value) - 1;
+    const int shift = exponent - SUB_BUCKET_BITS;
+    const auto column = (value >> shift) & (SUB_BUCKET_COUNT - 1);
+    return static_cast<size_t>(shift + 1) * SUB_BUCKET_COUNT +
+        static_cast<size_t>(column);
+}
+
+uint64_t Histogram::BucketLowerBound(const size_t index) noexcept {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const size_t row = index / SUB_BUCKET_COUNT;
+    const size_t column = index % SUB_BUCKET_COUNT;
+    return (SUB_BUCKET_COUNT + column) << (row - 1);
+}
+
+uint64_t Histogram::BucketUpperBound(const size_t index) noexcept {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const size_t row = index / SUB_BUCKET_COUNT;
+    return BucketLowerBound(index) + ((uint64_t { 1 } << (row - 1)) - 1);
+}
+
+HistogramSnapshot::HistogramSnapshot()
+    : counts(Histogram::BUCKET_COUNT)
+    , count { 0 }
+    , sum { 0 } {}
+
+uint64_t HistogramSnapshot::Count() const noexcept {
+    return count;
+}
+
+uint64_t HistogramSnapshot::Sum() const noexcept {
+    return sum;
+}
+
+double HistogramSnapshot::Mean() const noexcept {
+    return count == 0 ? 0.0 :
+        static_cast<double>(sum) / static_cast<double>(count);
+}
+
+uint64_t HistogramSnapshot::Min() const noexcept {
+    const auto it = std::ranges::find_if(
+        counts, [](const uint64_t bucket) { return bucket != 0; });
+    if (it == counts.end()) {
+        return 0;
+    }
+    return Histogram::BucketUpperBound(
+        static_cast<size_t>(it - counts.begin()));
+}
+
+uint64_t HistogramSnapshot::Max() const noexcept {
+    return Percentile(100.0);
+}
+
+uint64_t HistogramSnapshot::Percentile(const double percentile) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    // Rank of the value, counting from one
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(
+        std::clamp(percentile, 0.0, 100.0) / 100.0 *
+        static_cast<double>(count))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return Histogram::BucketUpperBound(i);
+        }
+    }
+    return Histogram::BucketUpperBound(counts.size() - 1);
+}
+
+HistogramSnapshot& HistogramSnapshot::operator+=(
+    const HistogramSnapshot& other) noexcept {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sum += other.sum;
+    return *this;
+}
+
+HistogramSnapshot& HistogramSnapshot::operator-=(
+    const HistogramSnapshot& other) noexcept {
+    // Clamped, as counts are read one by one while being recorded
+    count = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] -= std::min(counts[i], other.counts[i]);
+        count += counts[i];
+    }
+    sum -= std::min(sum, other.sum);
+    return *this;
+}
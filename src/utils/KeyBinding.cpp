@@ -0,0 +1,244 @@
+#include "utils/KeyBinding.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+// Windows virtual-key codes, kept here so the bindings stay portable. The
+// low-level hook reports left and right modifiers apart, so only those have
+// names as keys.
+constexpr uint8_t VK_0 = 0x30;
+constexpr uint8_t VK_A = 0x41;
+constexpr uint8_t VK_NUMPAD0 = 0x60;
+constexpr uint8_t VK_F1 = 0x70;
+constexpr int FUNCTION_KEY_COUNT = 24;
+
+constexpr std::array KEY_NAMES {
+    std::pair { uint8_t { 0x08 }, std::string_view { "Backspace" } },
+    std::pair { uint8_t { 0x09 }, std::string_view { "Tab" } },
+    std::pair { uint8_t { 0x0D }, std::string_view { "Enter" } },
+    std::pair { uint8_t { 0x13 }, std::string_view { "Pause" } },
+    std::pair { uint8_t { 0x14 }, std::string_view { "CapsLock" } },
+    std::pair { uint8_t { 0x1B }, std::string_view { "Escape" } },
+    std::pair { uint8_t { 0x20 }, std::string_view { "Space" } },
+    std::pair { uint8_t { 0x21 }, std::string_view { "PageUp" } },
+    std::pair { uint8_t { 0x22 }, std::string_view { "PageDown" } },
+    std::pair { uint8_t { 0x23 }, std::string_view { "End" } },
+    std::pair { uint8_t { 0x24 }, std::string_view { "Home" } },
+    std::pair { uint8_t { 0x25 }, std::string_view { "Left" } },
+    std::pair { uint8_t { 0x26 }, std::string_view { "Up" } },
+    std::pair { uint8_t { 0x27 }, std::string_view { "Right" } },
+    std::pair { uint8_t { 0x28 }, std::string_view { "Down" } },
+    std::pair { uint8_t { 0x2C }, std::string_view { "PrintScreen" } },
+    std::pair { uint8_t { 0x2D }, std::string_view { "Insert" } },
+    std::pair { uint8_t { 0x2E }, std::string_view { "Delete" } },
+    std::pair { uint8_t { 0x5B }, std::string_view { "LWin" } },
+    std::pair { uint8_t { 0x5C }, std::string_view { "RWin" } },
+    std::pair { uint8_t { 0x6A }, std::string_view { "Multiply" } },
+    std::pair { uint8_t { 0x6B }, std::string_view { "Add" } },
+    std::pair { uint8_t { 0x6D }, std::string_view { "Subtract" } },
+    std::pair { uint8_t { 0x6E }, std::string_view { "Decimal" } },
+    std::pair { uint8_t { 0x6F }, std::string_view { "Divide" } },
+    std::pair { uint8_t { 0x90 }, std::string_view { "NumLock" } },
+    std::pair { uint8_t { 0x91 }, std::string_view { "ScrollLock" } },
+    std::pair { uint8_t { 0xA0 }, std::string_view { "LShift" } },
+    std::pair { uint8_t { 0xA1 }, std::string_view { "RShift" } },
+    std::pair { uint8_t { 0xA2 }, std::string_view { "LCtrl" } },
+    std::pair { uint8_t { 0xA3 }, std::string_view { "RCtrl" } },
+    std::pair { uint8_t { 0xA4 }, std::string_view { "LAlt" } },
+    std::pair { uint8_t { 0xA5 }, std::string_view { "RAlt" } }
+};
+
+constexpr std::array MODIFIER_NAMES {
+    std::pair { KeyModifiers::Ctrl, std::string_view { "Ctrl" } },
+    std::pair { KeyModifiers::Shift, std::string_view { "Shift" } },
+    std::pair { KeyModifiers::Alt, std::string_view { "Alt" } },
+    std::pair { KeyModifiers::Win, std::string_view { "Win" } }
+};
+
+constexpr std::array PRESS_PREFIXES {
+    std::pair { KeyPress::Tap, std::string_view { "tap:" } },
+    std::pair { KeyPress::Hold, std::string_view { "hold:" } }
+};
+
+bool IsEqualIgnoringCase(
+    const std::string_view lhs,
+    const std::string_view rhs) noexcept {
+    return std::ranges::equal(lhs, rhs, [](const char a, const char b) {
+        return std::tolower(static_cast<unsigned char>(a)) ==
+            std::tolower(static_cast<unsigned char>(b));
+    });
+}
+
+std::optional<uint8_t> ParseNumber(const std::string_view text) noexcept {
+    const bool isHex = text.starts_with("0x") || text.starts_with("0X");
+    const auto digits = isHex ? text.substr(2) : text;
+    int value {};
+    const auto [end, error] = std::from_chars(
+        digits.data(), digits.data() + digits.size(), value, isHex ? 16 : 10);
+    if (digits.empty() || error != std::errc {} ||
+        end != digits.data() + digits.size() || value <= 0 || value >= 255) {
+        return std::nullopt;
+    }
+    return static_cast<uint8_t>(value);
+}
+
+// Names and numbers in the same forms as formatted below
+std::optional<uint8_t> ParseKey(const std::string_view name) noexcept {
+    if (name.size() == 1) {
+        const auto c = static_cast<char>(
+            std::toupper(static_cast<unsigned char>(name[0])));
+        if ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z')) {
+            return static_cast<uint8_t>(c);
+        }
+    }
+    for (const auto& [vKey, keyName] : KEY_NAMES) {
+        if (IsEqualIgnoringCase(name, keyName)) {
+            return vKey;
+        }
+    }
+
+    const auto parseIndexed = [name](
+        const std::string_view prefix, const int count) noexcept {
+        int index {};
+        if (name.size() <= prefix.size() ||
+            !IsEqualIgnoringCase(name.substr(0, prefix.size()), prefix)) {
+            return -1;
+        }
+        const auto digits = name.substr(prefix.size());
+        const auto [end, error] = std::from_chars(
+            digits.data(), digits.data() + digits.size(), index);
+        if (error != std::errc {} || end != digits.data() + digits.size() ||
+            (digits.front() == '0' && digits.size() > 1)) {
+            return -1;
+        }
+        return index < count ? index : -1;
+    };
+    if (const int index = parseIndexed("Numpad", 10); index >= 0) {
+        return static_cast<uint8_t>(VK_NUMPAD0 + index);
+    }
+    if (const int index = parseIndexed("F", FUNCTION_KEY_COUNT + 1);
+        index >= 1) {
+        return static_cast<uint8_t>(VK_F1 + index - 1);
+    }
+    return ParseNumber(name);
+}
+
+std::string FormatKey(const uint8_t vKey) {
+    if ((vKey >= VK_0 && vKey <= VK_0 + 9) ||
+        (vKey >= VK_A && vKey < VK_A + 26)) {
+        return std::string(1, static_cast<char>(vKey));
+    }
+    if (vKey >= VK_NUMPAD0 && vKey < VK_NUMPAD0 + 10) {
+        return "Numpad" + std::to_string(vKey - VK_NUMPAD0);
+    }
+    if (vKey >= VK_F1 && vKey < VK_F1 + FUNCTION_KEY_COUNT) {
+        return "F" + std::to_string(vKey - VK_F1 + 1);
+    }
+    for (const auto& [keyVKey, keyName] : KEY_NAMES) {
+        if (vKey == keyVKey) {
+            return std::string { keyName };
+        }
+    }
+
+    constexpr auto HEX = "0123456789ABCDEF";
+    return std::string { "0x" } + HEX[vKey >> 4] + HEX[vKey & 0xF];
+}
+
+KeyChord ParseChord(std::string_view text) {
+    KeyChord chord { 0, KeyModifiers::None };
+    for (auto separator = text.find('+');
+         separator != std::string_view::npos;
+         separator = text.find('+')) {
+        const auto name = text.substr(0, separator);
+        const auto it = std::ranges::find_if(MODIFIER_NAMES,
+            [name](const auto& modifier) {
+                return IsEqualIgnoringCase(name, modifier.second);
+            });
+        if (it == MODIFIER_NAMES.end()) {
+            throw std::invalid_argument {
+                "Unknown modifier '" + std::string { name } + "'" };
+        }
+        chord.modifiers = chord.modifiers | it->first;
+        text.remove_prefix(separator + 1);
+    }
+
+    const auto vKey = ParseKey(text);
+    if (!vKey) {
+        throw std::invalid_argument {
+            "Unknown key '" + std::string { text } + "'" };
+    }
+    chord.vKey = *vKey;
+    return chord;
+}
+} // namespace
+
+KeyModifiers GetKeyModifier(const uint8_t vKey) noexcept {
+    switch (vKey) {
+        case 0x11: case 0xA2: case 0xA3: return KeyModifiers::Ctrl;
+        case 0x10: case 0xA0: case 0xA1: return KeyModifiers::Shift;
+        case 0x12: case 0xA4: case 0xA5: return KeyModifiers::Alt;
+        case 0x5B: case 0x5C: return KeyModifiers::Win;
+        default: return KeyModifiers::None;
+    }
+}
+
+KeyBinding MakeKeyBinding(const uint8_t vKey) {
+    return { { { vKey, KeyModifiers::None } }, KeyPress::Down };
+}
+
+KeyBinding ParseKeyBinding(std::string_view text) {
+    KeyBinding binding { {}, KeyPress::Down };
+    for (const auto& [press, prefix] : PRESS_PREFIXES) {
+        if (text.size() >= prefix.size() &&
+            IsEqualIgnoringCase(text.substr(0, prefix.size()), prefix)) {
+            binding.press = press;
+            text.remove_prefix(prefix.size());
+            break;
+        }
+    }
+
+    while (!text.empty()) {
+        const auto end = std::min(text.find(' '), text.size());
+        if (end > 0) {
+            binding.sequence.push_back(ParseChord(text.substr(0, end)));
+        }
+        text.remove_prefix(std::min(end + 1, text.size()));
+    }
+    if (binding.sequence.empty()) {
+        throw std::invalid_argument { "Empty key binding" };
+    }
+    return binding;
+}
+
+std::string FormatKeyBinding(const KeyBinding& binding) {
+    std::string text {};
+    for (const auto& [press, prefix] : PRESS_PREFIXES) {
+        if (binding.press == press) {
+            text += prefix;
+        }
+    }
+    for (const auto& [vKey, modifiers] : binding.sequence) {
+        if (&vKey != &binding.sequence.front().vKey) {
+            text += ' ';
+        }
+        for (const auto& [modifier, name] : MODIFIER_NAMES) {
+            if ((modifiers & modifier) != KeyModifiers::None) {
+                text += name;
+                text += '+';
+            }
+        }
+        text += FormatKey(vKey);
+    }
+    return text;
+}
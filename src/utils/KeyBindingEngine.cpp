@@ -0,0 +1,243 @@
+#include "utils/KeyBindingEngine.hpp"
+#include "utils/KeyBinding.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+// States of the trie the table is flattened from
+struct Node {
+    std::vector<std::pair<KeyChord, uint16_t>> children;
+    std::array<uint16_t, 3> actions;
+};
+
+size_t ModifierIndex(const KeyModifiers modifier) noexcept {
+    return static_cast<size_t>(
+        std::countr_zero(static_cast<unsigned>(modifier)));
+}
+} // namespace
+
+KeyBindingEngine::KeyBindingEngine()
+    : KeyBindingEngine { std::span<const KeyBinding> {} } {}
+
+KeyBindingEngine::KeyBindingEngine(
+    const std::span<const KeyBinding> bindings,
+    const std::chrono::milliseconds holdDelay,
+    const std::chrono::milliseconds sequenceTimeout)
+    : holdDelay { holdDelay }
+    , sequenceTimeout { sequenceTimeout }
+    , edgeEnds {}
+    , edges {}
+    , actions {}
+    , state { ROOT }
+    , stepTime {}
+    , keysDown {}
+    , modifierKeyCounts {}
+    , modifiers { KeyModifiers::None }
+    , pendingState { NONE }
+    , pendingKey { 0 }
+    , pendingTime {} {
+    constexpr std::array<uint16_t, 3> NO_ACTIONS { NONE, NONE, NONE };
+    std::vector<Node> nodes { Node { {}, NO_ACTIONS } };
+
+    for (size_t i = 0; i < bindings.size(); ++i) {
+        const auto& [sequence, press] = bindings[i];
+        const auto name = "'" + FormatKeyBinding(bindings[i]) + "'";
+        if (sequence.empty()) {
+            throw std::invalid_argument { "Empty key binding" };
+        }
+
+        uint16_t node = ROOT;
+        for (const auto& chord : sequence) {
+            auto& children = nodes[node].children;
+            const auto it = std::ranges::find(
+                children, chord, &std::pair<KeyChord, uint16_t>::first);
+            if (it != children.end()) {
+                node = it->second;
+                continue;
+            }
+            if (nodes.size() == NONE) {
+                throw std::invalid_argument { "Too many key bindings" };
+            }
+            const auto child = static_cast<uint16_t>(nodes.size());
+            children.emplace_back(chord, child);
+            nodes.push_back({ {}, NO_ACTIONS });
+            node = child;
+        }
+
+        auto& nodeActions = nodes[node].actions;
+        auto& action = nodeActions[static_cast<size_t>(press)];
+        if (action != NONE) {
+            throw std::invalid_argument { name + " is bound twice" };
+        }
+        action = static_cast<uint16_t>(i);
+    }
+
+    // A state either continues sequences or ends them, and a key pressed
+    // down cannot also wait for its release
+    for (const auto& [children, nodeActions] : nodes) {
+        const auto hasAction = std::ranges::any_of(
+            nodeActions, [](const uint16_t action) { return action != NONE; });
+        if (!hasAction) {
+            continue;
+        }
+        const auto name = "'" + FormatKeyBinding(bindings[
+            *std::ranges::find_if(nodeActions, [](const uint16_t action) {
+                return action != NONE;
+            })]) + "'";
+        if (!children.empty()) {
+            throw std::invalid_argument {
+                name + " is the start of another binding" };
+        }
+        if (nodeActions[static_cast<size_t>(KeyPress::Down)] != NONE &&
+            (nodeActions[static_cast<size_t>(KeyPress::Tap)] != NONE ||
+             nodeActions[static_cast<size_t>(KeyPress::Hold)] != NONE)) {
+            throw std::invalid_argument {
+                name + " is bound both on press and on tap or hold" };
+        }
+    }
+
+    edgeEnds.resize(nodes.size() * KEY_COUNT);
+    actions.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto& [children, nodeActions] = nodes[i];
+        std::ranges::sort(children, {}, [](const auto& child) {
+            return child.first.vKey;
+        });
+        auto it = children.begin();
+        for (size_t vKey = 0; vKey < KEY_COUNT; ++vKey) {
+            for (; it != children.end() && it->first.vKey == vKey; ++it) {
+                edges.push_back({ it->first.modifiers, it->second });
+            }
+            edgeEnds[i * KEY_COUNT + vKey] = static_cast<uint32_t>(edges.size());
+        }
+        actions.push_back(nodeActions);
+    }
+}
+
+std::optional<size_t> KeyBindingEngine::OnKeyDown(
+    const uint8_t vKey,
+    const TimePoint time) noexcept {
+    // Modifiers only modify other keys
+    const auto chordModifiers = modifiers & ~GetKeyModifier(vKey);
+    SetKeyDown(vKey, true);
+
+    if (state != ROOT && time - stepTime > sequenceTimeout) {
+        state = ROOT;
+    }
+    auto next = Find(state, vKey, chordModifiers);
+    if (next == NONE && state != ROOT) {
+        next = Find(ROOT, vKey, chordModifiers);
+    }
+    if (next == NONE) {
+        // Pressing a modifier for the next chord keeps the sequence going
+        if (GetKeyModifier(vKey) == KeyModifiers::None) {
+            state = ROOT;
+        }
+        return std::nullopt;
+    }
+
+    state = next;
+    stepTime = time;
+    const auto& [down, tap, hold] = actions[next];
+    if (down == NONE && tap == NONE && hold == NONE) {
+        return std::nullopt;
+    }
+
+    state = ROOT;
+    if (down != NONE) {
+        return down;
+    }
+    pendingState = next;
+    pendingKey = vKey;
+    pendingTime = time;
+    return std::nullopt;
+}
+
+std::optional<size_t> KeyBindingEngine::OnKeyHold(
+    const uint8_t vKey,
+    const TimePoint time) noexcept {
+    if (pendingState == NONE || vKey != pendingKey ||
+        time - pendingTime < holdDelay) {
+        return std::nullopt;
+    }
+    const auto hold = actions[pendingState][static_cast<size_t>(KeyPress::Hold)];
+    if (hold == NONE) {
+        return std::nullopt;
+    }
+    pendingState = NONE;
+    return hold;
+}
+
+std::optional<size_t> KeyBindingEngine::OnKeyUp(
+    const uint8_t vKey,
+    const TimePoint time) noexcept {
+    SetKeyDown(vKey, false);
+    if (pendingState == NONE || vKey != pendingKey) {
+        return std::nullopt;
+    }
+
+    // Holds also trigger here when the key does not auto-repeat
+    const auto press = time - pendingTime < holdDelay ?
+        KeyPress::Tap : KeyPress::Hold;
+    const auto action = actions[pendingState][static_cast<size_t>(press)];
+    pendingState = NONE;
+    if (action == NONE) {
+        return std::nullopt;
+    }
+    return action;
+}
+
+void KeyBindingEngine::Reset() noexcept {
+    state = ROOT;
+    pendingState = NONE;
+}
+
+uint16_t KeyBindingEngine::Find(
+    const uint16_t state,
+    const uint8_t vKey,
+    const KeyModifiers modifiers) const noexcept {
+    const size_t row = state * KEY_COUNT + vKey;
+    const size_t begin = row == 0 ? 0 : edgeEnds[row - 1];
+    const size_t end = edgeEnds[row];
+
+    // Chords without modifiers also match while unbound modifiers are held,
+    // as keys did before chords existed
+    uint16_t fallback = NONE;
+    for (size_t i = begin; i < end; ++i) {
+        if (edges[i].modifiers == modifiers) {
+            return edges[i].next;
+        }
+        if (edges[i].modifiers == KeyModifiers::None) {
+            fallback = edges[i].next;
+        }
+    }
+    return fallback;
+}
+
+void KeyBindingEngine::SetKeyDown(
+    const uint8_t vKey,
+    const bool isDown) noexcept {
+    if (keysDown.test(vKey) == isDown) {
+        return;
+    }
+    keysDown.set(vKey, isDown);
+
+    const auto modifier = GetKeyModifier(vKey);
+    if (modifier == KeyModifiers::None) {
+        return;
+    }
+    auto& count = modifierKeyCounts[ModifierIndex(modifier)];
+    isDown ? ++count : --count;
+    modifiers = count > 0 ?
+        modifiers | modifier : modifiers & ~modifier;
+}
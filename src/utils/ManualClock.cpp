@@ -0,0 +1,19 @@
+#include "utils/ManualClock.hpp"
+
+#include <atomic>
+
+namespace {
+std::atomic<ManualClock::rep> ticks { 0 };
+} // namespace
+
+ManualClock::time_point ManualClock::now() noexcept {
+    return time_point { duration { ticks.load(std::memory_order_relaxed) } };
+}
+
+void ManualClock::Set(const time_point value) noexcept {
+    ticks.store(value.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void ManualClock::Advance(const duration value) noexcept {
+    ticks.fetch_add(value.count(), std::memory_order_relaxed);
+}
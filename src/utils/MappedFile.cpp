@@ -0,0 +1,122 @@
+#include "utils/MappedFile.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <system_error>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+[[noreturn]] void ThrowLastError() {
+#ifdef _WIN32
+    const auto error = static_cast<int>(GetLastError());
+#else
+    const auto error = errno;
+#endif
+    throw std::system_error { error, std::system_category() };
+}
+} // namespace
+
+// The file and mapping handles are closed as soon as the view exists, since
+// the view alone keeps the mapping alive
+#ifdef _WIN32
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+    : data { nullptr }
+    , size { 0 } {
+    const HANDLE file = CreateFileW(
+        filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        ThrowLastError();
+    }
+
+    LARGE_INTEGER fileSize {};
+    if (!GetFileSizeEx(file, &fileSize)) {
+        const auto error = GetLastError();
+        CloseHandle(file);
+        SetLastError(error);
+        ThrowLastError();
+    }
+    if (fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    const HANDLE mapping = CreateFileMappingW(
+        file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const auto mappingError = GetLastError();
+    CloseHandle(file);
+    if (!mapping) {
+        SetLastError(mappingError);
+        ThrowLastError();
+    }
+
+    const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    const auto viewError = GetLastError();
+    CloseHandle(mapping);
+    if (!view) {
+        SetLastError(viewError);
+        ThrowLastError();
+    }
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+}
+
+MappedFile::~MappedFile() noexcept {
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+}
+#else
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+    : data { nullptr }
+    , size { 0 } {
+    const int file = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        ThrowLastError();
+    }
+
+    struct stat status {};
+    if (fstat(file, &status) != 0) {
+        const auto error = errno;
+        close(file);
+        errno = error;
+        ThrowLastError();
+    }
+    if (status.st_size == 0) {
+        close(file);
+        return;
+    }
+
+    const auto fileSize = static_cast<size_t>(status.st_size);
+    const auto view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+    const auto error = errno;
+    close(file);
+    if (view == MAP_FAILED) {
+        errno = error;
+        ThrowLastError();
+    }
+    data = static_cast<const uint8_t*>(view);
+    size = fileSize;
+}
+
+MappedFile::~MappedFile() noexcept {
+    if (data) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+}
+#endif
+
+std::span<const uint8_t> MappedFile::Data() const noexcept {
+    return { data, size };
+}
@@ -0,0 +1,147 @@
+#include "utils/Metrics.hpp"
+#include "utils/Histogram.hpp"
+#include "utils/json/JsonWriter.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+constexpr std::array<std::pair<std::string_view, double>, 4> PERCENTILES {{
+    { "p50", 50.0 }, { "p90", 90.0 }, { "p99", 99.0 }, { "max", 100.0 }
+}};
+} // namespace
+
+void MetricCounter::Add(const uint64_t value) noexcept {
+    this->value.fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t MetricCounter::Value() const noexcept {
+    return value.load(std::memory_order_relaxed);
+}
+
+void MetricGauge::Set(const int64_t value) noexcept {
+    this->value.store(value, std::memory_order_relaxed);
+}
+
+void MetricGauge::Add(const int64_t value) noexcept {
+    this->value.fetch_add(value, std::memory_order_relaxed);
+}
+
+int64_t MetricGauge::Value() const noexcept {
+    return value.load(std::memory_order_relaxed);
+}
+
+MetricsRegistry& MetricsRegistry::GetInstance() {
+    static MetricsRegistry instance {};
+    return instance;
+}
+
+MetricCounter& MetricsRegistry::RegisterCounter(const std::string_view name) {
+    return Register(counters, name);
+}
+
+MetricGauge& MetricsRegistry::RegisterGauge(const std::string_view name) {
+    return Register(gauges, name);
+}
+
+Histogram& MetricsRegistry::RegisterHistogram(const std::string_view name) {
+    return Register(histograms, name);
+}
+
+std::string MetricsRegistry::ToText() const {
+    std::lock_guard lock { mutex };
+    std::string text {};
+    for (const auto& [name, counter] : counters) {
+        text += name + ' ' + std::to_string(counter->Value()) + '\n';
+    }
+    for (const auto& [name, gauge] : gauges) {
+        text += name + ' ' + std::to_string(gauge->Value()) + '\n';
+    }
+    for (const auto& [name, histogram] : histograms) {
+        const auto snapshot = histogram->Snapshot();
+        text += name + " count=" + std::to_string(snapshot.Count()) +
+            " mean=" + std::to_string(snapshot.Mean());
+        for (const auto& [key, percentile] : PERCENTILES) {
+            text += ' ';
+            text += key;
+            text += '=' + std::to_string(snapshot.Percentile(percentile));
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+std::string MetricsRegistry::ToJson(const int indent) const {
+    std::lock_guard lock { mutex };
+    JsonWriter writer { indent };
+    writer.BeginObject();
+
+    writer.Key("counters");
+    writer.BeginObject();
+    for (const auto& [name, counter] : counters) {
+        writer.Key(name);
+        writer.Unsigned(counter->Value());
+    }
+    writer.EndObject();
+
+    writer.Key("gauges");
+    writer.BeginObject();
+    for (const auto& [name, gauge] : gauges) {
+        writer.Key(name);
+        writer.Integer(gauge->Value());
+    }
+    writer.EndObject();
+
+    writer.Key("histograms");
+    writer.BeginObject();
+    for (const auto& [name, histogram] : histograms) {
+        const auto snapshot = histogram->Snapshot();
+        writer.Key(name);
+        writer.BeginObject();
+        writer.Key("count");
+        writer.Unsigned(snapshot.Count());
+        writer.Key("sum");
+        writer.Unsigned(snapshot.Sum());
+        writer.Key("mean");
+        writer.Number(snapshot.Mean());
+        for (const auto& [key, percentile] : PERCENTILES) {
+            writer.Key(key);
+            writer.Unsigned(snapshot.Percentile(percentile));
+        }
+        writer.EndObject();
+    }
+    writer.EndObject();
+
+    writer.EndObject();
+    return writer.Output();
+}
+
+template <typename Metric>
+Metric& MetricsRegistry::Register(
+    Metrics<Metric>& metrics, const std::string_view name) {
+    std::lock_guard lock { mutex };
+    if (const auto it = metrics.find(name); it != metrics.end()) {
+        return *it->second;
+    }
+    if (IsRegistered(name)) {
+        throw std::invalid_argument {
+            "Metric '" + std::string { name } + "' is of another kind"
+        };
+    }
+    auto metric = std::make_unique<Metric>();
+    auto& result = *metric;
+    metrics.emplace(std::string { name }, std::move(metric));
+    return result;
+}
+
+bool MetricsRegistry::IsRegistered(const std::string_view name) const noexcept {
+    return counters.contains(name) || gauges.contains(name) ||
+        histograms.contains(name);
+}
@@ -1,72 +1,189 @@
 #include "utils/MinHook.hpp"
+#include "utils/HookEngine.hpp"
 
-#include <MinHook.h>
-
-#include <format>
+#include <memory>
+#include <optional>
+#include <ranges>
 #include <stdexcept>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+namespace {
 struct Status {
-    bool isCreated;
     bool isEnabled;
+
+    // Requested state while a transaction is open
+    std::optional<bool> pending;
 };
 
-bool isInitialized = false;
-std::unordered_map<void*, Status> hooks;
+struct State {
+    std::unique_ptr<IHookEngine> engine;
+    std::unordered_map<void*, Status> hooks;
+    bool isInTransaction;
+};
+
+// Never destroyed, like MinHook's own state, so hooks with static storage
+// duration can still be removed during exit
+State& GetState() noexcept {
+    static const auto state = new State {};
+    return *state;
+}
+
+IHookEngine& GetEngine() {
+    if (const auto& engine = GetState().engine) {
+        return *engine;
+    }
+    throw std::runtime_error { "Backend not initialized" };
+}
+
+Status& GetStatus(void* target) {
+    auto& hooks = GetState().hooks;
+    if (const auto it = hooks.find(target); it != hooks.end()) {
+        return it->second;
+    }
+    throw std::runtime_error { "Hook not created" };
+}
 
-void CheckStatus(const MH_STATUS status) {
-    if (status == MH_OK) {
+void SetEnabled(void* target, const bool enable) {
+    auto& status = GetStatus(target);
+    if (GetState().isInTransaction) {
+        status.pending = enable;
         return;
     }
-    throw std::runtime_error(std::format(
-        "MinHook failed with status {}",
-        MH_StatusToString(status)
-    ));
+    const HookChange change { target, enable };
+    GetEngine().Apply({ &change, 1 });
+    status.isEnabled = enable;
+}
+} // namespace
+
+void SetHookEngine(std::unique_ptr<IHookEngine> engine) {
+    auto& state = GetState();
+    if (!state.hooks.empty()) {
+        throw std::runtime_error { "Hooks are still created" };
+    }
+    state.engine = std::move(engine);
 }
 
 size_t details::MinHookBackend::Count() noexcept {
-    return hooks.size();
+    return GetState().hooks.size();
 }
 
 bool details::MinHookBackend::IsInitialized() noexcept {
-    return isInitialized;
+    return GetState().engine != nullptr;
 }
 
 void details::MinHookBackend::Initialize() {
-    CheckStatus(MH_Initialize());
-    isInitialized = true;
+    if (IsInitialized()) {
+        throw std::runtime_error { "Backend already initialized" };
+    }
+    GetState().engine = CreateHookEngine();
 }
 
 void details::MinHookBackend::Uninitialize() {
-    CheckStatus(MH_Uninitialize());
-    isInitialized = false;
+    auto& [engine, hooks, isInTransaction] = GetState();
+    if (!engine) {
+        throw std::runtime_error { "Backend not initialized" };
+    }
+    for (const auto& target : hooks | std::views::keys) {
+        engine->Remove(target);
+    }
     hooks.clear();
+    isInTransaction = false;
+    engine.reset();
 }
 
 bool details::MinHookBackend::IsCreated(void* target) noexcept {
-    return hooks.contains(target) && hooks[target].isCreated;
+    return GetState().hooks.contains(target);
 }
 
 void details::MinHookBackend::Create(void* target, void* detour, void** original) {
-    CheckStatus(MH_CreateHook(target, detour, original));
-    hooks[target].isCreated = true;
+    if (IsCreated(target)) {
+        throw std::runtime_error { "Hook already created" };
+    }
+    GetEngine().Create(target, detour, original);
+    GetState().hooks.emplace(target, Status { false, std::nullopt });
 }
 
 void details::MinHookBackend::Remove(void* target) {
-    CheckStatus(MH_RemoveHook(target));
-    hooks.erase(target);
+    GetEngine().Remove(target);
+    GetState().hooks.erase(target);
 }
 
 bool details::MinHookBackend::IsEnabled(void* target) noexcept {
-    return hooks.contains(target) && hooks[target].isEnabled;
+    const auto& hooks = GetState().hooks;
+    const auto it = hooks.find(target);
+    return it != hooks.end() &&
+        it->second.pending.value_or(it->second.isEnabled);
 }
 
 void details::MinHookBackend::Enable(void* target) {
-    CheckStatus(MH_EnableHook(target));
-    hooks[target].isEnabled = true;
+    SetEnabled(target, true);
 }
 
 void details::MinHookBackend::Disable(void* target) {
-    CheckStatus(MH_DisableHook(target));
-    hooks[target].isEnabled = false;
+    SetEnabled(target, false);
+}
+
+void details::MinHookBackend::BeginTransaction() {
+    auto& state = GetState();
+    if (state.isInTransaction) {
+        throw std::runtime_error { "Transaction already open" };
+    }
+    state.isInTransaction = true;
+}
+
+void details::MinHookBackend::CommitTransaction() {
+    auto& [engine, hooks, isInTransaction] = GetState();
+    if (!isInTransaction) {
+        throw std::runtime_error { "No transaction open" };
+    }
+
+    std::vector<HookChange> changes {};
+    for (const auto& [target, status] : hooks) {
+        if (status.pending && *status.pending != status.isEnabled) {
+            changes.push_back({ target, *status.pending });
+        }
+    }
+    if (!changes.empty()) {
+        try {
+            engine->Apply(changes);
+        } catch (...) {
+            AbortTransaction();
+            throw;
+        }
+    }
+    for (auto& status : hooks | std::views::values) {
+        status.isEnabled = status.pending.value_or(status.isEnabled);
+        status.pending.reset();
+    }
+    isInTransaction = false;
+}
+
+void details::MinHookBackend::AbortTransaction() noexcept {
+    auto& state = GetState();
+    for (auto& status : state.hooks | std::views::values) {
+        status.pending.reset();
+    }
+    state.isInTransaction = false;
+}
+
+HookTransaction::HookTransaction()
+    : isOpen { false } {
+    BeginTransaction();
+    isOpen = true;
+}
+
+HookTransaction::~HookTransaction() noexcept {
+    if (isOpen) {
+        AbortTransaction();
+    }
+}
+
+void HookTransaction::Commit() {
+    if (!isOpen) {
+        throw std::runtime_error { "Transaction already committed" };
+    }
+    isOpen = false;
+    CommitTransaction();
 }
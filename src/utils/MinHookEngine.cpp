@@ -0,0 +1,98 @@
+#include "utils/HookEngine.hpp"
+
+#include <MinHook.h>
+
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+void CheckStatus(const MH_STATUS status) {
+    if (status == MH_OK) {
+        return;
+    }
+    throw std::runtime_error(std::format(
+        "MinHook failed with status {}",
+        MH_StatusToString(status)
+    ));
+}
+
+class MinHookEngine final : public IHookEngine {
+public:
+    MinHookEngine();
+    ~MinHookEngine() noexcept override;
+
+    void Create(void* target, void* detour, void** original) override;
+    void Remove(void* target) override;
+    void Apply(std::span<const HookChange> changes) override;
+
+private:
+    // Whether each created hook is enabled, to take back queued changes
+    std::unordered_map<void*, bool> hooks;
+};
+
+MinHookEngine::MinHookEngine()
+    : hooks {} {
+    CheckStatus(MH_Initialize());
+}
+
+MinHookEngine::~MinHookEngine() noexcept {
+    MH_Uninitialize();
+}
+
+void MinHookEngine::Create(void* target, void* detour, void** original) {
+    CheckStatus(MH_CreateHook(target, detour, original));
+    hooks.insert_or_assign(target, false);
+}
+
+void MinHookEngine::Remove(void* target) {
+    CheckStatus(MH_RemoveHook(target));
+    hooks.erase(target);
+}
+
+// MinHook suspends the other threads once per MH_ApplyQueued. Its queue
+// outlives a failed Apply, so the changes queued by then are taken back
+// rather than left for the next one to apply.
+void MinHookEngine::Apply(const std::span<const HookChange> changes) {
+    for (const auto [target, enable] : changes) {
+        if (!hooks.contains(target)) {
+            throw std::runtime_error { "Hook not created" };
+        }
+    }
+
+    size_t queuedCount = 0;
+    bool isQueued = false;
+    try {
+        for (const auto [target, enable] : changes) {
+            CheckStatus(enable ?
+                MH_QueueEnableHook(target) : MH_QueueDisableHook(target));
+            ++queuedCount;
+        }
+        isQueued = true;
+        CheckStatus(MH_ApplyQueued());
+    } catch (...) {
+        for (const auto [target, enable] : changes.first(queuedCount)) {
+            if (hooks.at(target)) {
+                MH_QueueEnableHook(target);
+            } else {
+                MH_QueueDisableHook(target);
+            }
+        }
+        // Undoes the changes applied before the one that failed
+        if (isQueued) {
+            MH_ApplyQueued();
+        }
+        throw;
+    }
+    for (const auto [target, enable] : changes) {
+        hooks.at(target) = enable;
+    }
+}
+} // namespace
+
+std::unique_ptr<IHookEngine> CreateHookEngine() {
+    return std::make_unique<MinHookEngine>();
+}
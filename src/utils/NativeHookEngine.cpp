@@ -0,0 +1,112 @@
+#include "utils/HookEngine.hpp"
+#include "utils/hook/InlineHook.hpp"
+#include "utils/hook/Memory.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+class NativeHookEngine final : public IHookEngine {
+public:
+    ~NativeHookEngine() noexcept override;
+
+    void Create(void* target, void* detour, void** original) override;
+    void Remove(void* target) override;
+    void Apply(std::span<const HookChange> changes) override;
+
+private:
+    [[nodiscard]] hook::InlineHook* Find(void* target) const noexcept;
+    [[nodiscard]] hook::InlineHook& Get(void* target) const;
+
+    std::vector<std::unique_ptr<hook::InlineHook>> hooks;
+};
+
+NativeHookEngine::~NativeHookEngine() noexcept {
+    std::vector<HookChange> changes {};
+    for (const auto& hook : hooks) {
+        if (hook->IsEnabled()) {
+            changes.push_back({ hook->Target(), false });
+        }
+    }
+    try {
+        Apply(changes);
+    } catch (...) {
+        // Leak the hooks since their targets may still jump into them
+        for (auto& hook : hooks) {
+            static_cast<void>(hook.release());
+        }
+    }
+}
+
+void NativeHookEngine::Create(void* target, void* detour, void** original) {
+    if (Find(target)) {
+        throw std::runtime_error { "Hook already created" };
+    }
+    auto hook = std::make_unique<hook::InlineHook>(target, detour);
+    *original = hook->Trampoline();
+    hooks.push_back(std::move(hook));
+}
+
+void NativeHookEngine::Remove(void* target) {
+    if (Get(target).IsEnabled()) {
+        const HookChange change { target, false };
+        Apply({ &change, 1 });
+    }
+    std::erase_if(hooks, [target](const auto& hook) {
+        return hook->Target() == target;
+    });
+}
+
+// Threads suspended inside the patched bytes are moved to the equivalent
+// instruction so they never resume in the middle of the new jump
+void NativeHookEngine::Apply(const std::span<const HookChange> changes) {
+    if (changes.empty()) {
+        return;
+    }
+
+    std::vector<hook::InlineHook*> enabled {};
+    std::vector<hook::InlineHook*> disabled {};
+    for (const auto [target, enable] : changes) {
+        (enable ? enabled : disabled).push_back(&Get(target));
+    }
+
+    hook::ThreadFreezer freezer {};
+    for (const auto hook : enabled) {
+        hook->Enable();
+    }
+    for (const auto hook : disabled) {
+        hook->Disable();
+    }
+    freezer.RedirectInstructionPointers([&](uintptr_t ip) {
+        for (const auto hook : enabled) {
+            ip = hook->ToTrampoline(ip);
+        }
+        for (const auto hook : disabled) {
+            ip = hook->FromTrampoline(ip);
+        }
+        return ip;
+    });
+}
+
+hook::InlineHook* NativeHookEngine::Find(void* target) const noexcept {
+    const auto it = std::ranges::find_if(hooks, [target](const auto& hook) {
+        return hook->Target() == target;
+    });
+    return it != hooks.end() ? it->get() : nullptr;
+}
+
+hook::InlineHook& NativeHookEngine::Get(void* target) const {
+    if (const auto hook = Find(target)) {
+        return *hook;
+    }
+    throw std::runtime_error { "Hook not created" };
+}
+} // namespace
+
+std::unique_ptr<IHookEngine> CreateHookEngine() {
+    return std::make_unique<NativeHookEngine>();
+}
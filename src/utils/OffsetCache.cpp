@@ -0,0 +1,113 @@
+#include "utils/OffsetCache.hpp"
+#include "utils/AtomicFile.hpp"
+#include "utils/PeImage.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace {
+// FNV-1a
+constexpr uint64_t HASH_OFFSET_BASIS = 0xCBF29CE484222325;
+constexpr uint64_t HASH_PRIME = 0x00000100000001B3;
+
+template <typename T>
+void Hash(uint64_t& hash, const T& value) noexcept {
+    const auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        hash = (hash ^ bytes[i]) * HASH_PRIME;
+    }
+}
+} // namespace
+
+ModuleFingerprint GetModuleFingerprint(const PeImage& image) noexcept {
+    uint64_t hash = HASH_OFFSET_BASIS;
+    for (const auto& section : image.Sections()) {
+        for (const char c : section.name) {
+            Hash(hash, c);
+        }
+        Hash(hash, section.virtualAddress);
+        Hash(hash, section.virtualSize);
+        Hash(hash, section.rawDataSize);
+        Hash(hash, section.characteristics);
+    }
+    return {
+        .timeDateStamp = image.TimeDateStamp(),
+        .sizeOfImage = image.SizeOfImage(),
+        .sectionHash = hash
+    };
+}
+
+OffsetCache::OffsetCache(std::filesystem::path filePath) noexcept
+    : filePath { std::move(filePath) } {}
+
+OffsetCache::~OffsetCache() noexcept = default;
+
+// One entry per line: name, time date stamp, image size, section hash and
+// RVA, with all numbers in hexadecimal
+void OffsetCache::Read() {
+    entries.clear();
+    std::ifstream file { filePath };
+    if (!file.is_open()) {
+        if (!std::filesystem::exists(filePath)) {
+            return;
+        }
+        throw std::runtime_error { "Failed to open file" };
+    }
+
+    std::string line {};
+    while (std::getline(file, line)) {
+        std::istringstream stream { line };
+        Entry entry {};
+        auto& [name, fingerprint, rva] = entry;
+        stream >> name >> std::hex >> fingerprint.timeDateStamp
+            >> fingerprint.sizeOfImage >> fingerprint.sectionHash >> rva;
+        if (stream) {
+            entries.push_back(std::move(entry));
+        }
+    }
+}
+
+// Replaced atomically so that a crash mid-write never leaves a cache that
+// another launch reads as fewer or truncated entries
+void OffsetCache::Write() const {
+    std::ostringstream stream {};
+    stream << std::hex;
+    for (const auto& [name, fingerprint, rva] : entries) {
+        stream << name << ' ' << fingerprint.timeDateStamp << ' '
+            << fingerprint.sizeOfImage << ' ' << fingerprint.sectionHash
+            << ' ' << rva << '\n';
+    }
+    WriteFileAtomic(filePath, stream.view());
+}
+
+std::optional<uint32_t> OffsetCache::Get(
+    const std::string_view name,
+    const ModuleFingerprint& fingerprint) const noexcept {
+    const auto it = std::ranges::find_if(entries, [&](const Entry& entry) {
+        return entry.name == name && entry.fingerprint == fingerprint;
+    });
+    return it != entries.end() ? std::optional { it->rva } : std::nullopt;
+}
+
+void OffsetCache::Set(
+    const std::string_view name,
+    const ModuleFingerprint& fingerprint,
+    const uint32_t rva) {
+    if (name.empty() || name.find_first_of(" \t\r\n") != name.npos) {
+        throw std::invalid_argument { "Name must be a non-empty word" };
+    }
+    // Entries of previous builds are never hit again after a patch
+    std::erase_if(entries, [name](const Entry& entry) {
+        return entry.name == name;
+    });
+    entries.push_back({ std::string { name }, fingerprint, rva });
+}
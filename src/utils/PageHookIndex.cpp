@@ -0,0 +1,149 @@
+#include "utils/PageHookIndex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define INITIAL_EXEC_TLS [[gnu::tls_model("initial-exec")]]
+#else
+    #define INITIAL_EXEC_TLS
+#endif
+
+namespace {
+// Zero is never a hooked page since the null page cannot be mapped. Initial
+// exec storage is reserved when the thread starts, so the first access from
+// a signal handler never allocates.
+INITIAL_EXEC_TLS thread_local uintptr_t pendingPage = 0;
+} // namespace
+
+PageHookIndex::PageHookIndex(const size_t pageSize) noexcept
+    : pageSize { pageSize }
+    , current { nullptr }
+    , snapshots {} {}
+
+PageHookIndex::~PageHookIndex() noexcept = default;
+
+size_t PageHookIndex::PageSize() const noexcept {
+    return pageSize;
+}
+
+uintptr_t PageHookIndex::PageOf(const void* address) const noexcept {
+    return reinterpret_cast<uintptr_t>(address) & ~(pageSize - 1);
+}
+
+size_t PageHookIndex::Size() const noexcept {
+    const auto snapshot = current.load(std::memory_order_acquire);
+    return snapshot ? snapshot->size : 0;
+}
+
+std::vector<uintptr_t> PageHookIndex::Pages() const {
+    std::vector<uintptr_t> addresses {};
+    const auto snapshot = current.load(std::memory_order_acquire);
+    if (!snapshot) {
+        return addresses;
+    }
+    addresses.reserve(snapshot->pages.size());
+    for (const auto& page : snapshot->pages) {
+        addresses.push_back(page.address);
+    }
+    return addresses;
+}
+
+bool PageHookIndex::Contains(const void* target) const noexcept {
+    return FindDetour(target) != nullptr;
+}
+
+bool PageHookIndex::IsHookedPage(const void* address) const noexcept {
+    const auto snapshot = current.load(std::memory_order_acquire);
+    return snapshot && FindPage(*snapshot, PageOf(address)) != nullptr;
+}
+
+void* PageHookIndex::FindDetour(const void* address) const noexcept {
+    const auto snapshot = current.load(std::memory_order_acquire);
+    if (!snapshot) {
+        return nullptr;
+    }
+    const auto page = FindPage(*snapshot, PageOf(address));
+    if (!page) {
+        return nullptr;
+    }
+    const auto it = std::ranges::find(page->hooks, address, &Hook::target);
+    return it != page->hooks.end() ? it->detour : nullptr;
+}
+
+void PageHookIndex::Insert(void* target, void* detour) {
+    if (!target || !detour) {
+        throw std::invalid_argument { "Target and detour must be non-null" };
+    }
+    if (Contains(target)) {
+        throw std::invalid_argument { "Hook already created" };
+    }
+
+    const auto previous = current.load(std::memory_order_relaxed);
+    auto snapshot = previous ?
+        std::make_unique<Snapshot>(*previous) : std::make_unique<Snapshot>();
+    auto& pages = snapshot->pages;
+    const auto address = PageOf(target);
+    auto it = std::ranges::lower_bound(pages, address, {}, &Page::address);
+    if (it == pages.end() || it->address != address) {
+        it = pages.insert(it, Page { address, {} });
+    }
+    it->hooks.push_back({ target, detour });
+    ++snapshot->size;
+    Publish(std::move(snapshot));
+}
+
+bool PageHookIndex::Erase(const void* target) {
+    const auto previous = current.load(std::memory_order_relaxed);
+    if (!previous || !Contains(target)) {
+        return false;
+    }
+
+    auto snapshot = std::make_unique<Snapshot>(*previous);
+    auto& pages = snapshot->pages;
+    const auto it = std::ranges::lower_bound(
+        pages, PageOf(target), {}, &Page::address);
+    std::erase_if(it->hooks, [target](const Hook& hook) {
+        return hook.target == target;
+    });
+    --snapshot->size;
+    const bool isEmpty = it->hooks.empty();
+    if (isEmpty) {
+        pages.erase(it);
+    }
+    Publish(std::move(snapshot));
+    return isEmpty;
+}
+
+void PageHookIndex::Clear() noexcept {
+    current.store(nullptr, std::memory_order_release);
+    snapshots.clear();
+}
+
+void PageHookIndex::SetPendingPage(const uintptr_t page) noexcept {
+    pendingPage = page;
+}
+
+std::optional<uintptr_t> PageHookIndex::TakePendingPage() noexcept {
+    if (pendingPage == 0) {
+        return std::nullopt;
+    }
+    return std::exchange(pendingPage, 0);
+}
+
+const PageHookIndex::Page* PageHookIndex::FindPage(
+    const Snapshot& snapshot, const uintptr_t address) const noexcept {
+    const auto& pages = snapshot.pages;
+    const auto it = std::ranges::lower_bound(pages, address, {}, &Page::address);
+    return it != pages.end() && it->address == address ? &*it : nullptr;
+}
+
+// The old snapshot stays alive for lookups that loaded it before the swap
+void PageHookIndex::Publish(std::unique_ptr<Snapshot> snapshot) {
+    snapshots.reserve(snapshots.size() + 1);
+    current.store(snapshot.get(), std::memory_order_release);
+    snapshots.push_back(std::move(snapshot));
+}
@@ -0,0 +1,256 @@
+#include "utils/PeImage.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace {
+constexpr uint16_t DOS_SIGNATURE = 0x5A4D; // MZ
+constexpr uint32_t NT_SIGNATURE = 0x00004550; // PE\0\0
+constexpr uint16_t PE32_MAGIC = 0x010B;
+constexpr uint16_t PE32_PLUS_MAGIC = 0x020B;
+constexpr uint32_t SCN_CNT_CODE = 0x00000020;
+constexpr uint32_t SCN_MEM_EXECUTE = 0x20000000;
+
+constexpr size_t DOS_LFANEW_OFFSET = 0x3C;
+constexpr size_t FILE_HEADER_SIZE = 20;
+constexpr size_t SECTION_HEADER_SIZE = 40;
+constexpr size_t SECTION_NAME_SIZE = 8;
+constexpr size_t EXPORT_DIRECTORY_SIZE = 40;
+
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+T Read(const std::span<const uint8_t> data, const size_t offset) {
+    if (offset > data.size() || data.size() - offset < sizeof(T)) {
+        throw std::runtime_error { "Truncated PE image" };
+    }
+    T value {};
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+std::string_view ReadString(
+    const std::span<const uint8_t> data, const size_t offset,
+    const size_t maxSize) noexcept {
+    if (offset >= data.size()) {
+        return {};
+    }
+    const auto begin = reinterpret_cast<const char*>(data.data() + offset);
+    const auto size = std::min(maxSize, data.size() - offset);
+    return { begin, static_cast<size_t>(
+        std::find(begin, begin + size, '\0') - begin) };
+}
+} // namespace
+
+bool PeImage::Section::IsExecutable() const noexcept {
+    return characteristics & (SCN_CNT_CODE | SCN_MEM_EXECUTE);
+}
+
+PeImage::PeImage(const std::span<const uint8_t> data, const Layout layout)
+    : data { data }
+    , layout { layout }
+    , timeDateStamp { 0 }
+    , sizeOfImage { 0 }
+    , sizeOfHeaders { 0 }
+    , exportDirectoryRva { 0 }
+    , exportDirectorySize { 0 } {
+    if (Read<uint16_t>(data, 0) != DOS_SIGNATURE) {
+        throw std::runtime_error { "Invalid DOS signature" };
+    }
+    const size_t ntHeaders = Read<uint32_t>(data, DOS_LFANEW_OFFSET);
+    if (Read<uint32_t>(data, ntHeaders) != NT_SIGNATURE) {
+        throw std::runtime_error { "Invalid NT signature" };
+    }
+
+    const size_t fileHeader = ntHeaders + sizeof(uint32_t);
+    const auto numberOfSections = Read<uint16_t>(data, fileHeader + 2);
+    timeDateStamp = Read<uint32_t>(data, fileHeader + 4);
+    const auto sizeOfOptionalHeader = Read<uint16_t>(data, fileHeader + 16);
+
+    const size_t optionalHeader = fileHeader + FILE_HEADER_SIZE;
+    size_t dataDirectories {};
+    size_t numberOfRvaAndSizes {};
+    switch (Read<uint16_t>(data, optionalHeader)) {
+        case PE32_MAGIC: {
+            numberOfRvaAndSizes = Read<uint32_t>(data, optionalHeader + 92);
+            dataDirectories = optionalHeader + 96;
+            break;
+        }
+        case PE32_PLUS_MAGIC: {
+            numberOfRvaAndSizes = Read<uint32_t>(data, optionalHeader + 108);
+            dataDirectories = optionalHeader + 112;
+            break;
+        }
+        default: {
+            throw std::runtime_error { "Invalid optional header magic" };
+        }
+    }
+    sizeOfImage = Read<uint32_t>(data, optionalHeader + 56);
+    sizeOfHeaders = Read<uint32_t>(data, optionalHeader + 60);
+    if (numberOfRvaAndSizes > 0) {
+        exportDirectoryRva = Read<uint32_t>(data, dataDirectories);
+        exportDirectorySize = Read<uint32_t>(data, dataDirectories + 4);
+    }
+
+    const size_t sectionTable = optionalHeader + sizeOfOptionalHeader;
+    sections.reserve(numberOfSections);
+    for (size_t i = 0; i < numberOfSections; ++i) {
+        const size_t header = sectionTable + i * SECTION_HEADER_SIZE;
+        sections.push_back({
+            .name = ReadString(data, header, SECTION_NAME_SIZE),
+            .virtualAddress = Read<uint32_t>(data, header + 12),
+            .virtualSize = Read<uint32_t>(data, header + 8),
+            .rawDataOffset = Read<uint32_t>(data, header + 20),
+            .rawDataSize = Read<uint32_t>(data, header + 16),
+            .characteristics = Read<uint32_t>(data, header + 36)
+        });
+    }
+}
+
+PeImage::~PeImage() noexcept = default;
+
+std::span<const uint8_t> PeImage::Data() const noexcept {
+    return data;
+}
+
+std::span<const uint8_t> PeImage::Headers() const noexcept {
+    return data.first(std::min<size_t>(sizeOfHeaders, data.size()));
+}
+
+uint32_t PeImage::TimeDateStamp() const noexcept {
+    return timeDateStamp;
+}
+
+uint32_t PeImage::SizeOfImage() const noexcept {
+    return sizeOfImage;
+}
+
+std::span<const PeImage::Section> PeImage::Sections() const noexcept {
+    return sections;
+}
+
+std::span<const uint8_t> PeImage::SectionData(
+    const Section& section) const noexcept {
+    size_t offset {};
+    size_t size {};
+    if (layout == Layout::Image) {
+        offset = section.virtualAddress;
+        size = section.virtualSize ?
+            section.virtualSize : section.rawDataSize;
+    } else {
+        offset = section.rawDataOffset;
+        size = section.virtualSize ?
+            std::min(section.virtualSize, section.rawDataSize) :
+            section.rawDataSize;
+    }
+    if (offset >= data.size()) {
+        return {};
+    }
+    return data.subspan(offset, std::min(size, data.size() - offset));
+}
+
+std::optional<size_t> PeImage::RvaToOffset(const uint32_t rva) const noexcept {
+    if (layout == Layout::Image || rva < sizeOfHeaders) {
+        return rva < data.size() ? std::optional<size_t> { rva } : std::nullopt;
+    }
+    for (const auto& section : sections) {
+        const auto size = std::max(section.virtualSize, section.rawDataSize);
+        if (rva < section.virtualAddress ||
+            rva - section.virtualAddress >= size) {
+            continue;
+        }
+        const size_t delta = rva - section.virtualAddress;
+        if (delta >= section.rawDataSize) {
+            return std::nullopt;
+        }
+        const size_t offset = section.rawDataOffset + delta;
+        return offset < data.size() ?
+            std::optional<size_t> { offset } : std::nullopt;
+    }
+    return std::nullopt;
+}
+
+std::vector<PeImage::Export> PeImage::Exports() const {
+    std::vector<Export> exports {};
+    if (!exportDirectoryRva || exportDirectorySize < EXPORT_DIRECTORY_SIZE) {
+        return exports;
+    }
+
+    const auto offset = [this](const uint32_t rva) {
+        if (const auto offset = RvaToOffset(rva)) {
+            return *offset;
+        }
+        throw std::runtime_error { "Export data outside of image" };
+    };
+
+    const auto directory = offset(exportDirectoryRva);
+    const auto numberOfFunctions = Read<uint32_t>(data, directory + 20);
+    const auto numberOfNames = Read<uint32_t>(data, directory + 24);
+    const auto addressOfFunctions = Read<uint32_t>(data, directory + 28);
+    const auto addressOfNames = Read<uint32_t>(data, directory + 32);
+    const auto addressOfNameOrdinals = Read<uint32_t>(data, directory + 36);
+    if (!numberOfNames) {
+        return exports;
+    }
+
+    const auto functions = offset(addressOfFunctions);
+    const auto names = offset(addressOfNames);
+    const auto ordinals = offset(addressOfNameOrdinals);
+    exports.reserve(numberOfNames);
+    for (size_t i = 0; i < numberOfNames; ++i) {
+        const auto nameRva = Read<uint32_t>(data, names + i * 4);
+        const auto ordinal = Read<uint16_t>(data, ordinals + i * 2);
+        if (ordinal >= numberOfFunctions) {
+            continue;
+        }
+        exports.push_back({
+            .name = ReadString(data, offset(nameRva), data.size()),
+            .rva = Read<uint32_t>(data, functions + ordinal * 4)
+        });
+    }
+    return exports;
+}
+
+std::optional<uint32_t> PeImage::FindExport(const std::string_view name) const {
+    for (const auto& entry : Exports()) {
+        if (entry.name == name) {
+            return entry.rva;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<uint32_t> PeImage::FindTypeDescriptor(
+    const std::string_view decoratedName) const noexcept {
+    // x64 type descriptors are laid out as { vftable, spare, name[] }
+    constexpr uint32_t NAME_OFFSET = 2 * sizeof(uint64_t);
+
+    for (const auto& section : sections) {
+        if (section.IsExecutable()) {
+            continue;
+        }
+        const auto sectionData = SectionData(section);
+        const std::string_view haystack {
+            reinterpret_cast<const char*>(sectionData.data()),
+            sectionData.size()
+        };
+        for (size_t position = haystack.find(decoratedName);
+            position != std::string_view::npos;
+            position = haystack.find(decoratedName, position + 1)) {
+            const auto end = position + decoratedName.size();
+            if (end < haystack.size() && haystack[end] == '\0' &&
+                position >= NAME_OFFSET) {
+                return section.virtualAddress +
+                    static_cast<uint32_t>(position) - NAME_OFFSET;
+            }
+        }
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,197 @@
+#include "utils/SharedMemory.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/file.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+[[noreturn]] void ThrowLastError() {
+#ifdef _WIN32
+    const auto error = static_cast<int>(GetLastError());
+#else
+    const auto error = errno;
+#endif
+    throw std::system_error { error, std::system_category() };
+}
+
+#ifndef _WIN32
+// Whether a region was left by a creator that died without removing it.
+// Creators hold a lock on the region while they live, taken before it is
+// sized, so a sized region nobody holds is abandoned.
+bool IsAbandoned(const std::string& fullName) noexcept {
+    const int file = shm_open(fullName.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (file < 0) {
+        return false;
+    }
+    struct stat status {};
+    const bool isAbandoned = flock(file, LOCK_EX | LOCK_NB) == 0 &&
+        fstat(file, &status) == 0 && status.st_size > 0;
+    close(file);
+    return isAbandoned;
+}
+
+// Returns the locked descriptor of a new region, or -1 with errno set.
+// Fails with EEXIST while another creator has the region.
+int CreateExclusive(const std::string& fullName) noexcept {
+    constexpr int FLAGS = O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC;
+    int file = shm_open(fullName.c_str(), FLAGS, 0644);
+    if (file < 0 && errno == EEXIST && IsAbandoned(fullName)) {
+        shm_unlink(fullName.c_str());
+        file = shm_open(fullName.c_str(), FLAGS, 0644);
+    }
+    if (file < 0) {
+        return -1;
+    }
+    if (flock(file, LOCK_EX | LOCK_NB) != 0) {
+        const auto error = errno;
+        close(file);
+        shm_unlink(fullName.c_str());
+        errno = error;
+        return -1;
+    }
+    return file;
+}
+#endif
+} // namespace
+
+// The mapping handle is closed as soon as the view exists, since the view
+// alone keeps the mapping and its name alive
+#ifdef _WIN32
+SharedMemory::SharedMemory(
+    const std::string_view name,
+    const size_t size,
+    const Access access)
+    : data { nullptr }
+    , size { size }
+    , unlinkName {}
+    , lockFile { -1 } {
+    // Local names are per session, so no privilege is needed to create one
+    std::string fullName { "Local\\" };
+    fullName += name;
+    const auto isReadOnly = access == Access::ReadOnly;
+    const auto mapping = access == Access::Create ?
+        CreateFileMappingA(
+            INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+            static_cast<DWORD>(size), fullName.c_str()) :
+        OpenFileMappingA(
+            isReadOnly ? FILE_MAP_READ : FILE_MAP_READ | FILE_MAP_WRITE,
+            FALSE, fullName.c_str());
+    if (!mapping) {
+        ThrowLastError();
+    }
+    // Opened rather than created when another creator has it, which must
+    // not be zeroed and taken over under it
+    if (access == Access::Create && GetLastError() == ERROR_ALREADY_EXISTS) {
+        CloseHandle(mapping);
+        SetLastError(ERROR_ALREADY_EXISTS);
+        ThrowLastError();
+    }
+
+    const auto view = MapViewOfFile(
+        mapping, isReadOnly ? FILE_MAP_READ : FILE_MAP_READ | FILE_MAP_WRITE,
+        0, 0, size);
+    const auto viewError = GetLastError();
+    CloseHandle(mapping);
+    if (!view) {
+        SetLastError(viewError);
+        ThrowLastError();
+    }
+    data = view;
+}
+
+SharedMemory::~SharedMemory() noexcept {
+    UnmapViewOfFile(data);
+}
+#else
+SharedMemory::SharedMemory(
+    const std::string_view name,
+    const size_t size,
+    const Access access)
+    : data { nullptr }
+    , size { size }
+    , unlinkName {}
+    , lockFile { -1 } {
+    std::string fullName { "/" };
+    fullName += name;
+    const auto isReadOnly = access == Access::ReadOnly;
+
+    const int file = access == Access::Create ?
+        CreateExclusive(fullName) :
+        shm_open(
+            fullName.c_str(),
+            (isReadOnly ? O_RDONLY : O_RDWR) | O_CLOEXEC, 0);
+    if (file < 0) {
+        ThrowLastError();
+    }
+
+    const auto fail = [file](const int error) {
+        close(file);
+        errno = error;
+        ThrowLastError();
+    };
+    if (access == Access::Create) {
+        unlinkName = fullName;
+        if (ftruncate(file, static_cast<off_t>(size)) != 0) {
+            const auto error = errno;
+            shm_unlink(unlinkName.c_str());
+            fail(error);
+        }
+    } else {
+        struct stat status {};
+        if (fstat(file, &status) != 0) {
+            fail(errno);
+        }
+        if (static_cast<size_t>(status.st_size) < size) {
+            fail(EINVAL);
+        }
+    }
+
+    const auto view = mmap(
+        nullptr, size, isReadOnly ? PROT_READ : PROT_READ | PROT_WRITE,
+        MAP_SHARED, file, 0);
+    if (view == MAP_FAILED) {
+        const auto error = errno;
+        if (!unlinkName.empty()) {
+            shm_unlink(unlinkName.c_str());
+        }
+        fail(error);
+    }
+    data = view;
+
+    // The creator keeps its lock for as long as it has the region
+    if (access == Access::Create) {
+        lockFile = file;
+    } else {
+        close(file);
+    }
+}
+
+SharedMemory::~SharedMemory() noexcept {
+    munmap(data, size);
+    if (!unlinkName.empty()) {
+        shm_unlink(unlinkName.c_str());
+    }
+    if (lockFile >= 0) {
+        close(lockFile);
+    }
+}
+#endif
+
+std::span<std::byte> SharedMemory::Data() const noexcept {
+    return { static_cast<std::byte*>(data), size };
+}
@@ -0,0 +1,278 @@
+#include "utils/Signature.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+    #define SIGNATURE_SIMD
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+        #define TARGET_AVX2
+    #else
+        #define TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#endif
+
+namespace {
+constexpr auto WHITESPACE = " \t\r\n";
+constexpr size_t CHUNK_SIZE = 1 << 20;
+
+struct Pattern {
+    const uint8_t* bytes;
+    const uint8_t* mask;
+    size_t size;
+    size_t firstAnchor;
+    size_t lastAnchor;
+};
+
+bool MatchesAt(const Pattern& pattern, const uint8_t* data) noexcept {
+    for (size_t i = 0; i < pattern.size; ++i) {
+        if ((data[i] & pattern.mask[i]) != pattern.bytes[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Candidate start positions are [begin, end)
+std::optional<size_t> FindScalar(
+    const Pattern& pattern, const uint8_t* data,
+    size_t begin, const size_t end) noexcept {
+    const auto anchor = pattern.bytes[pattern.firstAnchor];
+    while (begin < end) {
+        const auto found = static_cast<const uint8_t*>(std::memchr(
+            data + begin + pattern.firstAnchor, anchor, end - begin));
+        if (!found) {
+            break;
+        }
+        begin = static_cast<size_t>(found - data) - pattern.firstAnchor;
+        if (MatchesAt(pattern, data + begin)) {
+            return begin;
+        }
+        ++begin;
+    }
+    return std::nullopt;
+}
+
+#ifdef SIGNATURE_SIMD
+bool HasAvx2() noexcept {
+#ifdef _MSC_VER
+    int info[4] {};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool hasOsxsave = info[2] & (1 << 27);
+    const bool hasAvx = info[2] & (1 << 28);
+    if (!hasOsxsave || !hasAvx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+// Loads at both anchors stay in bounds because every position of a block
+// is a valid candidate start, and anchors lie within the pattern
+std::optional<size_t> FindSse2(
+    const Pattern& pattern, const uint8_t* data, const size_t end) noexcept {
+    const auto first = _mm_set1_epi8(
+        static_cast<char>(pattern.bytes[pattern.firstAnchor]));
+    const auto last = _mm_set1_epi8(
+        static_cast<char>(pattern.bytes[pattern.lastAnchor]));
+
+    size_t i = 0;
+    for (; i + 16 <= end; i += 16) {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+            data + i + pattern.firstAnchor));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+            data + i + pattern.lastAnchor));
+        auto candidates = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+        while (candidates) {
+            const auto position = i + std::countr_zero(candidates);
+            if (MatchesAt(pattern, data + position)) {
+                return position;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+    return FindScalar(pattern, data, i, end);
+}
+
+TARGET_AVX2 std::optional<size_t> FindAvx2(
+    const Pattern& pattern, const uint8_t* data, const size_t end) noexcept {
+    const auto first = _mm256_set1_epi8(
+        static_cast<char>(pattern.bytes[pattern.firstAnchor]));
+    const auto last = _mm256_set1_epi8(
+        static_cast<char>(pattern.bytes[pattern.lastAnchor]));
+
+    size_t i = 0;
+    for (; i + 32 <= end; i += 32) {
+        const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+            data + i + pattern.firstAnchor));
+        const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+            data + i + pattern.lastAnchor));
+        auto candidates = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(
+                _mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+        while (candidates) {
+            const auto position = i + std::countr_zero(candidates);
+            if (MatchesAt(pattern, data + position)) {
+                return position;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+    return FindSse2(pattern, data + i, end - i).transform(
+        [i](const size_t position) { return i + position; });
+}
+#endif
+} // namespace
+
+Signature::Signature(const std::string_view pattern)
+    : firstAnchor { 0 }
+    , lastAnchor { 0 } {
+    size_t position = pattern.find_first_not_of(WHITESPACE);
+    while (position != std::string_view::npos) {
+        const auto end = std::min(
+            pattern.find_first_of(WHITESPACE, position), pattern.size());
+        const auto token = pattern.substr(position, end - position);
+        position = pattern.find_first_not_of(WHITESPACE, end);
+
+        if (token == "?" || token == "??") {
+            bytes.push_back(0x00);
+            mask.push_back(0x00);
+            continue;
+        }
+
+        uint8_t byte {};
+        const auto last = token.data() + token.size();
+        if (const auto [ptr, ec] = std::from_chars(
+                token.data(), last, byte, 16);
+            token.size() != 2 || ec != std::errc {} || ptr != last) {
+            throw std::invalid_argument { std::format(
+                "Invalid token '{}' in signature", token) };
+        }
+        bytes.push_back(byte);
+        mask.push_back(0xFF);
+    }
+
+    const auto first = std::ranges::find(mask, 0xFF);
+    if (first == mask.end()) {
+        throw std::invalid_argument {
+            "Signature must contain at least one non-wildcard byte"
+        };
+    }
+    const auto last = std::ranges::find(mask | std::views::reverse, 0xFF);
+    firstAnchor = static_cast<size_t>(first - mask.begin());
+    lastAnchor = static_cast<size_t>(mask.rend() - last) - 1;
+}
+
+Signature::~Signature() noexcept = default;
+
+size_t Signature::Size() const noexcept {
+    return bytes.size();
+}
+
+bool Signature::Matches(
+    const std::span<const uint8_t> data, const size_t offset) const noexcept {
+    if (offset > data.size() || data.size() - offset < bytes.size()) {
+        return false;
+    }
+    const Pattern pattern {
+        bytes.data(), mask.data(), bytes.size(), firstAnchor, lastAnchor
+    };
+    return MatchesAt(pattern, data.data() + offset);
+}
+
+std::optional<size_t> Signature::Find(
+    const std::span<const uint8_t> data) const noexcept {
+    if (data.size() < bytes.size()) {
+        return std::nullopt;
+    }
+
+    const Pattern pattern {
+        bytes.data(), mask.data(), bytes.size(), firstAnchor, lastAnchor
+    };
+    const size_t end = data.size() - bytes.size() + 1;
+#ifdef SIGNATURE_SIMD
+    static const bool hasAvx2 = HasAvx2();
+    if (hasAvx2) {
+        return FindAvx2(pattern, data.data(), end);
+    }
+    return FindSse2(pattern, data.data(), end);
+#else
+    return FindScalar(pattern, data.data(), 0, end);
+#endif
+}
+
+std::optional<size_t> Signature::FindParallel(
+    const std::span<const uint8_t> data, size_t threadCount) const {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const size_t chunkCount = (data.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    threadCount = std::min(threadCount, chunkCount);
+    if (threadCount <= 1) {
+        return Find(data);
+    }
+
+    constexpr size_t NOT_FOUND = SIZE_MAX;
+    std::atomic<size_t> nextChunk { 0 };
+    std::atomic<size_t> result { NOT_FOUND };
+    const auto worker = [&]() noexcept {
+        while (true) {
+            const size_t chunk = nextChunk.fetch_add(
+                1, std::memory_order_relaxed);
+            const size_t begin = chunk * CHUNK_SIZE;
+            if (chunk >= chunkCount ||
+                begin >= result.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            // Chunks overlap by one pattern length so that matches
+            // straddling a boundary are found by the earlier chunk
+            const size_t size = std::min(
+                CHUNK_SIZE + bytes.size() - 1, data.size() - begin);
+            if (const auto offset = Find(data.subspan(begin, size))) {
+                const size_t position = begin + *offset;
+                size_t current = result.load(std::memory_order_relaxed);
+                while (position < current && !result.compare_exchange_weak(
+                    current, position, std::memory_order_relaxed)) {}
+                return;
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads {};
+        threads.reserve(threadCount - 1);
+        for (size_t i = 1; i < threadCount; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+    }
+
+    const size_t position = result.load();
+    return position != NOT_FOUND ?
+        std::optional<size_t> { position } : std::nullopt;
+}
@@ -0,0 +1,195 @@
+#include "utils/Tracer.hpp"
+#include "utils/AtomicFile.hpp"
+#include "utils/json/JsonWriter.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+// Duration of instants, which spans can't have
+constexpr int64_t INSTANT = -1;
+
+// Tracers are told apart by an id rather than their address, which a later
+// one could reuse
+std::atomic<uint64_t> nextTracerId { 1 };
+
+struct ThreadState {
+    uint64_t tracerId;
+    void* buffer;
+};
+thread_local ThreadState threadState { 0, nullptr };
+
+double ToMicroseconds(const int64_t nanoseconds) noexcept {
+    return static_cast<double>(nanoseconds) / 1000.0;
+}
+} // namespace
+
+// Written by its thread only. Slots are read like a seqlock: an event is
+// only valid if its slot held the same sequence before and after the copy.
+struct Tracer::Buffer {
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        std::atomic<const char*> name;
+        std::atomic<int64_t> start;
+        std::atomic<int64_t> duration;
+    };
+
+    uint64_t id;
+    std::atomic<const char*> threadName;
+    std::atomic<uint64_t> head;
+    std::array<Slot, CAPACITY> slots;
+};
+
+Tracer& Tracer::GetInstance() {
+    static Tracer instance {};
+    return instance;
+}
+
+Tracer::Tracer()
+    : id { nextTracerId.fetch_add(1, std::memory_order_relaxed) }
+    , origin { Clock::now() }
+    , mutex {}
+    , buffers {} {}
+
+Tracer::~Tracer() noexcept = default;
+
+void Tracer::Span(
+    const char* name, const TimePoint start, const TimePoint end) noexcept {
+    Record(name, start, std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - start).count());
+}
+
+void Tracer::Instant(const char* name) noexcept {
+    Record(name, Clock::now(), INSTANT);
+}
+
+void Tracer::SetThreadName(const char* name) noexcept {
+    if (const auto buffer = ThreadBuffer()) {
+        buffer->threadName.store(name, std::memory_order_release);
+    }
+}
+
+std::string Tracer::ToJson() const {
+    JsonWriter writer { -1 };
+    writer.BeginObject();
+    writer.Key("displayTimeUnit");
+    writer.String("ns");
+    writer.Key("traceEvents");
+    writer.BeginArray();
+
+    const auto beginEvent = [&writer](
+        const char* name, const char* phase, const uint64_t threadId) {
+        writer.BeginObject();
+        writer.Key("name");
+        writer.String(name ? name : "");
+        writer.Key("ph");
+        writer.String(phase);
+        writer.Key("pid");
+        writer.Unsigned(1);
+        writer.Key("tid");
+        writer.Unsigned(threadId);
+    };
+
+    std::lock_guard lock { mutex };
+    for (const auto& buffer : buffers) {
+        if (const auto threadName =
+                buffer->threadName.load(std::memory_order_acquire)) {
+            beginEvent("thread_name", "M", buffer->id);
+            writer.Key("args");
+            writer.BeginObject();
+            writer.Key("name");
+            writer.String(threadName);
+            writer.EndObject();
+            writer.EndObject();
+        }
+
+        const auto head = buffer->head.load(std::memory_order_acquire);
+        for (auto position = head > CAPACITY ? head - CAPACITY : 0;
+             position < head;
+             ++position) {
+            const auto& slot = buffer->slots[position % CAPACITY];
+            const auto before = slot.sequence.load(std::memory_order_acquire);
+            const auto name = slot.name.load(std::memory_order_relaxed);
+            const auto start = slot.start.load(std::memory_order_relaxed);
+            const auto duration = slot.duration.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const auto after = slot.sequence.load(std::memory_order_relaxed);
+            if (before != position + 1 || after != before) {
+                continue;
+            }
+
+            if (duration == INSTANT) {
+                beginEvent(name, "i", buffer->id);
+                writer.Key("s");
+                writer.String("t");
+            } else {
+                beginEvent(name, "X", buffer->id);
+                writer.Key("dur");
+                writer.Number(ToMicroseconds(duration));
+            }
+            writer.Key("ts");
+            writer.Number(ToMicroseconds(start));
+            writer.EndObject();
+        }
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+    return writer.Output();
+}
+
+void Tracer::Write(const std::filesystem::path& filePath) const {
+    WriteFileAtomic(filePath, ToJson());
+}
+
+Tracer::Buffer* Tracer::ThreadBuffer() noexcept try {
+    if (threadState.tracerId == id) {
+        return static_cast<Buffer*>(threadState.buffer);
+    }
+
+    // Kept until the tracer is gone so the events of ended threads remain
+    auto buffer = std::make_unique<Buffer>();
+    std::lock_guard lock { mutex };
+    buffer->id = buffers.size() + 1;
+    buffers.push_back(std::move(buffer));
+    threadState = { id, buffers.back().get() };
+    return buffers.back().get();
+} catch (...) {
+    return nullptr;
+}
+
+void Tracer::Record(
+    const char* name, const TimePoint start, const int64_t duration) noexcept {
+    const auto buffer = ThreadBuffer();
+    if (!buffer) {
+        return;
+    }
+
+    const auto position = buffer->head.load(std::memory_order_relaxed);
+    auto& slot = buffer->slots[position % CAPACITY];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        start - origin).count(), std::memory_order_relaxed);
+    slot.duration.store(duration, std::memory_order_relaxed);
+    slot.sequence.store(position + 1, std::memory_order_release);
+    buffer->head.store(position + 1, std::memory_order_release);
+}
+
+TraceScope::TraceScope(const char* name) noexcept
+    : tracer { Tracer::GetInstance() }
+    , name { name }
+    , start { Tracer::Clock::now() } {}
+
+TraceScope::~TraceScope() noexcept {
+    tracer.Span(name, start, Tracer::Clock::now());
+}
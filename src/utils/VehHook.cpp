@@ -1,19 +1,27 @@
 #include "utils/VehHook.hpp"
+#include "utils/PageHookIndex.hpp"
 
 #include <cstdint>
-#include <ranges>
+#include <mutex>
 #include <stdexcept>
 #include <system_error>
-#include <unordered_map>
 
 #include <Windows.h>
 
 // TODO: ADD HOOK ENABLE/DISABLE
-// TODO: THREAD SAFETY?
 
+size_t GetPageSize() noexcept {
+    SYSTEM_INFO info {};
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+}
+
+// Create, Remove and initialization are serialized, while the handler only
+// reads the index's published snapshot and the per-thread pending page
+std::mutex mutex {};
 SYSTEM_INFO systemInfo {};
 PVOID exceptionHandler {};
-std::unordered_map<void*, void*> hooks;
+PageHookIndex index { GetPageSize() };
 
 template <typename T> void ThrowOnSystemError(T&& t) {
     if (!t) {
@@ -23,17 +31,17 @@ template <typename T> void ThrowOnSystemError(T&& t) {
     }
 }
 
-DWORD details::SetProtection(void* target, DWORD protection) noexcept {
+uint32_t details::SetProtection(void* target, uint32_t protection) noexcept {
     DWORD oldProtect {};
     VirtualProtect(target, systemInfo.dwPageSize, protection, &oldProtect);
     return oldProtect;
 }
 
-DWORD details::SetPageGuard(void* target) noexcept {
+uint32_t details::SetPageGuard(void* target) noexcept {
     return details::SetProtection(target, PAGE_EXECUTE_READ | PAGE_GUARD);
 }
 
-DWORD details::ClearPageGuard(void* target) noexcept {
+uint32_t details::ClearPageGuard(void* target) noexcept {
     return details::SetProtection(target, PAGE_EXECUTE_READ);
 }
 
@@ -44,18 +52,26 @@ LONG VectorizedExceptionHandler(PEXCEPTION_POINTERS exceptionPointers) {
 
     switch (exceptionRecord.ExceptionCode) {
         case EXCEPTION_GUARD_PAGE: {
-            if (const auto it = hooks.find(exceptionAddress);
-                it != hooks.end()) {
-                const auto detour = reinterpret_cast<DWORD64>(it->second);
-                contextRecord.Rip = detour;
+            // The guard is consumed by the access, whose address may be on
+            // a different page than the faulting instruction
+            const auto accessAddress = reinterpret_cast<void*>(
+                exceptionRecord.ExceptionInformation[1]);
+            if (!index.IsHookedPage(accessAddress)) {
+                return EXCEPTION_CONTINUE_SEARCH;
             }
+            if (const auto detour = index.FindDetour(exceptionAddress)) {
+                contextRecord.Rip = reinterpret_cast<DWORD64>(detour);
+            }
+            PageHookIndex::SetPendingPage(index.PageOf(accessAddress));
             contextRecord.EFlags |= PAGE_GUARD;
             return EXCEPTION_CONTINUE_EXECUTION;
         }
         case EXCEPTION_SINGLE_STEP: {
-            for (const auto& target : hooks | std::views::keys) {
-                details::SetPageGuard(target);
+            const auto page = PageHookIndex::TakePendingPage();
+            if (!page) {
+                return EXCEPTION_CONTINUE_SEARCH;
             }
+            details::SetPageGuard(reinterpret_cast<void*>(*page));
             return EXCEPTION_CONTINUE_EXECUTION;
         }
         default: {
@@ -65,7 +81,7 @@ LONG VectorizedExceptionHandler(PEXCEPTION_POINTERS exceptionPointers) {
 }
 
 size_t details::VehHookBackend::Count() noexcept {
-    return hooks.size();
+    return index.Size();
 }
 
 bool details::VehHookBackend::IsInitialized() noexcept {
@@ -73,6 +89,7 @@ bool details::VehHookBackend::IsInitialized() noexcept {
 }
 
 void details::VehHookBackend::Initialize() {
+    std::lock_guard lock { mutex };
     if (IsInitialized()) {
         return;
     }
@@ -84,42 +101,41 @@ void details::VehHookBackend::Initialize() {
 }
 
 void details::VehHookBackend::Uninitialize() noexcept {
+    std::lock_guard lock { mutex };
     if (!IsInitialized()) {
         return;
     }
 
-    for (const auto& target : hooks | std::views::keys) {
-        ClearPageGuard(target);
+    for (const auto page : index.Pages()) {
+        ClearPageGuard(reinterpret_cast<void*>(page));
     }
-    hooks.clear();
+    index.Clear();
     RemoveVectoredExceptionHandler(exceptionHandler);
     exceptionHandler = nullptr;
 }
 
 bool details::VehHookBackend::IsCreated(void* target) noexcept {
-    return hooks.contains(target);
+    return index.Contains(target);
 }
 
 void details::VehHookBackend::Create(void* target, void* detour) {
-    if (!target || !detour) {
-        throw std::invalid_argument { "Target and detour must be non-null" };
-    }
+    std::lock_guard lock { mutex };
     if (!IsInitialized()) {
         throw std::runtime_error { "Backend not initialized" };
     }
-    if (IsCreated(target)) {
-        throw std::invalid_argument { "Hook already created" };
-    }
 
+    index.Insert(target, detour);
     SetPageGuard(target);
-    hooks[target] = detour;
 }
 
 void details::VehHookBackend::Remove(void* target) noexcept {
+    std::lock_guard lock { mutex };
     if (!IsCreated(target)) {
         return;
     }
 
-    ClearPageGuard(target);
-    hooks.erase(target);
+    // Other hooks on the same page keep it guarded
+    if (index.Erase(target)) {
+        ClearPageGuard(target);
+    }
 }
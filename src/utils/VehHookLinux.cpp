@@ -0,0 +1,224 @@
+#include "utils/VehHook.hpp"
+#include "utils/PageHookIndex.hpp"
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+// Mirrors the vectored exception handler backend with signals. Guarded
+// pages lose execute permission, so only instruction fetches fault and data
+// on the same page stays readable. Faults at a target are redirected to its
+// detour, and any other fault on a guarded page is single-stepped with the
+// page briefly executable again.
+
+namespace {
+constexpr uint32_t GUARDED = PROT_READ;
+constexpr uint32_t UNGUARDED = PROT_READ | PROT_EXEC;
+constexpr greg_t TRAP_FLAG = 0x100;
+constexpr size_t MAX_PAGES = 64;
+
+struct PageProtection {
+    std::atomic<uintptr_t> page;
+    std::atomic<uint32_t> protection;
+};
+
+// Create, Remove and initialization are serialized, while the handlers
+// only read lock-free state
+std::mutex mutex {};
+bool isInitialized = false;
+PageHookIndex index { static_cast<size_t>(sysconf(_SC_PAGESIZE)) };
+
+// Last protection set on each page holding a target, since Linux has no
+// cheap way to query it back. A fixed array of atomics, with zero marking a
+// free entry, so the handlers can search it while hooks come and go.
+std::array<PageProtection, MAX_PAGES> protections {};
+
+struct sigaction previousSegvAction {};
+struct sigaction previousTrapAction {};
+
+PageProtection* FindProtection(const uintptr_t page) noexcept {
+    for (auto& entry : protections) {
+        if (entry.page.load(std::memory_order_acquire) == page) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+// Hands a signal that does not belong to a guarded page to whoever was
+// installed before, or raises it again with the default action
+void Forward(const int signal, siginfo_t* info, void* context,
+    const struct sigaction& previous) noexcept {
+    if (previous.sa_flags & SA_SIGINFO) {
+        previous.sa_sigaction(signal, info, context);
+    } else if (previous.sa_handler == SIG_IGN) {
+        return;
+    } else if (previous.sa_handler != SIG_DFL) {
+        previous.sa_handler(signal);
+    } else {
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+}
+
+void SegvHandler(const int signal, siginfo_t* info, void* context) noexcept {
+    // The page may already be unguarded by another thread that faulted on
+    // it first, so an instruction fetch from any hooked page is taken
+    auto& registers = static_cast<ucontext_t*>(context)->uc_mcontext.gregs;
+    const auto address = info->si_addr;
+    const auto page = index.PageOf(address);
+    if (info->si_code != SEGV_ACCERR ||
+        reinterpret_cast<greg_t>(address) != registers[REG_RIP] ||
+        !FindProtection(page)) {
+        Forward(signal, info, context, previousSegvAction);
+        return;
+    }
+
+    if (const auto detour = index.FindDetour(address)) {
+        registers[REG_RIP] = reinterpret_cast<greg_t>(detour);
+        return;
+    }
+    details::ClearPageGuard(address);
+    registers[REG_EFL] |= TRAP_FLAG;
+    PageHookIndex::SetPendingPage(page);
+}
+
+void TrapHandler(const int signal, siginfo_t* info, void* context) noexcept {
+    const auto page = PageHookIndex::TakePendingPage();
+    if (!page) {
+        Forward(signal, info, context, previousTrapAction);
+        return;
+    }
+    auto& registers = static_cast<ucontext_t*>(context)->uc_mcontext.gregs;
+    details::SetPageGuard(reinterpret_cast<void*>(*page));
+    registers[REG_EFL] &= ~TRAP_FLAG;
+}
+
+void ThrowOnSystemError(const bool success) {
+    if (!success) {
+        throw std::system_error { errno, std::system_category() };
+    }
+}
+} // namespace
+
+uint32_t details::SetProtection(void* target, uint32_t protection) noexcept {
+    const auto page = index.PageOf(target);
+    uint32_t oldProtection = UNGUARDED;
+    if (const auto entry = FindProtection(page)) {
+        oldProtection = entry->protection.exchange(
+            protection, std::memory_order_acq_rel);
+    }
+    mprotect(reinterpret_cast<void*>(page), index.PageSize(),
+        static_cast<int>(protection));
+    return oldProtection;
+}
+
+uint32_t details::SetPageGuard(void* target) noexcept {
+    return details::SetProtection(target, GUARDED);
+}
+
+uint32_t details::ClearPageGuard(void* target) noexcept {
+    return details::SetProtection(target, UNGUARDED);
+}
+
+size_t details::VehHookBackend::Count() noexcept {
+    return index.Size();
+}
+
+bool details::VehHookBackend::IsInitialized() noexcept {
+    return isInitialized;
+}
+
+void details::VehHookBackend::Initialize() {
+    std::lock_guard lock { mutex };
+    if (IsInitialized()) {
+        return;
+    }
+
+    struct sigaction action {};
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    action.sa_sigaction = SegvHandler;
+    ThrowOnSystemError(sigaction(SIGSEGV, &action, &previousSegvAction) == 0);
+    action.sa_sigaction = TrapHandler;
+    if (sigaction(SIGTRAP, &action, &previousTrapAction) != 0) {
+        const auto error = errno;
+        sigaction(SIGSEGV, &previousSegvAction, nullptr);
+        throw std::system_error { error, std::system_category() };
+    }
+    isInitialized = true;
+}
+
+void details::VehHookBackend::Uninitialize() noexcept {
+    std::lock_guard lock { mutex };
+    if (!IsInitialized()) {
+        return;
+    }
+
+    for (const auto page : index.Pages()) {
+        ClearPageGuard(reinterpret_cast<void*>(page));
+    }
+    for (auto& entry : protections) {
+        entry.page.store(0, std::memory_order_release);
+    }
+    index.Clear();
+    sigaction(SIGTRAP, &previousTrapAction, nullptr);
+    sigaction(SIGSEGV, &previousSegvAction, nullptr);
+    isInitialized = false;
+}
+
+bool details::VehHookBackend::IsCreated(void* target) noexcept {
+    return index.Contains(target);
+}
+
+// The protection entry is published before the hook, so a fault on the
+// page always finds it
+void details::VehHookBackend::Create(void* target, void* detour) {
+    std::lock_guard lock { mutex };
+    if (!IsInitialized()) {
+        throw std::runtime_error { "Backend not initialized" };
+    }
+
+    const auto page = index.PageOf(target);
+    PageProtection* added = nullptr;
+    if (!FindProtection(page)) {
+        added = FindProtection(0);
+        if (!added) {
+            throw std::runtime_error { "Too many guarded pages" };
+        }
+        added->protection.store(UNGUARDED, std::memory_order_relaxed);
+        added->page.store(page, std::memory_order_release);
+    }
+    try {
+        index.Insert(target, detour);
+    } catch (...) {
+        if (added) {
+            added->page.store(0, std::memory_order_release);
+        }
+        throw;
+    }
+    SetPageGuard(target);
+}
+
+void details::VehHookBackend::Remove(void* target) noexcept {
+    std::lock_guard lock { mutex };
+    if (!IsCreated(target)) {
+        return;
+    }
+
+    // Other hooks on the same page keep it guarded
+    if (index.Erase(target)) {
+        ClearPageGuard(target);
+        FindProtection(index.PageOf(target))->page.store(
+            0, std::memory_order_release);
+    }
+}
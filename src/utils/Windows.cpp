@@ -1,9 +1,13 @@
 #include "utils/Windows.hpp"
+#include "utils/Tracer.hpp"
 
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <ranges>
+#include <span>
+#include <stdexcept>
 #include <thread>
 #include <tuple>
 #include <vector>
@@ -45,7 +49,24 @@ fs::path GetModulePath(const void* address) {
     return fs::path { buffer };
 }
 
+std::span<const uint8_t> GetModuleImage(HMODULE module) {
+    if (!module) {
+        throw std::invalid_argument { "Module must not be null" };
+    }
+
+    const auto base = reinterpret_cast<const uint8_t*>(module);
+    const auto dosHeader = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+    const auto ntHeaders = reinterpret_cast<const IMAGE_NT_HEADERS*>(
+        base + dosHeader->e_lfanew);
+    if (dosHeader->e_magic != IMAGE_DOS_SIGNATURE ||
+        ntHeaders->Signature != IMAGE_NT_SIGNATURE) {
+        throw std::runtime_error { "Module is not a valid PE image" };
+    }
+    return { base, ntHeaders->OptionalHeader.SizeOfImage };
+}
+
 std::vector<HWND> GetProcessWindows(DWORD processId) {
+    TRACE_SCOPE("GetProcessWindows");
     if (!processId) {
         processId = GetCurrentProcessId();
     }
@@ -0,0 +1,29 @@
+#include "utils/WriteEchoFilter.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+WriteEchoFilter::WriteEchoFilter() noexcept
+    : writes {} {}
+
+void WriteEchoFilter::OnWrite(std::string contents) {
+    writes.push_back(std::move(contents));
+    if (writes.size() > MAX_WRITES) {
+        writes.pop_front();
+    }
+}
+
+bool WriteEchoFilter::IsEcho(const std::string_view contents) noexcept {
+    // The latest write is the most likely to match
+    const auto it = std::find(writes.rbegin(), writes.rend(), contents);
+    if (it == writes.rend()) {
+        writes.clear();
+        return false;
+    }
+    // The write itself stays, since it may be seen more than once
+    writes.erase(writes.begin(), std::prev(it.base()));
+    return true;
+}
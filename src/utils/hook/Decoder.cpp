@@ -0,0 +1,358 @@
+#include "utils/hook/Decoder.hpp"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+namespace {
+constexpr uint8_t MAX_LENGTH = 15;
+
+// Operand layout of an opcode
+enum Flags : uint8_t {
+    NONE = 0,
+    MODRM = 1 << 0,
+    IMM8 = 1 << 1,
+    IMM16 = 1 << 2,
+    IMMZ = 1 << 3, // 16 or 32 bits depending on operand size
+    REL8 = 1 << 4,
+    RELZ = 1 << 5,
+    INVALID = 1 << 6,
+    SPECIAL = 1 << 7 // Handled case by case
+};
+
+constexpr std::array<uint8_t, 256> PRIMARY_TABLE = [] {
+    std::array<uint8_t, 256> table {};
+    for (int row = 0x00; row <= 0x30; row += 0x10) {
+        for (const int base : { row, row + 0x08 }) {
+            table[base + 0] = table[base + 1] = MODRM;
+            table[base + 2] = table[base + 3] = MODRM;
+            table[base + 4] = IMM8;
+            table[base + 5] = IMMZ;
+            table[base + 6] = table[base + 7] = INVALID;
+        }
+    }
+    table[0x0F] = SPECIAL;
+    table[0x60] = table[0x61] = INVALID;
+    table[0x62] = SPECIAL;
+    table[0x63] = MODRM;
+    table[0x68] = IMMZ;
+    table[0x69] = MODRM | IMMZ;
+    table[0x6A] = IMM8;
+    table[0x6B] = MODRM | IMM8;
+    for (int op = 0x70; op <= 0x7F; ++op) {
+        table[op] = REL8;
+    }
+    table[0x80] = MODRM | IMM8;
+    table[0x81] = MODRM | IMMZ;
+    table[0x82] = INVALID;
+    table[0x83] = MODRM | IMM8;
+    for (int op = 0x84; op <= 0x8F; ++op) {
+        table[op] = MODRM;
+    }
+    table[0x9A] = INVALID;
+    for (int op = 0xA0; op <= 0xA3; ++op) {
+        table[op] = SPECIAL;
+    }
+    table[0xA8] = IMM8;
+    table[0xA9] = IMMZ;
+    for (int op = 0xB0; op <= 0xB7; ++op) {
+        table[op] = IMM8;
+    }
+    for (int op = 0xB8; op <= 0xBF; ++op) {
+        table[op] = SPECIAL;
+    }
+    table[0xC0] = table[0xC1] = MODRM | IMM8;
+    table[0xC2] = IMM16;
+    table[0xC4] = table[0xC5] = SPECIAL;
+    table[0xC6] = MODRM | IMM8;
+    table[0xC7] = MODRM | IMMZ;
+    table[0xC8] = SPECIAL;
+    table[0xCA] = IMM16;
+    table[0xCD] = IMM8;
+    table[0xCE] = INVALID;
+    for (int op = 0xD0; op <= 0xD3; ++op) {
+        table[op] = MODRM;
+    }
+    table[0xD4] = table[0xD5] = table[0xD6] = INVALID;
+    for (int op = 0xD8; op <= 0xDF; ++op) {
+        table[op] = MODRM;
+    }
+    for (int op = 0xE0; op <= 0xE3; ++op) {
+        table[op] = REL8;
+    }
+    for (int op = 0xE4; op <= 0xE7; ++op) {
+        table[op] = IMM8;
+    }
+    table[0xE8] = table[0xE9] = RELZ;
+    table[0xEA] = INVALID;
+    table[0xEB] = REL8;
+    table[0xF6] = table[0xF7] = SPECIAL;
+    table[0xFE] = table[0xFF] = MODRM;
+    return table;
+}();
+
+constexpr std::array<uint8_t, 256> SECONDARY_TABLE = [] {
+    std::array<uint8_t, 256> table {};
+    table.fill(MODRM);
+    for (const int op : {
+        0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0E,
+        0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x77,
+        0xA0, 0xA1, 0xA2, 0xA8, 0xA9, 0xAA }) {
+        table[op] = NONE;
+    }
+    table[0x0F] = MODRM | IMM8; // 3DNow! suffix
+    table[0x38] = table[0x3A] = SPECIAL;
+    for (int op = 0x70; op <= 0x73; ++op) {
+        table[op] = MODRM | IMM8;
+    }
+    for (int op = 0x80; op <= 0x8F; ++op) {
+        table[op] = RELZ;
+    }
+    for (const int op : { 0xA4, 0xAC, 0xBA, 0xC2, 0xC4, 0xC5, 0xC6 }) {
+        table[op] = MODRM | IMM8;
+    }
+    for (int op = 0xC8; op <= 0xCF; ++op) {
+        table[op] = NONE;
+    }
+    return table;
+}();
+
+bool IsLegacyPrefix(const uint8_t byte) noexcept {
+    switch (byte) {
+        case 0x26: case 0x2E: case 0x36: case 0x3E: case 0x64: case 0x65:
+        case 0x66: case 0x67: case 0xF0: case 0xF2: case 0xF3:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Opcodes of the 0F map that take an imm8 also under VEX and EVEX
+bool HasVexImmediate(const uint8_t map, const uint8_t opcode) noexcept {
+    if (map == 3) {
+        return true;
+    }
+    return map == 1 && (SECONDARY_TABLE[opcode] & IMM8);
+}
+
+struct Decoder {
+    const uint8_t* code;
+    uint8_t position = 0;
+
+    [[nodiscard]] bool Available(const uint8_t count) const noexcept {
+        return position + count <= MAX_LENGTH;
+    }
+
+    // Returns false when the encoding exceeds the maximum length
+    bool ModRm(hook::Instruction& instruction) noexcept {
+        if (!Available(1)) {
+            return false;
+        }
+        const uint8_t modRm = code[position++];
+        const uint8_t mod = modRm >> 6;
+        const uint8_t rm = modRm & 0x07;
+        if (mod == 3) {
+            return true;
+        }
+
+        uint8_t displacement = mod == 1 ? 1 : mod == 2 ? 4 : 0;
+        if (rm == 4) {
+            if (!Available(1)) {
+                return false;
+            }
+            const uint8_t sib = code[position++];
+            if (mod == 0 && (sib & 0x07) == 5) {
+                displacement = 4;
+            }
+        } else if (mod == 0 && rm == 5) {
+            instruction.ripDisplacementOffset = position;
+            displacement = 4;
+        }
+        if (!Available(displacement)) {
+            return false;
+        }
+        position += displacement;
+        return true;
+    }
+
+    bool Skip(const uint8_t count) noexcept {
+        if (!Available(count)) {
+            return false;
+        }
+        position += count;
+        return true;
+    }
+
+    bool Relative(hook::Instruction& instruction, const uint8_t size) noexcept {
+        instruction.relativeOffset = position;
+        instruction.relativeSize = size;
+        return Skip(size);
+    }
+};
+} // namespace
+
+bool hook::Instruction::IsRipRelative() const noexcept {
+    return ripDisplacementOffset != 0;
+}
+
+bool hook::Instruction::IsRelativeBranch() const noexcept {
+    return relativeSize != 0;
+}
+
+std::optional<hook::Instruction> hook::Decode(const uint8_t* code) noexcept {
+    Instruction instruction {};
+    Decoder decoder { code };
+    auto& position = decoder.position;
+
+    bool operandSize16 = false;
+    bool addressSize32 = false;
+    while (IsLegacyPrefix(code[position])) {
+        operandSize16 |= code[position] == 0x66;
+        addressSize32 |= code[position] == 0x67;
+        if (!decoder.Skip(1)) {
+            return std::nullopt;
+        }
+    }
+
+    bool rexW = false;
+    if ((code[position] & 0xF0) == 0x40) {
+        rexW = code[position] & 0x08;
+        if (!decoder.Skip(1)) {
+            return std::nullopt;
+        }
+    }
+
+    const auto finish = [&](const bool ok) -> std::optional<Instruction> {
+        if (!ok || position > MAX_LENGTH) {
+            return std::nullopt;
+        }
+        instruction.length = position;
+        return instruction;
+    };
+    const uint8_t immz = operandSize16 && !rexW ? 2 : 4;
+
+    const uint8_t opcode = code[position++];
+    instruction.opcode = opcode;
+    const uint8_t flags = PRIMARY_TABLE[opcode];
+    if (flags & INVALID) {
+        return std::nullopt;
+    }
+
+    if (flags & SPECIAL) {
+        switch (opcode) {
+            case 0x0F: {
+                const uint8_t secondary = code[position++];
+                instruction.opcode = secondary;
+                const uint8_t secondaryFlags = SECONDARY_TABLE[secondary];
+                if (secondary == 0x38 || secondary == 0x3A) {
+                    instruction.opcode = code[position++];
+                    return finish(decoder.ModRm(instruction) &&
+                        (secondary == 0x38 || decoder.Skip(1)));
+                }
+                if (secondaryFlags & RELZ) {
+                    instruction.branch = Branch::Conditional;
+                    return finish(decoder.Relative(instruction, 4));
+                }
+                bool ok = true;
+                if (secondaryFlags & MODRM) {
+                    ok = decoder.ModRm(instruction);
+                }
+                if (ok && (secondaryFlags & IMM8)) {
+                    ok = decoder.Skip(1);
+                }
+                return finish(ok);
+            }
+            case 0x62: {
+                // EVEX: same operand layout as VEX after a 3-byte payload
+                const uint8_t map = code[position] & 0x07;
+                position += 3;
+                if (map < 1 || map > 6 || map == 4) {
+                    return std::nullopt;
+                }
+                instruction.opcode = code[position++];
+                return finish(decoder.ModRm(instruction) &&
+                    (!HasVexImmediate(map, instruction.opcode) ||
+                    decoder.Skip(1)));
+            }
+            case 0xA0: case 0xA1: case 0xA2: case 0xA3: {
+                return finish(decoder.Skip(addressSize32 ? 4 : 8));
+            }
+            case 0xB8: case 0xB9: case 0xBA: case 0xBB:
+            case 0xBC: case 0xBD: case 0xBE: case 0xBF: {
+                return finish(decoder.Skip(rexW ? 8 : immz));
+            }
+            case 0xC4: case 0xC5: {
+                // VEX: implied 0F map for the two-byte form
+                uint8_t map = 1;
+                if (opcode == 0xC4) {
+                    map = code[position] & 0x1F;
+                    position += 2;
+                } else {
+                    position += 1;
+                }
+                if (map < 1 || map > 3) {
+                    return std::nullopt;
+                }
+                instruction.opcode = code[position++];
+                if (map == 1 && instruction.opcode == 0x77) {
+                    return finish(true); // vzeroupper, vzeroall
+                }
+                return finish(decoder.ModRm(instruction) &&
+                    (!HasVexImmediate(map, instruction.opcode) ||
+                    decoder.Skip(1)));
+            }
+            case 0xC8: {
+                return finish(decoder.Skip(3));
+            }
+            case 0xF6: case 0xF7: {
+                // Only TEST (/0, /1) of group 3 takes an immediate
+                const bool isTest = ((code[position] >> 3) & 0x07) < 2;
+                return finish(decoder.ModRm(instruction) && (!isTest ||
+                    decoder.Skip(opcode == 0xF6 ? 1 : immz)));
+            }
+            default: {
+                return std::nullopt;
+            }
+        }
+    }
+
+    if (flags & REL8) {
+        if (opcode == 0xEB) {
+            instruction.branch = Branch::Jump;
+        } else if (opcode >= 0xE0 && opcode <= 0xE3) {
+            instruction.branch = Branch::Loop;
+        } else {
+            instruction.branch = Branch::Conditional;
+        }
+        return finish(decoder.Relative(instruction, 1));
+    }
+    if (flags & RELZ) {
+        instruction.branch = opcode == 0xE8 ? Branch::Call : Branch::Jump;
+        return finish(decoder.Relative(instruction, 4));
+    }
+    if (opcode == 0xC2 || opcode == 0xC3 || opcode == 0xCA || opcode == 0xCB) {
+        instruction.branch = Branch::Return;
+    } else if (opcode == 0xFF) {
+        // Indirect call (/2, /3) and jump (/4, /5)
+        switch ((code[position] >> 3) & 0x07) {
+            case 2: case 3: instruction.branch = Branch::Call; break;
+            case 4: case 5: instruction.branch = Branch::Jump; break;
+            default: break;
+        }
+    }
+
+    bool ok = true;
+    if (flags & MODRM) {
+        ok = decoder.ModRm(instruction);
+    }
+    if (ok && (flags & IMM8)) {
+        ok = decoder.Skip(1);
+    }
+    if (ok && (flags & IMM16)) {
+        ok = decoder.Skip(2);
+    }
+    if (ok && (flags & IMMZ)) {
+        ok = decoder.Skip(immz);
+    }
+    return finish(ok);
+}
@@ -0,0 +1,234 @@
+#include "utils/hook/InlineHook.hpp"
+#include "utils/hook/Decoder.hpp"
+#include "utils/hook/Memory.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+constexpr size_t JMP_REL_SIZE = 5;
+constexpr size_t JMP_ABS_SIZE = 14;
+constexpr size_t MAX_RELOCATED_SIZE = 16;
+constexpr size_t RELAY_OFFSET = hook::SLOT_SIZE - JMP_ABS_SIZE;
+
+// jmp qword ptr [rip + 0]; dq destination
+size_t EmitJmpAbs(uint8_t* out, const uintptr_t destination) noexcept {
+    constexpr uint8_t code[] { 0xFF, 0x25, 0x00, 0x00, 0x00, 0x00 };
+    std::memcpy(out, code, sizeof(code));
+    std::memcpy(out + sizeof(code), &destination, sizeof(destination));
+    return JMP_ABS_SIZE;
+}
+
+// jmp rel32
+size_t EmitJmpRel(
+    uint8_t* out, const uint8_t* address, const uint8_t* destination) noexcept {
+    const auto relative = static_cast<int32_t>(
+        destination - (address + JMP_REL_SIZE));
+    out[0] = 0xE9;
+    std::memcpy(out + 1, &relative, sizeof(relative));
+    return JMP_REL_SIZE;
+}
+
+// call qword ptr [rip + 2]; jmp short +8; dq destination
+size_t EmitCallAbs(uint8_t* out, const uintptr_t destination) noexcept {
+    constexpr uint8_t code[] { 0xFF, 0x15, 0x02, 0x00, 0x00, 0x00, 0xEB, 0x08 };
+    std::memcpy(out, code, sizeof(code));
+    std::memcpy(out + sizeof(code), &destination, sizeof(destination));
+    return sizeof(code) + sizeof(destination);
+}
+
+// Inverted jcc short over an absolute jump
+size_t EmitJccAbs(
+    uint8_t* out, const uint8_t condition, const uintptr_t destination) noexcept {
+    out[0] = static_cast<uint8_t>(0x70 | (condition ^ 1));
+    out[1] = static_cast<uint8_t>(JMP_ABS_SIZE);
+    return 2 + EmitJmpAbs(out + 2, destination);
+}
+
+int64_t ReadRelative(const uint8_t* operand, const uint8_t size) noexcept {
+    if (size == 1) {
+        return static_cast<int8_t>(operand[0]);
+    }
+    int32_t value {};
+    std::memcpy(&value, operand, sizeof(value));
+    return value;
+}
+} // namespace
+
+hook::InlineHook::InlineHook(void* target, void* detour)
+    : target { static_cast<uint8_t*>(target) }
+    , detour { static_cast<uint8_t*>(detour) }
+    , slot { nullptr }
+    , isEnabled { false }
+    , patchSize { 0 }
+    , patch {}
+    , original {}
+    , mappingCount { 0 }
+    , mappings {} {
+    if (!target || !detour) {
+        throw std::invalid_argument { "Target and detour must not be null" };
+    }
+    slot = AllocateSlot(target);
+    try {
+        Build();
+    } catch (...) {
+        FreeSlot(slot);
+        throw;
+    }
+}
+
+hook::InlineHook::~InlineHook() noexcept {
+    if (isEnabled) {
+        try {
+            Disable();
+        } catch (...) {
+            // Leak the slot since the target may still jump into it
+            return;
+        }
+    }
+    FreeSlot(slot);
+}
+
+void* hook::InlineHook::Target() const noexcept {
+    return target;
+}
+
+void* hook::InlineHook::Trampoline() const noexcept {
+    return slot;
+}
+
+size_t hook::InlineHook::PatchSize() const noexcept {
+    return patchSize;
+}
+
+bool hook::InlineHook::IsEnabled() const noexcept {
+    return isEnabled;
+}
+
+void hook::InlineHook::Enable() {
+    if (isEnabled) {
+        return;
+    }
+    WriteCode(target, patch.data(), patchSize);
+    isEnabled = true;
+}
+
+void hook::InlineHook::Disable() {
+    if (!isEnabled) {
+        return;
+    }
+    WriteCode(target, original.data(), patchSize);
+    isEnabled = false;
+}
+
+uintptr_t hook::InlineHook::ToTrampoline(const uintptr_t ip) const noexcept {
+    for (size_t i = 0; i < mappingCount; ++i) {
+        const auto [targetOffset, trampolineOffset] = mappings[i];
+        if (ip == reinterpret_cast<uintptr_t>(target + targetOffset)) {
+            return reinterpret_cast<uintptr_t>(slot + trampolineOffset);
+        }
+    }
+    return ip;
+}
+
+uintptr_t hook::InlineHook::FromTrampoline(const uintptr_t ip) const noexcept {
+    for (size_t i = 0; i < mappingCount; ++i) {
+        const auto [targetOffset, trampolineOffset] = mappings[i];
+        if (ip == reinterpret_cast<uintptr_t>(slot + trampolineOffset)) {
+            return reinterpret_cast<uintptr_t>(target + targetOffset);
+        }
+    }
+    return ip;
+}
+
+// Slot layout: relocated instructions, a jump back to the rest of the
+// target, and a relay to the detour at the end of the slot used when the
+// detour is out of rel32 range of the target
+void hook::InlineHook::Build() {
+    const bool isNear = IsNear(target, slot) &&
+        IsNear(target + JMP_REL_SIZE, slot + SLOT_SIZE);
+    patchSize = isNear ? JMP_REL_SIZE : JMP_ABS_SIZE;
+
+    size_t offset = 0;
+    size_t size = 0;
+    while (offset < patchSize) {
+        const uint8_t* source = target + offset;
+        const auto instruction = Decode(source);
+        if (!instruction) {
+            throw std::runtime_error { "Unsupported instruction in target" };
+        }
+        const auto [length, opcode, ripDisplacementOffset,
+            branch, relativeOffset, relativeSize] = *instruction;
+
+        uint8_t buffer[MAX_RELOCATED_SIZE] {};
+        size_t bufferSize = length;
+        std::memcpy(buffer, source, length);
+        if (branch == Branch::Loop) {
+            throw std::runtime_error { "Unsupported loop in target" };
+        }
+        if (instruction->IsRelativeBranch()) {
+            const auto destination = reinterpret_cast<uintptr_t>(
+                source + length) + ReadRelative(
+                source + relativeOffset, relativeSize);
+            if (destination >= reinterpret_cast<uintptr_t>(target) &&
+                destination < reinterpret_cast<uintptr_t>(target + patchSize)) {
+                throw std::runtime_error { "Branch into patched bytes" };
+            }
+            switch (branch) {
+                case Branch::Call: {
+                    bufferSize = EmitCallAbs(buffer, destination);
+                    break;
+                }
+                case Branch::Jump: {
+                    bufferSize = EmitJmpAbs(buffer, destination);
+                    break;
+                }
+                default: {
+                    bufferSize = EmitJccAbs(buffer, opcode & 0x0F, destination);
+                    break;
+                }
+            }
+        } else if (instruction->IsRipRelative()) {
+            int32_t displacement {};
+            std::memcpy(&displacement, source + ripDisplacementOffset,
+                sizeof(displacement));
+            const int64_t relocated = displacement + (source - (slot + size));
+            if (relocated < INT32_MIN || relocated > INT32_MAX) {
+                throw std::runtime_error {
+                    "RIP-relative operand out of range of trampoline"
+                };
+            }
+            displacement = static_cast<int32_t>(relocated);
+            std::memcpy(buffer + ripDisplacementOffset, &displacement,
+                sizeof(displacement));
+        }
+
+        if (size + bufferSize > RELAY_OFFSET - JMP_ABS_SIZE) {
+            throw std::runtime_error { "Relocated instructions too large" };
+        }
+        std::memcpy(slot + size, buffer, bufferSize);
+        mappings[mappingCount++] = {
+            static_cast<uint8_t>(offset), static_cast<uint8_t>(size)
+        };
+        offset += length;
+        size += bufferSize;
+
+        const bool isEnd = branch == Branch::Jump || branch == Branch::Return;
+        if (isEnd && offset < patchSize) {
+            throw std::runtime_error { "Target too short to hook" };
+        }
+    }
+    EmitJmpAbs(slot + size, reinterpret_cast<uintptr_t>(target + offset));
+
+    if (isNear) {
+        EmitJmpAbs(slot + RELAY_OFFSET, reinterpret_cast<uintptr_t>(detour));
+        const auto destination = IsNear(target + JMP_REL_SIZE, detour) ?
+            detour : slot + RELAY_OFFSET;
+        EmitJmpRel(patch.data(), target, destination);
+    } else {
+        EmitJmpAbs(patch.data(), reinterpret_cast<uintptr_t>(detour));
+    }
+    std::memcpy(original.data(), target, patchSize);
+}
@@ -0,0 +1,458 @@
+#include "utils/hook/Memory.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+    #include <Windows.h>
+    #include <TlHelp32.h>
+    #include <intrin.h>
+#else
+    #include <cerrno>
+    #include <charconv>
+    #include <fstream>
+    #include <string>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+constexpr size_t BLOCK_SIZE = 0x10000;
+
+// Keeps trampolines close enough for relocated RIP-relative operands, which
+// may themselves point up to 2 GiB away from the original code, to still fit
+constexpr uintptr_t MAX_DISTANCE = 0x40000000;
+
+struct Block {
+    uint8_t* base;
+    std::vector<uint8_t*> freeSlots;
+};
+
+struct Allocator {
+    std::mutex mutex;
+    std::vector<Block> blocks;
+};
+
+// Never destroyed so hooks with static storage duration can still free
+// their slots during exit
+Allocator& GetAllocator() noexcept {
+    static const auto allocator = new Allocator {};
+    return *allocator;
+}
+
+[[noreturn]] void ThrowLastError() {
+#ifdef _WIN32
+    const auto error = static_cast<int>(GetLastError());
+#else
+    const auto error = errno;
+#endif
+    throw std::system_error { error, std::system_category() };
+}
+
+uintptr_t Distance(const void* from, const void* to) noexcept {
+    const auto a = reinterpret_cast<uintptr_t>(from);
+    const auto b = reinterpret_cast<uintptr_t>(to);
+    return a > b ? a - b : b - a;
+}
+
+bool IsNearBlock(const uint8_t* base, const void* origin) noexcept {
+    return Distance(base, origin) < MAX_DISTANCE &&
+        Distance(base + BLOCK_SIZE, origin) < MAX_DISTANCE;
+}
+
+#ifdef _WIN32
+uint8_t* TryAllocateBlock(const uintptr_t address) noexcept {
+    return static_cast<uint8_t*>(VirtualAlloc(
+        reinterpret_cast<void*>(address), BLOCK_SIZE,
+        MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE));
+}
+
+void FreeBlock(uint8_t* block) noexcept {
+    VirtualFree(block, 0, MEM_RELEASE);
+}
+
+uint8_t* TryAllocateNearBlock(
+    const uintptr_t address, const void* origin) noexcept {
+    const auto block = TryAllocateBlock(address);
+    if (block && !IsNearBlock(block, origin)) {
+        FreeBlock(block);
+        return nullptr;
+    }
+    return block;
+}
+
+// Walks free regions below then above origin at allocation granularity
+uint8_t* AllocateNearBlock(const void* origin) noexcept {
+    SYSTEM_INFO systemInfo {};
+    GetSystemInfo(&systemInfo);
+    const uintptr_t granularity = systemInfo.dwAllocationGranularity;
+    const auto address = reinterpret_cast<uintptr_t>(origin);
+    const auto minAddress = std::max(
+        address > MAX_DISTANCE ? address - MAX_DISTANCE : 0,
+        reinterpret_cast<uintptr_t>(systemInfo.lpMinimumApplicationAddress));
+    const auto maxAddress = std::min(
+        address + MAX_DISTANCE,
+        reinterpret_cast<uintptr_t>(systemInfo.lpMaximumApplicationAddress));
+
+    MEMORY_BASIC_INFORMATION info {};
+    uintptr_t current = address - address % granularity - granularity;
+    while (current >= minAddress) {
+        if (!VirtualQuery(reinterpret_cast<void*>(current),
+            &info, sizeof(info))) {
+            break;
+        }
+        if (info.State == MEM_FREE) {
+            if (const auto block = TryAllocateNearBlock(current, origin)) {
+                return block;
+            }
+        }
+        const auto allocationBase =
+            reinterpret_cast<uintptr_t>(info.AllocationBase);
+        if (allocationBase < granularity) {
+            break;
+        }
+        current = allocationBase - granularity;
+    }
+
+    current = address - address % granularity + granularity;
+    while (current <= maxAddress) {
+        if (!VirtualQuery(reinterpret_cast<void*>(current),
+            &info, sizeof(info))) {
+            break;
+        }
+        if (info.State == MEM_FREE) {
+            if (const auto block = TryAllocateNearBlock(current, origin)) {
+                return block;
+            }
+        }
+        current = reinterpret_cast<uintptr_t>(info.BaseAddress) +
+            info.RegionSize + granularity - 1;
+        current -= current % granularity;
+    }
+    return nullptr;
+}
+
+uint8_t* AllocateBlock() {
+    const auto block = TryAllocateBlock(0);
+    if (!block) {
+        ThrowLastError();
+    }
+    return block;
+}
+#else
+uint8_t* TryAllocateBlock(const uintptr_t address) noexcept {
+    const auto block = mmap(
+        reinterpret_cast<void*>(address), BLOCK_SIZE,
+        PROT_READ | PROT_WRITE | PROT_EXEC,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return block != MAP_FAILED ? static_cast<uint8_t*>(block) : nullptr;
+}
+
+void FreeBlock(uint8_t* block) noexcept {
+    munmap(block, BLOCK_SIZE);
+}
+
+// The kernel treats the address as a hint and falls back to a nearby free
+// range when it is taken, so exponentially spaced hints cover the window
+uint8_t* AllocateNearBlock(const void* origin) noexcept {
+    const auto address = reinterpret_cast<uintptr_t>(origin) &
+        ~static_cast<uintptr_t>(BLOCK_SIZE - 1);
+    for (uintptr_t distance = BLOCK_SIZE;
+        distance < MAX_DISTANCE; distance *= 2) {
+        for (const auto hint : { address - distance, address + distance }) {
+            if (hint > address + distance || hint < BLOCK_SIZE) {
+                continue;
+            }
+            const auto block = TryAllocateBlock(hint);
+            if (!block) {
+                continue;
+            }
+            if (IsNearBlock(block, origin)) {
+                return block;
+            }
+            FreeBlock(block);
+        }
+    }
+    return nullptr;
+}
+
+uint8_t* AllocateBlock() {
+    const auto block = TryAllocateBlock(0);
+    if (!block) {
+        ThrowLastError();
+    }
+    return block;
+}
+
+struct MappingProtection {
+    uintptr_t begin;
+    uintptr_t end;
+    int protection;
+};
+
+// Protection of each mapping overlapping [first, last), clipped to it, read
+// from lines such as "7f12a000-7f12c000 r-xp ..."
+std::vector<MappingProtection> QueryProtections(
+    const uintptr_t first, const uintptr_t last) {
+    std::ifstream maps { "/proc/self/maps" };
+    if (!maps) {
+        ThrowLastError();
+    }
+
+    std::vector<MappingProtection> protections {};
+    std::string line {};
+    while (std::getline(maps, line)) {
+        const auto dash = line.find('-');
+        const auto space = line.find(' ');
+        if (dash == std::string::npos || space == std::string::npos ||
+            space < dash || line.size() < space + 4) {
+            continue;
+        }
+        uintptr_t begin {};
+        uintptr_t end {};
+        std::from_chars(line.data(), line.data() + dash, begin, 16);
+        std::from_chars(line.data() + dash + 1, line.data() + space, end, 16);
+        if (end <= first || begin >= last) {
+            continue;
+        }
+
+        int protection = PROT_NONE;
+        protection |= line[space + 1] == 'r' ? PROT_READ : 0;
+        protection |= line[space + 2] == 'w' ? PROT_WRITE : 0;
+        protection |= line[space + 3] == 'x' ? PROT_EXEC : 0;
+        protections.push_back({
+            std::max(begin, first), std::min(end, last), protection
+        });
+    }
+    return protections;
+}
+#endif
+
+void StoreAtomic128(uint8_t* address, const uint8_t* bytes, const size_t size) {
+    const auto first = reinterpret_cast<uintptr_t>(address);
+    const auto aligned = first & ~static_cast<uintptr_t>(15);
+    const auto offset = first - aligned;
+    const auto words = reinterpret_cast<volatile int64_t*>(aligned);
+
+#ifdef _MSC_VER
+    int64_t expected[2] { words[0], words[1] };
+    while (true) {
+        int64_t desired[2] { expected[0], expected[1] };
+        std::memcpy(reinterpret_cast<uint8_t*>(desired) + offset, bytes, size);
+        if (_InterlockedCompareExchange128(
+            words, desired[1], desired[0], expected)) {
+            return;
+        }
+    }
+#else
+    while (true) {
+        uint64_t expected[2] {
+            static_cast<uint64_t>(words[0]), static_cast<uint64_t>(words[1])
+        };
+        uint64_t desired[2] { expected[0], expected[1] };
+        std::memcpy(reinterpret_cast<uint8_t*>(desired) + offset, bytes, size);
+        bool success {};
+        __asm__ __volatile__(
+            "lock cmpxchg16b %[words]"
+            : "=@ccz" (success), [words] "+m" (*words),
+              "+a" (expected[0]), "+d" (expected[1])
+            : "b" (desired[0]), "c" (desired[1])
+            : "memory"
+        );
+        if (success) {
+            return;
+        }
+    }
+#endif
+}
+
+void Store(uint8_t* address, const uint8_t* bytes, const size_t size) {
+    const auto first = reinterpret_cast<uintptr_t>(address);
+    const auto last = first + size - 1;
+    if ((first & ~uintptr_t { 7 }) == (last & ~uintptr_t { 7 })) {
+        auto& word = *reinterpret_cast<uint64_t*>(first & ~uintptr_t { 7 });
+        std::atomic_ref atomicWord { word };
+        uint64_t value = atomicWord.load();
+        std::memcpy(reinterpret_cast<uint8_t*>(&value) + (first & 7),
+            bytes, size);
+        atomicWord.store(value);
+    } else if ((first & ~uintptr_t { 15 }) == (last & ~uintptr_t { 15 })) {
+        StoreAtomic128(address, bytes, size);
+    } else {
+        std::memcpy(address, bytes, size);
+    }
+}
+} // namespace
+
+bool hook::IsNear(const void* from, const void* to) noexcept {
+    const auto delta = reinterpret_cast<intptr_t>(to) -
+        reinterpret_cast<intptr_t>(from);
+    return delta >= INT32_MIN && delta <= INT32_MAX;
+}
+
+uint8_t* hook::AllocateSlot(const void* origin) {
+    auto& [mutex, blocks] = GetAllocator();
+    std::lock_guard lock { mutex };
+
+    auto it = std::ranges::find_if(blocks, [origin](const Block& block) {
+        return !block.freeSlots.empty() && IsNearBlock(block.base, origin);
+    });
+    if (it == blocks.end()) {
+        auto base = AllocateNearBlock(origin);
+        if (!base) {
+            it = std::ranges::find_if(blocks, [](const Block& block) {
+                return !block.freeSlots.empty();
+            });
+        }
+        if (it == blocks.end()) {
+            if (!base) {
+                base = AllocateBlock();
+            }
+            try {
+                Block block { base, {} };
+                block.freeSlots.reserve(BLOCK_SIZE / SLOT_SIZE);
+                for (size_t offset = BLOCK_SIZE; offset > 0;
+                    offset -= SLOT_SIZE) {
+                    block.freeSlots.push_back(base + offset - SLOT_SIZE);
+                }
+                blocks.push_back(std::move(block));
+            } catch (...) {
+                FreeBlock(base);
+                throw;
+            }
+            it = std::prev(blocks.end());
+        }
+    }
+
+    const auto slot = it->freeSlots.back();
+    it->freeSlots.pop_back();
+    std::memset(slot, 0xCC, SLOT_SIZE);
+    return slot;
+}
+
+void hook::FreeSlot(uint8_t* slot) noexcept {
+    auto& [mutex, blocks] = GetAllocator();
+    std::lock_guard lock { mutex };
+
+    const auto it = std::ranges::find_if(blocks, [slot](const Block& block) {
+        return slot >= block.base && slot < block.base + BLOCK_SIZE;
+    });
+    if (it == blocks.end()) {
+        return;
+    }
+    // Capacity was reserved for every slot of the block
+    it->freeSlots.push_back(slot);
+    if (it->freeSlots.size() == BLOCK_SIZE / SLOT_SIZE) {
+        FreeBlock(it->base);
+        blocks.erase(it);
+    }
+}
+
+#ifdef _WIN32
+void hook::WriteCode(uint8_t* address, const uint8_t* bytes, const size_t size) {
+    DWORD protection {};
+    if (!VirtualProtect(address, size, PAGE_EXECUTE_READWRITE, &protection)) {
+        ThrowLastError();
+    }
+    Store(address, bytes, size);
+    VirtualProtect(address, size, protection, &protection);
+    FlushInstructionCache(GetCurrentProcess(), address, size);
+}
+
+// Threads are listed before any is suspended, and the handles reserved, so
+// that nothing allocates while a suspended thread may hold the heap lock
+hook::ThreadFreezer::ThreadFreezer() {
+    const HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) {
+        ThrowLastError();
+    }
+
+    std::vector<DWORD> threadIds {};
+    try {
+        THREADENTRY32 entry { .dwSize = sizeof(entry) };
+        for (BOOL found = Thread32First(snapshot, &entry); found;
+            found = Thread32Next(snapshot, &entry)) {
+            if (entry.th32OwnerProcessID == GetCurrentProcessId() &&
+                entry.th32ThreadID != GetCurrentThreadId()) {
+                threadIds.push_back(entry.th32ThreadID);
+            }
+        }
+        threads.reserve(threadIds.size());
+    } catch (...) {
+        CloseHandle(snapshot);
+        throw;
+    }
+    CloseHandle(snapshot);
+
+    for (const auto threadId : threadIds) {
+        const HANDLE thread = OpenThread(
+            THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_SET_CONTEXT,
+            FALSE, threadId);
+        if (!thread) {
+            continue;
+        }
+        if (SuspendThread(thread) == static_cast<DWORD>(-1)) {
+            CloseHandle(thread);
+            continue;
+        }
+        threads.push_back(thread);
+    }
+}
+
+hook::ThreadFreezer::~ThreadFreezer() noexcept {
+    for (const auto thread : threads) {
+        ResumeThread(thread);
+        CloseHandle(thread);
+    }
+}
+
+void hook::ThreadFreezer::RedirectInstructionPointers(
+    const std::function<uintptr_t(uintptr_t)>& relocate) noexcept {
+    for (const auto thread : threads) {
+        CONTEXT context { .ContextFlags = CONTEXT_CONTROL };
+        if (!GetThreadContext(thread, &context)) {
+            continue;
+        }
+        if (const auto rip = relocate(context.Rip); rip != context.Rip) {
+            context.Rip = rip;
+            SetThreadContext(thread, &context);
+        }
+    }
+}
+#else
+// The pages get back the protection each had before, which may be a guard
+// set by another hook rather than read and execute
+void hook::WriteCode(uint8_t* address, const uint8_t* bytes, const size_t size) {
+    const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto first = reinterpret_cast<uintptr_t>(address) & ~(pageSize - 1);
+    const auto last = reinterpret_cast<uintptr_t>(address) + size;
+    const auto length = (last - first + pageSize - 1) & ~(pageSize - 1);
+    const auto pages = reinterpret_cast<void*>(first);
+
+    const auto protections = QueryProtections(first, first + length);
+    if (mprotect(pages, length, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+        ThrowLastError();
+    }
+    Store(address, bytes, size);
+    for (const auto& [begin, end, protection] : protections) {
+        mprotect(reinterpret_cast<void*>(begin), end - begin, protection);
+    }
+    __builtin___clear_cache(
+        reinterpret_cast<char*>(address),
+        reinterpret_cast<char*>(address + size));
+}
+
+hook::ThreadFreezer::ThreadFreezer() = default;
+hook::ThreadFreezer::~ThreadFreezer() noexcept = default;
+
+void hook::ThreadFreezer::RedirectInstructionPointers(
+    const std::function<uintptr_t(uintptr_t)>&) noexcept {}
+#endif
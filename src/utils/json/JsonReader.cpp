@@ -0,0 +1,393 @@
+#include "utils/json/JsonReader.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace {
+bool IsDigit(const char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+int HexDigit(const char c) noexcept {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+void AppendUtf8(std::string& out, const uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+} // namespace
+
+JsonReader::JsonReader(const std::string_view text) noexcept
+    : text { text }
+    , position { 0 }
+    , expect { Expect::Value }
+    , depth { 0 }
+    , isObjects {}
+    , value {}
+    , buffer {}
+    , error {}
+    , errorPosition { 0 } {}
+
+JsonToken JsonReader::Next() noexcept {
+    if (HasError()) {
+        return JsonToken::Error;
+    }
+
+    SkipWhitespace();
+    if (position == text.size() && expect != Expect::Done) {
+        return Fail("Unexpected end of input");
+    }
+
+    switch (expect) {
+        case Expect::Done: {
+            if (position != text.size()) {
+                return Fail("Unexpected character after the value");
+            }
+            return JsonToken::End;
+        }
+        case Expect::CommaOrEnd: {
+            const bool isObject = isObjects[depth - 1];
+            const char c = text[position];
+            if (c == (isObject ? '}' : ']')) {
+                return EndContainer(isObject);
+            }
+            if (c != ',') {
+                return Fail(isObject ? "Expected ',' or '}'" : "Expected ',' or ']'");
+            }
+            ++position;
+            expect = isObject ? Expect::Key : Expect::Value;
+            return Next();
+        }
+        case Expect::FirstKeyOrEnd: {
+            if (text[position] == '}') {
+                return EndContainer(true);
+            }
+            [[fallthrough]];
+        }
+        case Expect::Key: {
+            if (text[position] != '"') {
+                return Fail("Expected a key");
+            }
+            if (!ReadString()) {
+                return JsonToken::Error;
+            }
+            SkipWhitespace();
+            if (position == text.size() || text[position] != ':') {
+                return Fail("Expected ':'");
+            }
+            ++position;
+            expect = Expect::Value;
+            return JsonToken::Key;
+        }
+        case Expect::FirstValueOrEnd: {
+            if (text[position] == ']') {
+                return EndContainer(false);
+            }
+            [[fallthrough]];
+        }
+        case Expect::Value: {
+            switch (text[position]) {
+                case '{': return BeginContainer(true);
+                case '[': return BeginContainer(false);
+                default: return ReadScalar();
+            }
+        }
+    }
+    return Fail("Invalid state");
+}
+
+JsonToken JsonReader::SkipValue(const JsonToken first) noexcept {
+    if (first != JsonToken::BeginObject && first != JsonToken::BeginArray) {
+        return first;
+    }
+
+    size_t level = 1;
+    while (true) {
+        const auto token = Next();
+        switch (token) {
+            case JsonToken::BeginObject: case JsonToken::BeginArray: {
+                ++level;
+                break;
+            }
+            case JsonToken::EndObject: case JsonToken::EndArray: {
+                if (--level == 0) {
+                    return token;
+                }
+                break;
+            }
+            case JsonToken::Error: {
+                return token;
+            }
+            default: break;
+        }
+    }
+}
+
+std::string_view JsonReader::Value() const noexcept {
+    return value;
+}
+
+bool JsonReader::HasError() const noexcept {
+    return !error.empty();
+}
+
+std::string JsonReader::Error() const {
+    if (!HasError()) {
+        return {};
+    }
+
+    const auto before = text.substr(0, errorPosition);
+    const auto line = std::ranges::count(before, '\n') + 1;
+    const auto lineStart = before.rfind('\n');
+    const auto column = errorPosition -
+        (lineStart == std::string_view::npos ? 0 : lineStart + 1) + 1;
+    return std::string { error } + " at line " + std::to_string(line) +
+        ", column " + std::to_string(column);
+}
+
+JsonToken JsonReader::Fail(const std::string_view message) noexcept {
+    if (!HasError()) {
+        error = message;
+        errorPosition = position;
+    }
+    return JsonToken::Error;
+}
+
+JsonToken JsonReader::BeginContainer(const bool isObject) noexcept {
+    if (depth == MAX_DEPTH) {
+        return Fail("Maximum nesting depth exceeded");
+    }
+    ++position;
+    isObjects[depth++] = isObject;
+    expect = isObject ? Expect::FirstKeyOrEnd : Expect::FirstValueOrEnd;
+    return isObject ? JsonToken::BeginObject : JsonToken::BeginArray;
+}
+
+JsonToken JsonReader::EndContainer(const bool isObject) noexcept {
+    ++position;
+    --depth;
+    return EndValue(isObject ? JsonToken::EndObject : JsonToken::EndArray);
+}
+
+JsonToken JsonReader::ReadScalar() noexcept {
+    const char c = text[position];
+    if (c == '"') {
+        return ReadString() ? EndValue(JsonToken::String) : JsonToken::Error;
+    }
+    if (c == '-' || IsDigit(c)) {
+        return ReadNumber() ? EndValue(JsonToken::Number) : JsonToken::Error;
+    }
+    if (c == 't') {
+        return ReadLiteral("true") ? EndValue(JsonToken::True) : JsonToken::Error;
+    }
+    if (c == 'f') {
+        return ReadLiteral("false") ? EndValue(JsonToken::False) : JsonToken::Error;
+    }
+    if (c == 'n') {
+        return ReadLiteral("null") ? EndValue(JsonToken::Null) : JsonToken::Error;
+    }
+    return Fail("Expected a value");
+}
+
+JsonToken JsonReader::EndValue(const JsonToken token) noexcept {
+    expect = depth == 0 ? Expect::Done : Expect::CommaOrEnd;
+    return token;
+}
+
+bool JsonReader::ReadString() noexcept {
+    const size_t start = ++position;
+
+    // Strings without escapes are returned in place
+    while (position < text.size()) {
+        const char c = text[position];
+        if (c == '"') {
+            value = text.substr(start, position++ - start);
+            return true;
+        }
+        if (c == '\\') {
+            break;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            Fail("Unescaped control character in string");
+            return false;
+        }
+        ++position;
+    }
+
+    try {
+        buffer.assign(text.substr(start, position - start));
+        while (position < text.size()) {
+            const char c = text[position];
+            if (c == '"') {
+                ++position;
+                value = buffer;
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                Fail("Unescaped control character in string");
+                return false;
+            }
+            if (c != '\\') {
+                buffer += c;
+                ++position;
+                continue;
+            }
+
+            if (++position == text.size()) {
+                break;
+            }
+            switch (text[position++]) {
+                case '"': buffer += '"'; break;
+                case '\\': buffer += '\\'; break;
+                case '/': buffer += '/'; break;
+                case 'b': buffer += '\b'; break;
+                case 'f': buffer += '\f'; break;
+                case 'n': buffer += '\n'; break;
+                case 'r': buffer += '\r'; break;
+                case 't': buffer += '\t'; break;
+                case 'u': {
+                    const auto readHex = [this](uint32_t& out) noexcept {
+                        if (text.size() - position < 4) {
+                            return false;
+                        }
+                        out = 0;
+                        for (size_t i = 0; i < 4; ++i) {
+                            const int digit = HexDigit(text[position++]);
+                            if (digit < 0) {
+                                return false;
+                            }
+                            out = out << 4 | static_cast<uint32_t>(digit);
+                        }
+                        return true;
+                    };
+
+                    uint32_t codePoint {};
+                    if (!readHex(codePoint)) {
+                        Fail("Invalid unicode escape");
+                        return false;
+                    }
+                    // Surrogate pairs encode code points above U+FFFF
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+                        if (text.substr(position, 2) != "\\u") {
+                            Fail("Invalid surrogate pair");
+                            return false;
+                        }
+                        position += 2;
+                        uint32_t low {};
+                        if (!readHex(low) || low < 0xDC00 || low >= 0xE000) {
+                            Fail("Invalid surrogate pair");
+                            return false;
+                        }
+                        codePoint = 0x10000 +
+                            ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (codePoint >= 0xDC00 && codePoint < 0xE000) {
+                        Fail("Invalid surrogate pair");
+                        return false;
+                    }
+                    AppendUtf8(buffer, codePoint);
+                    break;
+                }
+                default: {
+                    --position;
+                    Fail("Invalid escape sequence");
+                    return false;
+                }
+            }
+        }
+    } catch (...) {
+        Fail("Out of memory");
+        return false;
+    }
+    Fail("Unterminated string");
+    return false;
+}
+
+bool JsonReader::ReadNumber() noexcept {
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    const size_t start = position;
+    const auto digits = [this]() noexcept {
+        const size_t first = position;
+        while (position < text.size() && IsDigit(text[position])) {
+            ++position;
+        }
+        return position - first;
+    };
+    const auto peek = [this]() noexcept {
+        return position < text.size() ? text[position] : '\0';
+    };
+
+    if (peek() == '-') {
+        ++position;
+    }
+    if (peek() == '0') {
+        ++position;
+    } else if (digits() == 0) {
+        Fail("Invalid number");
+        return false;
+    }
+    if (peek() == '.') {
+        ++position;
+        if (digits() == 0) {
+            Fail("Invalid number");
+            return false;
+        }
+    }
+    if (peek() == 'e' || peek() == 'E') {
+        ++position;
+        if (peek() == '+' || peek() == '-') {
+            ++position;
+        }
+        if (digits() == 0) {
+            Fail("Invalid number");
+            return false;
+        }
+    }
+    value = text.substr(start, position - start);
+    return true;
+}
+
+bool JsonReader::ReadLiteral(const std::string_view literal) noexcept {
+    if (text.substr(position, literal.size()) != literal) {
+        Fail("Expected a value");
+        return false;
+    }
+    position += literal.size();
+    value = {};
+    return true;
+}
+
+void JsonReader::SkipWhitespace() noexcept {
+    while (position < text.size()) {
+        const char c = text[position];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return;
+        }
+        ++position;
+    }
+}
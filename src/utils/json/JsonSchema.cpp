@@ -0,0 +1,25 @@
+#include "utils/json/JsonSchema.hpp"
+#include "utils/json/JsonReader.hpp"
+#include "utils/json/JsonWriter.hpp"
+
+#include <string>
+
+std::string JsonCodec<bool>::TypeName() {
+    return "a boolean";
+}
+
+bool JsonCodec<bool>::Read(
+    JsonReader& reader,
+    const JsonToken token,
+    bool& value) noexcept {
+    if (token != JsonToken::True && token != JsonToken::False) {
+        reader.SkipValue(token);
+        return false;
+    }
+    value = token == JsonToken::True;
+    return true;
+}
+
+void JsonCodec<bool>::Write(JsonWriter& writer, const bool value) {
+    writer.Bool(value);
+}
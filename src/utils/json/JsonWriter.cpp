@@ -0,0 +1,168 @@
+#include "utils/json/JsonWriter.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+JsonWriter::JsonWriter(const int indent)
+    : indent { indent }
+    , output {}
+    , isEmpty {}
+    , isAfterKey { false } {}
+
+void JsonWriter::BeginObject() {
+    Begin('{');
+}
+
+void JsonWriter::EndObject() {
+    End('}');
+}
+
+void JsonWriter::BeginArray() {
+    Begin('[');
+}
+
+void JsonWriter::EndArray() {
+    End(']');
+}
+
+void JsonWriter::Key(const std::string_view key) {
+    BeginValue();
+    AppendString(key);
+    output += indent < 0 ? ":" : ": ";
+    isAfterKey = true;
+}
+
+void JsonWriter::String(const std::string_view value) {
+    BeginValue();
+    AppendString(value);
+}
+
+void JsonWriter::Bool(const bool value) {
+    BeginValue();
+    output += value ? "true" : "false";
+}
+
+void JsonWriter::Null() {
+    BeginValue();
+    output += "null";
+}
+
+void JsonWriter::Integer(const int64_t value) {
+    BeginValue();
+    AppendNumber(value);
+}
+
+void JsonWriter::Unsigned(const uint64_t value) {
+    BeginValue();
+    AppendNumber(value);
+}
+
+void JsonWriter::Number(const float value) {
+    BeginValue();
+    AppendNumber(value);
+}
+
+void JsonWriter::Number(const double value) {
+    BeginValue();
+    AppendNumber(value);
+}
+
+const std::string& JsonWriter::Output() const noexcept {
+    return output;
+}
+
+void JsonWriter::BeginValue() {
+    // Values after a key share its line
+    if (isAfterKey) {
+        isAfterKey = false;
+        return;
+    }
+    if (isEmpty.empty()) {
+        return;
+    }
+    if (!isEmpty.back()) {
+        output += ',';
+    }
+    isEmpty.back() = false;
+    NewLine();
+}
+
+void JsonWriter::Begin(const char bracket) {
+    BeginValue();
+    output += bracket;
+    isEmpty.push_back(true);
+}
+
+void JsonWriter::End(const char bracket) {
+    const bool wasEmpty = isEmpty.back();
+    isEmpty.pop_back();
+    if (!wasEmpty) {
+        NewLine();
+    }
+    output += bracket;
+}
+
+void JsonWriter::NewLine() {
+    if (indent < 0) {
+        return;
+    }
+    output += '\n';
+    output.append(isEmpty.size() * static_cast<size_t>(indent), ' ');
+}
+
+void JsonWriter::AppendString(const std::string_view value) {
+    constexpr auto HEX = "0123456789abcdef";
+
+    output += '"';
+    for (const char c : value) {
+        switch (c) {
+            case '"': output += "\\\""; break;
+            case '\\': output += "\\\\"; break;
+            case '\b': output += "\\b"; break;
+            case '\f': output += "\\f"; break;
+            case '\n': output += "\\n"; break;
+            case '\r': output += "\\r"; break;
+            case '\t': output += "\\t"; break;
+            default: {
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    output += "\\u00";
+                    output += HEX[c >> 4];
+                    output += HEX[c & 0xF];
+                } else {
+                    output += c;
+                }
+                break;
+            }
+        }
+    }
+    output += '"';
+}
+
+template <typename T>
+void JsonWriter::AppendNumber(const T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        // JSON has no infinities or NaNs
+        if (!std::isfinite(value)) {
+            output += "null";
+            return;
+        }
+    }
+
+    std::array<char, 32> buffer {};
+    const auto result = std::to_chars(
+        buffer.data(), buffer.data() + buffer.size(), value);
+    const std::string_view text { buffer.data(), result.ptr };
+    output += text;
+
+    // Keeps floating-point values recognizable as such
+    if constexpr (std::is_floating_point_v<T>) {
+        if (text.find_first_of(".e") == std::string_view::npos) {
+            output += ".0";
+        }
+    }
+}
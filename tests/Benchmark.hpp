@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+// Minimal benchmark registry. Each BENCHMARK is a function registered before
+// main and run by BenchmarkMain; it calls Run once per measured case, and
+// Run grows the iteration count until a case takes long enough to time.
+namespace bench {
+bool Register(std::string_view name, void (*function)());
+
+// The body runs the case the given number of times. Bytes per iteration, if
+// non-zero, add a throughput column.
+void Run(
+    std::string_view name,
+    const std::function<void(uint64_t iterations)>& body,
+    uint64_t bytesPerIteration = 0);
+
+template <typename T>
+void DoNotOptimize(const T& value) noexcept {
+#ifdef _MSC_VER
+    static_cast<void>(*static_cast<const volatile char*>(
+        static_cast<const void*>(&value)));
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+} // namespace bench
+
+#define BENCHMARK(name) \
+    static void name(); \
+    [[maybe_unused]] static const bool name##Registered = \
+        bench::Register(#name, name); \
+    static void name()
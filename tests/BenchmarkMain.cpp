@@ -0,0 +1,79 @@
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+// Runs every registered benchmark, or those whose name contains the first
+// argument, printing the time per iteration of each case
+
+namespace {
+constexpr auto MIN_TIME = std::chrono::milliseconds(200);
+constexpr uint64_t MAX_ITERATIONS = uint64_t { 1 } << 32;
+
+struct BenchmarkCase {
+    std::string_view name;
+    void (*function)();
+};
+
+std::vector<BenchmarkCase>& Benchmarks() {
+    static std::vector<BenchmarkCase> benchmarks {};
+    return benchmarks;
+}
+} // namespace
+
+bool bench::Register(const std::string_view name, void (*function)()) {
+    Benchmarks().push_back({ name, function });
+    return true;
+}
+
+void bench::Run(
+    const std::string_view name,
+    const std::function<void(uint64_t iterations)>& body,
+    const uint64_t bytesPerIteration) {
+    uint64_t iterations = 1;
+    std::chrono::nanoseconds elapsed {};
+    while (true) {
+        const auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed >= MIN_TIME || iterations >= MAX_ITERATIONS) {
+            break;
+        }
+        // Aim past the minimum so that the next attempt is usually the last
+        const auto scale = elapsed.count() > 0 ?
+            1.5 * MIN_TIME / elapsed : 100.0;
+        iterations = std::max(
+            iterations + 1,
+            static_cast<uint64_t>(static_cast<double>(iterations) *
+                std::min(scale, 100.0)));
+    }
+
+    const auto nanoseconds =
+        static_cast<double>(elapsed.count()) / static_cast<double>(iterations);
+    std::cout << std::left << std::setw(48) << name << std::right
+        << std::fixed << std::setprecision(2) << std::setw(14) << nanoseconds
+        << " ns" << std::setw(12) << iterations << " iterations";
+    if (bytesPerIteration > 0) {
+        std::cout << std::setw(10)
+            << static_cast<double>(bytesPerIteration) / nanoseconds
+            << " GB/s";
+    }
+    std::cout << '\n';
+}
+
+int main(const int argc, char* argv[]) {
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+    for (const auto& [name, function] : Benchmarks()) {
+        if (name.contains(filter)) {
+            function();
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <source_location>
+#include <string_view>
+
+// Minimal test registry. Each TEST is a function registered before main and
+// run by TestMain; a failed CHECK marks the test failed and carries on, and
+// a failed REQUIRE also stops the test.
+namespace test {
+struct Failure {};
+
+bool Register(std::string_view name, void (*function)());
+void Fail(std::string_view expression, std::source_location location);
+} // namespace test
+
+#define TEST(name) \
+    static void name(); \
+    [[maybe_unused]] static const bool name##Registered = \
+        test::Register(#name, name); \
+    static void name()
+
+#define CHECK(...) \
+    ((__VA_ARGS__) ? void() : \
+        test::Fail(#__VA_ARGS__, std::source_location::current()))
+
+#define REQUIRE(...) \
+    ((__VA_ARGS__) ? void() : \
+        (test::Fail(#__VA_ARGS__, std::source_location::current()), \
+            throw test::Failure {}))
+
+#define CHECK_THROWS(...) \
+    do { \
+        bool thrown = false; \
+        try { \
+            static_cast<void>(__VA_ARGS__); \
+        } catch (...) { \
+            thrown = true; \
+        } \
+        CHECK(thrown && "throws: " #__VA_ARGS__); \
+    } while (false)
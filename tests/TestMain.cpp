@@ -0,0 +1,63 @@
+#include "Test.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <source_location>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Runs every registered test, or those whose name contains the first
+// argument, and exits with failure if any of them failed
+
+namespace {
+struct TestCase {
+    std::string_view name;
+    void (*function)();
+};
+
+std::vector<TestCase>& Tests() {
+    static std::vector<TestCase> tests {};
+    return tests;
+}
+
+bool failed = false;
+} // namespace
+
+bool test::Register(const std::string_view name, void (*function)()) {
+    Tests().push_back({ name, function });
+    return true;
+}
+
+void test::Fail(
+    const std::string_view expression, const std::source_location location) {
+    failed = true;
+    std::cerr << location.file_name() << ':' << location.line()
+        << ": check failed: " << expression << '\n';
+}
+
+int main(const int argc, char* argv[]) {
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+
+    size_t failures = 0;
+    size_t count = 0;
+    for (const auto& [name, function] : Tests()) {
+        if (!name.contains(filter)) {
+            continue;
+        }
+        failed = false;
+        try {
+            function();
+        } catch (const test::Failure&) {
+        } catch (const std::exception& e) {
+            failed = true;
+            std::cerr << name << ": unexpected exception: " << e.what() << '\n';
+        }
+        std::cout << (failed ? "[FAIL] " : "[ OK ] ") << name << '\n';
+        failures += failed;
+        ++count;
+    }
+    std::cout << count - failures << " of " << count << " tests passed\n";
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,50 @@
+#include "Benchmark.hpp"
+#include "utils/AlphaPolicy.hpp"
+#include "utils/ExponentialFilter.hpp"
+#include "utils/ManualClock.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Alpha alone over varying frame times, and a whole filter update with
+// each policy
+
+namespace {
+template <typename Policy>
+void RunAlpha(const char* name) {
+    Policy policy {};
+    policy.SetTimeConstant(0.1f);
+    std::array<float, 64> deltaTimes {};
+    for (size_t i = 0; i < deltaTimes.size(); ++i) {
+        deltaTimes[i] = 0.001f + 0.0005f * static_cast<float>(i);
+    }
+    bench::Run(name, [&](const uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            bench::DoNotOptimize(policy(deltaTimes[i % deltaTimes.size()]));
+        }
+    });
+}
+
+template <typename Policy>
+void RunFilter(const char* name) {
+    ExponentialFilter<float, Policy, ManualClock> filter { 0.1f, 45.0f };
+    bench::Run(name, [&](const uint64_t iterations) {
+        auto time = ManualClock::time_point {};
+        for (uint64_t i = 0; i < iterations; ++i) {
+            time += std::chrono::microseconds(6944 + i % 64);
+            bench::DoNotOptimize(filter.Update(90.0f, time));
+        }
+    });
+}
+} // namespace
+
+BENCHMARK(AlphaPolicy) {
+    RunAlpha<ExactAlpha<float>>("alpha, exact");
+    RunAlpha<PolynomialAlpha<float>>("alpha, polynomial");
+    RunAlpha<TableAlpha<float>>("alpha, table");
+    RunFilter<ExactAlpha<float>>("filter update, exact");
+    RunFilter<PolynomialAlpha<float>>("filter update, polynomial");
+    RunFilter<TableAlpha<float>>("filter update, table");
+}
@@ -0,0 +1,66 @@
+#include "Benchmark.hpp"
+#include "utils/CycleCounter.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Cost of counting a call: reading the cycle counter, adding to a counter
+// alone and from several threads at once, against a shared atomic counter
+
+namespace {
+struct alignas(64) AtomicTotals {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> cycles;
+};
+
+template <typename AddFunction>
+void RunThreads(
+    const std::string_view name,
+    const uint64_t threadCount,
+    AddFunction add) {
+    bench::Run(name, [&](const uint64_t iterations) {
+        std::vector<std::jthread> threads {};
+        for (uint64_t i = 0; i < threadCount; ++i) {
+            threads.emplace_back([&, iterations] {
+                for (uint64_t j = 0; j < iterations; ++j) {
+                    add(j);
+                }
+            });
+        }
+    });
+}
+} // namespace
+
+BENCHMARK(CycleCounterAdd) {
+    bench::Run("read cycles", [](const uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            bench::DoNotOptimize(ReadCycles());
+        }
+    });
+
+    CycleCounter counter {};
+    bench::Run("scope", [&](const uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const CycleScope scope { counter };
+        }
+    });
+
+    // Iterations of the threaded cases are one add on every thread
+    const auto addToCounter = [&](const uint64_t cycles) {
+        counter.Add(cycles);
+    };
+    AtomicTotals totals {};
+    const auto addToAtomics = [&](const uint64_t cycles) {
+        totals.calls.fetch_add(1, std::memory_order_relaxed);
+        totals.cycles.fetch_add(cycles, std::memory_order_relaxed);
+    };
+    RunThreads("counter add, 1 thread", 1, addToCounter);
+    RunThreads("atomic add, 1 thread", 1, addToAtomics);
+    RunThreads("counter add, 4 threads", 4, addToCounter);
+    RunThreads("atomic add, 4 threads", 4, addToAtomics);
+    bench::DoNotOptimize(counter.Read().calls);
+    bench::DoNotOptimize(totals.calls.load());
+}
@@ -0,0 +1,70 @@
+#include "Benchmark.hpp"
+#include "utils/AlphaPolicy.hpp"
+#include "utils/ExponentialFilter.hpp"
+#include "utils/ExponentialFilterBank.hpp"
+#include "utils/ManualClock.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One bank update against N scalar filters, for N = 1, 8, 64 and 1024
+
+namespace {
+using Scalar = ExponentialFilter<float, ExactAlpha<float>, ManualClock>;
+
+template <size_t N>
+void RunBank(const bool isUniform) {
+    const auto bank = std::make_unique<
+        ExponentialFilterBank<float, N, ManualClock>>(0.1f, 45.0f);
+    if (!isUniform) {
+        for (size_t i = 0; i < N; ++i) {
+            bank->SetTimeConstant(i, 0.05f + 0.001f * static_cast<float>(i));
+        }
+    }
+    std::array<float, N> input {};
+    input.fill(90.0f);
+
+    const auto name = std::string { "bank, " } + std::to_string(N) +
+        (isUniform ? " channels" : " channels, per-channel time constants");
+    bench::Run(name, [&](const uint64_t iterations) {
+        auto time = ManualClock::time_point {};
+        for (uint64_t i = 0; i < iterations; ++i) {
+            time += std::chrono::milliseconds(16);
+            bench::DoNotOptimize(bank->Update(input, time).data());
+        }
+    });
+}
+
+template <size_t N>
+void RunScalars() {
+    std::vector<Scalar> filters(N, Scalar { 0.1f, 45.0f });
+    bench::Run("scalar filters, " + std::to_string(N) + " channels",
+        [&](const uint64_t iterations) {
+            auto time = ManualClock::time_point {};
+            for (uint64_t i = 0; i < iterations; ++i) {
+                time += std::chrono::milliseconds(16);
+                for (auto& filter : filters) {
+                    bench::DoNotOptimize(filter.Update(90.0f, time));
+                }
+            }
+        });
+}
+
+template <size_t N>
+void RunAll() {
+    RunScalars<N>();
+    RunBank<N>(true);
+    RunBank<N>(false);
+}
+} // namespace
+
+BENCHMARK(ExponentialFilterBankUpdate) {
+    RunAll<1>();
+    RunAll<8>();
+    RunAll<64>();
+    RunAll<1024>();
+}
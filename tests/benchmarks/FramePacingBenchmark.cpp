@@ -0,0 +1,41 @@
+#include "Benchmark.hpp"
+#include "plugin/FramePacing.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// One call recorded on the render thread, by 1, 4 or 8 cameras taking turns,
+// so that later cameras are found further into the slots
+
+namespace {
+void RunInstances(const size_t instanceCount) {
+    const auto pacing = std::make_unique<FramePacing>();
+    auto time = FramePacing::TimePoint {} + std::chrono::seconds(100);
+    // The first call of each takes its slot, and a sample lets the rest
+    // record intervals
+    for (size_t i = 0; i < instanceCount; ++i) {
+        pacing->Record(reinterpret_cast<void*>((i + 1) * 0x1000), time);
+    }
+    pacing->Sample(time);
+
+    const auto name = "record, " + std::to_string(instanceCount) +
+        (instanceCount == 1 ? " camera" : " cameras");
+    bench::Run(name, [&](const uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const auto instance = (i % instanceCount + 1) * 0x1000;
+            time += std::chrono::microseconds(6944) / instanceCount;
+            pacing->Record(reinterpret_cast<void*>(instance), time);
+        }
+    });
+    bench::DoNotOptimize(pacing->Snapshot().size());
+}
+} // namespace
+
+BENCHMARK(FramePacingRecord) {
+    RunInstances(1);
+    RunInstances(4);
+    RunInstances(FramePacing::MAX_INSTANCES);
+}
@@ -0,0 +1,57 @@
+#include "Benchmark.hpp"
+#include "utils/HookEngine.hpp"
+#include "utils/hook/InlineHook.hpp"
+#include "utils/hook/TestCode.hpp"
+
+#include <cstdint>
+
+// Cost of calling through a hook's detour and trampoline, and of patching
+
+namespace {
+test::Function original = nullptr;
+
+int Detour(const int x) {
+    return original(x);
+}
+
+void RunCalls(const char* name, const test::Function function) {
+    bench::Run(name, [function](const uint64_t iterations) {
+        int x = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            x = function(x);
+            bench::DoNotOptimize(x);
+        }
+    });
+}
+} // namespace
+
+BENCHMARK(InlineHookCall) {
+    const test::TestCode code {};
+    const auto function = code.Get(test::TestCode::RIP_RELATIVE);
+    hook::InlineHook hook {
+        code.At(test::TestCode::RIP_RELATIVE), reinterpret_cast<void*>(Detour)
+    };
+    original = reinterpret_cast<test::Function>(hook.Trampoline());
+
+    RunCalls("call, unhooked", function);
+    RunCalls("call, trampoline", original);
+    hook.Enable();
+    RunCalls("call, hooked through detour and trampoline", function);
+}
+
+BENCHMARK(InlineHookApply) {
+    const test::TestCode code {};
+    const auto engine = CreateHookEngine();
+    const auto target = code.At(test::TestCode::PROLOGUE);
+    void* trampoline = nullptr;
+    engine->Create(target, reinterpret_cast<void*>(Detour), &trampoline);
+
+    const HookChange enable[] { { target, true } };
+    const HookChange disable[] { { target, false } };
+    bench::Run("apply enable and disable", [&](const uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            engine->Apply(enable);
+            engine->Apply(disable);
+        }
+    });
+}
@@ -0,0 +1,66 @@
+#include "Benchmark.hpp"
+#include "utils/json/JsonReader.hpp"
+#include "utils/json/JsonSchema.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Tokenizing and reading a document shaped like the config, and writing it
+// back, as on every reload and save
+
+namespace {
+struct Settings {
+    bool enabled = true;
+    int fov = 90;
+    std::vector<int> presets = { 60, 70, 80, 90, 100, 110 };
+    float smoothing = 0.1f;
+    float beta = 0.007f;
+    int enableKey = 0x70;
+    int nextKey = 0x71;
+    int previousKey = 0x72;
+};
+
+constexpr auto SCHEMA = MakeJsonSchema<Settings>(
+    MakeJsonField("enabled", &Settings::enabled),
+    JSON_FIELD_IF("fov", Settings, fov, fov > 0 && fov < 180),
+    MakeJsonField("presets", &Settings::presets),
+    JSON_FIELD_IF("smoothing", Settings, smoothing,
+        smoothing >= 0.0f && smoothing <= 1.0f),
+    JSON_FIELD_IF("beta", Settings, beta, beta >= 0.0f),
+    JSON_FIELD_IF("enable_key", Settings, enableKey,
+        enableKey > 0 && enableKey < 255),
+    JSON_FIELD_IF("next_key", Settings, nextKey, nextKey > 0 && nextKey < 255),
+    JSON_FIELD_IF("previous_key", Settings, previousKey,
+        previousKey > 0 && previousKey < 255)
+);
+} // namespace
+
+BENCHMARK(JsonConfigDocument) {
+    const auto text = SCHEMA.Write(Settings {});
+
+    bench::Run("reader, tokens", [&](const uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            JsonReader reader { text };
+            auto token = reader.Next();
+            while (token != JsonToken::End && token != JsonToken::Error) {
+                token = reader.Next();
+            }
+            bench::DoNotOptimize(token);
+        }
+    }, text.size());
+
+    bench::Run("schema, read", [&](const uint64_t iterations) {
+        Settings settings {};
+        for (uint64_t i = 0; i < iterations; ++i) {
+            bench::DoNotOptimize(SCHEMA.Read(text, settings));
+        }
+        bench::DoNotOptimize(settings.fov);
+    }, text.size());
+
+    bench::Run("schema, write", [&](const uint64_t iterations) {
+        const Settings settings {};
+        for (uint64_t i = 0; i < iterations; ++i) {
+            bench::DoNotOptimize(SCHEMA.Write(settings));
+        }
+    }, text.size());
+}
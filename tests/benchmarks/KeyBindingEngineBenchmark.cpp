@@ -0,0 +1,101 @@
+#include "Benchmark.hpp"
+#include "utils/KeyBinding.hpp"
+#include "utils/KeyBindingEngine.hpp"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Events per second through the engine on a synthetic stream of downs,
+// repeats and ups, with few, mixed and many bindings
+
+namespace {
+enum class EventType : uint8_t {
+    Down,
+    Hold,
+    Up
+};
+
+struct KeyEvent {
+    uint8_t vKey;
+    EventType type;
+};
+
+std::vector<KeyEvent> MakeStream() {
+    constexpr std::array<uint8_t, 16> KEYS {
+        0x27, 0x25, 'K', 'F', 'G', 0xA2, 0xA0, 'W',
+        'A', 'S', 'D', 0x20, 0x28, 0x7B, 'E', '1'
+    };
+    std::mt19937 random { 3 };
+    std::bitset<256> isDown {};
+    std::vector<KeyEvent> stream {};
+    for (int i = 0; i < 65536; ++i) {
+        const auto vKey = KEYS[random() % KEYS.size()];
+        auto type = EventType::Down;
+        if (isDown.test(vKey)) {
+            type = random() % 2 == 0 ? EventType::Hold : EventType::Up;
+        }
+        isDown.set(vKey, type != EventType::Up);
+        stream.push_back({ vKey, type });
+    }
+    return stream;
+}
+
+void Run(const char* name, const std::vector<KeyBinding>& bindings) {
+    static const auto stream = MakeStream();
+    KeyBindingEngine engine { bindings };
+    bench::Run(name, [&](const uint64_t iterations) {
+        auto time = KeyBindingEngine::Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const auto [vKey, type] = stream[i % stream.size()];
+            time += std::chrono::milliseconds(50);
+            switch (type) {
+                case EventType::Down: {
+                    bench::DoNotOptimize(engine.OnKeyDown(vKey, time));
+                    break;
+                }
+                case EventType::Hold: {
+                    bench::DoNotOptimize(engine.OnKeyHold(vKey, time));
+                    break;
+                }
+                case EventType::Up: {
+                    bench::DoNotOptimize(engine.OnKeyUp(vKey, time));
+                    break;
+                }
+            }
+        }
+    });
+}
+} // namespace
+
+BENCHMARK(KeyBindingEvents) {
+    Run("event, 4 single keys", {
+        MakeKeyBinding(0x28), MakeKeyBinding(0x27), MakeKeyBinding(0x25),
+        MakeKeyBinding(0x7B)
+    });
+
+    std::vector<KeyBinding> mixed {};
+    for (const auto text : {
+        "Right", "Ctrl+Right", "Ctrl+K F", "tap:G", "hold:G", "Left"
+    }) {
+        mixed.push_back(ParseKeyBinding(text));
+    }
+    Run("event, 6 mixed bindings", mixed);
+
+    // Every letter with every modifier combination, then a digit
+    std::vector<KeyBinding> many {};
+    for (int i = 0; i < 26 * 16; ++i) {
+        many.push_back({
+            {
+                { static_cast<uint8_t>('A' + i % 26),
+                    static_cast<KeyModifiers>(i / 26) },
+                { static_cast<uint8_t>('0' + i % 10), KeyModifiers::None }
+            },
+            KeyPress::Down
+        });
+    }
+    Run("event, 416 sequences", many);
+}
@@ -0,0 +1,75 @@
+#include "Benchmark.hpp"
+#include "utils/MulticastRing.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Synthetic key inputs pushed in bursts, as the keyboard hook does, while
+// 1 to 8 consumer threads drain them through their own readers. Iterations
+// are pushes, timed until every consumer has caught up.
+
+namespace {
+// Same layout as the keyboard observer's input: a time, a key and an action
+struct KeyInput {
+    uint64_t time : 48;
+    uint64_t vKey : 8;
+    uint64_t action : 8;
+};
+
+using Ring = MulticastRing<KeyInput, 1024>;
+
+constexpr uint64_t BURST = 256;
+
+void RunConsumers(const size_t consumerCount) {
+    Ring ring {};
+    const auto name = "push, " + std::to_string(consumerCount) +
+        (consumerCount == 1 ? " consumer" : " consumers");
+    bench::Run(name, [&](const uint64_t iterations) {
+        std::atomic<bool> isDone { false };
+        std::atomic<size_t> readyCount { 0 };
+        std::vector<std::jthread> consumers {};
+        for (size_t i = 0; i < consumerCount; ++i) {
+            consumers.emplace_back([&] {
+                Ring::Reader reader { ring };
+                ++readyCount;
+                KeyInput input {};
+                uint64_t keys = 0;
+                while (true) {
+                    if (reader.Next(input)) {
+                        keys += input.vKey;
+                    } else if (isDone.load(std::memory_order_acquire)) {
+                        while (reader.Next(input)) {
+                            keys += input.vKey;
+                        }
+                        break;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                bench::DoNotOptimize(keys);
+            });
+        }
+        while (readyCount.load() < consumerCount) {
+            std::this_thread::yield();
+        }
+
+        for (uint64_t i = 0; i < iterations; ++i) {
+            ring.Push(KeyInput { i, 0x25 + i % 4, i % 3 });
+            if (i % BURST == BURST - 1) {
+                std::this_thread::yield();
+            }
+        }
+        isDone.store(true, std::memory_order_release);
+    });
+}
+} // namespace
+
+BENCHMARK(MulticastRingPush) {
+    for (const size_t consumerCount : { 1, 2, 4, 8 }) {
+        RunConsumers(consumerCount);
+    }
+}
@@ -0,0 +1,85 @@
+#include "Benchmark.hpp"
+#include "utils/PageHookIndex.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Fault-path lookups with 1, 16 and 256 hooks, one per page or packed 16
+// to a page, and the cost of inserting and erasing a hook
+
+namespace {
+constexpr size_t PAGE_SIZE = 0x1000;
+constexpr uintptr_t BASE = 0x140001000;
+
+void* Address(const uintptr_t value) noexcept {
+    return reinterpret_cast<void*>(value);
+}
+
+std::vector<uintptr_t> Targets(const size_t count, const size_t perPage) {
+    std::vector<uintptr_t> targets {};
+    for (size_t i = 0; i < count; ++i) {
+        targets.push_back(BASE + (i / perPage) * 7 * PAGE_SIZE +
+            (i % perPage) * 0x40);
+    }
+    return targets;
+}
+} // namespace
+
+BENCHMARK(PageHookIndexLookup) {
+    for (const size_t perPage : { 1, 16 }) {
+        for (const size_t count : { 1, 16, 256 }) {
+            PageHookIndex index { PAGE_SIZE };
+            const auto targets = Targets(count, perPage);
+            for (const auto target : targets) {
+                index.Insert(Address(target), Address(target + 1));
+            }
+
+            const auto name = "FindDetour, " + std::to_string(count) +
+                " hooks, " + std::to_string(perPage) + " per page";
+            bench::Run(name, [&](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; ++i) {
+                    bench::DoNotOptimize(index.FindDetour(
+                        Address(targets[i % targets.size()])));
+                }
+            });
+
+            // A fault on a hooked page away from any target
+            bench::Run("IsHookedPage miss, " + std::to_string(count) +
+                " hooks, " + std::to_string(perPage) + " per page",
+                [&](const uint64_t iterations) {
+                    for (uint64_t i = 0; i < iterations; ++i) {
+                        bench::DoNotOptimize(index.IsHookedPage(
+                            Address(targets[i % targets.size()] + PAGE_SIZE)));
+                    }
+                });
+        }
+    }
+}
+
+BENCHMARK(PageHookIndexChange) {
+    for (const size_t count : { 1, 16, 256 }) {
+        PageHookIndex index { PAGE_SIZE };
+        const auto targets = Targets(count, 1);
+        for (const auto target : targets) {
+            index.Insert(Address(target), Address(target + 1));
+        }
+
+        // Snapshots are only freed by Clear, so the index is rebuilt now
+        // and then to keep memory bounded
+        const auto extra = BASE - 3 * PAGE_SIZE;
+        bench::Run("Insert and Erase, " + std::to_string(count) + " hooks",
+            [&](const uint64_t iterations) {
+                for (uint64_t i = 0; i < iterations; ++i) {
+                    index.Insert(Address(extra), Address(extra + 1));
+                    index.Erase(Address(extra));
+                    if (i % 1024 == 1023) {
+                        index.Clear();
+                        for (const auto target : targets) {
+                            index.Insert(Address(target), Address(target + 1));
+                        }
+                    }
+                }
+            });
+    }
+}
@@ -0,0 +1,103 @@
+#include "Benchmark.hpp"
+#include "utils/PeImage.hpp"
+#include "utils/Signature.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Scanning only the code section of an image, on one thread or all of them,
+// against scanning the whole image
+
+namespace {
+constexpr uint32_t SECTION_ALIGNMENT = 0x1000;
+constexpr uint32_t TEXT_SIZE = 32 << 20;
+constexpr uint32_t RDATA_SIZE = 64 << 20;
+constexpr uint32_t SIZE_OF_IMAGE = SECTION_ALIGNMENT + TEXT_SIZE + RDATA_SIZE;
+
+template <typename T>
+void Write(std::vector<uint8_t>& data, const size_t offset, const T value) {
+    std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+const std::vector<uint8_t>& Image() {
+    static const auto image = [] {
+        std::mt19937 random { 27 };
+        std::uniform_int_distribution<int> byte { 0, 255 };
+        std::vector<uint8_t> image(SIZE_OF_IMAGE);
+        for (size_t i = SECTION_ALIGNMENT; i < image.size(); ++i) {
+            image[i] = static_cast<uint8_t>(byte(random));
+        }
+
+        Write<uint16_t>(image, 0, 0x5A4D);
+        Write<uint32_t>(image, 0x3C, 0x40);
+        Write<uint32_t>(image, 0x40, 0x00004550);
+        Write<uint16_t>(image, 0x46, 2);
+        Write<uint16_t>(image, 0x54, 240);
+        Write<uint16_t>(image, 0x58, 0x020B);
+        Write<uint32_t>(image, 0x58 + 56, SIZE_OF_IMAGE);
+        Write<uint32_t>(image, 0x58 + 60, SECTION_ALIGNMENT);
+
+        const auto writeSection = [&](
+            const size_t header, const char* name, const uint32_t address,
+            const uint32_t size, const uint32_t characteristics) {
+            std::memcpy(image.data() + header, name, std::strlen(name));
+            Write(image, header + 8, size);
+            Write(image, header + 12, address);
+            Write(image, header + 16, size);
+            Write(image, header + 20, address);
+            Write(image, header + 36, characteristics);
+        };
+        writeSection(0x148, ".text", SECTION_ALIGNMENT, TEXT_SIZE, 0x60000020);
+        writeSection(0x170, ".rdata", SECTION_ALIGNMENT + TEXT_SIZE,
+            RDATA_SIZE, 0x40000040);
+
+        // At the end of the code, so that it is scanned whole
+        constexpr uint8_t pattern[] { 0x48, 0x89, 0x5C, 0x24, 0x08, 0x57 };
+        std::memcpy(image.data() + SECTION_ALIGNMENT + TEXT_SIZE -
+            sizeof(pattern), pattern, sizeof(pattern));
+        return image;
+    }();
+    return image;
+}
+
+size_t ScanExecutableSections(
+    const PeImage& image, const Signature& signature,
+    const size_t threadCount) {
+    for (const auto& section : image.Sections()) {
+        if (!section.IsExecutable()) {
+            continue;
+        }
+        if (const auto offset = signature.FindParallel(
+            image.SectionData(section), threadCount)) {
+            return section.virtualAddress + *offset;
+        }
+    }
+    return 0;
+}
+} // namespace
+
+BENCHMARK(PeImageScan) {
+    const PeImage image { Image() };
+    const Signature signature { "48 89 5C 24 ?? 57" };
+    const Signature missing { "48 89 5C 24 ?? 57 41 56 41 57" };
+
+    bench::Run("whole image, 96 MiB", [&](const uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            bench::DoNotOptimize(missing.Find(image.Data()));
+        }
+    }, SIZE_OF_IMAGE);
+    for (const size_t threads : { 1, 0 }) {
+        const auto name = std::string { "executable sections, 32 MiB, " } +
+            (threads == 1 ? "1 thread" : "all threads");
+        bench::Run(name, [&](const uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                bench::DoNotOptimize(
+                    ScanExecutableSections(image, signature, threads));
+            }
+        }, TEXT_SIZE);
+    }
+}
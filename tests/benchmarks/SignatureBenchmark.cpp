@@ -0,0 +1,60 @@
+#include "Benchmark.hpp"
+#include "utils/Signature.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr size_t BUFFER_SIZE = 64 << 20;
+
+// Random code-like bytes, with the pattern only at the very end so that the
+// whole buffer is scanned
+const std::vector<uint8_t>& Buffer() {
+    static const auto data = [] {
+        std::mt19937 random { 26 };
+        std::uniform_int_distribution<int> byte { 0, 255 };
+        std::vector<uint8_t> data(BUFFER_SIZE);
+        for (auto& value : data) {
+            value = static_cast<uint8_t>(byte(random));
+        }
+        constexpr uint8_t pattern[] { 0x48, 0x89, 0x5C, 0x24, 0x08, 0x57 };
+        std::copy(std::begin(pattern), std::end(pattern),
+            data.end() - sizeof(pattern));
+        return data;
+    }();
+    return data;
+}
+} // namespace
+
+BENCHMARK(SignatureFind) {
+    const auto& data = Buffer();
+    const Signature signature { "48 89 5C 24 ?? 57" };
+    bench::Run("Signature::Find 64 MiB", [&](const uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; ++i) {
+            bench::DoNotOptimize(signature.Find(data));
+        }
+    }, BUFFER_SIZE);
+
+    // Anchors are the first and last bytes, so a wildcard there leaves a
+    // frequent byte to compare
+    const Signature leading { "?? 89 5C 24 ?? 57" };
+    bench::Run("Signature::Find 64 MiB, leading wildcard",
+        [&](const uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                bench::DoNotOptimize(leading.Find(data));
+            }
+        }, BUFFER_SIZE);
+}
+
+BENCHMARK(SignatureFindParallel) {
+    const auto& data = Buffer();
+    const Signature signature { "48 89 5C 24 ?? 57" };
+    bench::Run("Signature::FindParallel 64 MiB",
+        [&](const uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+                bench::DoNotOptimize(signature.FindParallel(data));
+            }
+        }, BUFFER_SIZE);
+}
@@ -0,0 +1,31 @@
+#include "Benchmark.hpp"
+#include "utils/ManualClock.hpp"
+#include "utils/SmoothingFilter.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// One update of each filter type behind SmoothingFilter, as the unlocker
+// calls it once per frame, toward a target that jumps every 64 frames
+
+namespace {
+void RunFilter(const FilterType type, const std::string& name) {
+    SmoothingFilter<float, ManualClock> filter { type, 0.1f, 45.0f };
+    filter.SetBeta(0.5f);
+    bench::Run(name, [&](const uint64_t iterations) {
+        auto time = ManualClock::time_point {};
+        for (uint64_t i = 0; i < iterations; ++i) {
+            time += std::chrono::microseconds(6944);
+            const float target = (i & 64) != 0 ? 90.0f : 45.0f;
+            bench::DoNotOptimize(filter.Update(target, time));
+        }
+    });
+}
+} // namespace
+
+BENCHMARK(SmoothingFilterUpdate) {
+    RunFilter(FilterType::Exponential, "exponential");
+    RunFilter(FilterType::OneEuro, "one euro");
+    RunFilter(FilterType::Spring, "spring");
+}
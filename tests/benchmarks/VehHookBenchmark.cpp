@@ -0,0 +1,37 @@
+#include "Benchmark.hpp"
+#include "utils/VehHook.hpp"
+#include "utils/hook/TestCode.hpp"
+
+#include <cstdint>
+
+// Cost of a guard-page fault redirected to a detour, and of a fault on
+// other code of a guarded page, which is single-stepped and re-armed
+
+namespace {
+int Negate(const int x) {
+    return -x;
+}
+
+void RunCalls(const char* name, const test::Function function) {
+    bench::Run(name, [function](const uint64_t iterations) {
+        int x = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            x = function(x);
+            bench::DoNotOptimize(x);
+        }
+    });
+}
+} // namespace
+
+BENCHMARK(VehHookFault) {
+    const test::TestCode code {};
+    RunCalls("call, unguarded", code.Get(test::TestCode::RIP_RELATIVE));
+
+    VehHook<int, int> hook {
+        code.At(test::TestCode::PROLOGUE), reinterpret_cast<void*>(Negate)
+    };
+    RunCalls("call, redirected by fault",
+        code.Get(test::TestCode::PROLOGUE));
+    RunCalls("call, single-stepped on guarded page",
+        code.Get(test::TestCode::RIP_RELATIVE));
+}
@@ -0,0 +1,133 @@
+#include "Test.hpp"
+#include "plugin/Command.hpp"
+#include "plugin/CommandRing.hpp"
+
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+// Values of the commands left in the ring, in the order they are popped
+std::vector<int32_t> Drain(CommandRing& ring) {
+    std::vector<int32_t> values {};
+    Command command {};
+    while (ring.TryPop(command)) {
+        values.push_back(command.value);
+    }
+    return values;
+}
+} // namespace
+
+TEST(DeliversCommandsInOrder) {
+    CommandRing ring {};
+    CommandClient client {};
+    const auto first = client.SetFieldOfView(60);
+    const auto second = client.SelectPreset(2);
+    REQUIRE(first && second);
+    CHECK(*second == *first + 1);
+    CHECK(!client.IsReceived(*first));
+
+    Command command {};
+    REQUIRE(ring.TryPop(command));
+    CHECK(command.type == CommandType::SetFieldOfView);
+    CHECK(command.value == 60);
+    CHECK(command.sendTime > 0);
+    CHECK(client.IsReceived(*first));
+    CHECK(!client.IsReceived(*second));
+    REQUIRE(ring.TryPop(command));
+    CHECK(command.type == CommandType::SelectPreset);
+    CHECK(client.IsReceived(*second));
+    CHECK(!ring.TryPop(command));
+}
+
+TEST(FailsWhenClientRingIsFull) {
+    CommandRing ring {};
+    CommandClient client {};
+    for (size_t i = 0; i < CommandRing::CAPACITY; ++i) {
+        REQUIRE(client.Ping());
+    }
+    CHECK(!client.Ping());
+    // Other clients have rings of their own
+    CommandClient other {};
+    CHECK(other.Ping());
+}
+
+TEST(TakesFromClientsInTurn) {
+    CommandRing ring {};
+    CommandClient flooding {};
+    CommandClient quiet {};
+    for (int32_t i = 0; i < 4; ++i) {
+        REQUIRE(flooding.SetFieldOfView(i));
+    }
+    REQUIRE(quiet.SetFieldOfView(100));
+    const auto values = Drain(ring);
+    REQUIRE(values.size() == 5);
+    // The quiet client's command is not behind all of the other's
+    CHECK(values[0] == 100 || values[1] == 100);
+}
+
+TEST(ReusesReleasedChannels) {
+    CommandRing ring {};
+    {
+        std::list<CommandClient> clients {};
+        for (size_t i = 0; i < CommandRing::MAX_CLIENTS; ++i) {
+            clients.emplace_back();
+        }
+        CHECK_THROWS(CommandClient {});
+        REQUIRE(clients.front().SetFieldOfView(1));
+        clients.pop_front();
+        // Commands of released channels are still delivered
+        CommandClient client {};
+        REQUIRE(client.SetFieldOfView(2));
+        const auto values = Drain(ring);
+        CHECK(values.size() == 2);
+    }
+    for (size_t i = 0; i < 2 * CommandRing::MAX_CLIENTS; ++i) {
+        CommandClient client {};
+        CHECK(client.Ping());
+    }
+    CHECK(Drain(ring).size() == 2 * CommandRing::MAX_CLIENTS);
+}
+
+TEST(TakesOverChannelOfDeadClient) {
+    CommandRing ring {};
+    int ready[2] {};
+    REQUIRE(pipe(ready) == 0);
+    const pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) try {
+        CommandClient client {};
+        static_cast<void>(client.SetFieldOfView(7));
+        const char byte = 1;
+        static_cast<void>(write(ready[1], &byte, 1));
+        pause();
+        _exit(0);
+    } catch (...) {
+        _exit(1);
+    }
+    char byte {};
+    REQUIRE(read(ready[0], &byte, 1) == 1);
+    close(ready[0]);
+    close(ready[1]);
+
+    std::list<CommandClient> clients {};
+    for (size_t i = 1; i < CommandRing::MAX_CLIENTS; ++i) {
+        clients.emplace_back();
+    }
+    // Every channel is taken while the child lives
+    CHECK_THROWS(CommandClient {});
+
+    // Killed while holding its channel, which it never releases
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+    CommandClient client {};
+    REQUIRE(client.SetFieldOfView(8));
+    CHECK(Drain(ring) == std::vector<int32_t> { 7, 8 });
+}
@@ -0,0 +1,207 @@
+#include "Test.hpp"
+#include "plugin/FramePacing.hpp"
+#include "utils/Histogram.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+// Synthetic call timestamps of several cameras, fed in time order with the
+// sampling thread's calls in between, as the unlocker and mediator make them
+
+namespace {
+using namespace std::chrono_literals;
+using TimePoint = FramePacing::TimePoint;
+
+const TimePoint START = TimePoint {} + 100s;
+
+struct Camera {
+    void* instance;
+    // Frame times cycled through in order
+    std::vector<std::chrono::nanoseconds> frameTimes;
+    TimePoint nextCall;
+    size_t frame;
+    uint64_t calls;
+};
+
+Camera MakeCamera(
+    const uintptr_t id,
+    std::vector<std::chrono::nanoseconds> frameTimes,
+    const TimePoint firstCall = START) {
+    return Camera {
+        reinterpret_cast<void*>(id * 0x1000), std::move(frameTimes),
+        firstCall, 0, 0
+    };
+}
+
+// Calls of every camera until the end, with the sampling thread trying
+// every 100 ms
+void Run(
+    FramePacing& pacing,
+    std::vector<Camera*> cameras,
+    const TimePoint end) {
+    auto nextSample = START;
+    while (true) {
+        const auto next = std::ranges::min_element(cameras, {},
+            [](const Camera* camera) { return camera->nextCall; });
+        if (next == cameras.end() || (*next)->nextCall >= end) {
+            break;
+        }
+        auto& camera = **next;
+        while (nextSample <= camera.nextCall) {
+            pacing.Sample(nextSample);
+            nextSample += 100ms;
+        }
+        pacing.Record(camera.instance, camera.nextCall);
+        ++camera.calls;
+        camera.nextCall += camera.frameTimes[camera.frame];
+        camera.frame = (camera.frame + 1) % camera.frameTimes.size();
+    }
+    pacing.Sample(end);
+}
+
+std::optional<HistogramSnapshot> Find(
+    const FramePacing& pacing, const Camera& camera) {
+    for (auto& [instance, snapshot] : pacing.Snapshot()) {
+        if (instance == camera.instance) {
+            return std::move(snapshot);
+        }
+    }
+    return std::nullopt;
+}
+
+// Within the histogram's precision, which only ever rounds up
+bool IsNear(const uint64_t value, const std::chrono::nanoseconds expected) {
+    const auto exact = static_cast<uint64_t>(expected.count());
+    return value >= exact &&
+        value - exact <= exact / Histogram::SUB_BUCKET_COUNT;
+}
+} // namespace
+
+TEST(MeasuresEachInstanceApart) {
+    FramePacing pacing {};
+    auto fast = MakeCamera(1, { 6'944'444ns });
+    auto slow = MakeCamera(2, { 16'666'667ns });
+    Run(pacing, { &fast, &slow }, START + 5s);
+
+    const auto fastIntervals = Find(pacing, fast);
+    const auto slowIntervals = Find(pacing, slow);
+    REQUIRE(fastIntervals && slowIntervals);
+    // Every interval after the first sample, a period after the first call
+    CHECK(fastIntervals->Count() < fast.calls);
+    CHECK(fastIntervals->Count() + 145 >= fast.calls);
+    CHECK(slowIntervals->Count() < slow.calls);
+    CHECK(slowIntervals->Count() + 61 >= slow.calls);
+    CHECK(IsNear(fastIntervals->Percentile(50.0), 6'944'444ns));
+    CHECK(IsNear(fastIntervals->Max(), 6'944'444ns));
+    CHECK(IsNear(slowIntervals->Percentile(50.0), 16'666'667ns));
+}
+
+// One frame in fifty is a stutter, which the 99th percentile and so the 1%
+// low show, while the median does not
+TEST(ShowsStuttersInPercentiles) {
+    FramePacing pacing {};
+    std::vector<std::chrono::nanoseconds> frameTimes(49, 5ms);
+    frameTimes.push_back(25ms);
+    auto camera = MakeCamera(1, frameTimes);
+    Run(pacing, { &camera }, START + 5s);
+
+    const auto intervals = Find(pacing, camera);
+    REQUIRE(intervals);
+    CHECK(IsNear(intervals->Percentile(50.0), 5ms));
+    CHECK(IsNear(intervals->Percentile(97.0), 5ms));
+    CHECK(IsNear(intervals->Percentile(99.0), 25ms));
+    const double low = 1e9 / static_cast<double>(intervals->Percentile(99.0));
+    CHECK(low <= 40.0 && low > 40.0 * 0.96);
+    const double mean = 1e9 / intervals->Mean();
+    CHECK(mean > 184.0 && mean < 186.5);
+}
+
+// Reports cover the last samples only, so an old stutter drops out
+TEST(ForgetsIntervalsOutsideWindow) {
+    FramePacing pacing {};
+    auto camera = MakeCamera(1, { 30ms, 10ms });
+    Run(pacing, { &camera }, START + 2s);
+    CHECK(IsNear(Find(pacing, camera)->Max(), 30ms));
+
+    camera.frameTimes = { 10ms };
+    camera.frame = 0;
+    Run(pacing, { &camera }, START + 2s + FramePacing::SAMPLE_PERIOD *
+        (FramePacing::WINDOW_SAMPLES + 2));
+    const auto intervals = Find(pacing, camera);
+    REQUIRE(intervals);
+    CHECK(IsNear(intervals->Max(), 10ms));
+    CHECK(intervals->Count() >= 900);
+}
+
+// Once every slot is taken, a camera that stopped calling gives its slot
+// to a new one, whose intervals are not mixed with the old one's
+TEST(KeepsReusedSlotApart) {
+    FramePacing pacing {};
+    std::vector<Camera> cameras {};
+    for (uintptr_t id = 1; id <= FramePacing::MAX_INSTANCES; ++id) {
+        cameras.push_back(MakeCamera(id, { 20ms }));
+    }
+    std::vector<Camera*> all {};
+    for (auto& camera : cameras) {
+        all.push_back(&camera);
+    }
+    Run(pacing, all, START + 2s);
+
+    // The first camera stops, and a new one finds no free slot until the
+    // first has been quiet for longer than a frame could be
+    auto stopped = all;
+    stopped.erase(stopped.begin());
+    auto late = MakeCamera(100, { 7ms }, START + 2s);
+    stopped.push_back(&late);
+    Run(pacing, stopped, START + 2s + FramePacing::MAX_INTERVAL + 2s);
+
+    CHECK(!Find(pacing, cameras.front()));
+    const auto intervals = Find(pacing, late);
+    REQUIRE(intervals);
+    CHECK(intervals->Count() > 0);
+    CHECK(IsNear(intervals->Percentile(0.0), 7ms));
+    CHECK(IsNear(intervals->Max(), 7ms));
+    // The cameras that kept calling are unaffected
+    CHECK(IsNear(Find(pacing, cameras.back())->Percentile(50.0), 20ms));
+}
+
+// A camera recreated at the same address after a pause starts over, rather
+// than counting the pause or the old camera's frames
+TEST(RestartsSameInstanceAfterPause) {
+    FramePacing pacing {};
+    auto camera = MakeCamera(1, { 30ms });
+    Run(pacing, { &camera }, START + 2s);
+
+    camera.frameTimes = { 8ms };
+    camera.frame = 0;
+    camera.nextCall = START + 5s;
+    Run(pacing, { &camera }, START + 7s);
+    const auto intervals = Find(pacing, camera);
+    REQUIRE(intervals);
+    CHECK(intervals->Count() > 0);
+    CHECK(IsNear(intervals->Percentile(0.0), 8ms));
+    CHECK(IsNear(intervals->Max(), 8ms));
+}
+
+// Until the sampling thread has seen a new instance, it reports nothing
+TEST(ReportsNothingBeforeFirstSample) {
+    FramePacing pacing {};
+    const auto instance = reinterpret_cast<void*>(0x1000);
+    pacing.Record(instance, START);
+    pacing.Record(instance, START + 10ms);
+    const auto snapshots = pacing.Snapshot();
+    REQUIRE(snapshots.size() == 1);
+    CHECK(snapshots.front().second.Count() == 0);
+
+    pacing.Sample(START + 10ms);
+    pacing.Record(instance, START + 20ms);
+    CHECK(pacing.Snapshot().front().second.Count() == 1);
+    // A line for the header and the only instance with frames
+    CHECK(std::ranges::count(pacing.Report(), '\n') == 2);
+}
@@ -0,0 +1,102 @@
+#include "Test.hpp"
+#include "utils/AlphaPolicy.hpp"
+#include "utils/ExponentialFilter.hpp"
+#include "utils/ManualClock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+
+// The approximations are swept densely against exp in long double, over
+// the documented range and past it, for several time constants
+
+namespace {
+constexpr size_t SAMPLES = 400000;
+constexpr long double MAX_RATIO = 40.0L;
+
+template <typename Policy, typename T>
+long double MaxError(const T timeConstant) {
+    Policy policy {};
+    policy.SetTimeConstant(timeConstant);
+    long double maxError = 0.0L;
+    for (size_t i = 0; i <= SAMPLES; ++i) {
+        const auto ratio = MAX_RATIO * static_cast<long double>(i) / SAMPLES;
+        const auto deltaTime = static_cast<T>(ratio * timeConstant);
+        const T alpha = policy(deltaTime);
+        if (!(alpha >= static_cast<T>(0) && alpha <= static_cast<T>(1))) {
+            return 1.0L;
+        }
+        const auto exact = std::exp(-static_cast<long double>(deltaTime) /
+            static_cast<long double>(timeConstant));
+        maxError = std::max(maxError,
+            std::abs(static_cast<long double>(alpha) - exact));
+    }
+    return maxError;
+}
+
+template <typename Policy, typename T>
+void CheckBound(const long double bound) {
+    for (const T timeConstant : { T(0.001), T(0.05), T(0.2), T(3.0) }) {
+        CHECK(MaxError<Policy, T>(timeConstant) < bound);
+    }
+}
+} // namespace
+
+TEST(ExactAlphaMatchesExp) {
+    CheckBound<ExactAlpha<double>, double>(1e-15L);
+    CheckBound<ExactAlpha<float>, float>(1e-7L);
+}
+
+TEST(PolynomialAlphaStaysWithinBound) {
+    CheckBound<PolynomialAlpha<double>, double>(7.5e-8L);
+    CheckBound<PolynomialAlpha<float>, float>(1.6e-7L);
+}
+
+TEST(TableAlphaStaysWithinBound) {
+    CheckBound<TableAlpha<double>, double>(3.1e-5L);
+    CheckBound<TableAlpha<float>, float>(3.1e-5L);
+}
+
+TEST(ApproximationsHandleEdges) {
+    PolynomialAlpha<double> polynomial {};
+    TableAlpha<double> table {};
+    polynomial.SetTimeConstant(0.1);
+    table.SetTimeConstant(0.1);
+
+    CHECK(std::abs(polynomial(0.0) - 1.0) < 7.5e-8);
+    CHECK(table(0.0) == 1.0);
+    CHECK(polynomial(1e9) == 0.0);
+    CHECK(table(1e9) == 0.0);
+    CHECK(polynomial(HUGE_VAL) == 0.0);
+    CHECK(table(HUGE_VAL) == 0.0);
+    CHECK(polynomial(NAN) == 0.0);
+    CHECK(table(NAN) == 0.0);
+}
+
+// Over a step the error per update does not build up in the output
+TEST(FiltersAgreeOverStep) {
+    using namespace std::chrono_literals;
+    ExponentialFilter<double, ExactAlpha<double>, ManualClock> exact { 0.1 };
+    ExponentialFilter<double, PolynomialAlpha<double>, ManualClock>
+        polynomial { 0.1 };
+    ExponentialFilter<double, TableAlpha<double>, ManualClock> table { 0.1 };
+    auto time = ManualClock::time_point {};
+    exact.SetInitialValue(45.0, time);
+    polynomial.SetInitialValue(45.0, time);
+    table.SetInitialValue(45.0, time);
+
+    double maxPolynomialError = 0.0;
+    double maxTableError = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        time += i % 3 ? 7ms : 16ms;
+        const auto expected = exact.Update(90.0, time);
+        maxPolynomialError = std::max(maxPolynomialError,
+            std::abs(polynomial.Update(90.0, time) - expected));
+        maxTableError = std::max(maxTableError,
+            std::abs(table.Update(90.0, time) - expected));
+    }
+    CHECK(maxPolynomialError < 45.0 * 7.5e-8 * 4);
+    CHECK(maxTableError < 45.0 * 3.1e-5 * 4);
+}
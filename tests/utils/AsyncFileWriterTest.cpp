@@ -0,0 +1,112 @@
+#include "Test.hpp"
+#include "utils/AsyncFileWriter.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+constexpr auto DEBOUNCE_DELAY = 100ms;
+constexpr auto SHUTDOWN_TIMEOUT = 1s;
+
+std::filesystem::path TempDirectory(const std::string_view name) {
+    const auto directory = std::filesystem::temp_directory_path() /
+        "async_file_writer_test" / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+std::string ReadFile(const std::filesystem::path& path) {
+    std::ifstream file { path, std::ios::binary };
+    return { std::istreambuf_iterator<char> { file }, {} };
+}
+
+bool WaitForContents(
+    const std::filesystem::path& path,
+    const std::string_view contents) {
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (ReadFile(path) != contents) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(5ms);
+    }
+    return true;
+}
+} // namespace
+
+TEST(CoalescesWritesIntoLatest) {
+    const auto directory = TempDirectory("coalesce");
+    const auto path = directory / "config.json";
+    {
+        AsyncFileWriter writer { path, DEBOUNCE_DELAY, SHUTDOWN_TIMEOUT };
+        // Each write pushes the deadline back, so nothing reaches the file
+        // while they keep coming
+        bool isWrittenEarly = false;
+        for (int i = 0; i < 20; ++i) {
+            writer.Write(std::to_string(i));
+            std::this_thread::sleep_for(5ms);
+            isWrittenEarly |= std::filesystem::exists(path);
+        }
+        CHECK(!isWrittenEarly);
+        CHECK(WaitForContents(path, "19"));
+    }
+    CHECK(ReadFile(path) == "19");
+    std::filesystem::remove_all(directory);
+}
+
+TEST(WritesPendingContentsOnDestruction) {
+    const auto directory = TempDirectory("destroy");
+    const auto path = directory / "config.json";
+    const auto start = std::chrono::steady_clock::now();
+    {
+        AsyncFileWriter writer { path, 10s, SHUTDOWN_TIMEOUT };
+        writer.Write("discarded");
+        writer.Write("latest");
+    }
+    CHECK(std::chrono::steady_clock::now() - start < SHUTDOWN_TIMEOUT);
+    CHECK(ReadFile(path) == "latest");
+    std::filesystem::remove_all(directory);
+}
+
+TEST(DoesNotWriteWithoutContents) {
+    const auto directory = TempDirectory("idle");
+    const auto path = directory / "config.json";
+    {
+        AsyncFileWriter writer { path, 0ms, SHUTDOWN_TIMEOUT };
+    }
+    CHECK(!std::filesystem::exists(path));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ReportsFailedWrites) {
+    const auto directory = TempDirectory("error");
+    std::atomic<int> errors { 0 };
+    {
+        AsyncFileWriter writer {
+            directory / "missing" / "config.json", 0ms, SHUTDOWN_TIMEOUT,
+            [&](const std::exception&) { ++errors; }
+        };
+        writer.Write("x");
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (errors.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(5ms);
+        }
+        CHECK(errors.load() == 1);
+        // Writing keeps working after a failure
+        std::filesystem::create_directories(directory / "missing");
+        writer.Write("y");
+        CHECK(WaitForContents(directory / "missing" / "config.json", "y"));
+    }
+    CHECK(errors.load() == 1);
+    std::filesystem::remove_all(directory);
+}
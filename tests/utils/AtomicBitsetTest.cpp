@@ -0,0 +1,89 @@
+#include "Test.hpp"
+#include "utils/AtomicBitset.hpp"
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace {
+// Indices around the boundaries of the three words of a 130-bit set
+constexpr size_t EDGES[] { 0, 1, 62, 63, 64, 65, 126, 127, 128, 129 };
+
+template <size_t N>
+size_t Count(const AtomicBitset<N>& bits) noexcept {
+    size_t count = 0;
+    for (size_t i = 0; i < N; ++i) {
+        count += bits.Test(i);
+    }
+    return count;
+}
+} // namespace
+
+TEST(StartsCleared) {
+    const AtomicBitset<130> bits {};
+    CHECK(bits.Size() == 130);
+    CHECK(Count(bits) == 0);
+}
+
+TEST(SetsAndClearsAtWordBoundaries) {
+    AtomicBitset<130> bits {};
+    for (const auto index : EDGES) {
+        CHECK(!bits.Set(index));
+        CHECK(bits.Test(index));
+        // Setting again reports that it was already set
+        CHECK(bits.Set(index));
+        CHECK(Count(bits) == 1);
+        CHECK(bits.Reset(index));
+        CHECK(!bits.Test(index));
+        CHECK(!bits.Reset(index));
+        CHECK(Count(bits) == 0);
+    }
+}
+
+TEST(LeavesNeighboursAlone) {
+    AtomicBitset<130> bits {};
+    for (const auto index : EDGES) {
+        bits.Set(index);
+    }
+    CHECK(Count(bits) == std::size(EDGES));
+    CHECK(bits.Set(64, false));
+    CHECK(bits.Test(63));
+    CHECK(!bits.Test(64));
+    CHECK(bits.Test(65));
+    CHECK(Count(bits) == std::size(EDGES) - 1);
+
+    bits.ResetAll();
+    CHECK(Count(bits) == 0);
+}
+
+TEST(FitsSingleWord) {
+    AtomicBitset<64> bits {};
+    CHECK(!bits.Set(63));
+    CHECK(!bits.Set(0));
+    CHECK(Count(bits) == 2);
+}
+
+// Threads flipping their own bits of shared words do not undo each other's
+TEST(KeepsConcurrentChanges) {
+    constexpr size_t THREADS = 4;
+    AtomicBitset<256> bits {};
+    {
+        std::vector<std::jthread> threads {};
+        for (size_t t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&bits, t] {
+                for (int round = 0; round < 1000; ++round) {
+                    for (size_t i = t; i < 256; i += THREADS) {
+                        bits.Set(i, round % 2 == 0);
+                    }
+                }
+                // Ends with every odd index of this thread set
+                for (size_t i = t; i < 256; i += THREADS) {
+                    bits.Set(i, (i / THREADS) % 2 == 1);
+                }
+            });
+        }
+    }
+    for (size_t i = 0; i < 256; ++i) {
+        CHECK(bits.Test(i) == ((i / THREADS) % 2 == 1));
+    }
+}
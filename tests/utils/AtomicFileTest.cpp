@@ -0,0 +1,124 @@
+#include "Test.hpp"
+#include "utils/AsyncFileWriter.hpp"
+#include "utils/AtomicFile.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#ifndef _WIN32
+    #include <csignal>
+    #include <cstdlib>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+std::filesystem::path TempDirectory(const std::string_view name) {
+    const auto directory = std::filesystem::temp_directory_path() /
+        "atomic_file_test" / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+std::string ReadFile(const std::filesystem::path& path) {
+    std::ifstream file { path, std::ios::binary };
+    return { std::istreambuf_iterator<char> { file }, {} };
+}
+} // namespace
+
+TEST(ReplacesContents) {
+    const auto directory = TempDirectory("replace");
+    const auto path = directory / "config.json";
+    WriteFileAtomic(path, "first, and longer than the second");
+    CHECK(ReadFile(path) == "first, and longer than the second");
+    WriteFileAtomic(path, "second");
+    CHECK(ReadFile(path) == "second");
+    WriteFileAtomic(path, "");
+    CHECK(std::filesystem::exists(path));
+    CHECK(ReadFile(path).empty());
+
+    // Only the file itself is left behind
+    CHECK(std::distance(std::filesystem::directory_iterator { directory },
+        std::filesystem::directory_iterator {}) == 1);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ThrowsWhenDirectoryIsMissing) {
+    const auto directory = TempDirectory("missing");
+    CHECK_THROWS(WriteFileAtomic(directory / "missing" / "config.json", "x"));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(KeepsOldContentsWhenRenameFails) {
+    const auto directory = TempDirectory("rename");
+    // A non-empty directory cannot be replaced by a file
+    const auto path = directory / "config.json";
+    std::filesystem::create_directories(path / "child");
+    CHECK_THROWS(WriteFileAtomic(path, "x"));
+    CHECK(std::filesystem::is_directory(path / "child"));
+    CHECK(!std::filesystem::exists(directory / "config.json.tmp"));
+    std::filesystem::remove_all(directory);
+}
+
+#ifndef _WIN32
+// Kills a process rewriting the file as fast as it can, at random points,
+// and checks that the file always holds one of the contents in full
+TEST(SurvivesKillDuringWrites) {
+    constexpr int KILLS = 100;
+    const auto directory = TempDirectory("kill");
+    const auto path = directory / "config.json";
+    // Sizes above a page, so a torn write would show
+    const std::string first(4096, 'a');
+    const std::string second(8192 + 17, 'b');
+    WriteFileAtomic(path, first);
+
+    std::mt19937 random { 1 };
+    int torn = 0;
+    for (int i = 0; i < KILLS; ++i) {
+        const pid_t child = fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            AsyncFileWriter writer {
+                path, std::chrono::milliseconds::zero(), std::chrono::seconds(1)
+            };
+            for (uint64_t n = 0;; ++n) {
+                writer.Write(n % 2 == 0 ? second : first);
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+
+        // Kill only once the child is writing, so the kill lands in the
+        // middle of the stream rather than before it
+        const auto deadline = std::chrono::steady_clock::now() +
+            std::chrono::seconds(5);
+        while (ReadFile(path) != second &&
+            std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(random() % 10000));
+        kill(child, SIGKILL);
+        int status {};
+        waitpid(child, &status, 0);
+        CHECK(WIFSIGNALED(status));
+
+        const auto contents = ReadFile(path);
+        if (contents != first && contents != second) {
+            ++torn;
+        }
+        // The next child starts from the first contents again
+        WriteFileAtomic(path, first);
+    }
+    CHECK(torn == 0);
+    std::filesystem::remove_all(directory);
+}
+#endif
@@ -0,0 +1,119 @@
+#include "Test.hpp"
+#include "utils/CycleCounter.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr uint64_t ADDS_PER_THREAD = 100000;
+
+void AddMany(CycleCounter& counter) {
+    for (uint64_t i = 0; i < ADDS_PER_THREAD; ++i) {
+        counter.Add(i % 7);
+    }
+}
+
+// Sum of i % 7 over the adds of one thread
+constexpr uint64_t CyclesPerThread() noexcept {
+    uint64_t cycles = 0;
+    for (uint64_t i = 0; i < ADDS_PER_THREAD; ++i) {
+        cycles += i % 7;
+    }
+    return cycles;
+}
+
+bool HasTotals(const CycleCounter& counter, const uint64_t threads) {
+    const auto [calls, cycles] = counter.Read();
+    return calls == threads * ADDS_PER_THREAD &&
+        cycles == threads * CyclesPerThread();
+}
+} // namespace
+
+TEST(StartsEmpty) {
+    const CycleCounter counter {};
+    const auto [calls, cycles] = counter.Read();
+    CHECK(calls == 0);
+    CHECK(cycles == 0);
+}
+
+TEST(SumsOneThread) {
+    CycleCounter counter {};
+    counter.Add(10);
+    counter.Add(0);
+    counter.Add(32);
+    const auto [calls, cycles] = counter.Read();
+    CHECK(calls == 3);
+    CHECK(cycles == 42);
+}
+
+TEST(SumsConcurrentThreads) {
+    // Twice as many threads as slots, so some share the last one
+    constexpr uint64_t THREADS = CycleCounter::MAX_THREADS * 2;
+    CycleCounter counter {};
+    {
+        std::vector<std::jthread> threads {};
+        for (uint64_t i = 0; i < THREADS; ++i) {
+            threads.emplace_back([&counter] { AddMany(counter); });
+        }
+    }
+    CHECK(HasTotals(counter, THREADS));
+}
+
+TEST(KeepsCountsOfExitedThreads) {
+    // Many more threads than slots, one after the other, each taking the
+    // slot the previous one gave back
+    constexpr uint64_t THREADS = CycleCounter::MAX_THREADS * 8;
+    CycleCounter counter {};
+    for (uint64_t i = 0; i < THREADS; ++i) {
+        std::jthread { [&counter] { AddMany(counter); } };
+    }
+    CHECK(HasTotals(counter, THREADS));
+}
+
+TEST(ReadsWhileThreadsAdd) {
+    constexpr uint64_t THREADS = 4;
+    CycleCounter counter {};
+    uint64_t previousCalls = 0;
+    bool isMonotonic = true;
+    {
+        std::vector<std::jthread> threads {};
+        for (uint64_t i = 0; i < THREADS; ++i) {
+            threads.emplace_back([&counter] { AddMany(counter); });
+        }
+        for (int i = 0; i < 1000; ++i) {
+            const auto calls = counter.Read().calls;
+            isMonotonic &= calls >= previousCalls;
+            previousCalls = calls;
+        }
+    }
+    CHECK(isMonotonic);
+    CHECK(HasTotals(counter, THREADS));
+}
+
+TEST(ScopeAddsOnce) {
+    CycleCounter counter {};
+    {
+        CycleScope scope { counter };
+        scope.Stop();
+        scope.Stop();
+    }
+    {
+        const CycleScope scope { counter };
+    }
+    CHECK(counter.Read().calls == 2);
+}
+
+TEST(CalibratesAgainstSteadyClock) {
+    const CycleCalibration calibration {};
+    const auto start = ReadCycles();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto cycles = ReadCycles() - start;
+    const auto nanoseconds = static_cast<double>(cycles) *
+        calibration.NanosecondsPerCycle();
+    // Within a wide margin, as the sleep is not the whole calibration
+    CHECK(cycles > 0);
+    CHECK(nanoseconds > 25'000'000.0);
+    CHECK(nanoseconds < 500'000'000.0);
+}
@@ -0,0 +1,105 @@
+#include "Test.hpp"
+#include "utils/AlphaPolicy.hpp"
+#include "utils/ExponentialFilter.hpp"
+#include "utils/ExponentialFilterBank.hpp"
+#include "utils/ManualClock.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Each channel of a bank must follow the scalar filter it replaces, fed the
+// same values at the same times
+
+namespace {
+using namespace std::chrono_literals;
+
+using Scalar = ExponentialFilter<double, ExactAlpha<double>, ManualClock>;
+
+constexpr double TOLERANCE = 1e-12;
+
+template <size_t N>
+void CheckAgainstScalar(const bool isUniform) {
+    std::mt19937 random { static_cast<unsigned>(N) };
+    std::uniform_real_distribution<double> value { -90.0, 90.0 };
+    std::uniform_real_distribution<double> timeConstant { 0.01, 0.5 };
+    std::uniform_int_distribution<int> frameTime { 0, 40 };
+
+    auto time = ManualClock::time_point {};
+    const auto bank = std::make_unique<
+        ExponentialFilterBank<double, N, ManualClock>>();
+    std::vector<Scalar> scalars(N);
+    bank->SetTimeConstant(0.1);
+    bank->SetInitialValue(45.0, time);
+    for (size_t i = 0; i < N; ++i) {
+        const auto tau = isUniform ? 0.1 : timeConstant(random);
+        bank->SetTimeConstant(i, tau);
+        scalars[i].SetTimeConstant(tau);
+        scalars[i].SetInitialValue(45.0, time);
+    }
+
+    std::array<double, N> input {};
+    for (int step = 0; step < 200; ++step) {
+        // Zero frame times and occasional clock steps backwards count as no
+        // time elapsed for both
+        time += std::chrono::milliseconds(frameTime(random));
+        if (step % 50 == 49) {
+            time -= 5ms;
+        }
+        for (auto& x : input) {
+            x = value(random);
+        }
+        const auto output = bank->Update(input, time);
+        for (size_t i = 0; i < N; ++i) {
+            const auto expected = scalars[i].Update(input[i], time);
+            if (std::abs(output[i] - expected) > TOLERANCE) {
+                CHECK(std::abs(output[i] - expected) <= TOLERANCE);
+                return;
+            }
+        }
+    }
+}
+} // namespace
+
+TEST(UniformBankMatchesScalarFilters) {
+    CheckAgainstScalar<1>(true);
+    CheckAgainstScalar<8>(true);
+    CheckAgainstScalar<64>(true);
+    CheckAgainstScalar<1024>(true);
+}
+
+TEST(PerChannelBankMatchesScalarFilters) {
+    CheckAgainstScalar<1>(false);
+    CheckAgainstScalar<8>(false);
+    CheckAgainstScalar<64>(false);
+    CheckAgainstScalar<1024>(false);
+}
+
+TEST(ZeroTimeConstantPassesInputThrough) {
+    ExponentialFilterBank<float, 4, ManualClock> bank { 0.0f, 10.0f };
+    const std::array<float, 4> input { 1.0f, 2.0f, 3.0f, 4.0f };
+    const auto output = bank.Update(input, ManualClock::time_point { 1ms });
+    for (size_t i = 0; i < 4; ++i) {
+        CHECK(output[i] == input[i]);
+    }
+}
+
+TEST(ChannelsKeepTheirOwnState) {
+    ExponentialFilterBank<double, 3, ManualClock> bank { 1.0 };
+    bank.SetInitialValue(0.0, ManualClock::time_point {});
+    bank.SetInitialValue(1, 100.0);
+    bank.SetTimeConstant(2, 0.0);
+    CHECK(bank.Value(1) == 100.0);
+
+    const std::array<double, 3> input { 10.0, 10.0, 10.0 };
+    const auto output = bank.Update(input, ManualClock::time_point { 1s });
+    const auto alpha = std::exp(-1.0);
+    CHECK(std::abs(output[0] - (10.0 - 10.0 * alpha)) < TOLERANCE);
+    CHECK(std::abs(output[1] - (10.0 + 90.0 * alpha)) < TOLERANCE);
+    CHECK(output[2] == 10.0);
+    CHECK(bank.Values()[1] == output[1]);
+}
@@ -0,0 +1,153 @@
+#include "Test.hpp"
+#include "utils/FileWatcher.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+constexpr auto DEBOUNCE_DELAY = 100ms;
+// Generous bound for a call to arrive on a loaded machine
+constexpr auto CALL_TIMEOUT = 5s;
+
+std::filesystem::path TempDirectory(const std::string_view name) {
+    const auto directory = std::filesystem::temp_directory_path() /
+        "file_watcher_test" / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+void WriteFile(const std::filesystem::path& path, const int value) {
+    std::ofstream { path } << "{\"fov\": " << value << "}";
+}
+
+// Waits until at least the expected number of calls arrived, then for a few
+// more debounce delays so that any extra call would be seen too
+int WaitForCalls(const std::atomic<int>& calls, const int expected) {
+    const auto deadline = std::chrono::steady_clock::now() + CALL_TIMEOUT;
+    while (calls.load() < expected &&
+        std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+    }
+    std::this_thread::sleep_for(3 * DEBOUNCE_DELAY);
+    return calls.load();
+}
+} // namespace
+
+TEST(CoalescesBurstIntoOneCall) {
+    const auto directory = TempDirectory("burst");
+    const auto path = directory / "config.json";
+    std::atomic<int> calls { 0 };
+    {
+        FileWatcher watcher { path, DEBOUNCE_DELAY, [&] { ++calls; } };
+        // Each rewrite truncates, writes and closes, several notifications
+        // each, all well within the delay of the previous one
+        for (int i = 0; i < 50; ++i) {
+            WriteFile(path, i);
+            std::this_thread::sleep_for(2ms);
+        }
+        CHECK(WaitForCalls(calls, 1) == 1);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST(CallsOncePerQuietBurst) {
+    const auto directory = TempDirectory("bursts");
+    const auto path = directory / "config.json";
+    std::atomic<int> calls { 0 };
+    {
+        FileWatcher watcher { path, DEBOUNCE_DELAY, [&] { ++calls; } };
+        for (int burst = 1; burst <= 3; ++burst) {
+            for (int i = 0; i < 10; ++i) {
+                WriteFile(path, i);
+            }
+            CHECK(WaitForCalls(calls, burst) == burst);
+        }
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST(IgnoresOtherFilesInDirectory) {
+    const auto directory = TempDirectory("other");
+    std::atomic<int> calls { 0 };
+    {
+        FileWatcher watcher {
+            directory / "config.json", DEBOUNCE_DELAY, [&] { ++calls; }
+        };
+        WriteFile(directory / "other.json", 0);
+        WriteFile(directory / "config.json.tmp", 0);
+        std::this_thread::sleep_for(3 * DEBOUNCE_DELAY);
+        CHECK(calls.load() == 0);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST(SeesReplacementByRename) {
+    const auto directory = TempDirectory("rename");
+    const auto path = directory / "config.json";
+    WriteFile(path, 0);
+    std::atomic<int> calls { 0 };
+    {
+        FileWatcher watcher { path, DEBOUNCE_DELAY, [&] { ++calls; } };
+        const auto temporary = directory / "config.json.tmp";
+        WriteFile(temporary, 1);
+        std::filesystem::rename(temporary, path);
+        CHECK(WaitForCalls(calls, 1) == 1);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST(SeesCreationOfMissingFile) {
+    const auto directory = TempDirectory("create");
+    std::atomic<int> calls { 0 };
+    {
+        FileWatcher watcher {
+            directory / "config.json", DEBOUNCE_DELAY, [&] { ++calls; }
+        };
+        WriteFile(directory / "config.json", 0);
+        CHECK(WaitForCalls(calls, 1) == 1);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST(KeepsWatchingAfterCallbackThrows) {
+    const auto directory = TempDirectory("throws");
+    const auto path = directory / "config.json";
+    std::atomic<int> calls { 0 };
+    {
+        FileWatcher watcher { path, DEBOUNCE_DELAY, [&] {
+            ++calls;
+            throw std::runtime_error { "parse error" };
+        } };
+        WriteFile(path, 0);
+        CHECK(WaitForCalls(calls, 1) == 1);
+        WriteFile(path, 1);
+        CHECK(WaitForCalls(calls, 2) == 2);
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST(StopsWithoutWaitingForPendingCall) {
+    const auto directory = TempDirectory("stop");
+    const auto path = directory / "config.json";
+    std::atomic<int> calls { 0 };
+    std::optional<FileWatcher> watcher { std::in_place,
+        path, 10s, [&] { ++calls; } };
+    WriteFile(path, 0);
+    std::this_thread::sleep_for(DEBOUNCE_DELAY);
+
+    const auto start = std::chrono::steady_clock::now();
+    watcher.reset();
+    const auto stopTime = std::chrono::steady_clock::now() - start;
+    CHECK(calls.load() == 0);
+    CHECK(stopTime < 1s);
+    std::filesystem::remove_all(directory);
+}
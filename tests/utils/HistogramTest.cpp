@@ -0,0 +1,181 @@
+#include "Test.hpp"
+#include "utils/Histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr uint64_t MAX = std::numeric_limits<uint64_t>::max();
+constexpr size_t SUB = Histogram::SUB_BUCKET_COUNT;
+
+// Exact percentile of sorted values, by the same rank as the histogram
+uint64_t ExactPercentile(
+    const std::vector<uint64_t>& sorted, const double percentile) {
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(
+        percentile / 100.0 * static_cast<double>(sorted.size()))));
+    return sorted[rank - 1];
+}
+} // namespace
+
+TEST(KeepsSmallValuesExact) {
+    for (uint64_t value = 0; value < SUB; ++value) {
+        const auto index = Histogram::BucketIndex(value);
+        CHECK(index == value);
+        CHECK(Histogram::BucketLowerBound(index) == value);
+        CHECK(Histogram::BucketUpperBound(index) == value);
+    }
+    CHECK(Histogram::BucketIndex(SUB) == SUB);
+}
+
+// At each power of two a new row starts, whose buckets are twice as wide
+// as the row's before
+TEST(StartsRowsAtPowersOfTwo) {
+    for (int exponent = Histogram::SUB_BUCKET_BITS; exponent < 64; ++exponent) {
+        const uint64_t power = uint64_t { 1 } << exponent;
+        const auto index = Histogram::BucketIndex(power);
+        CHECK(index % SUB == 0);
+        CHECK(Histogram::BucketLowerBound(index) == power);
+        CHECK(Histogram::BucketIndex(power - 1) == index - 1);
+        CHECK(Histogram::BucketUpperBound(index - 1) == power - 1);
+
+        const uint64_t width = power >> Histogram::SUB_BUCKET_BITS;
+        CHECK(Histogram::BucketUpperBound(index) == power + width - 1);
+        CHECK(Histogram::BucketIndex(power + width - 1) == index);
+        CHECK(Histogram::BucketIndex(power + width) == index + 1);
+    }
+}
+
+TEST(CoversWholeRange) {
+    CHECK(Histogram::BucketIndex(0) == 0);
+    CHECK(Histogram::BucketIndex(MAX) == Histogram::BUCKET_COUNT - 1);
+    CHECK(Histogram::BucketUpperBound(Histogram::BUCKET_COUNT - 1) == MAX);
+
+    // Buckets are contiguous, without gaps or overlaps
+    for (size_t index = 1; index < Histogram::BUCKET_COUNT; ++index) {
+        CHECK(Histogram::BucketLowerBound(index) ==
+            Histogram::BucketUpperBound(index - 1) + 1);
+    }
+}
+
+TEST(RecordsExtremeValues) {
+    Histogram histogram {};
+    histogram.Record(0);
+    histogram.Record(MAX);
+    const auto snapshot = histogram.Snapshot();
+    CHECK(snapshot.Count() == 2);
+    CHECK(snapshot.Min() == 0);
+    CHECK(snapshot.Max() == MAX);
+    CHECK(snapshot.Percentile(50.0) == 0);
+    // Percentiles out of range are clamped
+    CHECK(snapshot.Percentile(-5.0) == 0);
+    CHECK(snapshot.Percentile(250.0) == MAX);
+}
+
+TEST(IsEmptyWithoutValues) {
+    const Histogram histogram {};
+    const auto snapshot = histogram.Snapshot();
+    CHECK(snapshot.Count() == 0);
+    CHECK(snapshot.Mean() == 0.0);
+    CHECK(snapshot.Min() == 0);
+    CHECK(snapshot.Max() == 0);
+    CHECK(snapshot.Percentile(99.0) == 0);
+}
+
+// Percentiles are never below the exact value, and above it by no more than
+// one bucket, or 1 / SUB_BUCKET_COUNT of it
+TEST(BoundsPercentileError) {
+    std::mt19937_64 random { 11 };
+    std::lognormal_distribution<double> distribution { 12.0, 2.0 };
+    Histogram histogram {};
+    std::vector<uint64_t> values {};
+    for (int i = 0; i < 100000; ++i) {
+        const auto value = static_cast<uint64_t>(distribution(random));
+        values.push_back(value);
+        histogram.Record(value);
+    }
+    std::ranges::sort(values);
+    const auto snapshot = histogram.Snapshot();
+    CHECK(snapshot.Count() == values.size());
+
+    for (const double percentile :
+        { 0.1, 1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 100.0 }) {
+        const auto exact = ExactPercentile(values, percentile);
+        const auto estimate = snapshot.Percentile(percentile);
+        CHECK(estimate >= exact);
+        CHECK(static_cast<double>(estimate - exact) <=
+            static_cast<double>(exact) / static_cast<double>(SUB));
+    }
+}
+
+TEST(KeepsExactSumAndMean) {
+    Histogram histogram {};
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        histogram.RecordExclusive(value);
+    }
+    const auto snapshot = histogram.Snapshot();
+    CHECK(snapshot.Count() == 1000);
+    CHECK(snapshot.Sum() == 500500);
+    CHECK(snapshot.Mean() == 500.5);
+}
+
+TEST(ResetsCounts) {
+    Histogram histogram {};
+    histogram.Record(5);
+    histogram.Record(5000);
+    histogram.Reset();
+    CHECK(histogram.Snapshot().Count() == 0);
+    CHECK(histogram.Snapshot().Sum() == 0);
+    histogram.Record(7);
+    CHECK(histogram.Snapshot().Max() == 7);
+}
+
+TEST(MergesAndSubtractsSnapshots) {
+    Histogram first {};
+    Histogram second {};
+    for (uint64_t value = 0; value < 100; ++value) {
+        first.Record(value);
+        second.Record(value + 1000);
+    }
+    auto merged = first.Snapshot();
+    merged += second.Snapshot();
+    CHECK(merged.Count() == 200);
+    CHECK(merged.Min() == 0);
+    CHECK(merged.Percentile(50.0) == 99);
+    CHECK(merged.Percentile(51.0) >= 1000);
+
+    // Values recorded since an earlier snapshot
+    const auto before = first.Snapshot();
+    for (int i = 0; i < 10; ++i) {
+        first.Record(1 << 20);
+    }
+    auto since = first.Snapshot();
+    since -= before;
+    CHECK(since.Count() == 10);
+    CHECK(since.Sum() == 10 << 20);
+    CHECK(since.Min() == Histogram::BucketUpperBound(
+        Histogram::BucketIndex(1 << 20)));
+}
+
+TEST(CountsEveryConcurrentRecord) {
+    constexpr uint64_t RECORDS = 100000;
+    Histogram histogram {};
+    {
+        std::vector<std::jthread> threads {};
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (uint64_t i = 0; i < RECORDS; ++i) {
+                    histogram.Record(i % 64);
+                }
+            });
+        }
+    }
+    const auto snapshot = histogram.Snapshot();
+    CHECK(snapshot.Count() == 4 * RECORDS);
+    CHECK(snapshot.Max() == 63);
+}
@@ -0,0 +1,180 @@
+#include "Test.hpp"
+#include "utils/HookEngine.hpp"
+#include "utils/MinHook.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// MinHook instances run against an engine that only records what it is
+// asked to do, where each Apply stands for one freeze of the other threads
+
+namespace {
+struct EngineLog {
+    size_t creates;
+    size_t removes;
+    size_t freezes;
+    std::vector<HookChange> changes;
+    bool shouldFail;
+};
+
+class FakeHookEngine final : public IHookEngine {
+public:
+    explicit FakeHookEngine(EngineLog& log) noexcept
+        : log { log } {}
+
+    void Create(void*, void* detour, void** original) override {
+        ++log.creates;
+        *original = detour;
+    }
+
+    void Remove(void*) override {
+        ++log.removes;
+    }
+
+    void Apply(const std::span<const HookChange> changes) override {
+        ++log.freezes;
+        if (log.shouldFail) {
+            throw std::runtime_error { "Apply failed" };
+        }
+        log.changes.insert(log.changes.end(), changes.begin(), changes.end());
+    }
+
+private:
+    EngineLog& log;
+};
+
+int Function(const int x) {
+    return x;
+}
+
+void* Target(const uintptr_t index) noexcept {
+    return reinterpret_cast<void*>(0x10000 + index * 0x100);
+}
+
+void* Detour() noexcept {
+    return reinterpret_cast<void*>(Function);
+}
+
+EngineLog& UseFakeEngine() {
+    static EngineLog log {};
+    log = {};
+    SetHookEngine(std::make_unique<FakeHookEngine>(log));
+    return log;
+}
+} // namespace
+
+TEST(FreezesOncePerChangeOutsideTransaction) {
+    auto& log = UseFakeEngine();
+    {
+        MinHook<int, int> first { Target(0), Detour() };
+        MinHook<int, int> second { Target(1), Detour(), true };
+        CHECK(log.creates == 2);
+        CHECK(log.freezes == 1);
+
+        first.Enable();
+        first.Enable();
+        second.Disable();
+        CHECK(log.freezes == 3);
+        CHECK(first.IsEnabled());
+        CHECK(!second.IsEnabled());
+        CHECK(first.CallOriginal(7) == 7);
+    }
+    CHECK(log.removes == 2);
+}
+
+TEST(FreezesOncePerCommit) {
+    auto& log = UseFakeEngine();
+    std::vector<std::unique_ptr<MinHook<int, int>>> hooks {};
+    for (uintptr_t i = 0; i < 16; ++i) {
+        hooks.push_back(std::make_unique<MinHook<int, int>>(
+            Target(i), Detour()));
+    }
+
+    HookTransaction transaction {};
+    for (const auto& hook : hooks) {
+        hook->Enable();
+        CHECK(hook->IsEnabled());
+    }
+    CHECK(log.freezes == 0);
+    transaction.Commit();
+    CHECK(log.freezes == 1);
+    CHECK(log.changes.size() == 16);
+    for (const auto& change : log.changes) {
+        CHECK(change.enable);
+    }
+    CHECK_THROWS(transaction.Commit());
+}
+
+TEST(SkipsChangesThatCancelOut) {
+    auto& log = UseFakeEngine();
+    MinHook<int, int> enabled { Target(0), Detour(), true };
+    MinHook<int, int> disabled { Target(1), Detour() };
+    log.freezes = 0;
+    log.changes.clear();
+
+    {
+        HookTransaction transaction {};
+        enabled.Disable();
+        enabled.Enable();
+        disabled.Enable();
+        disabled.Disable();
+        transaction.Commit();
+    }
+    CHECK(log.freezes == 0);
+
+    {
+        HookTransaction transaction {};
+        enabled.Disable();
+        disabled.Enable();
+        transaction.Commit();
+    }
+    CHECK(log.freezes == 1);
+    REQUIRE(log.changes.size() == 2);
+    CHECK(!enabled.IsEnabled());
+    CHECK(disabled.IsEnabled());
+}
+
+TEST(DiscardsUncommittedChanges) {
+    auto& log = UseFakeEngine();
+    MinHook<int, int> hook { Target(0), Detour() };
+    {
+        HookTransaction transaction {};
+        hook.Enable();
+        CHECK(hook.IsEnabled());
+    }
+    CHECK(log.freezes == 0);
+    CHECK(!hook.IsEnabled());
+
+    hook.Enable();
+    CHECK(log.freezes == 1);
+}
+
+TEST(AbortsWhenApplyFails) {
+    auto& log = UseFakeEngine();
+    MinHook<int, int> hook { Target(0), Detour() };
+    log.shouldFail = true;
+    {
+        HookTransaction transaction {};
+        hook.Enable();
+        CHECK_THROWS(transaction.Commit());
+    }
+    CHECK(!hook.IsEnabled());
+
+    // The failed transaction is closed, so another can open
+    log.shouldFail = false;
+    HookTransaction transaction {};
+    hook.Enable();
+    transaction.Commit();
+    CHECK(hook.IsEnabled());
+}
+
+TEST(RejectsNestedTransactions) {
+    UseFakeEngine();
+    MinHook<int, int> hook { Target(0), Detour() };
+    HookTransaction transaction {};
+    CHECK_THROWS(HookTransaction {});
+}
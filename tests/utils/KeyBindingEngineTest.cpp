@@ -0,0 +1,275 @@
+#include "Test.hpp"
+#include "utils/KeyBinding.hpp"
+#include "utils/KeyBindingEngine.hpp"
+
+#include <array>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+constexpr uint8_t LCTRL = 0xA2;
+constexpr uint8_t RCTRL = 0xA3;
+constexpr uint8_t LSHIFT = 0xA0;
+constexpr uint8_t LEFT = 0x25;
+constexpr uint8_t RIGHT = 0x27;
+
+// Bindings in the order of their indices
+enum Action : size_t {
+    Next,
+    NextFast,
+    Sequence,
+    TapG,
+    HoldG,
+    Previous
+};
+
+std::vector<KeyBinding> ParseAll(const std::initializer_list<std::string_view> texts) {
+    std::vector<KeyBinding> bindings {};
+    for (const auto text : texts) {
+        bindings.push_back(ParseKeyBinding(text));
+    }
+    return bindings;
+}
+
+KeyBindingEngine MakeEngine() {
+    const auto bindings = ParseAll({
+        "Right", "Ctrl+Right", "Ctrl+K F", "tap:G", "hold:G", "Left"
+    });
+    return KeyBindingEngine { bindings, 500ms, 1000ms };
+}
+
+const KeyBindingEngine::TimePoint START = KeyBindingEngine::TimePoint {} + 10s;
+
+// Presses and releases a key, returning what the press triggered
+std::optional<size_t> Press(
+    KeyBindingEngine& engine,
+    const uint8_t vKey,
+    const KeyBindingEngine::TimePoint time = START) {
+    const auto action = engine.OnKeyDown(vKey, time);
+    static_cast<void>(engine.OnKeyUp(vKey, time));
+    return action;
+}
+} // namespace
+
+TEST(MatchesChordsByModifiers) {
+    auto engine = MakeEngine();
+    CHECK(Press(engine, RIGHT) == Next);
+    CHECK(engine.OnKeyDown(LCTRL, START) == std::nullopt);
+    CHECK(Press(engine, RIGHT) == NextFast);
+    CHECK(engine.OnKeyUp(LCTRL, START) == std::nullopt);
+    CHECK(Press(engine, RIGHT) == Next);
+}
+
+TEST(TracksBothSidesOfModifiers) {
+    auto engine = MakeEngine();
+    static_cast<void>(engine.OnKeyDown(LCTRL, START));
+    static_cast<void>(engine.OnKeyDown(RCTRL, START));
+    static_cast<void>(engine.OnKeyUp(LCTRL, START));
+    // Right Ctrl is still held
+    CHECK(Press(engine, RIGHT) == NextFast);
+    static_cast<void>(engine.OnKeyUp(RCTRL, START));
+    CHECK(Press(engine, RIGHT) == Next);
+    // Releasing a modifier twice does not go below zero
+    static_cast<void>(engine.OnKeyUp(LCTRL, START));
+    static_cast<void>(engine.OnKeyDown(LCTRL, START));
+    CHECK(Press(engine, RIGHT) == NextFast);
+}
+
+TEST(FallsBackToChordWithoutModifiers) {
+    auto engine = MakeEngine();
+    static_cast<void>(engine.OnKeyDown(LSHIFT, START));
+    CHECK(Press(engine, RIGHT) == Next);
+    CHECK(Press(engine, LEFT) == Previous);
+}
+
+TEST(MatchesSequences) {
+    auto engine = MakeEngine();
+    static_cast<void>(engine.OnKeyDown(LCTRL, START));
+    CHECK(Press(engine, 'K') == std::nullopt);
+    static_cast<void>(engine.OnKeyUp(LCTRL, START));
+    CHECK(Press(engine, 'F', START + 100ms) == Sequence);
+    // The sequence is done, so F alone does nothing
+    CHECK(Press(engine, 'F', START + 200ms) == std::nullopt);
+
+    // Ctrl may still be held for the second chord
+    static_cast<void>(engine.OnKeyDown(LCTRL, START));
+    CHECK(Press(engine, 'K') == std::nullopt);
+    CHECK(Press(engine, 'F') == Sequence);
+}
+
+TEST(TimesOutSequences) {
+    auto engine = MakeEngine();
+    static_cast<void>(engine.OnKeyDown(LCTRL, START));
+    static_cast<void>(Press(engine, 'K'));
+    static_cast<void>(engine.OnKeyUp(LCTRL, START));
+    CHECK(Press(engine, 'F', START + 1001ms) == std::nullopt);
+}
+
+TEST(RestartsInterruptedSequences) {
+    auto engine = MakeEngine();
+    static_cast<void>(engine.OnKeyDown(LCTRL, START));
+    static_cast<void>(Press(engine, 'K'));
+    static_cast<void>(engine.OnKeyUp(LCTRL, START));
+    // A bound key interrupts and triggers from the root
+    CHECK(Press(engine, LEFT) == Previous);
+    CHECK(Press(engine, 'F') == std::nullopt);
+
+    static_cast<void>(engine.OnKeyDown(LCTRL, START));
+    static_cast<void>(Press(engine, 'K'));
+    static_cast<void>(engine.OnKeyUp(LCTRL, START));
+    CHECK(Press(engine, 'X') == std::nullopt);
+    CHECK(Press(engine, 'F') == std::nullopt);
+
+    static_cast<void>(engine.OnKeyDown(LCTRL, START));
+    static_cast<void>(Press(engine, 'K'));
+    engine.Reset();
+    CHECK(Press(engine, 'F') == std::nullopt);
+}
+
+TEST(TellsTapFromHold) {
+    auto engine = MakeEngine();
+    CHECK(engine.OnKeyDown('G', START) == std::nullopt);
+    CHECK(engine.OnKeyUp('G', START + 100ms) == TapG);
+
+    // Auto-repeat triggers the hold while the key is still down, once
+    CHECK(engine.OnKeyDown('G', START) == std::nullopt);
+    CHECK(engine.OnKeyHold('G', START + 300ms) == std::nullopt);
+    CHECK(engine.OnKeyHold('G', START + 600ms) == HoldG);
+    CHECK(engine.OnKeyHold('G', START + 700ms) == std::nullopt);
+    CHECK(engine.OnKeyUp('G', START + 800ms) == std::nullopt);
+
+    // Without auto-repeat the hold triggers on release
+    CHECK(engine.OnKeyDown('G', START) == std::nullopt);
+    CHECK(engine.OnKeyUp('G', START + 900ms) == HoldG);
+
+    // Releasing another key does not end the press
+    CHECK(engine.OnKeyDown('G', START) == std::nullopt);
+    CHECK(engine.OnKeyUp('X', START + 100ms) == std::nullopt);
+    CHECK(engine.OnKeyUp('G', START + 200ms) == TapG);
+}
+
+TEST(RejectsConflictingBindings) {
+    const auto isRejected = [](const std::initializer_list<std::string_view> texts) {
+        try {
+            const auto bindings = ParseAll(texts);
+            KeyBindingEngine engine { bindings };
+            return false;
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+    };
+    CHECK(isRejected({ "Right", "Right" }));
+    CHECK(isRejected({ "Ctrl+K", "Ctrl+K F" }));
+    CHECK(isRejected({ "G", "tap:G" }));
+    CHECK(isRejected({ "G", "hold:G" }));
+    CHECK(!isRejected({ "tap:G", "hold:G", "Ctrl+G", "Ctrl+K G" }));
+    CHECK(!isRejected({}));
+}
+
+TEST(DoesNothingWithoutBindings) {
+    KeyBindingEngine engine {};
+    for (size_t vKey = 0; vKey < 256; ++vKey) {
+        CHECK(!Press(engine, static_cast<uint8_t>(vKey)));
+    }
+}
+
+// Against a model of single-key bindings on a long random stream of downs,
+// repeats and ups over a few keys, including modifiers
+TEST(MatchesSingleKeysInRandomStream) {
+    constexpr std::array KEYS {
+        LCTRL, RCTRL, LSHIFT, LEFT, RIGHT, uint8_t { 'W' }, uint8_t { 'A' },
+        uint8_t { 'S' }, uint8_t { 'D' }, uint8_t { 0x20 }, uint8_t { 0x28 }
+    };
+    const std::vector bindings {
+        MakeKeyBinding(0x28), MakeKeyBinding(RIGHT), MakeKeyBinding(LEFT),
+        MakeKeyBinding(0x20)
+    };
+    KeyBindingEngine engine { bindings };
+
+    std::mt19937 random { 3 };
+    std::bitset<256> isDown {};
+    auto time = START;
+    int mismatches = 0;
+    for (int i = 0; i < 100000; ++i) {
+        const auto vKey = KEYS[random() % KEYS.size()];
+        time += std::chrono::milliseconds(random() % 50);
+
+        std::optional<size_t> expected {};
+        std::optional<size_t> action {};
+        if (!isDown.test(vKey)) {
+            for (size_t j = 0; j < bindings.size(); ++j) {
+                if (bindings[j].sequence.front().vKey == vKey) {
+                    expected = j;
+                }
+            }
+            action = engine.OnKeyDown(vKey, time);
+            isDown.set(vKey);
+        } else if (random() % 2 == 0) {
+            action = engine.OnKeyHold(vKey, time);
+        } else {
+            action = engine.OnKeyUp(vKey, time);
+            isDown.reset(vKey);
+        }
+        mismatches += action != expected;
+    }
+    CHECK(mismatches == 0);
+}
+
+// Every key of a sequence of two, with random unbound keys and timeouts
+// mixed in, triggers exactly when its second chord follows its first in
+// time
+TEST(MatchesSequencesInRandomStream) {
+    std::vector<KeyBinding> bindings {};
+    for (uint8_t first = 'A'; first <= 'H'; ++first) {
+        for (uint8_t second = '1'; second <= '4'; ++second) {
+            bindings.push_back({
+                { { first, KeyModifiers::None }, { second, KeyModifiers::None } },
+                KeyPress::Down
+            });
+        }
+    }
+    KeyBindingEngine engine { bindings, 500ms, 1000ms };
+
+    std::mt19937 random { 5 };
+    auto time = START;
+    std::optional<uint8_t> first {};
+    auto firstTime = time;
+    int mismatches = 0;
+    int triggers = 0;
+    for (int i = 0; i < 100000; ++i) {
+        // Mostly bound keys, sometimes others that break the sequence
+        const auto choice = random() % 14;
+        const auto vKey = static_cast<uint8_t>(
+            choice < 8 ? 'A' + choice : choice < 12 ? '1' + choice - 8 : 'X');
+        time += std::chrono::milliseconds(random() % 2 == 0 ? 10 : 600);
+
+        std::optional<size_t> expected {};
+        const bool isFirst = vKey >= 'A' && vKey <= 'H';
+        const bool isSecond = vKey >= '1' && vKey <= '4';
+        if (isSecond && first && time - firstTime <= 1000ms) {
+            expected = static_cast<size_t>(*first - 'A') * 4 + (vKey - '1');
+        }
+        if (isFirst) {
+            first = vKey;
+            firstTime = time;
+        } else {
+            first.reset();
+        }
+
+        const auto action = Press(engine, vKey, time);
+        mismatches += action != expected;
+        triggers += action.has_value();
+    }
+    CHECK(mismatches == 0);
+    CHECK(triggers > 1000);
+}
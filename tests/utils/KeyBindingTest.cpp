@@ -0,0 +1,56 @@
+#include "Test.hpp"
+#include "utils/KeyBinding.hpp"
+
+#include <string>
+#include <string_view>
+
+TEST(FormatsParsedBindingsBack) {
+    for (const std::string_view text : {
+        "Right", "Ctrl+Right", "hold:Ctrl+Shift+F5", "tap:Numpad3",
+        "Ctrl+K F", "Alt+Win+Space", "0xE9", "Down", "LCtrl", "F24"
+    }) {
+        CHECK(FormatKeyBinding(ParseKeyBinding(text)) == text);
+    }
+}
+
+TEST(ParsesChordsAndSequences) {
+    const auto binding = ParseKeyBinding("hold:Ctrl+Shift+K F");
+    CHECK(binding.press == KeyPress::Hold);
+    REQUIRE(binding.sequence.size() == 2);
+    CHECK(binding.sequence[0] ==
+        KeyChord { 'K', KeyModifiers::Ctrl | KeyModifiers::Shift });
+    CHECK(binding.sequence[1] == KeyChord { 'F', KeyModifiers::None });
+    CHECK(ParseKeyBinding("Right").press == KeyPress::Down);
+    CHECK(ParseKeyBinding("tap:Right").press == KeyPress::Tap);
+}
+
+TEST(IgnoresCaseAndExtraSpaces) {
+    CHECK(ParseKeyBinding("ctrl+right") == ParseKeyBinding("Ctrl+Right"));
+    CHECK(ParseKeyBinding("  Ctrl+K   F ") == ParseKeyBinding("Ctrl+K F"));
+    CHECK(ParseKeyBinding("TAP:g") == ParseKeyBinding("tap:G"));
+}
+
+TEST(ParsesVirtualKeyCodes) {
+    CHECK(ParseKeyBinding("40") == MakeKeyBinding(40));
+    CHECK(ParseKeyBinding("0x28") == MakeKeyBinding(0x28));
+    CHECK(MakeKeyBinding(0x27) == ParseKeyBinding("Right"));
+}
+
+TEST(RejectsMalformedBindings) {
+    for (const std::string_view text : {
+        "", "   ", "Foo", "Ctrl+", "+A", "Meta+A", "tap:", "press:A", "F25",
+        "F0", "0x100", "256", "Numpad10", "Ctrl"
+    }) {
+        CHECK_THROWS(ParseKeyBinding(text));
+    }
+}
+
+TEST(MapsModifierKeys) {
+    CHECK(GetKeyModifier(0x11) == KeyModifiers::Ctrl);
+    CHECK(GetKeyModifier(0xA2) == KeyModifiers::Ctrl);
+    CHECK(GetKeyModifier(0xA3) == KeyModifiers::Ctrl);
+    CHECK(GetKeyModifier(0xA0) == KeyModifiers::Shift);
+    CHECK(GetKeyModifier(0xA5) == KeyModifiers::Alt);
+    CHECK(GetKeyModifier(0x5B) == KeyModifiers::Win);
+    CHECK(GetKeyModifier('A') == KeyModifiers::None);
+}
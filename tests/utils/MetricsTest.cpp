@@ -0,0 +1,198 @@
+#include "Test.hpp"
+#include "utils/Histogram.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/json/JsonReader.hpp"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+// Every scalar of a JSON document by its dotted path, as written, or
+// nothing if the document is not valid
+std::optional<std::map<std::string, std::string>> Flatten(
+    const std::string_view json) {
+    JsonReader reader { json };
+    std::map<std::string, std::string> values {};
+    std::vector<std::string> path {};
+    std::string key {};
+    while (true) {
+        const auto token = reader.Next();
+        switch (token) {
+        case JsonToken::Key:
+            key = reader.Value();
+            break;
+        case JsonToken::BeginObject:
+            path.push_back(key);
+            break;
+        case JsonToken::EndObject:
+            path.pop_back();
+            break;
+        case JsonToken::Number:
+        case JsonToken::String: {
+            std::string fullKey {};
+            for (const auto& part : path) {
+                fullKey += part.empty() ? "" : part + '.';
+            }
+            values[fullKey + key] = reader.Value();
+            break;
+        }
+        case JsonToken::End:
+            return values;
+        default:
+            return std::nullopt;
+        }
+    }
+}
+
+// Each line's name and its values: a single one keyed by "", or key=value
+// pairs
+std::map<std::string, std::map<std::string, std::string>> ParseText(
+    const std::string& text) {
+    std::map<std::string, std::map<std::string, std::string>> lines {};
+    std::istringstream stream { text };
+    std::string line {};
+    while (std::getline(stream, line)) {
+        std::istringstream words { line };
+        std::string name {};
+        words >> name;
+        auto& values = lines[name];
+        std::string word {};
+        while (words >> word) {
+            const auto equals = word.find('=');
+            if (equals == std::string::npos) {
+                values[""] = word;
+            } else {
+                values[word.substr(0, equals)] = word.substr(equals + 1);
+            }
+        }
+    }
+    return lines;
+}
+
+MetricsRegistry& FillRegistry(MetricsRegistry& registry) {
+    registry.RegisterCounter("hook.calls").Add(42);
+    registry.RegisterCounter("config.reloads").Add(3);
+    registry.RegisterGauge("queue.length").Set(-7);
+    auto& histogram = registry.RegisterHistogram("tick.ns");
+    for (uint64_t value = 1; value <= 100; ++value) {
+        histogram.Record(value * 1000);
+    }
+    return registry;
+}
+} // namespace
+
+TEST(ReturnsSameMetricForSameName) {
+    MetricsRegistry registry {};
+    auto& counter = registry.RegisterCounter("a");
+    counter.Add(5);
+    CHECK(&registry.RegisterCounter("a") == &counter);
+    CHECK(registry.RegisterCounter("a").Value() == 5);
+    CHECK(&registry.RegisterCounter("b") != &counter);
+    CHECK(&registry.RegisterGauge("g") == &registry.RegisterGauge("g"));
+    CHECK(&registry.RegisterHistogram("h") ==
+        &registry.RegisterHistogram("h"));
+}
+
+TEST(ThrowsForNameOfAnotherKind) {
+    MetricsRegistry registry {};
+    static_cast<void>(registry.RegisterCounter("counter"));
+    static_cast<void>(registry.RegisterGauge("gauge"));
+    static_cast<void>(registry.RegisterHistogram("histogram"));
+    CHECK_THROWS(registry.RegisterGauge("counter"));
+    CHECK_THROWS(registry.RegisterHistogram("counter"));
+    CHECK_THROWS(registry.RegisterCounter("gauge"));
+    CHECK_THROWS(registry.RegisterCounter("histogram"));
+    // The metric of the name is left as it was
+    CHECK(&registry.RegisterCounter("counter") ==
+        &registry.RegisterCounter("counter"));
+}
+
+// Threads registering the same names and updating them with relaxed
+// atomics lose nothing
+TEST(AddsUpConcurrentUpdates) {
+    constexpr int THREADS = 4;
+    constexpr uint64_t UPDATES = 100000;
+    MetricsRegistry registry {};
+    {
+        std::vector<std::jthread> threads {};
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&registry] {
+                auto& counter = registry.RegisterCounter("counter");
+                auto& gauge = registry.RegisterGauge("gauge");
+                auto& histogram = registry.RegisterHistogram("histogram");
+                for (uint64_t i = 0; i < UPDATES; ++i) {
+                    counter.Add();
+                    counter.Add(2);
+                    gauge.Add(1);
+                    gauge.Add(i % 2 == 0 ? -2 : 0);
+                    histogram.Record(i % 100);
+                }
+            });
+        }
+    }
+    CHECK(registry.RegisterCounter("counter").Value() ==
+        3 * THREADS * UPDATES);
+    CHECK(registry.RegisterGauge("gauge").Value() == 0);
+    const auto snapshot = registry.RegisterHistogram("histogram").Snapshot();
+    CHECK(snapshot.Count() == THREADS * UPDATES);
+    CHECK(snapshot.Sum() == THREADS * (UPDATES / 100) * 4950);
+}
+
+TEST(WritesJsonReadBackWithSameValues) {
+    MetricsRegistry registry {};
+    FillRegistry(registry);
+    for (const int indent : { -1, 0, 4 }) {
+        const auto values = Flatten(registry.ToJson(indent));
+        REQUIRE(values);
+        CHECK(values->at("counters.hook.calls") == "42");
+        CHECK(values->at("counters.config.reloads") == "3");
+        CHECK(values->at("gauges.queue.length") == "-7");
+        CHECK(values->at("histograms.tick.ns.count") == "100");
+        CHECK(values->at("histograms.tick.ns.sum") == "5050000");
+        CHECK(std::stod(values->at("histograms.tick.ns.mean")) == 50500.0);
+        const auto snapshot = registry.RegisterHistogram("tick.ns").Snapshot();
+        CHECK(values->at("histograms.tick.ns.p50") ==
+            std::to_string(snapshot.Percentile(50.0)));
+        CHECK(values->at("histograms.tick.ns.p99") ==
+            std::to_string(snapshot.Percentile(99.0)));
+        CHECK(values->at("histograms.tick.ns.max") ==
+            std::to_string(snapshot.Max()));
+        CHECK(values->size() == 10);
+    }
+}
+
+TEST(WritesTextMatchingJson) {
+    MetricsRegistry registry {};
+    FillRegistry(registry);
+    const auto json = Flatten(registry.ToJson());
+    REQUIRE(json);
+    const auto lines = ParseText(registry.ToText());
+    CHECK(lines.size() == 4);
+
+    CHECK(lines.at("hook.calls").at("") == json->at("counters.hook.calls"));
+    CHECK(lines.at("config.reloads").at("") ==
+        json->at("counters.config.reloads"));
+    CHECK(lines.at("queue.length").at("") == json->at("gauges.queue.length"));
+    const auto& histogram = lines.at("tick.ns");
+    CHECK(histogram.at("count") == json->at("histograms.tick.ns.count"));
+    CHECK(std::stod(histogram.at("mean")) ==
+        std::stod(json->at("histograms.tick.ns.mean")));
+    for (const auto* key : { "p50", "p90", "p99", "max" }) {
+        CHECK(histogram.at(key) ==
+            json->at(std::string { "histograms.tick.ns." } + key));
+    }
+}
+
+TEST(WritesEmptyRegistry) {
+    const MetricsRegistry registry {};
+    CHECK(registry.ToText().empty());
+    const auto values = Flatten(registry.ToJson());
+    REQUIRE(values);
+    CHECK(values->empty());
+}
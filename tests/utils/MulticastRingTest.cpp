@@ -0,0 +1,156 @@
+#include "Test.hpp"
+#include "utils/MulticastRing.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <thread>
+#include <vector>
+
+namespace {
+// Values a reader has not read yet, until there are none
+template <typename Ring>
+std::vector<uint64_t> Drain(typename Ring::Reader& reader) {
+    std::vector<uint64_t> values {};
+    uint64_t value {};
+    while (reader.Next(value)) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+std::vector<uint64_t> Sequence(const uint64_t first, const uint64_t last) {
+    std::vector<uint64_t> values {};
+    for (auto value = first; value < last; ++value) {
+        values.push_back(value);
+    }
+    return values;
+}
+} // namespace
+
+TEST(DeliversInOrderToEveryReader) {
+    using Ring = MulticastRing<uint64_t, 16>;
+    Ring ring {};
+    std::list<Ring::Reader> readers {};
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back(ring);
+    }
+    for (uint64_t value = 0; value < 10; ++value) {
+        ring.Push(value);
+    }
+    for (auto& reader : readers) {
+        CHECK(Drain<Ring>(reader) == Sequence(0, 10));
+        CHECK(reader.Lost() == 0);
+    }
+
+    // Readers do not take values from each other
+    ring.Push(10);
+    CHECK(Drain<Ring>(readers.front()) == Sequence(10, 11));
+    CHECK(Drain<Ring>(readers.back()) == Sequence(10, 11));
+}
+
+TEST(StartsAfterPushedValues) {
+    using Ring = MulticastRing<uint64_t, 16>;
+    Ring ring {};
+    ring.Push(1);
+    ring.Push(2);
+    Ring::Reader reader { ring };
+    CHECK(Drain<Ring>(reader).empty());
+    ring.Push(3);
+    CHECK(Drain<Ring>(reader) == Sequence(3, 4));
+}
+
+TEST(WrapsAroundCapacity) {
+    using Ring = MulticastRing<uint64_t, 8>;
+    Ring ring {};
+    Ring::Reader reader { ring };
+    std::vector<uint64_t> values {};
+    for (uint64_t value = 0; value < 100; ++value) {
+        ring.Push(value);
+        if (value % 5 == 4) {
+            const auto drained = Drain<Ring>(reader);
+            values.insert(values.end(), drained.begin(), drained.end());
+        }
+    }
+    CHECK(values == Sequence(0, 100));
+    CHECK(reader.Lost() == 0);
+}
+
+// A reader lapped by the producer gets the last Capacity values and counts
+// the ones before as lost
+TEST(SkipsValuesOfLappedReader) {
+    using Ring = MulticastRing<uint64_t, 1024>;
+    Ring ring {};
+    Ring::Reader slow { ring };
+    Ring::Reader fast { ring };
+    for (uint64_t value = 0; value < 3000; ++value) {
+        ring.Push(value);
+        if (value % 512 == 511) {
+            static_cast<void>(Drain<Ring>(fast));
+        }
+    }
+    CHECK(Drain<Ring>(slow) == Sequence(3000 - 1024, 3000));
+    CHECK(slow.Lost() == 3000 - 1024);
+    CHECK(fast.Lost() == 0);
+
+    // Back in step afterwards
+    ring.Push(3000);
+    CHECK(Drain<Ring>(slow) == Sequence(3000, 3001));
+    CHECK(slow.Lost() == 3000 - 1024);
+}
+
+// Readers on their own threads, racing the producer, see values in order,
+// and every value is either read or counted as lost
+TEST(DeliversToConcurrentReaders) {
+    using Ring = MulticastRing<uint64_t, 64>;
+    constexpr uint64_t COUNT = 200000;
+    constexpr size_t READERS = 4;
+    Ring ring {};
+    std::atomic<bool> isDone { false };
+    std::atomic<int> errors { 0 };
+    std::atomic<uint64_t> totalRead { 0 };
+
+    std::vector<std::jthread> threads {};
+    std::atomic<size_t> readyCount { 0 };
+    for (size_t i = 0; i < READERS; ++i) {
+        threads.emplace_back([&] {
+            Ring::Reader reader { ring };
+            ++readyCount;
+            uint64_t read = 0;
+            uint64_t next = 0;
+            uint64_t value {};
+            while (true) {
+                if (reader.Next(value)) {
+                    errors += value < next;
+                    next = value + 1;
+                    ++read;
+                } else if (isDone.load(std::memory_order_acquire)) {
+                    if (!reader.Next(value)) {
+                        break;
+                    }
+                    errors += value < next;
+                    next = value + 1;
+                    ++read;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            errors += read + reader.Lost() != COUNT;
+            totalRead += read;
+        });
+    }
+    while (readyCount.load() < READERS) {
+        std::this_thread::yield();
+    }
+    for (uint64_t value = 0; value < COUNT; ++value) {
+        ring.Push(value);
+        if (value % 32 == 31) {
+            std::this_thread::yield();
+        }
+    }
+    isDone.store(true, std::memory_order_release);
+    threads.clear();
+    CHECK(errors.load() == 0);
+    CHECK(totalRead.load() > 0);
+}
@@ -0,0 +1,111 @@
+#include "Test.hpp"
+#include "utils/OffsetCache.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+constexpr ModuleFingerprint GLOBAL_BUILD {
+    .timeDateStamp = 0x65A1B2C3,
+    .sizeOfImage = 0x1F4A000,
+    .sectionHash = 0x0123456789ABCDEF
+};
+
+std::filesystem::path TempPath() {
+    const auto path = std::filesystem::temp_directory_path() /
+        "offset_cache_test.txt";
+    std::filesystem::remove(path);
+    return path;
+}
+} // namespace
+
+TEST(RoundTripsEntries) {
+    const auto path = TempPath();
+    {
+        OffsetCache cache { path };
+        cache.Set("SetFieldOfView", GLOBAL_BUILD, 0xFD8BE0);
+        cache.Set("GetCamera", GLOBAL_BUILD, 0x123450);
+        cache.Write();
+    }
+
+    OffsetCache cache { path };
+    cache.Read();
+    CHECK(cache.Get("SetFieldOfView", GLOBAL_BUILD) == 0xFD8BE0);
+    CHECK(cache.Get("GetCamera", GLOBAL_BUILD) == 0x123450);
+    CHECK(!cache.Get("Missing", GLOBAL_BUILD));
+    std::filesystem::remove(path);
+}
+
+TEST(MissesStaleFingerprints) {
+    OffsetCache cache { TempPath() };
+    cache.Set("SetFieldOfView", GLOBAL_BUILD, 0xFD8BE0);
+
+    auto patched = GLOBAL_BUILD;
+    ++patched.timeDateStamp;
+    CHECK(!cache.Get("SetFieldOfView", patched));
+    patched = GLOBAL_BUILD;
+    patched.sizeOfImage += 0x1000;
+    CHECK(!cache.Get("SetFieldOfView", patched));
+    patched = GLOBAL_BUILD;
+    patched.sectionHash ^= 1;
+    CHECK(!cache.Get("SetFieldOfView", patched));
+
+    // A new build replaces the entry of the previous one
+    cache.Set("SetFieldOfView", patched, 0xFD9000);
+    CHECK(cache.Get("SetFieldOfView", patched) == 0xFD9000);
+    CHECK(!cache.Get("SetFieldOfView", GLOBAL_BUILD));
+}
+
+TEST(ReadsMissingFileAsEmpty) {
+    OffsetCache cache { TempPath() };
+    cache.Set("SetFieldOfView", GLOBAL_BUILD, 0xFD8BE0);
+    cache.Read();
+    CHECK(!cache.Get("SetFieldOfView", GLOBAL_BUILD));
+}
+
+TEST(SkipsMalformedLines) {
+    const auto path = TempPath();
+    {
+        std::ofstream file { path };
+        file << "SetFieldOfView 65a1b2c3 1f4a000 123456789abcdef fd8be0\n"
+            << "Truncated 65a1b2c3 1f4a\n"
+            << "NotHex zz 1 2 3\n"
+            << "\n";
+    }
+    OffsetCache cache { path };
+    cache.Read();
+    CHECK(cache.Get("SetFieldOfView", GLOBAL_BUILD) == 0xFD8BE0);
+    CHECK(!cache.Get("Truncated", { 0x65A1B2C3, 0x1F4A, 0 }));
+    std::filesystem::remove(path);
+}
+
+TEST(OverwritesWholeFile) {
+    const auto path = TempPath();
+    {
+        std::ofstream file { path };
+        file << std::string(4096, 'x') << '\n';
+    }
+    OffsetCache cache { path };
+    cache.Set("SetFieldOfView", GLOBAL_BUILD, 0xFD8BE0);
+    cache.Write();
+    CHECK(std::filesystem::file_size(path) < 100);
+
+    // No temporary file is left next to it
+    size_t fileCount = 0;
+    for (const auto& entry : std::filesystem::directory_iterator {
+        path.parent_path() }) {
+        fileCount += entry.path().filename().string().starts_with(
+            path.filename().string());
+    }
+    CHECK(fileCount == 1);
+    std::filesystem::remove(path);
+}
+
+TEST(RejectsNamesThatAreNotWords) {
+    OffsetCache cache { TempPath() };
+    CHECK_THROWS(cache.Set("", GLOBAL_BUILD, 1));
+    CHECK_THROWS(cache.Set("Set Fov", GLOBAL_BUILD, 1));
+    CHECK_THROWS(cache.Set("SetFov\n", GLOBAL_BUILD, 1));
+}
@@ -0,0 +1,113 @@
+#include "Test.hpp"
+#include "utils/PageHookIndex.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr size_t PAGE_SIZE = 0x1000;
+
+void* Address(const uintptr_t value) noexcept {
+    return reinterpret_cast<void*>(value);
+}
+} // namespace
+
+TEST(FindsHooksByPage) {
+    PageHookIndex index { PAGE_SIZE };
+    index.Insert(Address(0x10010), Address(0xD1));
+    index.Insert(Address(0x10020), Address(0xD2));
+    index.Insert(Address(0x30000), Address(0xD3));
+
+    CHECK(index.Size() == 3);
+    CHECK(index.Pages() == std::vector<uintptr_t> { 0x10000, 0x30000 });
+    CHECK(index.FindDetour(Address(0x10010)) == Address(0xD1));
+    CHECK(index.FindDetour(Address(0x10020)) == Address(0xD2));
+    CHECK(index.FindDetour(Address(0x30000)) == Address(0xD3));
+    CHECK(!index.FindDetour(Address(0x10011)));
+    CHECK(index.IsHookedPage(Address(0x10FFF)));
+    CHECK(!index.IsHookedPage(Address(0x20000)));
+    CHECK(index.Contains(Address(0x10020)));
+    CHECK(!index.Contains(Address(0x10030)));
+}
+
+TEST(ReportsEmptiedPages) {
+    PageHookIndex index { PAGE_SIZE };
+    index.Insert(Address(0x10010), Address(0xD1));
+    index.Insert(Address(0x10020), Address(0xD2));
+
+    CHECK(!index.Erase(Address(0x10030)));
+    CHECK(!index.Erase(Address(0x10010)));
+    CHECK(index.IsHookedPage(Address(0x10000)));
+    CHECK(index.Erase(Address(0x10020)));
+    CHECK(!index.IsHookedPage(Address(0x10000)));
+    CHECK(index.Size() == 0);
+    CHECK(!index.Erase(Address(0x10020)));
+}
+
+TEST(RejectsInvalidInserts) {
+    PageHookIndex index { PAGE_SIZE };
+    index.Insert(Address(0x10010), Address(0xD1));
+    CHECK_THROWS(index.Insert(Address(0x10010), Address(0xD2)));
+    CHECK_THROWS(index.Insert(nullptr, Address(0xD2)));
+    CHECK_THROWS(index.Insert(Address(0x10020), nullptr));
+    CHECK(index.Size() == 1);
+
+    index.Clear();
+    CHECK(index.Size() == 0);
+    CHECK(index.Pages().empty());
+    CHECK(!index.FindDetour(Address(0x10010)));
+}
+
+TEST(KeepsPendingPagePerThread) {
+    CHECK(!PageHookIndex::TakePendingPage());
+    PageHookIndex::SetPendingPage(0x10000);
+
+    std::thread { [] {
+        CHECK(!PageHookIndex::TakePendingPage());
+        PageHookIndex::SetPendingPage(0x20000);
+        CHECK(PageHookIndex::TakePendingPage() == 0x20000);
+    } }.join();
+
+    CHECK(PageHookIndex::TakePendingPage() == 0x10000);
+    CHECK(!PageHookIndex::TakePendingPage());
+}
+
+// A reader looking up a hook that stays inserted must always find it while
+// other hooks on the same and other pages come and go
+TEST(LookupsRaceWithChanges) {
+    PageHookIndex index { PAGE_SIZE };
+    index.Insert(Address(0x10800), Address(0xD0));
+
+    std::atomic<bool> isDone { false };
+    std::atomic<uint64_t> misses { 0 };
+    std::atomic<uint64_t> lookups { 0 };
+    std::thread reader { [&] {
+        while (!isDone.load(std::memory_order_relaxed)) {
+            if (index.FindDetour(Address(0x10800)) != Address(0xD0) ||
+                !index.IsHookedPage(Address(0x10000))) {
+                misses.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (lookups.fetch_add(1, std::memory_order_relaxed) % 256 == 0) {
+                std::this_thread::yield();
+            }
+        }
+    } };
+
+    for (uintptr_t round = 0; round < 500; ++round) {
+        for (uintptr_t i = 1; i <= 8; ++i) {
+            index.Insert(Address(i * 0x10000 + 0x10), Address(0xD0 + i));
+        }
+        for (uintptr_t i = 1; i <= 8; ++i) {
+            index.Erase(Address(i * 0x10000 + 0x10));
+        }
+        std::this_thread::yield();
+    }
+    isDone = true;
+    reader.join();
+
+    CHECK(misses == 0);
+    CHECK(lookups > 0);
+    CHECK(index.Size() == 1);
+}
@@ -0,0 +1,238 @@
+#include "Test.hpp"
+#include "utils/MappedFile.hpp"
+#include "utils/PeImage.hpp"
+#include "utils/Signature.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// A small PE32+ image is built in both layouts: .text with code, .rdata with
+// an MSVC type descriptor and an export table, and .data without raw data
+
+namespace {
+constexpr uint32_t TIME_DATE_STAMP = 0x65A1B2C3;
+constexpr uint32_t SIZE_OF_IMAGE = 0x4000;
+constexpr uint32_t SIZE_OF_HEADERS = 0x400;
+constexpr uint32_t FILE_SIZE = 0xA00;
+
+constexpr uint32_t FUNCTION_RVA = 0x1040;
+constexpr uint32_t TYPE_DESCRIPTOR_RVA = 0x2100;
+constexpr uint32_t EXPORT_DIRECTORY_RVA = 0x2200;
+
+struct SectionHeader {
+    std::string_view name;
+    uint32_t virtualAddress;
+    uint32_t virtualSize;
+    uint32_t rawDataOffset;
+    uint32_t rawDataSize;
+    uint32_t characteristics;
+};
+
+constexpr SectionHeader SECTIONS[] {
+    { ".text", 0x1000, 0x180, 0x400, 0x200, 0x60000020 },
+    { ".rdata", 0x2000, 0x300, 0x600, 0x400, 0x40000040 },
+    { ".data", 0x3000, 0x100, 0, 0, 0xC0000080 }
+};
+
+template <typename T>
+void Write(std::vector<uint8_t>& data, const size_t offset, const T value) {
+    std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+void Write(
+    std::vector<uint8_t>& data, const size_t offset,
+    const std::string_view text) {
+    std::memcpy(data.data() + offset, text.data(), text.size());
+}
+
+std::vector<uint8_t> BuildImage() {
+    std::vector<uint8_t> image(SIZE_OF_IMAGE);
+    Write<uint16_t>(image, 0, 0x5A4D);
+    Write<uint32_t>(image, 0x3C, 0x40);
+    Write<uint32_t>(image, 0x40, 0x00004550);
+
+    constexpr size_t FILE_HEADER = 0x44;
+    Write<uint16_t>(image, FILE_HEADER, 0x8664);
+    Write<uint16_t>(image, FILE_HEADER + 2, std::size(SECTIONS));
+    Write<uint32_t>(image, FILE_HEADER + 4, TIME_DATE_STAMP);
+    Write<uint16_t>(image, FILE_HEADER + 16, 240);
+
+    constexpr size_t OPTIONAL_HEADER = FILE_HEADER + 20;
+    Write<uint16_t>(image, OPTIONAL_HEADER, 0x020B);
+    Write<uint32_t>(image, OPTIONAL_HEADER + 56, SIZE_OF_IMAGE);
+    Write<uint32_t>(image, OPTIONAL_HEADER + 60, SIZE_OF_HEADERS);
+    Write<uint32_t>(image, OPTIONAL_HEADER + 108, 16);
+    Write<uint32_t>(image, OPTIONAL_HEADER + 112, EXPORT_DIRECTORY_RVA);
+    Write<uint32_t>(image, OPTIONAL_HEADER + 116, 0x80);
+
+    size_t header = OPTIONAL_HEADER + 240;
+    for (const auto& section : SECTIONS) {
+        Write(image, header, section.name);
+        Write(image, header + 8, section.virtualSize);
+        Write(image, header + 12, section.virtualAddress);
+        Write(image, header + 16, section.rawDataSize);
+        Write(image, header + 20, section.rawDataOffset);
+        Write(image, header + 36, section.characteristics);
+        header += 40;
+    }
+
+    // Code, with a decorated name that must not be taken for a descriptor
+    Write(image, FUNCTION_RVA,
+        std::string_view { "\x48\x89\x5C\x24\x08\x57\xC3" });
+    Write(image, 0x1100, std::string_view { ".?AVCode@@\0", 11 });
+
+    Write(image, TYPE_DESCRIPTOR_RVA + 16,
+        std::string_view { ".?AVCamera@@\0", 13 });
+
+    Write<uint32_t>(image, EXPORT_DIRECTORY_RVA + 20, 1);
+    Write<uint32_t>(image, EXPORT_DIRECTORY_RVA + 24, 1);
+    Write<uint32_t>(image, EXPORT_DIRECTORY_RVA + 28, 0x2240);
+    Write<uint32_t>(image, EXPORT_DIRECTORY_RVA + 32, 0x2250);
+    Write<uint32_t>(image, EXPORT_DIRECTORY_RVA + 36, 0x2258);
+    Write<uint32_t>(image, 0x2240, FUNCTION_RVA);
+    Write<uint32_t>(image, 0x2250, 0x2260);
+    Write<uint16_t>(image, 0x2258, 0);
+    Write(image, 0x2260, std::string_view { "SetFov\0", 7 });
+    return image;
+}
+
+// Same image as stored on disk, with sections at their raw data offsets
+std::vector<uint8_t> BuildFile() {
+    const auto image = BuildImage();
+    std::vector<uint8_t> file(FILE_SIZE);
+    std::memcpy(file.data(), image.data(), SIZE_OF_HEADERS);
+    for (const auto& section : SECTIONS) {
+        std::memcpy(file.data() + section.rawDataOffset,
+            image.data() + section.virtualAddress, section.rawDataSize);
+    }
+    return file;
+}
+
+const PeImage::Section* FindSection(
+    const PeImage& image, const std::string_view name) {
+    for (const auto& section : image.Sections()) {
+        if (section.name == name) {
+            return &section;
+        }
+    }
+    return nullptr;
+}
+} // namespace
+
+TEST(ParsesHeadersAndSections) {
+    const auto data = BuildImage();
+    const PeImage image { data };
+    CHECK(image.TimeDateStamp() == TIME_DATE_STAMP);
+    CHECK(image.SizeOfImage() == SIZE_OF_IMAGE);
+    CHECK(image.Headers().size() == SIZE_OF_HEADERS);
+
+    REQUIRE(image.Sections().size() == std::size(SECTIONS));
+    for (size_t i = 0; i < std::size(SECTIONS); ++i) {
+        const auto& section = image.Sections()[i];
+        CHECK(section.name == SECTIONS[i].name);
+        CHECK(section.virtualAddress == SECTIONS[i].virtualAddress);
+        CHECK(section.rawDataSize == SECTIONS[i].rawDataSize);
+        CHECK(section.IsExecutable() == (i == 0));
+    }
+}
+
+TEST(SectionDataAgreesAcrossLayouts) {
+    const auto imageData = BuildImage();
+    const auto fileData = BuildFile();
+    const PeImage image { imageData, PeImage::Layout::Image };
+    const PeImage file { fileData, PeImage::Layout::File };
+
+    const auto imageText = image.SectionData(*FindSection(image, ".text"));
+    const auto fileText = file.SectionData(*FindSection(file, ".text"));
+    REQUIRE(imageText.size() == 0x180);
+    REQUIRE(fileText.size() == 0x180);
+    CHECK(std::memcmp(imageText.data(), fileText.data(), 0x180) == 0);
+    CHECK(imageText.data() == imageData.data() + 0x1000);
+    CHECK(fileText.data() == fileData.data() + 0x400);
+
+    // Uninitialized data only exists once loaded
+    CHECK(image.SectionData(*FindSection(image, ".data")).size() == 0x100);
+    CHECK(file.SectionData(*FindSection(file, ".data")).empty());
+}
+
+TEST(MapsRvasToOffsets) {
+    const auto fileData = BuildFile();
+    const PeImage file { fileData, PeImage::Layout::File };
+    CHECK(file.RvaToOffset(0x10) == 0x10);
+    CHECK(file.RvaToOffset(FUNCTION_RVA) == 0x440);
+    CHECK(file.RvaToOffset(TYPE_DESCRIPTOR_RVA) == 0x700);
+    CHECK(!file.RvaToOffset(0x3000));
+    CHECK(!file.RvaToOffset(0x5000));
+
+    const auto imageData = BuildImage();
+    const PeImage image { imageData };
+    CHECK(image.RvaToOffset(FUNCTION_RVA) == FUNCTION_RVA);
+    CHECK(!image.RvaToOffset(SIZE_OF_IMAGE));
+}
+
+TEST(FindsExportsAndTypeDescriptors) {
+    const auto imageData = BuildImage();
+    const auto fileData = BuildFile();
+    for (const PeImage& image : {
+        PeImage { imageData, PeImage::Layout::Image },
+        PeImage { fileData, PeImage::Layout::File } }) {
+        const auto exports = image.Exports();
+        REQUIRE(exports.size() == 1);
+        CHECK(exports[0].name == "SetFov");
+        CHECK(image.FindExport("SetFov") == FUNCTION_RVA);
+        CHECK(!image.FindExport("SetFo"));
+
+        CHECK(image.FindTypeDescriptor(".?AVCamera@@") == TYPE_DESCRIPTOR_RVA);
+        CHECK(!image.FindTypeDescriptor(".?AVCamera"));
+        CHECK(!image.FindTypeDescriptor(".?AVCode@@"));
+    }
+}
+
+TEST(RejectsMalformedImages) {
+    auto data = BuildImage();
+    CHECK_THROWS(PeImage { std::span { data }.first(0x50) });
+    CHECK_THROWS(PeImage { std::span { data }.first(1) });
+
+    Write<uint16_t>(data, 0x58, 0x0107);
+    CHECK_THROWS(PeImage { data });
+    Write<uint32_t>(data, 0x40, 0);
+    CHECK_THROWS(PeImage { data });
+    Write<uint16_t>(data, 0, 0);
+    CHECK_THROWS(PeImage { data });
+}
+
+TEST(ScansMappedFileSections) {
+    const auto path = std::filesystem::temp_directory_path() /
+        "pe_image_test.exe";
+    {
+        const auto fileData = BuildFile();
+        std::ofstream file { path, std::ios::binary };
+        file.write(reinterpret_cast<const char*>(fileData.data()),
+            static_cast<std::streamsize>(fileData.size()));
+    }
+
+    {
+        const MappedFile mappedFile { path };
+        const PeImage image { mappedFile.Data(), PeImage::Layout::File };
+        const Signature signature { "48 89 5C 24 ?? 57" };
+        std::optional<uint32_t> rva {};
+        for (const auto& section : image.Sections()) {
+            if (!section.IsExecutable()) {
+                continue;
+            }
+            if (const auto offset = signature.FindParallel(
+                image.SectionData(section))) {
+                rva = section.virtualAddress + static_cast<uint32_t>(*offset);
+            }
+        }
+        CHECK(rva == FUNCTION_RVA);
+    }
+    std::filesystem::remove(path);
+}
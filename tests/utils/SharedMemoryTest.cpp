@@ -0,0 +1,127 @@
+#include "Test.hpp"
+#include "utils/SharedMemory.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#ifdef _WIN32
+    #include <Windows.h>
+#else
+    #include <csignal>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+constexpr size_t SIZE = 4096;
+
+// Unique to the process, so that parallel runs do not meet
+std::string MakeName(const std::string_view test) {
+#ifdef _WIN32
+    const auto id = std::to_string(GetCurrentProcessId());
+#else
+    const auto id = std::to_string(getpid());
+#endif
+    return "shared_memory_test_" + std::string { test } + "_" + id;
+}
+
+bool ThrowsSystemError(
+    const std::string& name,
+    const size_t size,
+    const SharedMemory::Access access) {
+    try {
+        const SharedMemory memory { name, size, access };
+        return false;
+    } catch (const std::system_error&) {
+        return true;
+    }
+}
+} // namespace
+
+TEST(SharesDataBetweenMappings) {
+    const auto name = MakeName("share");
+    const SharedMemory creator { name, SIZE, SharedMemory::Access::Create };
+    REQUIRE(creator.Data().size() == SIZE);
+    for (const auto byte : creator.Data()) {
+        REQUIRE(byte == std::byte { 0 });
+    }
+    creator.Data()[100] = std::byte { 42 };
+
+    const SharedMemory reader { name, SIZE, SharedMemory::Access::ReadOnly };
+    CHECK(reader.Data()[100] == std::byte { 42 });
+    const SharedMemory writer { name, SIZE, SharedMemory::Access::ReadWrite };
+    writer.Data()[200] = std::byte { 7 };
+    CHECK(creator.Data()[200] == std::byte { 7 });
+}
+
+TEST(FailsToCreateExistingRegion) {
+    const auto name = MakeName("exists");
+    const SharedMemory creator { name, SIZE, SharedMemory::Access::Create };
+    creator.Data()[0] = std::byte { 1 };
+    CHECK(ThrowsSystemError(name, SIZE, SharedMemory::Access::Create));
+    // Left as it was, and still there for readers
+    CHECK(creator.Data()[0] == std::byte { 1 });
+    const SharedMemory reader { name, SIZE, SharedMemory::Access::ReadOnly };
+    CHECK(reader.Data()[0] == std::byte { 1 });
+}
+
+TEST(FailsToOpenMissingOrSmallerRegion) {
+    const auto name = MakeName("missing");
+    CHECK(ThrowsSystemError(name, SIZE, SharedMemory::Access::ReadOnly));
+    CHECK(ThrowsSystemError(name, SIZE, SharedMemory::Access::ReadWrite));
+#ifndef _WIN32
+    // Views on Windows are not checked against the mapping's size
+    const SharedMemory creator { name, SIZE, SharedMemory::Access::Create };
+    CHECK(ThrowsSystemError(name, SIZE * 2, SharedMemory::Access::ReadOnly));
+#endif
+}
+
+TEST(RemovesNameWhenCreatorCloses) {
+    const auto name = MakeName("close");
+    {
+        const SharedMemory creator { name, SIZE, SharedMemory::Access::Create };
+    }
+    CHECK(ThrowsSystemError(name, SIZE, SharedMemory::Access::ReadOnly));
+    // And it can be created again
+    const SharedMemory creator { name, SIZE, SharedMemory::Access::Create };
+    CHECK(creator.Data()[0] == std::byte { 0 });
+}
+
+#ifndef _WIN32
+// A creator in another process keeps the region until it dies, which leaves
+// the name behind for the next creator to take over
+TEST(TakesOverRegionOfDeadCreator) {
+    const auto name = MakeName("dead");
+    int ready[2] {};
+    REQUIRE(pipe(ready) == 0);
+    const pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) try {
+        const SharedMemory creator { name, SIZE, SharedMemory::Access::Create };
+        creator.Data()[0] = std::byte { 9 };
+        const char byte = 1;
+        static_cast<void>(write(ready[1], &byte, 1));
+        pause();
+        _exit(0);
+    } catch (...) {
+        _exit(1);
+    }
+    char byte {};
+    REQUIRE(read(ready[0], &byte, 1) == 1);
+    close(ready[0]);
+    close(ready[1]);
+
+    CHECK(ThrowsSystemError(name, SIZE, SharedMemory::Access::Create));
+    {
+        const SharedMemory reader { name, SIZE, SharedMemory::Access::ReadOnly };
+        CHECK(reader.Data()[0] == std::byte { 9 });
+    }
+
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+    const SharedMemory creator { name, SIZE, SharedMemory::Access::Create };
+    CHECK(creator.Data()[0] == std::byte { 0 });
+}
+#endif
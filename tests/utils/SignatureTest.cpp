@@ -0,0 +1,169 @@
+#include "Test.hpp"
+#include "utils/Signature.hpp"
+
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+// The vector scans are checked against a plain byte-by-byte search
+
+namespace {
+struct Pattern {
+    std::vector<uint8_t> bytes;
+    std::vector<bool> isWildcard;
+};
+
+std::optional<size_t> FindReference(
+    const Pattern& pattern, const std::span<const uint8_t> data) {
+    for (size_t i = 0; i + pattern.bytes.size() <= data.size(); ++i) {
+        bool isMatch = true;
+        for (size_t j = 0; j < pattern.bytes.size() && isMatch; ++j) {
+            isMatch = pattern.isWildcard[j] || data[i + j] == pattern.bytes[j];
+        }
+        if (isMatch) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string ToString(const Pattern& pattern) {
+    constexpr auto DIGITS = "0123456789ABCDEF";
+    std::string text {};
+    for (size_t i = 0; i < pattern.bytes.size(); ++i) {
+        if (pattern.isWildcard[i]) {
+            text += "?? ";
+            continue;
+        }
+        text += DIGITS[pattern.bytes[i] >> 4];
+        text += DIGITS[pattern.bytes[i] & 0xF];
+        text += ' ';
+    }
+    return text;
+}
+
+// Pattern copied from data at offset, with some bytes made wildcards but
+// never all of them
+Pattern CopyPattern(
+    std::mt19937& random, const std::span<const uint8_t> data,
+    const size_t offset, const size_t size) {
+    Pattern pattern {
+        { data.begin() + offset, data.begin() + offset + size },
+        std::vector<bool>(size)
+    };
+    std::bernoulli_distribution isWildcard { 0.25 };
+    for (size_t i = 0; i < size; ++i) {
+        pattern.isWildcard[i] = isWildcard(random);
+    }
+    pattern.isWildcard[std::uniform_int_distribution<size_t> {
+        0, size - 1 }(random)] = false;
+    return pattern;
+}
+
+// Few distinct byte values so that anchors match often and candidates have
+// to be verified
+std::vector<uint8_t> RandomBuffer(
+    std::mt19937& random, const size_t size, const int maxByte) {
+    std::uniform_int_distribution<int> byte { 0, maxByte };
+    std::vector<uint8_t> data(size);
+    for (auto& value : data) {
+        value = static_cast<uint8_t>(byte(random));
+    }
+    return data;
+}
+} // namespace
+
+TEST(MatchesReferenceOnRandomBuffers) {
+    std::mt19937 random { 26 };
+    for (int round = 0; round < 2000; ++round) {
+        const auto size = std::uniform_int_distribution<size_t> {
+            1, 300 }(random);
+        const auto data = RandomBuffer(random, size, round % 2 ? 3 : 255);
+        const auto patternSize = std::uniform_int_distribution<size_t> {
+            1, std::min<size_t>(size, 40) }(random);
+        const auto offset = std::uniform_int_distribution<size_t> {
+            0, size - patternSize }(random);
+
+        const auto pattern = CopyPattern(random, data, offset, patternSize);
+        const Signature signature { ToString(pattern) };
+        const auto expected = FindReference(pattern, data);
+        REQUIRE(expected.has_value());
+        CHECK(signature.Find(data) == expected);
+        CHECK(signature.Matches(data, *expected));
+    }
+}
+
+TEST(MissesAbsentPattern) {
+    std::mt19937 random { 261 };
+    for (int round = 0; round < 200; ++round) {
+        const auto data = RandomBuffer(random, 1000, 0xFE);
+        Pattern pattern {
+            { 0x10, 0xFF, 0x20 }, { false, false, true }
+        };
+        pattern.bytes[0] = data[round];
+        const Signature signature { ToString(pattern) };
+        CHECK(!FindReference(pattern, data));
+        CHECK(!signature.Find(data));
+    }
+}
+
+TEST(FindsMatchInTail) {
+    // Every position of the last vector block, and past it
+    for (size_t size = 64; size < 100; ++size) {
+        for (size_t offset = size - 40; offset + 4 <= size; ++offset) {
+            std::vector<uint8_t> data(size, 0x90);
+            data[offset] = 0x48;
+            data[offset + 3] = 0xC3;
+            const Signature signature { "48 ?? ?? C3" };
+            CHECK(signature.Find(data) == offset);
+        }
+    }
+}
+
+TEST(HandlesShortBuffers) {
+    const Signature signature { "48 8B ?? 89" };
+    const std::vector<uint8_t> data { 0x48, 0x8B, 0x00 };
+    CHECK(!signature.Find(data));
+    CHECK(!signature.Matches(data));
+    CHECK(!signature.Matches(data, 10));
+    CHECK(!signature.Find({}));
+}
+
+TEST(RejectsInvalidPatterns) {
+    CHECK_THROWS(Signature { "" });
+    CHECK_THROWS(Signature { "?? ??" });
+    CHECK_THROWS(Signature { "48 8" });
+    CHECK_THROWS(Signature { "48 GG" });
+    CHECK_THROWS(Signature { "488B" });
+    CHECK(Signature { " ? 48\t8B\n" }.Size() == 3);
+}
+
+TEST(ParallelFindsFirstMatch) {
+    constexpr size_t CHUNK_SIZE = 1 << 20;
+    std::mt19937 random { 2026 };
+    auto data = RandomBuffer(random, 5 * CHUNK_SIZE + 123, 0x7F);
+    const std::vector<uint8_t> bytes { 0xE8, 0xAA, 0xBB, 0xCC, 0xF3 };
+    const Signature signature { "E8 ?? BB CC F3" };
+    const auto plant = [&](const size_t offset) {
+        std::copy(bytes.begin(), bytes.end(), data.begin() + offset);
+    };
+
+    CHECK(!signature.FindParallel(data, 4));
+
+    // Straddling the boundary between the second and third chunk, with a
+    // later match in a chunk that a thread may finish first
+    plant(5 * CHUNK_SIZE);
+    plant(2 * CHUNK_SIZE - 2);
+    for (const size_t threads : { 0, 1, 2, 3, 8 }) {
+        CHECK(signature.FindParallel(data, threads) == 2 * CHUNK_SIZE - 2);
+        CHECK(signature.FindParallel(data, threads) == signature.Find(data));
+    }
+
+    plant(CHUNK_SIZE / 2);
+    CHECK(signature.FindParallel(data, 4) == CHUNK_SIZE / 2);
+}
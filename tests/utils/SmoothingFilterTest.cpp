@@ -0,0 +1,174 @@
+#include "Test.hpp"
+#include "utils/AlphaPolicy.hpp"
+#include "utils/ExponentialFilter.hpp"
+#include "utils/ManualClock.hpp"
+#include "utils/OneEuroFilter.hpp"
+#include "utils/SmoothingFilter.hpp"
+#include "utils/SpringFilter.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <optional>
+
+// Step responses of the filters from 0 to 1 with a time constant of 0.1 s:
+// when each crosses 63% and 90%, whether it overshoots, and whether the
+// result depends on the frame rate
+
+namespace {
+using namespace std::chrono_literals;
+using Time = ManualClock::time_point;
+
+constexpr double TIME_CONSTANT = 0.1;
+
+struct StepResponse {
+    std::optional<double> rise63;
+    std::optional<double> rise90;
+    double maxValue;
+    bool isMonotonic;
+};
+
+// Crossing times are in time constants, linearly interpolated between
+// frames
+template <typename Filter>
+StepResponse MeasureStep(Filter& filter, const std::chrono::microseconds frame) {
+    filter.SetInitialValue(0.0, Time {});
+    StepResponse response { std::nullopt, std::nullopt, 0.0, true };
+    double previous = 0.0;
+    for (auto time = Time {} + frame; time < Time { 2s }; time += frame) {
+        const double value = filter.Update(1.0, time);
+        const double seconds =
+            std::chrono::duration<double>(time.time_since_epoch()).count();
+        const auto crossing = [&](const double level) {
+            const double fraction = (level - previous) / (value - previous);
+            const double frameSeconds =
+                std::chrono::duration<double>(frame).count();
+            return (seconds - frameSeconds * (1.0 - fraction)) / TIME_CONSTANT;
+        };
+        if (!response.rise63 && value >= 1.0 - std::exp(-1.0)) {
+            response.rise63 = crossing(1.0 - std::exp(-1.0));
+        }
+        if (!response.rise90 && value >= 0.9) {
+            response.rise90 = crossing(0.9);
+        }
+        response.maxValue = std::max(response.maxValue, value);
+        response.isMonotonic = response.isMonotonic && value >= previous;
+        previous = value;
+    }
+    return response;
+}
+
+bool IsNear(const std::optional<double> value, const double expected,
+    const double tolerance) {
+    return value && std::abs(*value - expected) <= tolerance;
+}
+} // namespace
+
+TEST(SpringSettlesWithoutOvershoot) {
+    SpringFilter<double, ManualClock> filter { TIME_CONSTANT };
+    const auto response = MeasureStep(filter, 1ms);
+    CHECK(IsNear(response.rise63, 1.07, 0.02));
+    CHECK(IsNear(response.rise90, 1.94, 0.02));
+    CHECK(response.maxValue <= 1.0);
+    CHECK(response.maxValue > 0.999);
+    CHECK(response.isMonotonic);
+}
+
+TEST(ExponentialSettlesWithoutOvershoot) {
+    ExponentialFilter<double, ExactAlpha<double>, ManualClock> filter {
+        TIME_CONSTANT
+    };
+    const auto response = MeasureStep(filter, 1ms);
+    CHECK(IsNear(response.rise63, 1.0, 0.01));
+    CHECK(IsNear(response.rise90, std::log(10.0), 0.01));
+    CHECK(response.maxValue <= 1.0);
+    CHECK(response.isMonotonic);
+}
+
+TEST(OneEuroWithoutBetaIsExponential) {
+    OneEuroFilter<double, ManualClock> oneEuro {};
+    oneEuro.SetTimeConstant(TIME_CONSTANT);
+    ExponentialFilter<double, ExactAlpha<double>, ManualClock> exponential {
+        TIME_CONSTANT
+    };
+    oneEuro.SetInitialValue(10.0, Time {});
+    exponential.SetInitialValue(10.0, Time {});
+    for (int i = 1; i <= 500; ++i) {
+        const Time time { std::chrono::milliseconds(i * 7) };
+        const double input = i % 50 < 25 ? 90.0 : 30.0;
+        const double expected = exponential.Update(input, time);
+        if (std::abs(oneEuro.Update(input, time) - expected) > 1e-9) {
+            CHECK(false && "One Euro output differs from exponential");
+            return;
+        }
+    }
+}
+
+TEST(OneEuroBetaSpeedsUpLargeSteps) {
+    OneEuroFilter<double, ManualClock> slow {};
+    slow.SetTimeConstant(TIME_CONSTANT);
+    OneEuroFilter<double, ManualClock> fast {};
+    fast.SetTimeConstant(TIME_CONSTANT);
+    fast.SetBeta(5.0);
+    fast.SetDerivativeCutoff(5.0);
+
+    const auto slowResponse = MeasureStep(slow, 1ms);
+    const auto fastResponse = MeasureStep(fast, 1ms);
+    REQUIRE(slowResponse.rise90 && fastResponse.rise90);
+    CHECK(*fastResponse.rise90 < 0.8 * *slowResponse.rise90);
+    CHECK(fastResponse.maxValue <= 1.0);
+    CHECK(fastResponse.isMonotonic);
+}
+
+// The spring and exponential filters are exact for an input held over each
+// frame, so 1 ms and 50 ms frames agree where their times coincide
+TEST(ResponseDoesNotDependOnFrameRate) {
+    SpringFilter<double, ManualClock> fine { TIME_CONSTANT };
+    SpringFilter<double, ManualClock> coarse { TIME_CONSTANT };
+    ExponentialFilter<double, ExactAlpha<double>, ManualClock> fineExponential {
+        TIME_CONSTANT
+    };
+    ExponentialFilter<double, ExactAlpha<double>, ManualClock>
+        coarseExponential { TIME_CONSTANT };
+    fine.SetInitialValue(0.0, Time {});
+    coarse.SetInitialValue(0.0, Time {});
+    fineExponential.SetInitialValue(0.0, Time {});
+    coarseExponential.SetInitialValue(0.0, Time {});
+
+    for (int frame = 1; frame <= 1000; ++frame) {
+        const Time time { std::chrono::milliseconds(frame) };
+        const double fineValue = fine.Update(1.0, time);
+        const double fineExponentialValue = fineExponential.Update(1.0, time);
+        if (frame % 50 == 0) {
+            CHECK(std::abs(coarse.Update(1.0, time) - fineValue) < 1e-9);
+            CHECK(std::abs(coarseExponential.Update(1.0, time) -
+                fineExponentialValue) < 1e-9);
+        }
+    }
+}
+
+TEST(ZeroTimeConstantPassesInputThrough) {
+    SpringFilter<double, ManualClock> spring { 0.0 };
+    OneEuroFilter<double, ManualClock> oneEuro {};
+    oneEuro.SetTimeConstant(0.0);
+    CHECK(spring.Update(42.0, Time { 1ms }) == 42.0);
+    CHECK(oneEuro.Update(42.0, Time { 1ms }) == 42.0);
+}
+
+TEST(SwitchingFilterTypeContinuesFromOutput) {
+    ManualClock::Set(Time {});
+    SmoothingFilter<double, ManualClock> filter {
+        FilterType::Exponential, TIME_CONSTANT, 0.0
+    };
+    ManualClock::Advance(50ms);
+    const double before = filter.Update(1.0);
+    for (const auto type : { FilterType::Spring, FilterType::OneEuro,
+        FilterType::Exponential }) {
+        filter.SetType(type);
+        CHECK(filter.Type() == type);
+        // The polynomial alpha of the exponential filter is not exactly one
+        // when no time has elapsed
+        CHECK(std::abs(filter.Update(1.0) - before) < 1e-6);
+    }
+    ManualClock::Advance(50ms);
+    CHECK(filter.Update(1.0) > before);
+}
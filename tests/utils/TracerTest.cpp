@@ -0,0 +1,285 @@
+#include "Test.hpp"
+#include "utils/Tracer.hpp"
+#include "utils/json/JsonReader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Traces are read back with the in-tree JSON reader, as Perfetto would read
+// them
+
+namespace {
+struct TraceEvent {
+    std::string name;
+    std::string phase;
+    std::optional<uint64_t> threadId;
+    std::optional<double> start;
+    std::optional<double> duration;
+    std::string scope;
+    // Of thread name metadata
+    std::string threadName;
+};
+
+bool ReadArgs(JsonReader& reader, TraceEvent& event) {
+    auto token = reader.Next();
+    for (; token == JsonToken::Key; token = reader.Next()) {
+        const std::string key { reader.Value() };
+        token = reader.Next();
+        if (key == "name" && token == JsonToken::String) {
+            event.threadName = reader.Value();
+        } else {
+            reader.SkipValue(token);
+        }
+    }
+    return token == JsonToken::EndObject;
+}
+
+bool ReadEvent(JsonReader& reader, TraceEvent& event) {
+    for (auto token = reader.Next(); token != JsonToken::EndObject;
+         token = reader.Next()) {
+        if (token != JsonToken::Key) {
+            return false;
+        }
+        const std::string key { reader.Value() };
+        token = reader.Next();
+        if (key == "args" && token == JsonToken::BeginObject) {
+            if (!ReadArgs(reader, event)) {
+                return false;
+            }
+        } else if (token == JsonToken::String) {
+            if (key == "name") {
+                event.name = reader.Value();
+            } else if (key == "ph") {
+                event.phase = reader.Value();
+            } else if (key == "s") {
+                event.scope = reader.Value();
+            }
+        } else if (token == JsonToken::Number) {
+            const double number = std::stod(std::string { reader.Value() });
+            if (key == "tid") {
+                event.threadId = static_cast<uint64_t>(number);
+            } else if (key == "ts") {
+                event.start = number;
+            } else if (key == "dur") {
+                event.duration = number;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Events of a trace, or nothing if it is not a valid trace
+std::optional<std::vector<TraceEvent>> ParseTrace(const std::string_view json) {
+    JsonReader reader { json };
+    if (reader.Next() != JsonToken::BeginObject) {
+        return std::nullopt;
+    }
+    std::vector<TraceEvent> events {};
+    bool hasEvents = false;
+    for (auto token = reader.Next(); token == JsonToken::Key;
+         token = reader.Next()) {
+        if (reader.Value() != "traceEvents") {
+            reader.SkipValue(reader.Next());
+            continue;
+        }
+        if (reader.Next() != JsonToken::BeginArray) {
+            return std::nullopt;
+        }
+        hasEvents = true;
+        for (auto item = reader.Next(); item != JsonToken::EndArray;
+             item = reader.Next()) {
+            TraceEvent event {};
+            if (item != JsonToken::BeginObject || !ReadEvent(reader, event)) {
+                return std::nullopt;
+            }
+            events.push_back(std::move(event));
+        }
+    }
+    if (!hasEvents || reader.Next() != JsonToken::End) {
+        return std::nullopt;
+    }
+    return events;
+}
+
+bool IsSpan(const TraceEvent& event) {
+    return event.phase == "X";
+}
+
+bool IsInstant(const TraceEvent& event) {
+    return event.phase == "i";
+}
+
+// Complete events carry their begin as the start and their end as the
+// start plus the duration
+bool HasBeginAndEnd(const TraceEvent& event) {
+    return event.threadId && event.start && event.duration &&
+        *event.start >= 0.0 && *event.duration >= 0.0;
+}
+} // namespace
+
+TEST(WritesSpansAndInstants) {
+    const auto tracer = std::make_unique<Tracer>();
+    const auto start = Tracer::Clock::now();
+    tracer->SetThreadName("main");
+    tracer->Span("span", start, start + std::chrono::microseconds(5));
+    tracer->Instant("instant");
+
+    const auto events = ParseTrace(tracer->ToJson());
+    REQUIRE(events && events->size() == 3);
+    const auto& metadata = (*events)[0];
+    CHECK(metadata.phase == "M");
+    CHECK(metadata.name == "thread_name");
+    CHECK(metadata.threadName == "main");
+
+    const auto& span = (*events)[1];
+    CHECK(span.name == "span");
+    CHECK(IsSpan(span));
+    CHECK(HasBeginAndEnd(span));
+    CHECK(span.duration == 5.0);
+    CHECK(span.threadId == metadata.threadId);
+
+    const auto& instant = (*events)[2];
+    CHECK(instant.name == "instant");
+    CHECK(IsInstant(instant));
+    CHECK(instant.scope == "t");
+    CHECK(instant.start >= span.start);
+}
+
+TEST(WritesEmptyTrace) {
+    const auto tracer = std::make_unique<Tracer>();
+    const auto events = ParseTrace(tracer->ToJson());
+    REQUIRE(events);
+    CHECK(events->empty());
+}
+
+// Threads record into their own buffers while another serializes, and every
+// event ends up under the thread that recorded it
+TEST(RecordsFromSeveralThreads) {
+    constexpr size_t SPANS = 5000;
+    constexpr size_t INSTANT_PERIOD = 10;
+    constexpr std::array NAMES { "first", "second", "third", "fourth" };
+    const auto tracer = std::make_unique<Tracer>();
+
+    std::atomic<size_t> doneCount { 0 };
+    std::atomic<int> invalidTraces { 0 };
+    std::atomic<int> serializations { 0 };
+    {
+        std::vector<std::jthread> threads {};
+        threads.emplace_back([&] {
+            while (doneCount.load() < NAMES.size()) {
+                invalidTraces += !ParseTrace(tracer->ToJson());
+                ++serializations;
+            }
+        });
+        for (const auto name : NAMES) {
+            threads.emplace_back([&, name] {
+                tracer->SetThreadName(name);
+                for (size_t i = 0; i < SPANS; ++i) {
+                    const auto start = Tracer::Clock::now();
+                    if (i % INSTANT_PERIOD == 0) {
+                        tracer->Instant("tick");
+                    }
+                    tracer->Span("work", start, Tracer::Clock::now());
+                }
+                ++doneCount;
+            });
+        }
+    }
+    CHECK(invalidTraces.load() == 0);
+    CHECK(serializations.load() > 0);
+
+    const auto events = ParseTrace(tracer->ToJson());
+    REQUIRE(events);
+    std::map<uint64_t, std::string> threadNames {};
+    std::map<uint64_t, size_t> spans {};
+    std::map<uint64_t, size_t> instants {};
+    for (const auto& event : *events) {
+        REQUIRE(event.threadId);
+        if (event.phase == "M") {
+            threadNames[*event.threadId] = event.threadName;
+        } else if (IsSpan(event)) {
+            CHECK(event.name == "work");
+            CHECK(HasBeginAndEnd(event));
+            ++spans[*event.threadId];
+        } else if (IsInstant(event)) {
+            CHECK(event.name == "tick");
+            CHECK(event.start.has_value());
+            ++instants[*event.threadId];
+        } else {
+            CHECK(!"unknown phase");
+        }
+    }
+
+    REQUIRE(threadNames.size() == NAMES.size());
+    std::set<std::string> names {};
+    for (const auto& [threadId, name] : threadNames) {
+        names.insert(name);
+        CHECK(spans[threadId] == SPANS);
+        CHECK(instants[threadId] == SPANS / INSTANT_PERIOD);
+    }
+    CHECK(names == std::set<std::string> { NAMES.begin(), NAMES.end() });
+    CHECK(spans.size() == NAMES.size());
+}
+
+// A thread's buffer keeps its last events, dropping the oldest
+TEST(KeepsLastEventsOnOverflow) {
+    constexpr size_t EXTRA = 100;
+    const auto tracer = std::make_unique<Tracer>();
+    const auto start = Tracer::Clock::now();
+    for (size_t i = 0; i < Tracer::CAPACITY + EXTRA; ++i) {
+        tracer->Span("span", start, start + std::chrono::nanoseconds(i));
+    }
+
+    const auto events = ParseTrace(tracer->ToJson());
+    REQUIRE(events);
+    CHECK(events->size() == Tracer::CAPACITY);
+    double shortest = 1e9;
+    double longest = 0.0;
+    for (const auto& event : *events) {
+        REQUIRE(HasBeginAndEnd(event));
+        shortest = std::min(shortest, *event.duration);
+        longest = std::max(longest, *event.duration);
+    }
+    // Durations are written in microseconds
+    CHECK(std::lround(shortest * 1000.0) == EXTRA);
+    CHECK(std::lround(longest * 1000.0) == Tracer::CAPACITY + EXTRA - 1);
+}
+
+TEST(RecordsScopesOnGlobalTracer) {
+    {
+        const TraceScope scope { "scope" };
+    }
+    const auto events = ParseTrace(Tracer::GetInstance().ToJson());
+    REQUIRE(events);
+    const auto it = std::ranges::find(*events, "scope", &TraceEvent::name);
+    REQUIRE(it != events->end());
+    CHECK(IsSpan(*it));
+    CHECK(HasBeginAndEnd(*it));
+}
+
+// A tracer created where an earlier one was does not inherit its buffers
+TEST(KeepsTracersApart) {
+    auto first = std::make_unique<Tracer>();
+    first->Instant("first");
+    first.reset();
+    const auto second = std::make_unique<Tracer>();
+    second->Instant("second");
+    const auto events = ParseTrace(second->ToJson());
+    REQUIRE(events && events->size() == 1);
+    CHECK(events->front().name == "second");
+}
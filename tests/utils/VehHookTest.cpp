@@ -0,0 +1,136 @@
+#include "Test.hpp"
+#include "utils/VehHook.hpp"
+#include "utils/hook/TestCode.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::optional<VehHook<int, int>> hook {};
+
+int Detour(const int x) {
+    return hook->CallOriginal(x) * 100;
+}
+
+int Negate(const int x) {
+    return -x;
+}
+
+// Permissions such as "r-xp" of the mapping containing the address
+std::string QueryPermissions(const void* address) {
+    const auto value = reinterpret_cast<uintptr_t>(address);
+    std::ifstream maps { "/proc/self/maps" };
+    std::string line {};
+    while (std::getline(maps, line)) {
+        const auto begin = std::stoull(line.substr(0, line.find('-')), nullptr, 16);
+        const auto end = std::stoull(line.substr(line.find('-') + 1), nullptr, 16);
+        if (value >= begin && value < end) {
+            return line.substr(line.find(' ') + 1, 4);
+        }
+    }
+    return {};
+}
+} // namespace
+
+TEST(RedirectsGuardedTarget) {
+    const test::TestCode code {};
+    const auto target = code.Get(test::TestCode::PROLOGUE);
+    hook.emplace(code.At(test::TestCode::PROLOGUE),
+        reinterpret_cast<void*>(Detour));
+    CHECK(QueryPermissions(code.At(0)) == "r--p");
+    CHECK(target(5) == 600);
+    CHECK(target(1) == 200);
+    CHECK(QueryPermissions(code.At(0)) == "r--p");
+
+    // Data on a guarded page stays readable
+    CHECK(*code.At(test::TestCode::PROLOGUE) == 0x55);
+
+    hook.reset();
+    CHECK(QueryPermissions(code.At(0)) == "r-xp");
+    CHECK(target(5) == 6);
+}
+
+TEST(SingleStepsOtherCodeOnGuardedPage) {
+    const test::TestCode code {};
+    VehHook<int, int> negate {
+        code.At(test::TestCode::PROLOGUE), reinterpret_cast<void*>(Negate)
+    };
+    for (int i = 0; i < 100; ++i) {
+        CHECK(code.Get(test::TestCode::CONDITIONAL)(i) == (i ? i + 2 : 0));
+        CHECK(code.Get(test::TestCode::CALL)(i) == -i + 10);
+        CHECK(code.Get(test::TestCode::PROLOGUE)(i) == -i);
+    }
+    CHECK(QueryPermissions(code.At(0)) == "r--p");
+}
+
+TEST(KeepsPageGuardedWhileHooksRemain) {
+    const test::TestCode code {};
+    {
+        VehHook<int, int> first {
+            code.At(test::TestCode::PROLOGUE), reinterpret_cast<void*>(Negate)
+        };
+        {
+            VehHook<int, int> second {
+                code.At(test::TestCode::RIP_RELATIVE),
+                reinterpret_cast<void*>(Negate)
+            };
+            CHECK(code.Get(test::TestCode::RIP_RELATIVE)(3) == -3);
+            CHECK(code.Get(test::TestCode::PROLOGUE)(3) == -3);
+        }
+        CHECK(QueryPermissions(code.At(0)) == "r--p");
+        CHECK(code.Get(test::TestCode::RIP_RELATIVE)(3) == 44);
+        CHECK(code.Get(test::TestCode::PROLOGUE)(3) == -3);
+    }
+    CHECK(QueryPermissions(code.At(0)) == "r-xp");
+    CHECK(code.Get(test::TestCode::PROLOGUE)(3) == 4);
+}
+
+TEST(RejectsDuplicateTargets) {
+    const test::TestCode code {};
+    VehHook<int, int> first {
+        code.At(test::TestCode::PROLOGUE), reinterpret_cast<void*>(Negate)
+    };
+    VehHook<int, int> second {};
+    CHECK_THROWS(second.Create(
+        code.At(test::TestCode::PROLOGUE), reinterpret_cast<void*>(Negate)));
+    CHECK(!second.IsCreated());
+    CHECK(code.Get(test::TestCode::PROLOGUE)(3) == -3);
+}
+
+// Each thread single-steps its own faults and re-arms its own page
+TEST(StepsConcurrentFaultsPerThread) {
+    const test::TestCode code {};
+    const test::TestCode otherCode {};
+    VehHook<int, int> first {
+        code.At(test::TestCode::PROLOGUE), reinterpret_cast<void*>(Negate)
+    };
+    VehHook<int, int> second {
+        otherCode.At(test::TestCode::PROLOGUE), reinterpret_cast<void*>(Negate)
+    };
+
+    std::atomic<int> errors { 0 };
+    std::vector<std::thread> threads {};
+    for (int t = 0; t < 4; ++t) {
+        const auto& pageCode = t % 2 ? code : otherCode;
+        threads.emplace_back([&pageCode, &errors] {
+            for (int i = 0; i < 5000; ++i) {
+                if (pageCode.Get(test::TestCode::CONDITIONAL)(i) !=
+                    (i ? i + 2 : 0) ||
+                    pageCode.Get(test::TestCode::RIP_RELATIVE)(i) != i + 41) {
+                    ++errors;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    CHECK(errors == 0);
+    CHECK(code.Get(test::TestCode::PROLOGUE)(3) == -3);
+    CHECK(otherCode.Get(test::TestCode::PROLOGUE)(3) == -3);
+}
@@ -0,0 +1,198 @@
+#include "Test.hpp"
+#include "utils/ManualClock.hpp"
+#include "utils/WriteEchoFilter.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A config of one value kept the way ConfigManager keeps its config, over a
+// fake file whose writer and watcher follow the manual clock with the
+// plugin's delays
+
+namespace {
+using namespace std::chrono_literals;
+using Time = ManualClock::time_point;
+
+constexpr auto WRITE_DELAY = 500ms;
+constexpr auto RELOAD_DELAY = 200ms;
+constexpr auto TICK = 10ms;
+
+// Holds contents until none is given for the write delay, as
+// AsyncFileWriter does, and reloads once the file has been quiet for the
+// reload delay, as FileWatcher does
+struct FakeFile {
+    std::string contents {};
+    std::optional<std::string> pending {};
+    Time writeDeadline {};
+    std::optional<Time> reloadDeadline {};
+
+    void Write(std::string value) {
+        pending = std::move(value);
+        writeDeadline = ManualClock::now() + WRITE_DELAY;
+    }
+
+    // Written by someone else, right away
+    void Edit(std::string value) {
+        contents = std::move(value);
+        reloadDeadline = ManualClock::now() + RELOAD_DELAY;
+    }
+
+    // Contents reloaded at the current time, if any
+    std::optional<std::string> Poll() {
+        const auto now = ManualClock::now();
+        if (pending && now >= writeDeadline) {
+            Edit(std::move(*pending));
+            pending.reset();
+        }
+        if (reloadDeadline && now >= *reloadDeadline) {
+            reloadDeadline.reset();
+            return contents;
+        }
+        return std::nullopt;
+    }
+};
+
+struct Manager {
+    FakeFile& file;
+    WriteEchoFilter echoFilter {};
+    std::string current {};
+    std::string reported {};
+    // Reported changes, from and to
+    std::vector<std::pair<std::string, std::string>> changes {};
+
+    void Write(std::string value) {
+        echoFilter.OnWrite(value);
+        current = value;
+        reported = value;
+        file.Write(std::move(value));
+    }
+
+    // A reload on the watcher's thread, then a tick of the mediator
+    void Tick() {
+        ManualClock::Advance(TICK);
+        if (const auto contents = file.Poll();
+            contents && !echoFilter.IsEcho(*contents)) {
+            current = *contents;
+        }
+        if (current != reported) {
+            changes.emplace_back(reported, current);
+            reported = current;
+        }
+    }
+
+    void Run(const std::chrono::milliseconds duration) {
+        for (auto time = 0ms; time < duration; time += TICK) {
+            Tick();
+        }
+    }
+};
+} // namespace
+
+// A lands and the user picks B before the watcher reloads A, which must
+// not take the config back to A
+TEST(IgnoresWriteLandingBeforeLaterOne) {
+    ManualClock::Set(Time {});
+    FakeFile file {};
+    Manager manager { file };
+    manager.Write("A");
+    manager.Run(WRITE_DELAY);
+    CHECK(file.contents == "A");
+
+    manager.Run(100ms);
+    manager.Write("B");
+    manager.Run(100ms);
+    CHECK(manager.current == "B");
+    manager.Run(2s);
+    CHECK(file.contents == "B");
+    CHECK(manager.current == "B");
+    CHECK(manager.changes.empty());
+}
+
+// Writes at random intervals around the delays, as a client sending field
+// of view commands would, never take the config back
+TEST(IgnoresEveryOwnWriteInRandomStream) {
+    ManualClock::Set(Time {});
+    FakeFile file {};
+    Manager manager { file };
+    std::mt19937 random { 7 };
+    int reverts = 0;
+    for (int i = 0; i < 2000; ++i) {
+        const auto value = std::to_string(i);
+        manager.Write(value);
+        const auto gap = std::chrono::milliseconds(10 * (random() % 100));
+        for (auto time = 0ms; time < gap; time += TICK) {
+            manager.Tick();
+            reverts += manager.current != value;
+        }
+    }
+    manager.Run(2s);
+    CHECK(reverts == 0);
+    CHECK(manager.changes.empty());
+    CHECK(file.contents == "1999");
+}
+
+TEST(ReportsEditsByOthers) {
+    ManualClock::Set(Time {});
+    FakeFile file {};
+    Manager manager { file };
+    manager.Write("A");
+    manager.Run(1s);
+    file.Edit("X");
+    manager.Run(1s);
+    CHECK(manager.current == "X");
+    CHECK(manager.changes ==
+        std::vector<std::pair<std::string, std::string>> { { "A", "X" } });
+
+    // An edit back to an earlier write is still an edit
+    file.Edit("A");
+    manager.Run(1s);
+    CHECK(manager.current == "A");
+    CHECK(manager.changes.size() == 2);
+}
+
+// A write pending when someone else edits the file lands over the edit, and
+// the config follows the file rather than keeping the edit
+TEST(FollowsWriteLandingOverEdit) {
+    ManualClock::Set(Time {});
+    FakeFile file {};
+    Manager manager { file };
+    manager.Write("A");
+    manager.Run(1s);
+    manager.Write("B");
+    manager.Run(100ms);
+    file.Edit("X");
+    manager.Run(2s);
+    CHECK(file.contents == "B");
+    CHECK(manager.current == "B");
+    CHECK(manager.changes == std::vector<std::pair<std::string, std::string>> {
+        { "B", "X" }, { "X", "B" }
+    });
+}
+
+TEST(ForgetsWritesOlderThanLanded) {
+    WriteEchoFilter filter {};
+    filter.OnWrite("A");
+    filter.OnWrite("B");
+    filter.OnWrite("C");
+    CHECK(filter.IsEcho("B"));
+    // Seen again, such as by a second change notification
+    CHECK(filter.IsEcho("B"));
+    CHECK(filter.IsEcho("C"));
+    CHECK(!filter.IsEcho("B"));
+    // Nothing is left after an edit
+    CHECK(!filter.IsEcho("C"));
+}
+
+TEST(KeepsLatestWrites) {
+    WriteEchoFilter filter {};
+    for (size_t i = 0; i <= WriteEchoFilter::MAX_WRITES; ++i) {
+        filter.OnWrite(std::to_string(i));
+    }
+    CHECK(filter.IsEcho("1"));
+    CHECK(!filter.IsEcho("0"));
+}
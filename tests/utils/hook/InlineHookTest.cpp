@@ -0,0 +1,163 @@
+#include "Test.hpp"
+#include "utils/hook/TestCode.hpp"
+#include "utils/HookEngine.hpp"
+#include "utils/hook/Decoder.hpp"
+#include "utils/hook/InlineHook.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+test::Function original = nullptr;
+
+int Detour(const int x) {
+    return original(x) * 100;
+}
+
+int OtherDetour(const int x) {
+    return -x;
+}
+} // namespace
+
+TEST(DecodesInstructionLengths) {
+    struct Case {
+        std::vector<uint8_t> bytes;
+        uint8_t length;
+    };
+    const Case cases[] {
+        { { 0x55 }, 1 },
+        { { 0x48, 0x89, 0xE5 }, 3 },
+        { { 0x48, 0x83, 0xEC, 0x28 }, 4 },
+        { { 0x48, 0x89, 0x5C, 0x24, 0x08 }, 5 },
+        { { 0x8B, 0x05, 0x00, 0x00, 0x00, 0x00 }, 6 },
+        { { 0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8 }, 10 },
+        { { 0x0F, 0x29, 0x74, 0x24, 0x20 }, 5 },
+        { { 0x66, 0x0F, 0x1F, 0x44, 0x00, 0x00 }, 6 },
+        { { 0xE8, 0, 0, 0, 0 }, 5 },
+        { { 0x74, 0x04 }, 2 },
+        { { 0x0F, 0x84, 0, 0, 0, 0 }, 6 },
+        { { 0xC3 }, 1 }
+    };
+    for (const auto& [bytes, length] : cases) {
+        std::array<uint8_t, 16> code {};
+        std::memcpy(code.data(), bytes.data(), bytes.size());
+        const auto instruction = hook::Decode(code.data());
+        REQUIRE(instruction.has_value());
+        CHECK(instruction->length == length);
+    }
+
+    const std::array<uint8_t, 16> ripRelative {
+        0x48, 0x8B, 0x05, 0x10, 0x00, 0x00, 0x00
+    };
+    const auto load = hook::Decode(ripRelative.data());
+    REQUIRE(load.has_value());
+    CHECK(load->IsRipRelative());
+    CHECK(load->ripDisplacementOffset == 3);
+
+    const std::array<uint8_t, 16> call { 0xE8 };
+    const auto branch = hook::Decode(call.data());
+    REQUIRE(branch.has_value());
+    CHECK(branch->branch == hook::Branch::Call);
+    CHECK(branch->IsRelativeBranch());
+}
+
+TEST(HooksAndRestoresFunctions) {
+    const test::TestCode code {};
+    for (const auto [offset, input, expected] : {
+        std::array<int, 3> { test::TestCode::PROLOGUE, 5, 6 },
+        std::array<int, 3> { test::TestCode::RIP_RELATIVE, 1, 42 },
+        std::array<int, 3> { test::TestCode::CONDITIONAL, 3, 5 },
+        std::array<int, 3> { test::TestCode::CONDITIONAL, 0, 0 },
+        std::array<int, 3> { test::TestCode::CALL, 1, 12 } }) {
+        const auto function = code.Get(offset);
+        std::array<uint8_t, 16> before {};
+        std::memcpy(before.data(), code.At(offset), before.size());
+
+        hook::InlineHook hook { code.At(offset), reinterpret_cast<void*>(Detour) };
+        original = reinterpret_cast<test::Function>(hook.Trampoline());
+        CHECK(function(input) == expected);
+        CHECK(original(input) == expected);
+
+        for (int i = 0; i < 3; ++i) {
+            hook.Enable();
+            CHECK(hook.IsEnabled());
+            CHECK(function(input) == expected * 100);
+            hook.Disable();
+            CHECK(function(input) == expected);
+        }
+        CHECK(std::memcmp(before.data(), code.At(offset), before.size()) == 0);
+    }
+}
+
+TEST(RestoresTargetWhenDestroyedEnabled) {
+    const test::TestCode code {};
+    const auto function = code.Get(test::TestCode::PROLOGUE);
+    {
+        hook::InlineHook hook {
+            code.At(test::TestCode::PROLOGUE),
+            reinterpret_cast<void*>(OtherDetour)
+        };
+        hook.Enable();
+        CHECK(function(5) == -5);
+    }
+    CHECK(function(5) == 6);
+}
+
+TEST(MapsInstructionPointers) {
+    const test::TestCode code {};
+    const hook::InlineHook hook {
+        code.At(test::TestCode::PROLOGUE), reinterpret_cast<void*>(Detour)
+    };
+    const auto target = reinterpret_cast<uintptr_t>(hook.Target());
+    const auto trampoline = reinterpret_cast<uintptr_t>(hook.Trampoline());
+
+    // push rbp and mov rbp, rsp are copied as they are, at the same offsets
+    CHECK(hook.ToTrampoline(target) == trampoline);
+    CHECK(hook.ToTrampoline(target + 1) == trampoline + 1);
+    CHECK(hook.FromTrampoline(trampoline + 4) == target + 4);
+    CHECK(hook.ToTrampoline(target + 2) == target + 2);
+    CHECK(hook.ToTrampoline(target + 7) == target + 7);
+}
+
+TEST(RejectsUnhookableTargets) {
+    const test::TestCode code {};
+    CHECK_THROWS(hook::InlineHook {
+        code.At(test::TestCode::TOO_SHORT), reinterpret_cast<void*>(Detour)
+    });
+    CHECK_THROWS(hook::InlineHook { nullptr, reinterpret_cast<void*>(Detour) });
+    CHECK_THROWS(hook::InlineHook { code.At(test::TestCode::PROLOGUE), nullptr });
+}
+
+TEST(EngineAppliesBatches) {
+    const test::TestCode code {};
+    const auto engine = CreateHookEngine();
+    const auto prologue = code.At(test::TestCode::PROLOGUE);
+    const auto call = code.At(test::TestCode::CALL);
+
+    void* prologueOriginal = nullptr;
+    void* callOriginal = nullptr;
+    engine->Create(prologue, reinterpret_cast<void*>(OtherDetour),
+        &prologueOriginal);
+    engine->Create(call, reinterpret_cast<void*>(OtherDetour), &callOriginal);
+    CHECK_THROWS(engine->Create(prologue,
+        reinterpret_cast<void*>(Detour), &prologueOriginal));
+
+    const HookChange enable[] { { prologue, true }, { call, true } };
+    engine->Apply(enable);
+    CHECK(code.Get(test::TestCode::PROLOGUE)(5) == -5);
+    CHECK(code.Get(test::TestCode::CALL)(5) == -5);
+    // The relocated call still lands on the hooked prologue
+    CHECK(reinterpret_cast<test::Function>(callOriginal)(5) == -5 + 10);
+
+    const HookChange disable[] { { call, false } };
+    engine->Apply(disable);
+    CHECK(code.Get(test::TestCode::CALL)(5) == -5 + 10);
+
+    engine->Remove(prologue);
+    CHECK(code.Get(test::TestCode::PROLOGUE)(5) == 6);
+    CHECK(code.Get(test::TestCode::CALL)(5) == 16);
+    CHECK_THROWS(engine->Remove(prologue));
+}
@@ -0,0 +1,109 @@
+#include "Test.hpp"
+#include "utils/hook/Memory.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+// Permissions such as "r-xp" of the mapping containing the address
+std::string QueryPermissions(const void* address) {
+    const auto value = reinterpret_cast<uintptr_t>(address);
+    std::ifstream maps { "/proc/self/maps" };
+    std::string line {};
+    while (std::getline(maps, line)) {
+        const auto begin = std::stoull(line.substr(0, line.find('-')), nullptr, 16);
+        const auto end = std::stoull(line.substr(line.find('-') + 1), nullptr, 16);
+        if (value >= begin && value < end) {
+            return line.substr(line.find(' ') + 1, 4);
+        }
+    }
+    return {};
+}
+
+class Pages {
+public:
+    explicit Pages(const size_t count)
+        : pageSize { static_cast<size_t>(sysconf(_SC_PAGESIZE)) }
+        , size { count * pageSize }
+        , data { static_cast<uint8_t*>(mmap(nullptr, size,
+            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) } {}
+
+    ~Pages() noexcept {
+        munmap(data, size);
+    }
+
+    [[nodiscard]] uint8_t* Page(const size_t index) const noexcept {
+        return data + index * pageSize;
+    }
+
+    void Protect(const size_t index, const int protection) const noexcept {
+        mprotect(Page(index), pageSize, protection);
+    }
+
+    const size_t pageSize;
+    const size_t size;
+    uint8_t* const data;
+};
+
+constexpr uint8_t BYTES[] { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 };
+} // namespace
+
+TEST(WriteCodeRestoresProtection) {
+    const Pages pages { 3 };
+    pages.Protect(0, PROT_READ | PROT_EXEC);
+    pages.Protect(1, PROT_READ);
+    pages.Protect(2, PROT_NONE);
+
+    hook::WriteCode(pages.Page(0) + 16, BYTES, sizeof(BYTES));
+    hook::WriteCode(pages.Page(1) + 16, BYTES, sizeof(BYTES));
+    hook::WriteCode(pages.Page(2) + 16, BYTES, sizeof(BYTES));
+    CHECK(QueryPermissions(pages.Page(0)) == "r-xp");
+    CHECK(QueryPermissions(pages.Page(1)) == "r--p");
+    CHECK(QueryPermissions(pages.Page(2)) == "---p");
+
+    pages.Protect(2, PROT_READ);
+    for (size_t i = 0; i < 3; ++i) {
+        CHECK(std::memcmp(pages.Page(i) + 16, BYTES, sizeof(BYTES)) == 0);
+    }
+}
+
+TEST(WriteCodeRestoresEachPageAcrossBoundary) {
+    const Pages pages { 2 };
+    pages.Protect(0, PROT_READ | PROT_EXEC);
+    pages.Protect(1, PROT_NONE);
+
+    const auto address = pages.Page(1) - 6;
+    hook::WriteCode(address, BYTES, sizeof(BYTES));
+    CHECK(QueryPermissions(pages.Page(0)) == "r-xp");
+    CHECK(QueryPermissions(pages.Page(1)) == "---p");
+
+    pages.Protect(1, PROT_READ);
+    CHECK(std::memcmp(address, BYTES, sizeof(BYTES)) == 0);
+}
+
+TEST(AllocatesSlotsNearOrigin) {
+    const Pages pages { 1 };
+    uint8_t* slots[64] {};
+    for (auto& slot : slots) {
+        slot = hook::AllocateSlot(pages.data);
+        REQUIRE(slot != nullptr);
+        CHECK(hook::IsNear(pages.data, slot));
+        CHECK(hook::IsNear(slot, pages.data));
+    }
+    for (size_t i = 1; i < std::size(slots); ++i) {
+        CHECK(slots[i] != slots[i - 1]);
+    }
+    for (const auto slot : slots) {
+        hook::FreeSlot(slot);
+    }
+}
+
+TEST(ThreadFreezerIsScoped) {
+    // Suspending is a no-op here, but the freezer must still be usable
+    hook::ThreadFreezer freezer {};
+    freezer.RedirectInstructionPointers([](const uintptr_t ip) { return ip; });
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Hand-assembled functions on a page of their own, so that hooks patch
+// known instructions rather than whatever the compiler emitted. Each takes
+// an int and returns an int.
+namespace test {
+using Function = int (*)(int);
+
+class TestCode {
+public:
+    // push rbp; mov rbp, rsp; lea eax, [rdi + 1]; pop rbp; ret
+    static constexpr size_t PROLOGUE = 0x00;
+    // mov eax, [rip + constant]; add eax, edi; ret, with the constant 41
+    static constexpr size_t RIP_RELATIVE = 0x40;
+    // test edi, edi; je zero; lea eax, [rdi + 2]; ret; zero: xor eax, eax; ret
+    static constexpr size_t CONDITIONAL = 0xC0;
+    // call PROLOGUE; add eax, 10; ret
+    static constexpr size_t CALL = 0x100;
+    // ret
+    static constexpr size_t TOO_SHORT = 0x140;
+
+    TestCode() {
+        const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const auto page = mmap(nullptr, pageSize, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (page == MAP_FAILED) {
+            throw std::runtime_error { "Failed to map code page" };
+        }
+        code = static_cast<uint8_t*>(page);
+        size = pageSize;
+        std::memset(code, 0xCC, size);
+
+        Emit(PROLOGUE, { 0x55, 0x48, 0x89, 0xE5, 0x8D, 0x47, 0x01, 0x5D,
+            0xC3 });
+        Emit(RIP_RELATIVE, { 0x8B, 0x05, 0x3A, 0x00, 0x00, 0x00, 0x01, 0xF8,
+            0xC3 });
+        Emit(0x80, { 41, 0, 0, 0 });
+        Emit(CONDITIONAL, { 0x85, 0xFF, 0x74, 0x04, 0x8D, 0x47, 0x02, 0xC3,
+            0x31, 0xC0, 0xC3 });
+        const auto relative = static_cast<int32_t>(PROLOGUE - (CALL + 5));
+        Emit(CALL, { 0xE8, 0, 0, 0, 0, 0x83, 0xC0, 0x0A, 0xC3 });
+        std::memcpy(code + CALL + 1, &relative, sizeof(relative));
+        Emit(TOO_SHORT, { 0xC3 });
+
+        mprotect(code, size, PROT_READ | PROT_EXEC);
+    }
+
+    ~TestCode() noexcept {
+        munmap(code, size);
+    }
+
+    TestCode(const TestCode&) = delete;
+    TestCode& operator=(const TestCode&) = delete;
+
+    [[nodiscard]] uint8_t* At(const size_t offset) const noexcept {
+        return code + offset;
+    }
+
+    [[nodiscard]] Function Get(const size_t offset) const noexcept {
+        return reinterpret_cast<Function>(code + offset);
+    }
+
+private:
+    void Emit(const size_t offset, const std::initializer_list<uint8_t> bytes) {
+        std::memcpy(code + offset, bytes.begin(), bytes.size());
+    }
+
+    uint8_t* code;
+    size_t size;
+};
+} // namespace test
@@ -0,0 +1,178 @@
+#include "Test.hpp"
+#include "utils/json/JsonReader.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+// Every token up to and including End or Error
+std::vector<JsonToken> Tokenize(const std::string_view text) {
+    JsonReader reader { text };
+    std::vector<JsonToken> tokens {};
+    while (true) {
+        const auto token = reader.Next();
+        tokens.push_back(token);
+        if (token == JsonToken::End || token == JsonToken::Error) {
+            return tokens;
+        }
+    }
+}
+
+bool IsValid(const std::string_view text) {
+    return Tokenize(text).back() == JsonToken::End;
+}
+
+// Value of the only scalar in the text
+std::string ReadScalar(const std::string_view text) {
+    JsonReader reader { text };
+    const auto token = reader.Next();
+    if (token == JsonToken::Error) {
+        return "error";
+    }
+    return std::string { reader.Value() };
+}
+
+std::string ErrorOf(const std::string_view text) {
+    JsonReader reader { text };
+    while (true) {
+        const auto token = reader.Next();
+        if (token == JsonToken::End) {
+            return {};
+        }
+        if (token == JsonToken::Error) {
+            return reader.Error();
+        }
+    }
+}
+} // namespace
+
+TEST(TokenizesNestedDocument) {
+    using enum JsonToken;
+    const std::vector expected {
+        BeginObject,
+        Key, Number,
+        Key, BeginArray, Number, String, True, False, Null, EndArray,
+        Key, BeginObject, EndObject,
+        Key, BeginArray, EndArray,
+        EndObject,
+        End
+    };
+    CHECK(Tokenize(R"( { "a": -1.5e3, "b": [1, "x", true, false, null],
+        "c": {}, "d": [] } )") == expected);
+}
+
+TEST(AcceptsScalarsAtTopLevel) {
+    CHECK(Tokenize("42") == std::vector { JsonToken::Number, JsonToken::End });
+    CHECK(Tokenize("\"x\"") == std::vector { JsonToken::String, JsonToken::End });
+    CHECK(Tokenize("null") == std::vector { JsonToken::Null, JsonToken::End });
+}
+
+TEST(KeepsNumberText) {
+    CHECK(ReadScalar("0") == "0");
+    CHECK(ReadScalar("-0") == "-0");
+    CHECK(ReadScalar("90") == "90");
+    CHECK(ReadScalar("-12.25") == "-12.25");
+    CHECK(ReadScalar("1e-3") == "1e-3");
+    CHECK(ReadScalar("6.02E+23") == "6.02E+23");
+}
+
+TEST(RejectsMalformedNumbers) {
+    CHECK(!IsValid("01"));
+    CHECK(!IsValid("+1"));
+    CHECK(!IsValid("1."));
+    CHECK(!IsValid(".5"));
+    CHECK(!IsValid("1e"));
+    CHECK(!IsValid("1e+"));
+    CHECK(!IsValid("-"));
+    CHECK(!IsValid("0x10"));
+}
+
+TEST(UnescapesStrings) {
+    CHECK(ReadScalar(R"("plain")") == "plain");
+    CHECK(ReadScalar(R"("")") == "");
+    CHECK(ReadScalar(R"("a\"b\\c\/d")") == "a\"b\\c/d");
+    CHECK(ReadScalar(R"("\b\f\n\r\t")") == "\b\f\n\r\t");
+    CHECK(ReadScalar(R"("\u0041\u00e9\u20AC")") == "A\xC3\xA9\xE2\x82\xAC");
+    // U+1F600 as a surrogate pair
+    CHECK(ReadScalar(R"("\ud83d\ude00")") == "\xF0\x9F\x98\x80");
+}
+
+TEST(RejectsMalformedStrings) {
+    CHECK(ReadScalar(R"("unterminated)") == "error");
+    CHECK(ReadScalar(R"("\x")") == "error");
+    CHECK(ReadScalar(R"("\u12")") == "error");
+    CHECK(ReadScalar(R"("\u12g4")") == "error");
+    CHECK(ReadScalar(R"("\ud83d")") == "error");
+    CHECK(ReadScalar(R"("\ud83dA")") == "error");
+    CHECK(ReadScalar(R"("\ude00")") == "error");
+    CHECK(ReadScalar("\"tab\there\"") == "error");
+}
+
+TEST(RejectsMalformedStructure) {
+    CHECK(!IsValid(""));
+    CHECK(!IsValid("   "));
+    CHECK(!IsValid("{"));
+    CHECK(!IsValid("{\"a\": 1,}"));
+    CHECK(!IsValid("[1, 2,]"));
+    CHECK(!IsValid("[1 2]"));
+    CHECK(!IsValid("{\"a\" 1}"));
+    CHECK(!IsValid("{a: 1}"));
+    CHECK(!IsValid("{\"a\": 1]"));
+    CHECK(!IsValid("[1}"));
+    CHECK(!IsValid("{} {}"));
+    CHECK(!IsValid("tru"));
+    CHECK(!IsValid("nul"));
+    CHECK(!IsValid("True"));
+}
+
+TEST(LimitsNestingDepth) {
+    const auto nested = [](const size_t depth) {
+        return std::string(depth, '[') + std::string(depth, ']');
+    };
+    CHECK(IsValid(nested(64)));
+    CHECK(!IsValid(nested(65)));
+    CHECK(ErrorOf(nested(65)).starts_with("Maximum nesting depth exceeded"));
+}
+
+TEST(ReportsFirstErrorPosition) {
+    CHECK(ErrorOf("{\"a\": 1}").empty());
+    CHECK(ErrorOf("{\n  \"fov\": tru\n}") ==
+        "Expected a value at line 2, column 10");
+    CHECK(ErrorOf("{\"fov\": 90,}") == "Expected a key at line 1, column 12");
+    CHECK(ErrorOf("{\"fov\": 90} x") ==
+        "Unexpected character after the value at line 1, column 13");
+    CHECK(ErrorOf("[1, 2") == "Unexpected end of input at line 1, column 6");
+}
+
+TEST(StaysFailedAfterError) {
+    JsonReader reader { "[1, x, 2]" };
+    CHECK(reader.Next() == JsonToken::BeginArray);
+    CHECK(reader.Next() == JsonToken::Number);
+    CHECK(reader.Next() == JsonToken::Error);
+    CHECK(reader.Next() == JsonToken::Error);
+    CHECK(reader.HasError());
+}
+
+TEST(SkipsWholeValues) {
+    JsonReader reader { R"({"skip": {"a": [1, {"b": null}], "c": "d"}, "next": 7})" };
+    CHECK(reader.Next() == JsonToken::BeginObject);
+    CHECK(reader.Next() == JsonToken::Key);
+    CHECK(reader.SkipValue(reader.Next()) == JsonToken::EndObject);
+    CHECK(reader.Next() == JsonToken::Key);
+    CHECK(reader.Value() == "next");
+    CHECK(reader.Next() == JsonToken::Number);
+    CHECK(reader.Value() == "7");
+    // Scalars are already whole
+    CHECK(reader.SkipValue(JsonToken::Number) == JsonToken::Number);
+    CHECK(reader.Next() == JsonToken::EndObject);
+    CHECK(reader.Next() == JsonToken::End);
+}
+
+TEST(SkipStopsAtError) {
+    JsonReader reader { R"({"skip": [1, {"a": }], "next": 7})" };
+    CHECK(reader.Next() == JsonToken::BeginObject);
+    CHECK(reader.Next() == JsonToken::Key);
+    CHECK(reader.SkipValue(reader.Next()) == JsonToken::Error);
+    CHECK(reader.HasError());
+}
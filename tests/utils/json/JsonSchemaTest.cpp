@@ -0,0 +1,223 @@
+#include "Test.hpp"
+#include "utils/json/JsonSchema.hpp"
+#include "utils/json/JsonWriter.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+enum class Mode {
+    Fast,
+    Smooth
+};
+
+struct Settings {
+    bool enabled = true;
+    int fov = 90;
+    std::vector<int> presets = { 70, 90 };
+    float smoothing = 0.1f;
+    Mode mode = Mode::Fast;
+    uint8_t key = 0x70;
+};
+} // namespace
+
+template <>
+struct JsonEnum<Mode> {
+    static constexpr std::array NAMES {
+        std::pair { Mode::Fast, std::string_view { "fast" } },
+        std::pair { Mode::Smooth, std::string_view { "smooth" } }
+    };
+};
+
+namespace {
+constexpr auto SCHEMA = MakeJsonSchema<Settings>(
+    MakeJsonField("enabled", &Settings::enabled),
+    JSON_FIELD_IF("fov", Settings, fov, fov > 0 && fov < 180),
+    MakeJsonField("presets", &Settings::presets),
+    JSON_FIELD_IF("smoothing", Settings, smoothing,
+        smoothing >= 0.0f && smoothing <= 1.0f),
+    MakeJsonField("mode", &Settings::mode),
+    MakeJsonField("key", &Settings::key)
+);
+
+constexpr std::string_view COMPLETE = R"({
+    "enabled": false,
+    "fov": 120,
+    "presets": [60, 75],
+    "smoothing": 0.25,
+    "mode": "smooth",
+    "key": 255
+})";
+
+bool Contains(const std::vector<std::string>& errors, const std::string_view error) {
+    for (const auto& e : errors) {
+        if (e == error) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace
+
+TEST(ReadsEveryField) {
+    Settings settings {};
+    const auto result = SCHEMA.Read(COMPLETE, settings);
+    CHECK(!result.syntaxError);
+    CHECK(result.errors.empty());
+    CHECK(!settings.enabled);
+    CHECK(settings.fov == 120);
+    CHECK(settings.presets == std::vector { 60, 75 });
+    CHECK(settings.smoothing == 0.25f);
+    CHECK(settings.mode == Mode::Smooth);
+    CHECK(settings.key == 255);
+}
+
+TEST(ReportsMissingKeys) {
+    Settings settings {};
+    const auto result = SCHEMA.Read(R"({"fov": 100})", settings);
+    CHECK(!result.syntaxError);
+    CHECK(result.errors.size() == 5);
+    CHECK(Contains(result.errors, "Missing key 'enabled'"));
+    CHECK(Contains(result.errors, "Missing key 'key'"));
+    CHECK(settings.fov == 100);
+    CHECK(settings.enabled);
+}
+
+TEST(KeepsMembersOfInvalidValues) {
+    Settings settings {};
+    const auto result = SCHEMA.Read(R"({
+        "enabled": 1,
+        "fov": 200,
+        "presets": [10, "x", 20],
+        "smoothing": "a",
+        "mode": "spring",
+        "key": 256
+    })", settings);
+    CHECK(!result.syntaxError);
+    CHECK(result.errors.size() == 6);
+    CHECK(Contains(result.errors,
+        "Failed to parse key 'enabled': expected a boolean"));
+    CHECK(Contains(result.errors,
+        "Invalid value for key 'fov': fov > 0 && fov < 180 is not satisfied"));
+    CHECK(Contains(result.errors,
+        "Failed to parse key 'mode': expected one of 'fast', 'smooth'"));
+    CHECK(Contains(result.errors,
+        "Failed to parse key 'key': expected an integer from 0 to 255"));
+
+    const Settings defaults {};
+    CHECK(settings.enabled == defaults.enabled);
+    CHECK(settings.fov == defaults.fov);
+    CHECK(settings.presets == defaults.presets);
+    CHECK(settings.smoothing == defaults.smoothing);
+    CHECK(settings.mode == defaults.mode);
+    CHECK(settings.key == defaults.key);
+}
+
+TEST(RejectsFractionsForIntegers) {
+    Settings settings {};
+    const auto result = SCHEMA.Read(
+        R"({"enabled": true, "fov": 90.5, "presets": [], "smoothing": 1e-1,
+            "mode": "fast", "key": 1})", settings);
+    CHECK(result.errors.size() == 1);
+    CHECK(settings.fov == 90);
+    CHECK(settings.presets.empty());
+    CHECK(settings.smoothing == 0.1f);
+}
+
+TEST(IgnoresUnknownKeys) {
+    Settings settings {};
+    std::string text { COMPLETE };
+    text.insert(1, R"("extra": {"a": [1, {"b": null}]}, "other": "x",)");
+    const auto result = SCHEMA.Read(text, settings);
+    CHECK(!result.syntaxError);
+    CHECK(result.errors.empty());
+    CHECK(settings.fov == 120);
+}
+
+TEST(LastDuplicateKeyWins) {
+    Settings settings {};
+    std::string text { COMPLETE };
+    text.insert(1, R"("fov": 60,)");
+    static_cast<void>(SCHEMA.Read(text, settings));
+    CHECK(settings.fov == 120);
+}
+
+TEST(ReportsSyntaxErrors) {
+    Settings settings {};
+    CHECK(SCHEMA.Read("[1]", settings).syntaxError == "Expected an object");
+    CHECK(SCHEMA.Read("", settings).syntaxError ==
+        "Unexpected end of input at line 1, column 1");
+    CHECK(SCHEMA.Read(R"({"fov": 90,})", settings).syntaxError ==
+        "Expected a key at line 1, column 12");
+    CHECK(SCHEMA.Read(R"({"fov": 90} x)", settings).syntaxError ==
+        "Unexpected character after the value at line 1, column 13");
+    CHECK(SCHEMA.Read(R"({"presets": [1, }]})", settings).syntaxError);
+    // Syntax errors inside a field are not also reported as type errors
+    const auto result = SCHEMA.Read(R"({"fov": tru})", settings);
+    CHECK(result.syntaxError);
+    CHECK(result.errors.empty());
+}
+
+TEST(RoundTripsWrittenText) {
+    Settings written {};
+    written.enabled = false;
+    written.fov = 105;
+    written.presets = { 1, 179 };
+    written.smoothing = 0.3f;
+    written.mode = Mode::Smooth;
+    written.key = 7;
+
+    for (const int indent : { -1, 0, 2, 4 }) {
+        Settings read {};
+        const auto result = SCHEMA.Read(SCHEMA.Write(written, indent), read);
+        CHECK(!result.syntaxError);
+        CHECK(result.errors.empty());
+        CHECK(read.enabled == written.enabled);
+        CHECK(read.fov == written.fov);
+        CHECK(read.presets == written.presets);
+        CHECK(read.smoothing == written.smoothing);
+        CHECK(read.mode == written.mode);
+        CHECK(read.key == written.key);
+    }
+}
+
+TEST(WritesCompactAndIndented) {
+    Settings settings {};
+    CHECK(SCHEMA.Write(settings, -1) ==
+        R"({"enabled":true,"fov":90,"presets":[70,90],"smoothing":0.1,)"
+        R"("mode":"fast","key":112})");
+    CHECK(SCHEMA.Write(settings, 2) ==
+        "{\n"
+        "  \"enabled\": true,\n"
+        "  \"fov\": 90,\n"
+        "  \"presets\": [\n"
+        "    70,\n"
+        "    90\n"
+        "  ],\n"
+        "  \"smoothing\": 0.1,\n"
+        "  \"mode\": \"fast\",\n"
+        "  \"key\": 112\n"
+        "}");
+}
+
+TEST(WriterEscapesAndFormatsNumbers) {
+    JsonWriter writer { -1 };
+    writer.BeginArray();
+    writer.String("a\"b\\c\n\x01");
+    writer.Number(1.0);
+    writer.Number(0.1f);
+    writer.Number(std::numeric_limits<double>::infinity());
+    writer.Integer(std::numeric_limits<int64_t>::min());
+    writer.Unsigned(std::numeric_limits<uint64_t>::max());
+    writer.BeginObject();
+    writer.EndObject();
+    writer.EndArray();
+    CHECK(writer.Output() ==
+        R"(["a\"b\\c\n\u0001",1.0,0.1,null,-9223372036854775808,)"
+        R"(18446744073709551615,{}])");
+}
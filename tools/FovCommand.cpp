@@ -0,0 +1,90 @@
+#include "plugin/CommandRing.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+// Sends one command to a running plugin and waits until the plugin has
+// taken it off the ring
+
+namespace {
+constexpr auto USAGE = R"(Usage: fov_command <command> [value]
+
+  ping                      Check that the plugin is draining commands
+  fov <degrees>             Set the field of view
+  smoothing <seconds>       Set the smoothing time constant
+  enable | disable          Enable or disable the override
+  preset <index>            Select a field of view preset, from zero
+  dump                      Write the diagnostics files
+)";
+
+constexpr auto RECEIVE_TIMEOUT = std::chrono::seconds(1);
+
+std::optional<uint64_t> Send(
+    CommandClient& client,
+    const std::string_view command,
+    const std::string& value) {
+    if (command == "ping") {
+        return client.Ping();
+    }
+    if (command == "fov") {
+        return client.SetFieldOfView(std::stoi(value));
+    }
+    if (command == "smoothing") {
+        return client.SetSmoothing(std::stof(value));
+    }
+    if (command == "enable" || command == "disable") {
+        return client.SetEnable(command == "enable");
+    }
+    if (command == "preset") {
+        return client.SelectPreset(std::stoi(value));
+    }
+    if (command == "dump") {
+        return client.Dump();
+    }
+    throw std::runtime_error { "Unknown command " + std::string { command } };
+}
+} // namespace
+
+int main(const int argc, char* argv[]) try {
+    if (argc < 2) {
+        std::cerr << USAGE;
+        return EXIT_FAILURE;
+    }
+
+    std::optional<CommandClient> client {};
+    try {
+        client.emplace();
+    } catch (const std::system_error& e) {
+        throw std::runtime_error {
+            "No plugin running: " + std::string { e.what() }
+        };
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto sequence = Send(*client, argv[1], argc > 2 ? argv[2] : "");
+    if (!sequence) {
+        throw std::runtime_error { "Command ring is full" };
+    }
+    while (!client->IsReceived(*sequence)) {
+        if (std::chrono::steady_clock::now() - start > RECEIVE_TIMEOUT) {
+            throw std::runtime_error { "Plugin did not receive the command" };
+        }
+        std::this_thread::yield();
+    }
+    const auto latency = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << "received after " << latency << " us\n";
+    return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+    std::cerr << "fov_command: " << e.what() << '\n';
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,161 @@
+#include "plugin/Command.hpp"
+#include "plugin/CommandRing.hpp"
+#include "utils/Histogram.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+// Measures the latency of commands from a client to the plugin, by sending
+// pings one at a time and waiting for each to be taken off the ring. The
+// local mode drains the ring on a thread of its own instead, ticking like
+// the plugin's mediator, which measures the transport without a plugin.
+
+namespace {
+constexpr auto USAGE = R"(Usage: fov_command_bench [options]
+
+  --count <n>               Pings to send (default: 10000)
+  --local <us>              Drain the ring locally, sleeping this long
+                            between drains like the mediator, or spinning
+                            when zero. Fails while a plugin is running.
+)";
+
+constexpr auto RECEIVE_TIMEOUT = std::chrono::seconds(1);
+
+struct Options {
+    uint64_t count;
+    std::optional<std::chrono::microseconds> localTick;
+};
+
+Options ParseOptions(const std::span<char*> args) {
+    Options options {
+        .count = 10000,
+        .localTick = std::nullopt
+    };
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string_view arg { args[i] };
+        if (i + 1 >= args.size()) {
+            throw std::runtime_error {
+                "Missing value for " + std::string { arg }
+            };
+        }
+        const std::string value { args[++i] };
+
+        if (arg == "--count") {
+            options.count = std::stoull(value);
+        } else if (arg == "--local") {
+            options.localTick = std::chrono::microseconds(std::stoul(value));
+        } else {
+            throw std::runtime_error {
+                "Unknown option " + std::string { arg }
+            };
+        }
+    }
+    return options;
+}
+
+void PrintLatency(const std::string_view name, const Histogram& histogram) {
+    const auto snapshot = histogram.Snapshot();
+    const auto microseconds = [](const double nanoseconds) {
+        return nanoseconds / 1000.0;
+    };
+    std::cout << std::fixed << std::setprecision(2) << name
+        << " (us): count " << snapshot.Count()
+        << " mean " << microseconds(snapshot.Mean())
+        << " p50 " << microseconds(
+            static_cast<double>(snapshot.Percentile(50.0)))
+        << " p90 " << microseconds(
+            static_cast<double>(snapshot.Percentile(90.0)))
+        << " p99 " << microseconds(
+            static_cast<double>(snapshot.Percentile(99.0)))
+        << " max " << microseconds(static_cast<double>(snapshot.Max()))
+        << '\n';
+}
+} // namespace
+
+int main(const int argc, char* argv[]) try {
+    if (argc > 1 && std::string_view { argv[1] } == "--help") {
+        std::cerr << USAGE;
+        return EXIT_SUCCESS;
+    }
+
+    const auto options = ParseOptions({ argv + 1, argv + argc });
+
+    // Time from the send to the local consumer taking the command
+    Histogram delivery {};
+    std::optional<CommandRing> ring {};
+    std::jthread consumer {};
+    if (options.localTick) {
+        ring.emplace();
+        consumer = std::jthread([&, tick = *options.localTick](
+            const std::stop_token stopToken) {
+            Command command {};
+            while (!stopToken.stop_requested()) {
+                while (ring->TryPop(command)) {
+                    const auto now = std::chrono::duration_cast<
+                        std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+                            .time_since_epoch()).count();
+                    delivery.Record(
+                        static_cast<uint64_t>(now - command.sendTime));
+                }
+                if (tick.count() > 0) {
+                    std::this_thread::sleep_for(tick);
+                }
+            }
+        });
+    }
+
+    // Time from the send to the client seeing the command taken
+    Histogram roundTrip {};
+    std::optional<CommandClient> client {};
+    try {
+        client.emplace();
+    } catch (const std::system_error& e) {
+        throw std::runtime_error {
+            "No plugin running: " + std::string { e.what() }
+        };
+    }
+    for (uint64_t i = 0; i < options.count; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto sequence = client->Ping();
+        if (!sequence) {
+            throw std::runtime_error { "Command ring is full" };
+        }
+        while (!client->IsReceived(*sequence)) {
+            if (std::chrono::steady_clock::now() - start > RECEIVE_TIMEOUT) {
+                throw std::runtime_error {
+                    "Plugin did not receive the command"
+                };
+            }
+            std::this_thread::yield();
+        }
+        roundTrip.Record(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+    }
+    if (consumer.joinable()) {
+        consumer.request_stop();
+        consumer.join();
+    }
+
+    PrintLatency("round trip", roundTrip);
+    if (options.localTick) {
+        PrintLatency("delivery", delivery);
+    }
+    return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+    std::cerr << "fov_command_bench: " << e.what() << '\n';
+    return EXIT_FAILURE;
+}
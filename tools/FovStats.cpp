@@ -0,0 +1,133 @@
+#include "plugin/StatsPage.hpp"
+#include "utils/SmoothingFilter.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+// Polls the stats page of a running plugin and prints one line per poll.
+// Reading the page is a few loads of shared memory, so polling often costs
+// the plugin nothing.
+
+namespace {
+constexpr auto USAGE = R"(Usage: fov_stats [options]
+
+  --interval <ms>           Time between polls (default: 1000)
+  --count <n>               Stop after n polls (default: never)
+)";
+
+// Age after which the plugin is reported as stalled
+constexpr auto STALE_AGE = std::chrono::seconds(1);
+
+struct Options {
+    std::chrono::milliseconds interval;
+    uint64_t count;
+};
+
+std::string_view FilterName(const FilterType type) noexcept {
+    switch (type) {
+    case FilterType::OneEuro:
+        return "one_euro";
+    case FilterType::Spring:
+        return "spring";
+    default:
+        return "exponential";
+    }
+}
+
+Options ParseOptions(const std::span<char*> args) {
+    Options options {
+        .interval = std::chrono::milliseconds(1000),
+        .count = 0
+    };
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string_view arg { args[i] };
+        if (i + 1 >= args.size()) {
+            throw std::runtime_error {
+                "Missing value for " + std::string { arg }
+            };
+        }
+        const std::string value { args[++i] };
+
+        if (arg == "--interval") {
+            options.interval = std::chrono::milliseconds(std::stoul(value));
+        } else if (arg == "--count") {
+            options.count = std::stoull(value);
+        } else {
+            throw std::runtime_error {
+                "Unknown option " + std::string { arg }
+            };
+        }
+    }
+    return options;
+}
+
+StatsPageReader OpenReader() try {
+    return StatsPageReader {};
+} catch (const std::system_error& e) {
+    throw std::runtime_error {
+        "No plugin running: " + std::string { e.what() }
+    };
+}
+
+void PrintStats(const PluginStats& stats, const uint64_t version) {
+    const auto age = std::chrono::steady_clock::now().time_since_epoch() -
+        std::chrono::nanoseconds(stats.updateTime);
+    const auto ageMilliseconds =
+        std::chrono::duration<double, std::milli>(age).count();
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "fov " << stats.fov << " applied " << stats.appliedFov
+        << (stats.isEnabled ? " enabled" : " disabled")
+        << (stats.isHooked ? " hooked" : " unhooked")
+        << (stats.isWindowFocused ? " focused" : " unfocused")
+        << (stats.isCursorVisible ? " cursor" : "")
+        << " | " << FilterName(stats.filter)
+        << std::setprecision(3) << " smoothing " << stats.smoothing
+        << " beta " << stats.oneEuroBeta << std::setprecision(1)
+        << " | hook " << stats.hookCallRate << "/s " << stats.hookCalls
+        << " | mediator " << stats.tickRate << "/s "
+        << std::setprecision(2) << stats.tickMicroseconds << " us "
+        << stats.pendingEvents << " pending"
+        << " | errors hook " << stats.hookErrors
+        << " config " << stats.configParseErrors
+        << " dropped " << stats.droppedInputs
+        << std::setprecision(0) << " | update " << version
+        << " age " << ageMilliseconds << " ms"
+        << (age > STALE_AGE ? " STALE" : "") << '\n';
+}
+} // namespace
+
+int main(const int argc, char* argv[]) try {
+    if (argc > 1 && std::string_view { argv[1] } == "--help") {
+        std::cerr << USAGE;
+        return EXIT_SUCCESS;
+    }
+
+    const auto options = ParseOptions({ argv + 1, argv + argc });
+    const auto reader = OpenReader();
+    for (uint64_t i = 0; options.count == 0 || i < options.count; ++i) {
+        if (i > 0) {
+            std::this_thread::sleep_for(options.interval);
+        }
+        if (const auto stats = reader.Read()) {
+            PrintStats(*stats, reader.Version());
+        } else {
+            std::cout << "plugin stopped while publishing\n";
+        }
+    }
+    return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+    std::cerr << "fov_stats: " << e.what() << '\n';
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,435 @@
+#include "plugin/FovOverride.hpp"
+#include "utils/CallTrace.hpp"
+#include "utils/SmoothingFilter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Replays a recorded trace of field of view setter calls through the
+// override logic for every combination of the given parameters, and prints
+// one CSV row per combination, best total deviation first. Traces are
+// dumped by the plugin with the dump key when logging is enabled.
+
+namespace {
+constexpr auto USAGE = R"(Usage: fov_sweep [options] <trace>
+
+Lists are comma separated, and each item is a value or start:stop:step.
+
+  --filters <list>          exponential, one_euro, spring (default: all)
+  --smoothing <list>        Time constants in seconds (default: 0:1:0.05)
+  --beta <list>             One Euro beta (default: 0.002)
+  --reset-counts <list>     Calls before the filter restarts (default: 8)
+  --thresholds <list>       Settle thresholds in degrees (default: 0.1)
+  --fov <list>              Targets cycled through (default: 45,90)
+  --switch-interval <s>     Seconds between target switches (default: 2)
+  --tolerance <degrees>     Band around the target counted as settled
+                            (default: 0.5)
+  --threads <n>             Worker threads (default: all cores)
+  --top <n>                 Only print the best n rows (default: all)
+)";
+
+struct Options {
+    std::filesystem::path tracePath;
+    std::vector<FilterType> filters;
+    std::vector<double> smoothings;
+    std::vector<double> betas;
+    std::vector<double> resetCounts;
+    std::vector<double> thresholds;
+    std::vector<double> fovs;
+    double switchInterval;
+    double tolerance;
+    unsigned threadCount;
+    size_t top;
+};
+
+struct Parameters {
+    FilterType filter;
+    float smoothing;
+    float beta;
+    int resetCount;
+    float threshold;
+};
+
+struct Metrics {
+    double settlingMean;
+    double settlingMax;
+    int unsettledCount;
+    double maxDelta;
+    double totalDeviation;
+};
+
+std::string_view FilterName(const FilterType type) noexcept {
+    switch (type) {
+    case FilterType::OneEuro:
+        return "one_euro";
+    case FilterType::Spring:
+        return "spring";
+    default:
+        return "exponential";
+    }
+}
+
+std::vector<std::string_view> Split(std::string_view text, const char delimiter) {
+    std::vector<std::string_view> items {};
+    while (true) {
+        const auto pos = text.find(delimiter);
+        items.push_back(text.substr(0, pos));
+        if (pos == std::string_view::npos) {
+            return items;
+        }
+        text.remove_prefix(pos + 1);
+    }
+}
+
+double ParseNumber(const std::string_view text) {
+    const std::string string { text };
+    char* end = nullptr;
+    const double value = std::strtod(string.c_str(), &end);
+    if (string.empty() || *end != '\0' || !std::isfinite(value)) {
+        throw std::runtime_error { "Invalid number: " + string };
+    }
+    return value;
+}
+
+std::vector<double> ParseList(const std::string_view text) {
+    std::vector<double> values {};
+    for (const auto item : Split(text, ',')) {
+        const auto parts = Split(item, ':');
+        if (parts.size() == 1) {
+            values.push_back(ParseNumber(parts[0]));
+            continue;
+        }
+        if (parts.size() != 3) {
+            throw std::runtime_error { "Invalid range: " + std::string { item } };
+        }
+        const double start = ParseNumber(parts[0]);
+        const double stop = ParseNumber(parts[1]);
+        const double step = ParseNumber(parts[2]);
+        if (step <= 0.0) {
+            throw std::runtime_error { "Range step must be positive" };
+        }
+        // Indexed rather than accumulated so the stop value is not missed to
+        // rounding
+        const auto count = static_cast<long>(
+            std::floor((stop - start) / step + 1e-9)) + 1;
+        for (long i = 0; i < count; ++i) {
+            values.push_back(start + static_cast<double>(i) * step);
+        }
+    }
+    return values;
+}
+
+std::vector<FilterType> ParseFilters(const std::string_view text) {
+    static const std::map<std::string_view, FilterType> names {
+        { "exponential", FilterType::Exponential },
+        { "one_euro", FilterType::OneEuro },
+        { "spring", FilterType::Spring }
+    };
+
+    std::vector<FilterType> filters {};
+    for (const auto item : Split(text, ',')) {
+        const auto it = names.find(item);
+        if (it == names.end()) {
+            throw std::runtime_error {
+                "Unknown filter: " + std::string { item }
+            };
+        }
+        filters.push_back(it->second);
+    }
+    return filters;
+}
+
+Options ParseOptions(const std::span<char*> args) {
+    Options options {
+        .tracePath = {},
+        .filters = {
+            FilterType::Exponential, FilterType::OneEuro, FilterType::Spring
+        },
+        .smoothings = ParseList("0:1:0.05"),
+        .betas = { 0.002 },
+        .resetCounts = { 8.0 },
+        .thresholds = { 0.1 },
+        .fovs = { 45.0, 90.0 },
+        .switchInterval = 2.0,
+        .tolerance = 0.5,
+        .threadCount = std::max(std::thread::hardware_concurrency(), 1u),
+        .top = 0
+    };
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string_view arg { args[i] };
+        if (!arg.starts_with("--")) {
+            if (!options.tracePath.empty()) {
+                throw std::runtime_error { "More than one trace given" };
+            }
+            options.tracePath = arg;
+            continue;
+        }
+        if (i + 1 >= args.size()) {
+            throw std::runtime_error {
+                "Missing value for " + std::string { arg }
+            };
+        }
+        const std::string_view value { args[++i] };
+
+        if (arg == "--filters") {
+            options.filters = ParseFilters(value);
+        } else if (arg == "--smoothing") {
+            options.smoothings = ParseList(value);
+        } else if (arg == "--beta") {
+            options.betas = ParseList(value);
+        } else if (arg == "--reset-counts") {
+            options.resetCounts = ParseList(value);
+        } else if (arg == "--thresholds") {
+            options.thresholds = ParseList(value);
+        } else if (arg == "--fov") {
+            options.fovs = ParseList(value);
+        } else if (arg == "--switch-interval") {
+            options.switchInterval = ParseNumber(value);
+        } else if (arg == "--tolerance") {
+            options.tolerance = ParseNumber(value);
+        } else if (arg == "--threads") {
+            options.threadCount = static_cast<unsigned>(
+                std::max(ParseNumber(value), 1.0));
+        } else if (arg == "--top") {
+            options.top = static_cast<size_t>(
+                std::max(ParseNumber(value), 0.0));
+        } else {
+            throw std::runtime_error {
+                "Unknown option: " + std::string { arg }
+            };
+        }
+    }
+
+    if (options.tracePath.empty()) {
+        throw std::runtime_error { "No trace given" };
+    }
+    if (options.fovs.empty() || options.switchInterval <= 0.0) {
+        throw std::runtime_error { "Invalid field of view targets" };
+    }
+    return options;
+}
+
+std::vector<Parameters> MakeGrid(const Options& options) {
+    std::vector<Parameters> grid {};
+    for (const auto filter : options.filters) {
+        for (const auto smoothing : options.smoothings) {
+            // Beta only matters for the One Euro filter
+            const auto betas = filter == FilterType::OneEuro ?
+                std::span { options.betas } :
+                std::span { options.betas.data(), 1 };
+            for (const auto beta : betas) {
+                for (const auto resetCount : options.resetCounts) {
+                    for (const auto threshold : options.thresholds) {
+                        grid.push_back({
+                            filter,
+                            static_cast<float>(smoothing),
+                            static_cast<float>(beta),
+                            static_cast<int>(resetCount),
+                            static_cast<float>(threshold)
+                        });
+                    }
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+// The camera that calls the setter most often is the one the override
+// targets
+uint64_t FindMainInstance(const std::span<const CallSample> samples) {
+    std::unordered_map<uint64_t, size_t> counts {};
+    for (const auto& sample : samples) {
+        ++counts[sample.instance];
+    }
+    return std::ranges::max_element(
+        counts, {}, [](const auto& pair) { return pair.second; })->first;
+}
+
+FovOverride::TimePoint ToTimePoint(const double seconds) noexcept {
+    using Duration = FovOverride::TimePoint::duration;
+    return FovOverride::TimePoint {
+        std::chrono::duration_cast<Duration>(
+            std::chrono::duration<double>(seconds))
+    };
+}
+
+Metrics Simulate(
+    const std::span<const CallSample> samples,
+    const uint64_t mainInstance,
+    const Parameters& parameters,
+    const Options& options) {
+    FovOverride fovOverride {};
+    auto& filter = fovOverride.Filter();
+    filter.SetType(parameters.filter);
+    filter.SetTimeConstant(parameters.smoothing);
+    filter.SetBeta(parameters.beta);
+    fovOverride.SetResetCallCount(parameters.resetCount);
+    fovOverride.SetSettleThreshold(parameters.threshold);
+    fovOverride.SetEnable(true);
+    fovOverride.SetHook(true);
+
+    // Trace times start near zero, long before the filter's construction
+    // time on the steady clock
+    const auto& first = samples.front();
+    filter.SetInitialValue(first.value, ToTimePoint(first.time));
+
+    Metrics metrics {};
+    double settlingSum = 0.0;
+    int settledCount = 0;
+
+    const double startTime = first.time;
+    size_t segment = std::numeric_limits<size_t>::max();
+    double segmentStart = startTime;
+    double target = 0.0;
+    bool isSettled = false;
+    double settledAt = 0.0;
+    std::optional<float> previousOutput {};
+    double previousTime = startTime;
+
+    const auto endSegment = [&] {
+        if (segment == std::numeric_limits<size_t>::max()) {
+            return;
+        }
+        if (isSettled) {
+            const double settling = settledAt - segmentStart;
+            settlingSum += settling;
+            metrics.settlingMax = std::max(metrics.settlingMax, settling);
+            ++settledCount;
+        } else {
+            ++metrics.unsettledCount;
+        }
+    };
+
+    for (const auto& [time, instance, value] : samples) {
+        const auto index = static_cast<size_t>(
+            (time - startTime) / options.switchInterval);
+        if (index != segment) {
+            endSegment();
+            segment = index;
+            segmentStart = time;
+            target = options.fovs[index % options.fovs.size()];
+            isSettled = false;
+            fovOverride.SetFieldOfView(static_cast<int>(target));
+        }
+
+        const auto [output, isHookDone, isTargetApplied] = fovOverride.Process(
+            reinterpret_cast<void*>(instance), value, ToTimePoint(time));
+
+        // Calls passed through with the marker are not overridden
+        const auto marker = std::bit_cast<float>(
+            std::bit_cast<uint32_t>(value) + 1);
+        if (instance != mainInstance || output == marker) {
+            continue;
+        }
+
+        const double deviation = std::abs(output - target);
+        if (previousOutput) {
+            metrics.maxDelta = std::max(
+                metrics.maxDelta,
+                static_cast<double>(std::abs(output - *previousOutput)));
+            metrics.totalDeviation += deviation * (time - previousTime);
+        }
+        previousOutput = output;
+        previousTime = time;
+
+        if (deviation > options.tolerance) {
+            isSettled = false;
+        } else if (!isSettled) {
+            isSettled = true;
+            settledAt = time;
+        }
+    }
+    endSegment();
+
+    metrics.settlingMean = settledCount > 0 ?
+        settlingSum / settledCount : std::numeric_limits<double>::quiet_NaN();
+    return metrics;
+}
+
+void PrintResults(
+    const std::span<const Parameters> grid,
+    const std::span<const Metrics> results,
+    const size_t top) {
+    std::vector<size_t> order(grid.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::ranges::stable_sort(order, {}, [&](const size_t i) {
+        return results[i].totalDeviation;
+    });
+    if (top > 0 && top < order.size()) {
+        order.resize(top);
+    }
+
+    std::cout << "filter,smoothing,beta,reset_count,threshold,"
+        "settling_mean,settling_max,unsettled,max_delta,total_deviation\n";
+    for (const auto i : order) {
+        const auto& [filter, smoothing, beta, resetCount, threshold] = grid[i];
+        const auto& [settlingMean, settlingMax, unsettledCount, maxDelta,
+            totalDeviation] = results[i];
+        std::cout << FilterName(filter) << ',' << smoothing << ',' << beta
+            << ',' << resetCount << ',' << threshold << ',' << settlingMean
+            << ',' << settlingMax << ',' << unsettledCount << ',' << maxDelta
+            << ',' << totalDeviation << '\n';
+    }
+}
+} // namespace
+
+int main(const int argc, char* argv[]) try {
+    if (argc < 2) {
+        std::cerr << USAGE;
+        return EXIT_FAILURE;
+    }
+
+    const auto options = ParseOptions({ argv + 1, argv + argc });
+    auto samples = ReadCallTrace(options.tracePath);
+    if (samples.empty()) {
+        throw std::runtime_error { "Trace is empty" };
+    }
+    std::ranges::stable_sort(samples, {}, &CallSample::time);
+    const auto mainInstance = FindMainInstance(samples);
+
+    const auto grid = MakeGrid(options);
+    std::vector<Metrics> results(grid.size());
+    std::atomic<size_t> next { 0 };
+    {
+        std::vector<std::jthread> workers {};
+        const auto workerCount = std::min<size_t>(
+            options.threadCount, grid.size());
+        for (size_t i = 0; i < workerCount; ++i) {
+            workers.emplace_back([&] {
+                for (auto j = next.fetch_add(1, std::memory_order_relaxed);
+                     j < grid.size();
+                     j = next.fetch_add(1, std::memory_order_relaxed)) {
+                    results[j] = Simulate(samples, mainInstance, grid[j], options);
+                }
+            });
+        }
+    }
+
+    PrintResults(grid, results, options.top);
+    return EXIT_SUCCESS;
+} catch (const std::exception& e) {
+    std::cerr << "fov_sweep: " << e.what() << '\n';
+    return EXIT_FAILURE;
+}